@@ -19,9 +19,8 @@
 
 #include "abstractaction.h"
 
-#include <cstring>                      // for memset
-
 #include "random_gen.h"
+#include "stdcardfactory.h"
 
 #if defined(TRACE_AI) && !defined(NDEBUG)
 #include "logger.h"
@@ -37,6 +36,19 @@ const NetMauMau::Common::ICard::SUIT SUIT[4] = {
 	NetMauMau::Common::ICard::CLUBS
 };
 
+NetMauMau::Common::ICardPtr createSuitCard(NetMauMau::Common::ICard::SUIT s) {
+	return NetMauMau::Common::ICardPtr(NetMauMau::StdCardFactory().create(s,
+									   NetMauMau::Common::ICard::RANK_ILLEGAL));
+}
+
+// indexed by suit
+const NetMauMau::Common::ICardPtr SUITCARDS[4] = {
+	createSuitCard(NetMauMau::Common::ICard::DIAMONDS),
+	createSuitCard(NetMauMau::Common::ICard::HEARTS),
+	createSuitCard(NetMauMau::Common::ICard::SPADES),
+	createSuitCard(NetMauMau::Common::ICard::CLUBS)
+};
+
 #pragma GCC diagnostic ignored "-Weffc++"
 #pragma GCC diagnostic push
 struct _isSpecialRank : std::binary_function < NetMauMau::Player::IPlayer::CARDS::value_type,
@@ -60,7 +72,7 @@ private:
 
 using namespace NetMauMau::AI;
 
-AbstractAction::AbstractAction() throw() : IAction(), DecisionBase() {}
+AbstractAction::AbstractAction(NODETYPE nodeType) throw() : IAction(nodeType), DecisionBase() {}
 
 AbstractAction::~AbstractAction() throw() {}
 
@@ -75,23 +87,42 @@ const IConditionPtr &AbstractAction::operator()(IAIState &state) const throw() {
 	state.getCardCount();
 #endif
 
-	return perform(state, state.isNoJack() ? DecisionBase::removeJack(state.getPlayerCards()) :
-				   state.getPlayerCards());
+	if(state.isNoJack()) {
+		return perform(state, DecisionBase::removeJack(state, state.getPlayerCards()));
+	}
+
+	return perform(state, state.getPlayerCards());
 }
 
-void AbstractAction::countSuits(SUITCOUNT *suitCount,
-								const IAIState::PLAYEDOUTCARDS &cards) throw() {
+void AbstractAction::countSuits(SUITCOUNT *suitCount, const CardView &cards) throw() {
 
-	std::memset(suitCount, 0, sizeof(SUITCOUNT) * 4);
+	// indexed by suit
+	NetMauMau::Player::IPlayer::CARDS::difference_type cnt[4] = { 0, 0, 0, 0 };
+	const bool noCards = cards.empty();
 
-	IAIState::PLAYEDOUTCARDS myCards(cards);
+	for(CardView::const_iterator i(cards.begin()); i != cards.end(); ++i) {
+		if((*i)->getSuit() < 4) ++cnt[(*i)->getSuit()];
+	}
 
-	removeJack(myCards);
+	for(std::size_t i = 0; i < 4; ++i) suitCount[i] = SUITCOUNT(SUIT[i], cnt[SUIT[i]]);
 
-	const bool noCards = myCards.empty();
+	if(!noCards) std::sort(suitCount, suitCount + 4);
+}
 
-	for(std::size_t i = 0; i < 4; ++i) suitCount[i] = SUITCOUNT(SUIT[i],
-				noCards ? 0 : DecisionBase::count(myCards, SUIT[i]));
+void AbstractAction::countSuits(SUITCOUNT *suitCount,
+								const NetMauMau::IPlayedOutStats &stats) throw() {
+
+	bool noCards = true;
+
+	for(std::size_t i = 0; i < 4; ++i) {
+
+		const NetMauMau::Player::IPlayer::CARDS::difference_type cnt =
+			static_cast<NetMauMau::Player::IPlayer::CARDS::difference_type>
+			(stats.getCount(SUIT[i]));
+
+		suitCount[i] = SUITCOUNT(SUIT[i], cnt);
+		noCards = noCards && !cnt;
+	}
 
 	if(!noCards) std::sort(suitCount, suitCount + 4);
 }
@@ -100,7 +131,7 @@ NetMauMau::Common::ICard::SUIT AbstractAction::getMaxPlayedOffSuit(const IAIStat
 		NetMauMau::Player::IPlayer::CARDS::difference_type *count) throw() {
 
 	AbstractAction::SUITCOUNT poSuitCount[4];
-	AbstractAction::countSuits(poSuitCount, state.getPlayedOutCards());
+	AbstractAction::countSuits(poSuitCount, state.getPlayedOutStats());
 
 	if(count) *count = poSuitCount[0].count;
 
@@ -115,63 +146,55 @@ const IConditionPtr &AbstractAction::getNullCondition() throw() {
 	return NULLCONDITION;
 }
 
-NetMauMau::Player::IPlayer::CARDS::iterator
-AbstractAction::pullSpecialRank(NetMauMau::Player::IPlayer::CARDS &cards,
-								NetMauMau::Common::ICard::RANK rank, bool nineIsSuspend) throw() {
-	return std::partition(cards.begin(), cards.end(), std::bind2nd(_isSpecialRank(nineIsSuspend),
-						  rank));
+const NetMauMau::Common::ICardPtr &
+AbstractAction::getSuitCard(NetMauMau::Common::ICard::SUIT s) throw() {
+	return SUITCARDS[s < 4 ? s : 0];
 }
 
 NetMauMau::Common::ICardPtr AbstractAction::hasRankPath(const NetMauMau::Common::ICardPtr &uc,
 		NetMauMau::Common::ICard::SUIT suit, NetMauMau::Common::ICard::RANK rank,
-		const NetMauMau::Player::IPlayer::CARDS &c, bool nineIsSuspend) throw() {
+		const CardView &c, bool nineIsSuspend) throw() {
 
 	if(c.size() > 1) {
 
-		NetMauMau::Player::IPlayer::CARDS myCards(c);
-
-		const NetMauMau::Player::IPlayer::CARDS::iterator &e(pullSpecialRank(myCards, rank,
-				nineIsSuspend));
-
-		if(std::distance(myCards.begin(), e)) {
+		const _isSpecialRank isSpecialRank(nineIsSuspend);
 
-			const NetMauMau::Player::IPlayer::CARDS::value_type
-			f_src(NetMauMau::Common::find(uc->getSuit(), myCards.begin(), e));
+		CardView::value_type f_src;
+		bool f_dest = false;
 
-			if(f_src) {
+		for(CardView::const_iterator i(c.begin()); i != c.end() && !(f_src && f_dest); ++i) {
 
-				NetMauMau::Player::IPlayer::CARDS::value_type f_dest(NetMauMau::Common::find(suit,
-						myCards.begin(), e));
+			if(isSpecialRank(*i, rank)) {
+				if(!f_src && *i == uc->getSuit()) f_src = *i;
 
-				if(f_dest) return f_src;
+				f_dest = f_dest || *i == suit;
 			}
 		}
+
+		if(f_src && f_dest) return f_src;
 	}
 
 	return NetMauMau::Common::ICardPtr();
 }
 
 NetMauMau::Common::ICardPtr AbstractAction::findRankTryAvoidSuit(NetMauMau::Common::ICard::RANK r,
-		const NetMauMau::Player::IPlayer::CARDS &c,
-		NetMauMau::Common::ICard::SUIT avoidSuit) throw() {
+		const CardView &c, NetMauMau::Common::ICard::SUIT avoidSuit) throw() {
 
-	NetMauMau::Common::ICardPtr ret;
 	NetMauMau::Common::ICard::SUIT rndSuits[4];
-	NetMauMau::Player::IPlayer::CARDS myCards(c);
 
 	std::copy(getSuits(), getSuits() + 4, rndSuits);
 	std::random_shuffle(rndSuits, rndSuits + 4, NetMauMau::Common::genRandom<std::ptrdiff_t>);
 
 	for(unsigned int i = 0u; i < 4u; ++i) {
 
-		const NetMauMau::Player::IPlayer::CARDS::iterator &e(pull(myCards.begin(), myCards.end(),
-				rndSuits[i]));
+		if(rndSuits[i] == avoidSuit) continue;
 
-		if(rndSuits[i] != avoidSuit && ((ret = NetMauMau::Common::find(r, myCards.begin(), e))
-										&& ret == rndSuits[i])) break;
+		for(CardView::const_iterator j(c.begin()); j != c.end(); ++j) {
+			if(*j == rndSuits[i] && *j == r) return *j;
+		}
 	}
 
-	return ret ? ret : NetMauMau::Common::find(r, c.begin(), c.end());
+	return NetMauMau::Common::find(r, c.begin(), c.end());
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
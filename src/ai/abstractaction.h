@@ -21,6 +21,7 @@
 #define NETMAUMAU_ENGINE_AI_ABSTRACTACTION_H
 
 #include "decisionbase.h"               // for DecisionBase
+#include "decisionnodes.h"              // for NODETYPE, DYNAMIC_NODE
 #include "iaction.h"                    // for IAction
 
 #include "icondition.h"                 // for IConditionPtr
@@ -37,7 +38,27 @@ public:
 	virtual const IConditionPtr &operator()(IAIState &state) const throw();
 
 	virtual const IConditionPtr &perform(IAIState &state,
-										 const Player::IPlayer::CARDS &cards) const throw() = 0;
+										 const CardView &cards) const throw() = 0;
+
+	/**
+	 * @brief Executes @c act like operator() does, but calls its @c perform directly
+	 *
+	 * @tparam Act the most derived type of @c act
+	 */
+	template<class Act>
+	inline static const IConditionPtr &execute(const Act &act, IAIState &state) throw() {
+
+#ifndef NDEBUG
+		state.getCardCount();
+#endif
+
+		if(state.isNoJack()) {
+			return act.Act::perform(state, DecisionBase::removeJack(state, state.getPlayerCards()));
+		}
+
+		return act.Act::perform(state, state.getPlayerCards());
+	}
+
 protected:
 	typedef struct _suitCount {
 
@@ -58,21 +79,27 @@ protected:
 
 	} SUITCOUNT;
 
-	AbstractAction() throw();
+	explicit AbstractAction(NODETYPE nodeType = DYNAMIC_NODE) throw();
 
 	static Common::ICardPtr hasRankPath(const Common::ICardPtr &uc, Common::ICard::SUIT s,
-										Common::ICard::RANK r, const Player::IPlayer::CARDS &mCards,
+										Common::ICard::RANK r, const CardView &mCards,
 										bool nineIsSuspend) throw();
 
 	static const Common::ICard::SUIT *getSuits() throw() _CONST;
 
-	static void countSuits(SUITCOUNT *suitCount, const IAIState::PLAYEDOUTCARDS &myCards) throw();
+	static void countSuits(SUITCOUNT *suitCount, const CardView &myCards) throw();
+	static void countSuits(SUITCOUNT *suitCount, const IPlayedOutStats &stats) throw();
 
 	static Common::ICard::SUIT getMaxPlayedOffSuit(const IAIState &state,
 			Player::IPlayer::CARDS::difference_type *count = 0L) throw();
 
 	static Common::ICardPtr findRankTryAvoidSuit(NetMauMau::Common::ICard::RANK rank,
-			const NetMauMau::Player::IPlayer::CARDS &cards, Common::ICard::SUIT avoidSuit) throw();
+			const CardView &cards, Common::ICard::SUIT avoidSuit) throw();
+
+	/**
+	 * @brief Returns a shared card of suit @c s without a rank, as used to choose a jack suit
+	 */
+	static const Common::ICardPtr &getSuitCard(Common::ICard::SUIT s) throw() _PURE;
 
 	static const IConditionPtr &getNullCondition() throw() _CONST;
 
@@ -87,15 +114,39 @@ private:
 	template<class Iterator, class Tp>
 	inline static Iterator stable_pull_internal(Iterator first, Iterator last,
 			typename Commons::RParam<Tp>::Type arg) throw() {
-		return std::stable_partition(first, last, std::bind2nd(Common::equalTo
-									 <typename Iterator::value_type, Tp>(), arg));
+		return inplace_stable_partition(first, last, std::bind2nd(Common::equalTo
+										<typename Iterator::value_type, Tp>(), arg));
 	}
 
 	template<class Iterator, class Tp>
 	inline static Iterator push_internal(Iterator first, Iterator last,
 										 typename Commons::RParam<Tp>::Type arg) throw() {
-		return std::stable_partition(first, last, std::not1(std::bind2nd(Common::equalTo
-									 <typename Iterator::value_type, Tp>(), arg)));
+		return inplace_stable_partition(first, last, std::not1(std::bind2nd(Common::equalTo
+										<typename Iterator::value_type, Tp>(), arg)));
+	}
+
+	// std::stable_partition requests a temporary buffer from the heap, hands are small enough
+	// to partition them in place by rotating
+	template<class Iterator, class Predicate>
+	static Iterator inplace_stable_partition(Iterator first, Iterator last,
+			Predicate pred) throw() {
+
+		const typename std::iterator_traits<Iterator>::difference_type len =
+			std::distance(first, last);
+
+		if(len < 2) return (len && pred(*first)) ? last : first;
+
+		Iterator middle(first);
+		std::advance(middle, len / 2);
+
+		const Iterator &l(inplace_stable_partition(first, middle, pred));
+		const Iterator &r(inplace_stable_partition(middle, last, pred));
+
+		Iterator ret(l);
+		std::advance(ret, std::distance(middle, r));
+		std::rotate(l, middle, r);
+
+		return ret;
 	}
 
 protected:
@@ -113,10 +164,6 @@ protected:
 	inline static Iterator push(Iterator first, Iterator last, const Tp &arg) throw() {
 		return push_internal<Iterator, Tp>(first, last, arg);
 	}
-
-private:
-	static Player::IPlayer::CARDS::iterator pullSpecialRank(Player::IPlayer::CARDS &cards,
-			Common::ICard::RANK rank, bool nineIsSuspend) throw();
 };
 
 }
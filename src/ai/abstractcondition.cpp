@@ -31,7 +31,8 @@ const NetMauMau::AI::IActionPtr NULLACTION;
 
 using namespace NetMauMau::AI;
 
-AbstractCondition::AbstractCondition() throw() : ICondition(), DecisionBase() {}
+AbstractCondition::AbstractCondition(NODETYPE nodeType) throw() : ICondition(nodeType),
+	DecisionBase() {}
 
 AbstractCondition::~AbstractCondition() throw() {}
 
@@ -55,8 +56,11 @@ IActionPtr AbstractCondition::operator()(const IAIState &state) const throw() {
 	state.getCardCount();
 #endif
 
-	return perform(state, state.isNoJack() ? DecisionBase::removeJack(state.getPlayerCards()) :
-				   state.getPlayerCards());
+	if(state.isNoJack()) {
+		return perform(state, DecisionBase::removeJack(state, state.getPlayerCards()));
+	}
+
+	return perform(state, state.getPlayerCards());
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
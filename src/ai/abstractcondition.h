@@ -21,6 +21,7 @@
 #define NETMAUMAU_ENGINE_AI_ABSTRACTCONDITION_H
 
 #include "decisionbase.h"               // for DecisionBase
+#include "decisionnodes.h"              // for NODETYPE, DYNAMIC_NODE
 #include "icondition.h"                 // for ICondition, IConditionPtr
 
 #include "iaction.h"                    // for IActionPtr
@@ -36,11 +37,31 @@ public:
 
 	virtual IActionPtr operator()(const IAIState &state) const throw();
 
+	/**
+	 * @brief Evaluates @c cond like operator() does, but calls its @c perform directly
+	 *
+	 * @tparam Cond the most derived type of @c cond
+	 */
+	template<class Cond>
+	inline static IActionPtr evaluate(const Cond &cond, const IAIState &state) throw() {
+
+#ifndef NDEBUG
+		state.getCardCount();
+#endif
+
+		if(state.isNoJack()) {
+			return cond.Cond::perform(state, DecisionBase::removeJack(state,
+									  state.getPlayerCards()));
+		}
+
+		return cond.Cond::perform(state, state.getPlayerCards());
+	}
+
 protected:
-	AbstractCondition() throw();
+	explicit AbstractCondition(NODETYPE nodeType = DYNAMIC_NODE) throw();
 
 	virtual IActionPtr perform(const IAIState &state,
-							   const Player::IPlayer::CARDS &cards) const throw() = 0;
+							   const CardView &cards) const throw() = 0;
 
 	IActionPtr createNextAction(const IConditionPtr &cond) const throw();
 	static const IActionPtr &getNullAction() throw() _CONST;
@@ -28,12 +28,12 @@ const NetMauMau::AI::IConditionPtr RANDOMJACKCOND(new NetMauMau::AI::RandomJackC
 
 using namespace NetMauMau::AI;
 
-AceRoundAction::AceRoundAction() throw() : AbstractAction() {}
+AceRoundAction::AceRoundAction() throw() : AbstractAction(ACEROUNDACTION_NODE) {}
 
 AceRoundAction::~AceRoundAction() throw() {}
 
 const IConditionPtr &AceRoundAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+		const CardView &cards) const throw() {
 
 	if(state.getRuleSet()->isAceRound()) {
 		state.setCard(AbstractAction::findRankTryAvoidSuit(NetMauMau::Common::ICard::ACE, cards,
@@ -41,7 +41,7 @@ const IConditionPtr &AceRoundAction::perform(IAIState &state,
 		return AbstractAction::getNullCondition();
 	}
 
-	NetMauMau::Player::IPlayer::CARDS myCards(cards);
+	IAIState::SCRATCHCARDS myCards(DecisionBase::scratchCopy(state, cards));
 
 	state.setTryAceRound(DecisionBase::count(myCards, state.getRuleSet()->getAceRoundRank()) >
 						 (state.tryAceRound() ? 0 : 1));
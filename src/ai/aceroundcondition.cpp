@@ -21,24 +21,28 @@
 
 #include "aceroundaction.h"             // for AceRoundAction
 #include "iruleset.h"                   // for IRuleSet
+#include "nextaction.h"                 // for NextAction
 #include "randomjackcondition.h"        // for RandomJackCondition
 
 namespace {
 const NetMauMau::AI::IActionPtr ACEROUNDACTION(new NetMauMau::AI::AceRoundAction());
-const NetMauMau::AI::IConditionPtr RANDOMJACKCOND(new NetMauMau::AI::RandomJackCondition());
+const NetMauMau::AI::IConditionPtr
+ACEROUNDCOND_RANDOMJACKCOND(new NetMauMau::AI::RandomJackCondition());
+const NetMauMau::AI::IActionPtr
+NEXTRANDOMJACKCOND(new NetMauMau::AI::NextAction(ACEROUNDCOND_RANDOMJACKCOND));
 }
 
 using namespace NetMauMau::AI;
 
-AceRoundCondition::AceRoundCondition() throw() : AbstractCondition() {}
+AceRoundCondition::AceRoundCondition() throw() : AbstractCondition(ACEROUNDCONDITION_NODE) {}
 
 AceRoundCondition::~AceRoundCondition() throw() {}
 
 IActionPtr AceRoundCondition::perform(const IAIState &state,
-									  const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+									  const CardView &) const throw() {
 	return state.tryAceRound() || (!state.getRuleSet()->isAceRound() &&
 								   state.getRuleSet()->isAceRoundPossible()) ?
-		   ACEROUNDACTION : createNextAction(RANDOMJACKCOND);
+		   ACEROUNDACTION : NEXTRANDOMJACKCOND;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
@@ -21,6 +21,7 @@
 #define NETMAUMAU_ENGINE_AI_BASEAIPLAYER_H
 
 #include "decisionchain.h"
+#include "decisiondispatch.h"
 
 namespace NetMauMau {
 
@@ -36,23 +37,22 @@ public:
 	virtual ~BaseAIPlayer() throw();
 
 protected:
-	typedef Common::SmartPtr<DecisionChain<root_condition_type> > DecisionChainPtr;
-	typedef Common::SmartPtr<DecisionChain<jack_root_condition_type, true> > JackDecisionChainPtr;
+	typedef DecisionChain<root_condition_type, false, StaticDispatch> DECISIONCHAIN;
+	typedef DecisionChain<jack_root_condition_type, true, StaticDispatch> JACKDECISIONCHAIN;
+
+	typedef Common::SmartPtr<DECISIONCHAIN> DecisionChainPtr;
+	typedef Common::SmartPtr<JACKDECISIONCHAIN> JackDecisionChainPtr;
 
 	explicit BaseAIPlayer(const IActionPtr &trueAct, const IActionPtr &falseAct) throw()
-		: IAIState(), m_decisionChain(Common::SmartPtr<DecisionChain<root_condition_type> >
-									  (new DecisionChain<root_condition_type>(*this))),
-		m_jackDecisionChain(Common::SmartPtr<DecisionChain<jack_root_condition_type, true> >
-							(new DecisionChain<jack_root_condition_type, true>(*this,
-									IActionPtr(trueAct), IActionPtr(falseAct)))), m_card(),
-		m_uncoveredCard(), m_jackSuit(0L), m_playedCard(), m_noJack(false) {}
+		: IAIState(), m_decisionChain(DecisionChainPtr(new DECISIONCHAIN(*this))),
+		m_jackDecisionChain(JackDecisionChainPtr(new JACKDECISIONCHAIN(*this,
+							IActionPtr(trueAct), IActionPtr(falseAct)))), m_card(),
+		m_uncoveredCard(), m_jackSuit(0L), m_playedCard(), m_noJack(false), m_scratchArena() {}
 
 	explicit BaseAIPlayer() throw() : IAIState(),
-		m_decisionChain(Common::SmartPtr<DecisionChain<root_condition_type> >
-						(new DecisionChain<root_condition_type>(*this))),
-		m_jackDecisionChain(Common::SmartPtr<DecisionChain<jack_root_condition_type, true> >
-							(new DecisionChain<jack_root_condition_type, true>(*this))), m_card(),
-		m_uncoveredCard(), m_jackSuit(0L), m_playedCard(), m_noJack(false) {}
+		m_decisionChain(DecisionChainPtr(new DECISIONCHAIN(*this))),
+		m_jackDecisionChain(JackDecisionChainPtr(new JACKDECISIONCHAIN(*this))), m_card(),
+		m_uncoveredCard(), m_jackSuit(0L), m_playedCard(), m_noJack(false), m_scratchArena() {}
 
 	virtual Common::ICardPtr getUncoveredCard() const throw() {
 		return m_uncoveredCard;
@@ -82,6 +82,10 @@ protected:
 		return m_jackSuit;
 	}
 
+	virtual Common::ScratchArena &getScratchArena() const throw() {
+		return m_scratchArena;
+	}
+
 	const DecisionChainPtr &getDecisionChain() const throw() {
 		return m_decisionChain;
 	}
@@ -106,6 +110,7 @@ protected:
 	mutable Common::ICard::SUIT *m_jackSuit;
 	mutable Common::ICardPtr m_playedCard;
 	mutable bool m_noJack;
+	mutable Common::ScratchArena m_scratchArena;
 };
 
 template<class RootCond, class RootCondJack>
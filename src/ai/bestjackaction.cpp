@@ -22,24 +22,30 @@
 #include "checkjacksuitaction.h"        // for CheckJackSuitAction
 #include "checksevencondition.h"        // for CheckSevenCondition
 #include "decisionchain.h"              // for DecisionChain
+#include "decisiondispatch.h"           // for StaticDispatch
 #include "staticcondition.h"            // for StaticCondition
 
 namespace {
 const NetMauMau::AI::IConditionPtr
 CHECKJACKSUITACTION(new NetMauMau::AI::StaticCondition<NetMauMau::AI::CheckJackSuitAction>());
+const NetMauMau::AI::IConditionPtr CHECKSEVENCOND(new NetMauMau::AI::CheckSevenCondition());
 }
 
 using namespace NetMauMau::AI;
 
-BestJackAction::BestJackAction() throw() : AbstractAction() {}
+namespace {
+typedef DecisionChain<CheckSevenCondition, true, StaticDispatch> JACKCHAIN;
+}
+
+BestJackAction::BestJackAction() throw() : AbstractAction(BESTJACKACTION_NODE) {}
 
 BestJackAction::~BestJackAction() throw() {}
 
 const IConditionPtr &BestJackAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+		const CardView &) const throw() {
 
 	state.setCard();
-	const NetMauMau::Common::ICardPtr bc(DecisionChain<CheckSevenCondition, true>(state).
+	const NetMauMau::Common::ICardPtr bc(JACKCHAIN(state, CHECKSEVENCOND).
 										 getCard(NetMauMau::Player::IPlayer::CARDS(), true));
 	state.setCard((bc && bc != NetMauMau::Common::ICard::SUIT_ILLEGAL) ?
 				  bc : NetMauMau::Common::ICardPtr());
@@ -21,21 +21,27 @@
 
 #include "powersuitaction.h"            // for PowerSuitAction
 
+namespace {
+const NetMauMau::AI::IActionPtr POWERSUITACTION(new NetMauMau::AI::PowerSuitAction());
+const NetMauMau::AI::IActionPtr
+NOPOWERSUITACTION(new NetMauMau::AI::PowerSuitAction(NetMauMau::Common::ICard::SUIT_ILLEGAL));
+}
+
 using namespace NetMauMau::AI;
 
-BestSuitCondition::BestSuitCondition() throw() : AbstractCondition() {}
+BestSuitCondition::BestSuitCondition() throw() : AbstractCondition(BESTSUITCONDITION_NODE) {}
 
 BestSuitCondition::~BestSuitCondition() throw() {}
 
 IActionPtr
 BestSuitCondition::perform(const IAIState &state,
-						   const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+						   const CardView &cards) const throw() {
 
 	if(!state.getCard() && !state.isNoJack() && state.hasPlayerFewCards() &&
 			DecisionBase::count(cards, NetMauMau::Common::ICard::JACK)) {
-		return IActionPtr(new PowerSuitAction());
+		return POWERSUITACTION;
 	} else {
-		return IActionPtr(new PowerSuitAction(NetMauMau::Common::ICard::SUIT_ILLEGAL));
+		return NOPOWERSUITACTION;
 	}
 }
 
@@ -32,8 +32,9 @@ public:
 	virtual ~BinaryCondition() throw() {}
 
 protected:
-	BinaryCondition(const IActionPtr &actTrue, const IActionPtr &actFalse) throw()
-		: AbstractCondition(), m_trueAction(actTrue), m_falseAction(actFalse) {}
+	BinaryCondition(const IActionPtr &actTrue, const IActionPtr &actFalse,
+					NODETYPE nodeType = DYNAMIC_NODE) throw() : AbstractCondition(nodeType),
+		m_trueAction(actTrue), m_falseAction(actFalse) {}
 
 	inline IActionPtr getTrueAction() const throw() {
 		return m_trueAction;
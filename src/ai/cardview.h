@@ -0,0 +1,95 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_ENGINE_AI_CARDVIEW_H
+#define NETMAUMAU_ENGINE_AI_CARDVIEW_H
+
+#include <cstddef>                      // for size_t, ptrdiff_t
+#include <vector>
+
+#include "icard.h"                      // for ICardPtr
+#include "smartptr.h"                   // for SmartPtr
+
+namespace NetMauMau {
+
+namespace AI {
+
+/**
+ * @brief Read-only view of a contiguous range of cards
+ *
+ * Refers to the cards of any @c std::vector of Common::ICardPtr without copying them. The
+ * view is valid as long as the viewed vector isn't modified.
+ */
+class CardView {
+public:
+	typedef Common::ICardPtr value_type;
+	typedef const value_type *const_iterator;
+	typedef const_iterator iterator;
+	typedef const value_type &const_reference;
+	typedef const_reference reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template<class Alloc>
+	CardView(const std::vector<value_type, Alloc> &cards) throw()
+		: m_first(cards.empty() ? 0L : &cards.front()), m_last(m_first + cards.size()) {}
+
+	CardView(const_iterator first, const_iterator last) throw() : m_first(first),
+		m_last(last) {}
+
+	inline const_iterator begin() const throw() {
+		return m_first;
+	}
+
+	inline const_iterator end() const throw() {
+		return m_last;
+	}
+
+	inline size_type size() const throw() {
+		return static_cast<size_type>(m_last - m_first);
+	}
+
+	inline bool empty() const throw() {
+		return m_first == m_last;
+	}
+
+	inline const_reference front() const throw() {
+		return *m_first;
+	}
+
+	inline const_reference back() const throw() {
+		return *(m_last - 1);
+	}
+
+	inline const_reference operator[](size_type i) const throw() {
+		return m_first[i];
+	}
+
+private:
+	const_iterator m_first;
+	const_iterator m_last;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_ENGINE_AI_CARDVIEW_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
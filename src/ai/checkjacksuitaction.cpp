@@ -23,7 +23,6 @@
 #include <stdbool.h>
 
 #include "random_gen.h"                 // for genRandom
-#include "stdcardfactory.h"             // for StdCardFactory
 
 using namespace NetMauMau::AI;
 
@@ -34,7 +33,7 @@ CheckJackSuitAction::_hasRankPath::operator()
 	bool hrp = false;
 
 	if(c != rank) {
-		for(NetMauMau::Player::IPlayer::CARDS::const_iterator i(mCards.begin());
+		for(CardView::const_iterator i(mCards.begin());
 				i != mCards.end(); ++i) {
 			if((hrp = AbstractAction::hasRankPath(c, (*i)->getSuit(), rank, mCards,
 												  nineIsSuspend))) break;
@@ -44,12 +43,12 @@ CheckJackSuitAction::_hasRankPath::operator()
 	return hrp;
 }
 
-CheckJackSuitAction::CheckJackSuitAction() throw() : AbstractAction() {}
+CheckJackSuitAction::CheckJackSuitAction() throw() : AbstractAction(CHECKJACKSUITACTION_NODE) {}
 
 CheckJackSuitAction::~CheckJackSuitAction() throw() {}
 
 const IConditionPtr &CheckJackSuitAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+		const CardView &) const throw() {
 
 	NetMauMau::Common::ICard::SUIT s = CheckJackSuitAction::findJackChoice(state);
 
@@ -61,8 +60,7 @@ const IConditionPtr &CheckJackSuitAction::perform(IAIState &state,
 
 	assert(s != NetMauMau::Common::ICard::SUIT_ILLEGAL);
 
-	state.setCard(NetMauMau::Common::ICardPtr(NetMauMau::StdCardFactory().create(s,
-				  NetMauMau::Common::ICard::RANK_ILLEGAL)));
+	state.setCard(AbstractAction::getSuitCard(s));
 
 	return AbstractAction::getNullCondition();
 }
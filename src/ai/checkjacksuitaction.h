@@ -35,7 +35,7 @@ public:
 	virtual ~CheckJackSuitAction() throw() _CONST;
 
 	virtual const IConditionPtr &perform(IAIState &state,
-										 const Player::IPlayer::CARDS &cards) const throw();
+										 const CardView &cards) const throw();
 #if defined(TRACE_AI) && !defined(NDEBUG)
 	inline virtual std::string traceLog() const throw() {
 		return "CheckJackSuitAction";
@@ -45,15 +45,15 @@ public:
 private:
 #pragma GCC diagnostic ignored "-Weffc++"
 #pragma GCC diagnostic push
-	struct _hasRankPath : std::unary_function<Player::IPlayer::CARDS::value_type, bool> {
+	struct _hasRankPath : std::unary_function<CardView::value_type, bool> {
 
-		explicit _hasRankPath(const Player::IPlayer::CARDS &c, Common::ICard::RANK r,
+		explicit _hasRankPath(const CardView &c, Common::ICard::RANK r,
 							  bool nie)  throw() : mCards(c), rank(r), nineIsSuspend(nie) {}
 
 		result_type operator()(const argument_type &c) const throw();
 
 	private:
-		const Player::IPlayer::CARDS &mCards;
+		const CardView mCards;
 		const Common::ICard::RANK rank;
 		bool nineIsSuspend;
 	};
@@ -19,25 +19,29 @@
 
 #include "checksevencondition.h"
 
+#include "nextaction.h"                 // for NextAction
 #include "servesevenaction.h"           // for ServeSevenAction
 #include "skipplayercondition.h"        // for SkipPlayerCondition
 
 namespace {
 const NetMauMau::AI::IActionPtr SERVESEVENACTION(new NetMauMau::AI::ServeSevenAction());
-const NetMauMau::AI::IConditionPtr SKIPPLAYERACTION(new NetMauMau::AI::SkipPlayerCondition());
+const NetMauMau::AI::IConditionPtr
+CHECKSEVEN_SKIPPLAYERCOND(new NetMauMau::AI::SkipPlayerCondition());
+const NetMauMau::AI::IActionPtr
+NEXTSKIPPLAYERCOND(new NetMauMau::AI::NextAction(CHECKSEVEN_SKIPPLAYERCOND));
 }
 
 using namespace NetMauMau::AI;
 
-CheckSevenCondition::CheckSevenCondition() throw() : AbstractCondition() {}
+CheckSevenCondition::CheckSevenCondition() throw() : AbstractCondition(CHECKSEVENCONDITION_NODE) {}
 
 CheckSevenCondition::~CheckSevenCondition() throw() {}
 
 IActionPtr CheckSevenCondition::perform(const IAIState &state,
-										const NetMauMau::Player::IPlayer::CARDS &) const throw() {
-	return state.getPlayedOutCards().size() > (4 * state.getTalonFactor()) &&
+										const CardView &) const throw() {
+	return state.getPlayedOutStats().getCount() > (4 * state.getTalonFactor()) &&
 		   state.getUncoveredCard() == NetMauMau::Common::ICard::SEVEN ?
-		   SERVESEVENACTION : createNextAction(SKIPPLAYERACTION);
+		   SERVESEVENACTION : NEXTSKIPPLAYERCOND;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
@@ -25,14 +25,19 @@ DecisionBase::DecisionBase() throw() {}
 
 DecisionBase::~DecisionBase() throw() {}
 
-NetMauMau::Player::IPlayer::CARDS
-DecisionBase::removeJack(const NetMauMau::Player::IPlayer::CARDS &cards) throw() {
+IAIState::SCRATCHCARDS
+DecisionBase::scratchCopy(const IAIState &state, const CardView &cards) throw() {
+	return IAIState::SCRATCHCARDS(cards.begin(), cards.end(), state.getScratchArena());
+}
+
+IAIState::SCRATCHCARDS
+DecisionBase::removeJack(const IAIState &state, const CardView &cards) throw() {
 
-	NetMauMau::Player::IPlayer::CARDS myCards(cards);
+	IAIState::SCRATCHCARDS myCards(scratchCopy(state, cards));
 
 	myCards.erase(std::remove_if(myCards.begin(), myCards.end(),
 								 std::bind2nd(NetMauMau::Common::equalTo
-										 < NetMauMau::Player::IPlayer::CARDS::value_type,
+										 < IAIState::SCRATCHCARDS::value_type,
 										 NetMauMau::Common::ICard::RANK > (),
 										 NetMauMau::Common::ICard::JACK)), myCards.end());
 	return myCards;
@@ -21,6 +21,7 @@
 #define NETMAUMAU_ENGINE_AI_DECISIONBASE_H
 
 #include "iaistate.h"                   // for IAIState, etc
+#include "cardview.h"                   // for CardView
 #include "cardtools.h"
 
 namespace NetMauMau {
@@ -32,10 +33,19 @@ class DecisionBase {
 public:
 	virtual ~DecisionBase() throw() _CONST;
 
-	static Player::IPlayer::CARDS removeJack(const Player::IPlayer::CARDS &cards) throw();
+	/**
+	 * @brief Copies @c cards without the jacks into the scratch arena of @c state
+	 */
+	static IAIState::SCRATCHCARDS removeJack(const IAIState &state, const CardView &cards) throw();
+
+	/**
+	 * @brief Copies @c cards into the scratch arena of @c state
+	 */
+	static IAIState::SCRATCHCARDS scratchCopy(const IAIState &state,
+			const CardView &cards) throw();
 
 	template<class CardType, class Tp>
-	static typename CardType::difference_type count(CardType cards, Tp arg) throw() {
+	static typename CardType::difference_type count(const CardType &cards, Tp arg) throw() {
 		return std::count_if(cards.begin(), cards.end(), std::bind2nd(NetMauMau::Common::equalTo
 							 <typename CardType::value_type, Tp>(), arg));
 	}
@@ -43,7 +43,31 @@ namespace NetMauMau {
 
 namespace AI {
 
-template<class RootCond, bool Jack = false>
+/**
+ * @brief Dispatches the nodes of a decision chain through their vtable
+ */
+struct VirtualDispatch {
+
+	inline static void walk(const IConditionPtr &root, IAIState &state) throw() {
+
+		IConditionPtr cond(root);
+		IActionPtr act;
+
+		while(cond && (act = (*cond)(state))) {
+
+			cond = (*act)(state);
+
+			if(state.getCard()) break;
+		}
+	}
+};
+
+/**
+ * @brief Walks the conditions and actions starting at @c RootCond until a card is chosen
+ *
+ * @tparam Dispatch policy how the nodes get walked, see VirtualDispatch and StaticDispatch
+ */
+template<class RootCond, bool Jack = false, class Dispatch = VirtualDispatch>
 class DecisionChain {
 	DISALLOW_COPY_AND_ASSIGN(DecisionChain)
 public:
@@ -53,6 +77,9 @@ public:
 	explicit DecisionChain(IAIState &state) throw()
 		: m_rootCondition(IConditionPtr(new RootCond())), m_state(state) {}
 
+	DecisionChain(IAIState &state, const IConditionPtr &rootCond) throw()
+		: m_rootCondition(rootCond), m_state(state) {}
+
 	~DecisionChain() throw() {}
 
 	Common::ICardPtr getCard(const Player::IPlayer::CARDS &possCards,
@@ -63,12 +90,9 @@ private:
 	IAIState &m_state;
 };
 
-template<class RootCond, bool Jack>
-Common::ICardPtr DecisionChain<RootCond, Jack>::getCard(const Player::IPlayer::CARDS &possCards,
-		bool noJack) const throw() {
-
-	IConditionPtr cond(m_rootCondition);
-	IActionPtr act;
+template<class RootCond, bool Jack, class Dispatch>
+Common::ICardPtr DecisionChain<RootCond, Jack, Dispatch>::getCard(const Player::IPlayer::CARDS
+		&possCards, bool noJack) const throw() {
 
 	const bool oj = m_state.isNoJack();
 
@@ -82,12 +106,7 @@ Common::ICardPtr DecisionChain<RootCond, Jack>::getCard(const Player::IPlayer::C
 
 #endif
 
-	while(cond && (act = (*cond)(m_state))) {
-
-		cond = (*act)(m_state);
-
-		if(m_state.getCard()) break;
-	}
+	Dispatch::walk(m_rootCondition, m_state);
 
 	m_state.setNoJack(oj);
 
@@ -64,7 +64,7 @@ END {
 	print "\tvirtual ~" name "() throw() _CONST;\n";
 
 	print "\tvirtual const IConditionPtr &perform(IAIState &state,";
-	printf "\t\tconst Player::IPlayer::CARDS &cards) const throw()";
+	printf "\t\tconst CardView &cards) const throw()";
 	
 	if(constPerf == 1) {
 		printf " _CONST";
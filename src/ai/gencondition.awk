@@ -57,7 +57,7 @@ END {
 	print "\t" name "() throw();";
 	print "\tvirtual ~" name "() throw() _CONST;\n";
 
-	print "\tvirtual IActionPtr perform(const IAIState &state, const Player::IPlayer::CARDS &cards) const throw();\n";
+	print "\tvirtual IActionPtr perform(const IAIState &state, const CardView &cards) const throw();\n";
 
 	print "#if defined(TRACE_AI) && !defined(NDEBUG)";
 	print "protected:";
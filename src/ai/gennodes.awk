@@ -0,0 +1,209 @@
+####################################################################################################
+#
+# Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+#
+# This file is part of NetMauMau.
+#
+# NetMauMau is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as
+# published by the Free Software Foundation, either version 3 of
+# the License, or (at your option) any later version.
+#
+# NetMauMau is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+#
+####################################################################################################
+#
+# Reads all .aai and .cai files at once and emits either the node type enumeration
+# (mode=nodes), the declaration of the statically dispatching decision chain policy
+# (mode=dispatch) or its translation unit (mode=unit).
+#
+# The translation unit includes the sources of all nodes, so the compiler sees every
+# perform() it dispatches to and can inline them into the walk of the chain.
+#
+# Hand written nodes can be added with -v actions="..." and -v conditions="...", their
+# header and source are expected to be the lower case class name.
+#
+
+BEGIN { nodes = 0; }
+
+function addNode(n, isAction) {
+	node[nodes] = n;
+	action[nodes++] = isAction;
+}
+
+/^NAME\(/ {
+	n = $0;
+	sub(/^NAME\(/, "", n);
+	sub(/\).*$/, "", n);
+	addNode(n, FILENAME ~ /\.aai$/);
+}
+
+function license() {
+
+	print "/*";
+	print " * Copyright " year " by Heiko Schäfer <heiko@rangun.de>";
+	print " *";
+	print " * This file is part of NetMauMau.";
+	print " *";
+	print " * NetMauMau is free software: you can redistribute it and/or modify";
+	print " * it under the terms of the GNU Lesser General Public License as";
+	print " * published by the Free Software Foundation, either version 3 of";
+	print " * the License, or (at your option) any later version.";
+	print " *";
+	print " * NetMauMau is distributed in the hope that it will be useful,";
+	print " * but WITHOUT ANY WARRANTY; without even the implied warranty of";
+	print " * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the";
+	print " * GNU Lesser General Public License for more details.";
+	print " *";
+	print " * You should have received a copy of the GNU Lesser General Public License";
+	print " * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.";
+	print " */\n";
+}
+
+function enumeration(i) {
+
+	print "#ifndef NETMAUMAU_AI_DECISIONNODES_H";
+	print "#define NETMAUMAU_AI_DECISIONNODES_H\n";
+
+	print "namespace NetMauMau {\n";
+
+	print "namespace AI {\n";
+
+	print "/**";
+	print " * @brief Types of the decision nodes known at build time";
+	print " *";
+	print " * Nodes of type @c DYNAMIC_NODE are always dispatched virtually.";
+	print " */";
+	print "typedef enum {";
+	print "\tDYNAMIC_NODE = 0,";
+
+	for(i = 0; i < nodes; ++i) print "\t" toupper(node[i]) "_NODE,";
+
+	print "\tNODETYPE_COUNT";
+	print "} NODETYPE;\n";
+
+	print "}\n";
+
+	print "}\n";
+
+	print "#endif /* NETMAUMAU_AI_DECISIONNODES_H */";
+}
+
+function dispatchCases(isAction, i) {
+
+	for(i = 0; i < nodes; ++i) {
+
+		if(action[i] != isAction) continue;
+
+		print "\tcase " toupper(node[i]) "_NODE:";
+
+		if(isAction) {
+			print "\t\treturn AbstractAction::execute(static_cast<const " node[i] \
+				  " &>(act), state);";
+		} else {
+			print "\t\treturn AbstractCondition::evaluate(static_cast<const " node[i] \
+				  " &>(cond), state);";
+		}
+	}
+}
+
+function dispatch() {
+
+	print "#ifndef NETMAUMAU_AI_DECISIONDISPATCH_H";
+	print "#define NETMAUMAU_AI_DECISIONDISPATCH_H\n";
+
+	print "#include \"iaistate.h\"                  // for IAIState";
+	print "#include \"icondition.h\"                // for IConditionPtr\n";
+
+	print "namespace NetMauMau {\n";
+
+	print "namespace AI {\n";
+
+	print "/**";
+	print " * @brief Walks a decision chain with the nodes dispatched by their type";
+	print " *";
+	print " * The @c perform of every node known at build time is called directly instead of";
+	print " * through the vtable and is inlined into the walk, unknown nodes are dispatched";
+	print " * virtually.";
+	print " */";
+	print "struct StaticDispatch {";
+	print "\tstatic void walk(const IConditionPtr &root, IAIState &state) throw() _FLATTEN;";
+	print "};\n";
+
+	print "}\n";
+
+	print "}\n";
+
+	print "#endif /* NETMAUMAU_AI_DECISIONDISPATCH_H */";
+}
+
+function unit(i) {
+
+	print "#include \"decisiondispatch.h\"\n";
+
+	for(i = 0; i < nodes; ++i) print "#include \"" tolower(node[i]) ".cpp\"";
+
+	print "\nusing namespace NetMauMau::AI;\n";
+
+	print "namespace {\n";
+
+	print "inline IActionPtr evaluate(const ICondition &cond, const IAIState &state) throw() {\n";
+	print "#if !(defined(TRACE_AI) && !defined(NDEBUG))\n";
+	print "\tswitch(cond.getNodeType()) {";
+	dispatchCases(0);
+	print "\tdefault:";
+	print "\t\tbreak;";
+	print "\t}\n";
+	print "#endif\n";
+	print "\treturn cond(state);";
+	print "}\n";
+
+	print "inline const IConditionPtr &execute(const IAction &act, IAIState &state) throw() {\n";
+	print "#if !(defined(TRACE_AI) && !defined(NDEBUG))\n";
+	print "\tswitch(act.getNodeType()) {";
+	dispatchCases(1);
+	print "\tdefault:";
+	print "\t\tbreak;";
+	print "\t}\n";
+	print "#endif\n";
+	print "\treturn act(state);";
+	print "}\n";
+
+	print "}\n";
+
+	print "void StaticDispatch::walk(const IConditionPtr &root, IAIState &state) throw() {\n";
+	print "\tIConditionPtr cond(root);";
+	print "\tIActionPtr act;\n";
+	print "\twhile(cond && (act = evaluate(*cond, state))) {\n";
+	print "\t\tcond = execute(*act, state);\n";
+	print "\t\tif(state.getCard()) break;";
+	print "\t}";
+	print "}";
+}
+
+END {
+
+	na = split(actions, a, " ");
+	for(i = 1; i <= na; ++i) addNode(a[i], 1);
+
+	nc = split(conditions, c, " ");
+	for(i = 1; i <= nc; ++i) addNode(c[i], 0);
+
+	if(year == "") year = "2015";
+
+	license();
+
+	if(mode == "dispatch") {
+		dispatch();
+	} else if(mode == "unit") {
+		unit();
+	} else {
+		enumeration();
+	}
+}
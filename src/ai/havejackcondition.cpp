@@ -22,27 +22,31 @@
 #include "bestjackaction.h"             // for BestJackAction
 #include "havelessthancondition.h"      // for HaveLessThanCondition
 #include "jacksuitaction.h"             // for JackSuitAction
+#include "nextaction.h"                 // for NextAction
 
 namespace {
 const NetMauMau::AI::IConditionPtr
-HAVELESSTHANEIGHTCOND(new NetMauMau::AI::HaveLessThanCondition<8>(
+HAVEJACK_HAVELESSTHANEIGHTCOND(new NetMauMau::AI::HaveLessThanCondition<8>(
 						  NetMauMau::AI::IActionPtr(new NetMauMau::AI::BestJackAction()),
 						  NetMauMau::AI::IActionPtr()));
+const NetMauMau::AI::IActionPtr JACKSUITACTION(new NetMauMau::AI::JackSuitAction());
+const NetMauMau::AI::IActionPtr
+NEXTHAVELESSTHANEIGHTCOND(new NetMauMau::AI::NextAction(HAVEJACK_HAVELESSTHANEIGHTCOND));
 }
 
 using namespace NetMauMau::AI;
 
-HaveJackCondition::HaveJackCondition() throw() : AbstractCondition() {}
+HaveJackCondition::HaveJackCondition() throw() : AbstractCondition(HAVEJACKCONDITION_NODE) {}
 
 HaveJackCondition::~HaveJackCondition() throw() {}
 
 IActionPtr
 HaveJackCondition::perform(const IAIState &state,
-						   const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+						   const CardView &cards) const throw() {
 
 	return (state.getPlayerCards().size() == 2 &&
 			NetMauMau::Common::find(NetMauMau::Common::ICard::JACK, cards.begin(), cards.end()))
-		   ? IActionPtr(new JackSuitAction()) : createNextAction(HAVELESSTHANEIGHTCOND);
+		   ? JACKSUITACTION : NEXTHAVELESSTHANEIGHTCOND;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
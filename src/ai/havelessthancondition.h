@@ -38,7 +38,7 @@ public:
 	virtual ~HaveLessThanCondition() throw() {}
 
 	virtual IActionPtr perform(const IAIState &state,
-							   const Player::IPlayer::CARDS &) const throw() {
+							   const CardView &) const throw() {
 		return state.getPlayerCards().size() < Bound ? getTrueAction() : getFalseAction();
 	}
 
@@ -29,34 +29,44 @@
 #endif
 
 #include "linkercontrol.h"
+#include "intrusiveptr.h"
 
 namespace NetMauMau {
 
-namespace Common {
-template<class> class SmartPtr;
-}
-
 namespace AI {
 
 class ICondition;
 class IAIState;
 
-class IAction {
+class IAction : public Common::RefCounted<> {
 	DISALLOW_COPY_AND_ASSIGN(IAction)
 public:
 	virtual ~IAction() throw() {}
 
-	virtual const Common::SmartPtr<ICondition> &operator()(IAIState &state) const throw() = 0;
+	virtual const Common::IntrusivePtr<ICondition> &operator()(IAIState &state) const throw() = 0;
 
 #if defined(TRACE_AI) && !defined(NDEBUG)
 	virtual std::string traceLog() const throw() = 0;
 #endif
 
+	/**
+	 * @brief Returns the type of the node, used to dispatch it without the vtable
+	 *
+	 * @see StaticDispatch
+	 */
+	inline unsigned int getNodeType() const throw() {
+		return m_nodeType;
+	}
+
 protected:
-	IAction() throw() {}
+	explicit IAction(unsigned int nodeType = 0u) throw() : Common::RefCounted<>(),
+		m_nodeType(nodeType) {}
+
+private:
+	const unsigned int m_nodeType;
 };
 
-typedef Common::SmartPtr<IAction> IActionPtr;
+typedef Common::IntrusivePtr<IAction> IActionPtr;
 
 }
 
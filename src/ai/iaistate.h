@@ -22,6 +22,7 @@
 
 #include "iplayer.h"
 #include "iplayedoutcards.h"
+#include "scratcharena.h"
 
 namespace NetMauMau {
 
@@ -31,6 +32,8 @@ class IAIState {
 	DISALLOW_COPY_AND_ASSIGN(IAIState)
 public:
 	typedef IPlayedOutCards::CARDS PLAYEDOUTCARDS;
+	typedef std::vector<Common::ICardPtr, Common::ScratchAllocator<Common::ICardPtr> >
+	SCRATCHCARDS;
 
 	virtual ~IAIState() throw() {}
 
@@ -45,6 +48,7 @@ public:
 	virtual Common::ICardPtr getUncoveredCard() const = 0;
 	virtual const RuleSet::IRuleSet *getRuleSet() const = 0;
 	virtual const PLAYEDOUTCARDS &getPlayedOutCards() const = 0;
+	virtual const IPlayedOutStats &getPlayedOutStats() const = 0;
 	virtual bool hasPlayerFewCards() const = 0;
 	virtual Common::ICard::SUIT *getJackSuit() const = 0;
 	virtual bool isNoJack() const = 0;
@@ -67,6 +71,11 @@ public:
 	virtual bool isPowerPlay() const = 0;
 	virtual void setPowerPlay(bool b) = 0;
 
+	/**
+	 * @brief Scratch memory for the current decision, released when the next one starts
+	 */
+	virtual Common::ScratchArena &getScratchArena() const = 0;
+
 protected:
 	IAIState() throw() {}
 };
@@ -29,34 +29,44 @@
 #endif
 
 #include "linkercontrol.h"
+#include "intrusiveptr.h"
 
 namespace NetMauMau {
 
-namespace Common {
-template<class> class SmartPtr;
-}
-
 namespace AI {
 
 class IAction;
 class IAIState;
 
-class ICondition {
+class ICondition : public Common::RefCounted<> {
 	DISALLOW_COPY_AND_ASSIGN(ICondition)
 public:
 	virtual ~ICondition() throw() {}
 
-	virtual Common::SmartPtr<IAction> operator()(const IAIState &state) const throw() = 0;
+	virtual Common::IntrusivePtr<IAction> operator()(const IAIState &state) const throw() = 0;
 
 #if defined(TRACE_AI) && !defined(NDEBUG)
 	virtual std::string traceLog() const throw() = 0;
 #endif
 
+	/**
+	 * @brief Returns the type of the node, used to dispatch it without the vtable
+	 *
+	 * @see StaticDispatch
+	 */
+	inline unsigned int getNodeType() const throw() {
+		return m_nodeType;
+	}
+
 protected:
-	ICondition() throw() {}
+	explicit ICondition(unsigned int nodeType = 0u) throw() : Common::RefCounted<>(),
+		m_nodeType(nodeType) {}
+
+private:
+	const unsigned int m_nodeType;
 };
 
-typedef Common::SmartPtr<ICondition> IConditionPtr;
+typedef Common::IntrusivePtr<ICondition> IConditionPtr;
 
 }
 
@@ -22,34 +22,35 @@
 #include "aceroundaction.h"             // for AceRoundAction
 #include "jackplusonecondition.h"
 #include "iruleset.h"                   // for IRuleSet
+#include "nextaction.h"                 // for NextAction
 #include "playjackaction.h"             // for PlayJackAction
 #include "suspendaction.h"              // for SuspendAction
 
 namespace {
-const NetMauMau::AI::IActionPtr ACEROUNDACTION(new NetMauMau::AI::AceRoundAction());
+const NetMauMau::AI::IActionPtr JACKONLY_ACEROUNDACTION(new NetMauMau::AI::AceRoundAction());
 const NetMauMau::AI::IActionPtr PLAYJACKACTION(new NetMauMau::AI::PlayJackAction());
 const NetMauMau::AI::IActionPtr SUSPENDACTION(new NetMauMau::AI::SuspendAction());
 const NetMauMau::AI::IConditionPtr JACKPLUSONECOND(new NetMauMau::AI::JackPlusOneCondition());
+const NetMauMau::AI::IActionPtr NEXTJACKPLUSONECOND(new NetMauMau::AI::NextAction(JACKPLUSONECOND));
 }
 
 using namespace NetMauMau::AI;
 
-JackOnlyCondition::JackOnlyCondition() throw() : AbstractCondition() {}
+JackOnlyCondition::JackOnlyCondition() throw() : AbstractCondition(JACKONLYCONDITION_NODE) {}
 
 JackOnlyCondition::~JackOnlyCondition() throw() {}
 
 IActionPtr
 JackOnlyCondition::perform(const IAIState &state,
-						   const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+						   const CardView &cards) const throw() {
 
 	const bool oneCard = cards.size() == 1u;
 
 	return state.getRuleSet() ?
-		   (state.getRuleSet()->isAceRound() ? ACEROUNDACTION : ((oneCard &&
+		   (state.getRuleSet()->isAceRound() ? JACKONLY_ACEROUNDACTION : ((oneCard &&
 				   !(state.getUncoveredCard() == NetMauMau::Common::ICard::JACK && cards.front() ==
 					 NetMauMau::Common::ICard::JACK)) ? PLAYJACKACTION : (oneCard ? SUSPENDACTION :
-							 createNextAction(JACKPLUSONECOND)))) :
-			   createNextAction(JACKPLUSONECOND);
+							 NEXTJACKPLUSONECOND))) : NEXTJACKPLUSONECOND;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
@@ -21,19 +21,20 @@
 #include "checksevencondition.h"
 
 namespace {
-const NetMauMau::AI::IConditionPtr CHECKSEVENCOND(new NetMauMau::AI::CheckSevenCondition());
+const NetMauMau::AI::IConditionPtr
+PLUSONEACTION_CHECKSEVENCOND(new NetMauMau::AI::CheckSevenCondition());
 }
 
 using namespace NetMauMau::AI;
 
-JackPlusOneAction::JackPlusOneAction() throw() : AbstractAction() {}
+JackPlusOneAction::JackPlusOneAction() throw() : AbstractAction(JACKPLUSONEACTION_NODE) {}
 
 JackPlusOneAction::~JackPlusOneAction() throw() {}
 
 const IConditionPtr &JackPlusOneAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+		const CardView &cards) const throw() {
 
-	NetMauMau::Player::IPlayer::CARDS myCards(cards);
+	IAIState::SCRATCHCARDS myCards(DecisionBase::scratchCopy(state, cards));
 
 	push(myCards.begin(), myCards.end(), NetMauMau::Common::ICard::JACK);
 
@@ -44,7 +45,7 @@ const IConditionPtr &JackPlusOneAction::perform(IAIState &state,
 		return getNullCondition();
 	}
 
-	return CHECKSEVENCOND;
+	return PLUSONEACTION_CHECKSEVENCOND;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
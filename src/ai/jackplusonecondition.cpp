@@ -21,25 +21,30 @@
 
 #include "checksevencondition.h"
 #include "jackplusoneaction.h"
+#include "nextaction.h"                 // for NextAction
 
 namespace {
 const NetMauMau::AI::IActionPtr JACKPLUSONEACTION(new NetMauMau::AI::JackPlusOneAction());
-const NetMauMau::AI::IConditionPtr CHECKSEVENCOND(new NetMauMau::AI::CheckSevenCondition());
+const NetMauMau::AI::IConditionPtr
+PLUSONECOND_CHECKSEVENCOND(new NetMauMau::AI::CheckSevenCondition());
+const NetMauMau::AI::IActionPtr
+NEXTCHECKSEVENCOND(new NetMauMau::AI::NextAction(PLUSONECOND_CHECKSEVENCOND));
 }
 
 using namespace NetMauMau::AI;
 
-JackPlusOneCondition::JackPlusOneCondition() throw() : AbstractCondition() {}
+JackPlusOneCondition::JackPlusOneCondition() throw()
+	: AbstractCondition(JACKPLUSONECONDITION_NODE) {}
 
 JackPlusOneCondition::~JackPlusOneCondition() throw() {}
 
 IActionPtr JackPlusOneCondition::perform(const IAIState &/*state*/,
-		const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+		const CardView &cards) const throw() {
 
 	return (/*state.getPlayerCount() > 2 &&*/ cards.size() == 2u &&
 			!NetMauMau::Common::find(NetMauMau::Common::ICard::SEVEN, cards.begin(), cards.end())
 			&& NetMauMau::Common::find(NetMauMau::Common::ICard::JACK, cards.begin(), cards.end()))
-		   ? JACKPLUSONEACTION : createNextAction(CHECKSEVENCOND);
+		   ? JACKPLUSONEACTION : NEXTCHECKSEVENCOND;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
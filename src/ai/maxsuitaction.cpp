@@ -42,16 +42,16 @@ struct cardGreater : std::binary_function < NetMauMau::Player::IPlayer::CARDS::v
 
 using namespace NetMauMau::AI;
 
-MaxSuitAction::MaxSuitAction() throw() : AbstractAction() {}
+MaxSuitAction::MaxSuitAction() throw() : AbstractAction(MAXSUITACTION_NODE) {}
 
 MaxSuitAction::~MaxSuitAction() throw() {}
 
 const IConditionPtr &MaxSuitAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+		const CardView &cards) const throw() {
 
 	assert(!state.getCard());
 
-	NetMauMau::Player::IPlayer::CARDS myCards(cards);
+	IAIState::SCRATCHCARDS myCards(DecisionBase::scratchCopy(state, cards));
 
 	SUITCOUNT suitCount[4];
 	AbstractAction::countSuits(suitCount, myCards);
@@ -60,7 +60,7 @@ const IConditionPtr &MaxSuitAction::perform(IAIState &state,
 
 	for(std::size_t i = suitCount[0].suit != state.getAvoidSuit() ? 0u : 1u; i < 4u; ++i) {
 
-		const NetMauMau::Player::IPlayer::CARDS::iterator &e(AbstractAction::pull(myCards.begin(),
+		const IAIState::SCRATCHCARDS::iterator &e(AbstractAction::pull(myCards.begin(),
 				myCards.end(), suitCount[i].suit));
 
 		if(state.getJackSuit()) {
@@ -86,7 +86,7 @@ const IConditionPtr &MaxSuitAction::perform(IAIState &state,
 			const NetMauMau::Player::IPlayer::CARDS::value_type f =
 				NetMauMau::Common::find(state.getUncoveredCard()->getRank(), myCards.begin(), e);
 
-			if(f && (f != NetMauMau::Common::ICard::SEVEN || state.getPlayedOutCards().size() >
+			if(f && (f != NetMauMau::Common::ICard::SEVEN || state.getPlayedOutStats().getCount() >
 					 (4 * state.getTalonFactor()))) {
 				bestCard = f;
 				break;
@@ -98,7 +98,7 @@ const IConditionPtr &MaxSuitAction::perform(IAIState &state,
 
 		AbstractAction::push(myCards.begin(), myCards.end(), state.getAvoidRank());
 
-		const NetMauMau::Player::IPlayer::CARDS::iterator
+		const IAIState::SCRATCHCARDS::iterator
 		&e(AbstractAction::stable_pull(myCards.begin(), myCards.end(),
 									   NetMauMau::Common::ICard::SEVEN));
 
@@ -21,12 +21,13 @@
 
 using namespace NetMauMau::AI;
 
-NextAction::NextAction(const IConditionPtr &cond) throw() : AbstractAction(), m_condition(cond) {}
+NextAction::NextAction(const IConditionPtr &cond) throw() : AbstractAction(NEXTACTION_NODE),
+	m_condition(cond) {}
 
 NextAction::~NextAction() throw() {}
 
 const IConditionPtr &NextAction::perform(IAIState &,
-		const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+		const CardView &) const throw() {
 	return m_condition;
 }
 
@@ -33,7 +33,7 @@ public:
 	virtual ~NextAction() throw() _CONST;
 
 	virtual const IConditionPtr &perform(IAIState &state,
-										 const Player::IPlayer::CARDS &cards) const throw() _PURE;
+										 const CardView &cards) const throw() _PURE;
 #if defined(TRACE_AI) && !defined(NDEBUG)
 protected:
 	inline virtual std::string traceLog() const throw() {
@@ -21,12 +21,12 @@
 
 using namespace NetMauMau::AI;
 
-PowerJackAction::PowerJackAction() throw() : AbstractAction() {}
+PowerJackAction::PowerJackAction() throw() : AbstractAction(POWERJACKACTION_NODE) {}
 
 PowerJackAction::~PowerJackAction() throw() {}
 
 const IConditionPtr &PowerJackAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+		const CardView &cards) const throw() {
 
 	if(cards.size() == 1u) state.setCard(cards.front());
 
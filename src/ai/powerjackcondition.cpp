@@ -29,13 +29,13 @@ const NetMauMau::AI::IActionPtr BESTJACKACTION(new NetMauMau::AI::BestJackAction
 
 using namespace NetMauMau::AI;
 
-PowerJackCondition::PowerJackCondition() throw() : AbstractCondition() {}
+PowerJackCondition::PowerJackCondition() throw() : AbstractCondition(POWERJACKCONDITION_NODE) {}
 
 PowerJackCondition::~PowerJackCondition() throw() {}
 
 IActionPtr
 PowerJackCondition::perform(const IAIState &,
-							const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+							const CardView &cards) const throw() {
 	return cards.size() == 1u ? POWERJACKACTION : BESTJACKACTION;
 }
 
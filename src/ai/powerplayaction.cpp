@@ -25,23 +25,23 @@
 #include "havejackcondition.h"          // for HaveJackCondition
 #include "maxsuitaction.h"              // for MaxSuitAction
 #include "staticcondition.h"            // for StaticCondition
-#include "stdcardfactory.h"             // for StdCardFactory
 
 namespace {
 const NetMauMau::AI::IConditionPtr
 MAXSUITACTION(new NetMauMau::AI::StaticCondition<NetMauMau::AI::MaxSuitAction>());
 const NetMauMau::AI::IConditionPtr BESTJACKCOND(new NetMauMau::AI::HaveJackCondition());
-const NetMauMau::AI::IConditionPtr ACEROUNDCOND(new NetMauMau::AI::AceRoundCondition());
+const NetMauMau::AI::IConditionPtr POWERPLAY_ACEROUNDCOND(new NetMauMau::AI::AceRoundCondition());
 }
 
 using namespace NetMauMau::AI;
 
-PowerPlayAction::PowerPlayAction(bool set) throw() : AbstractAction(), m_set(set) {}
+PowerPlayAction::PowerPlayAction(bool set) throw() : AbstractAction(POWERPLAYACTION_NODE),
+	m_set(set) {}
 
 PowerPlayAction::~PowerPlayAction() throw() {}
 
 const IConditionPtr &PowerPlayAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+		const CardView &cards) const throw() {
 
 	if(m_set) {
 
@@ -52,30 +52,30 @@ const IConditionPtr &PowerPlayAction::perform(IAIState &state,
 
 		assert(s != NetMauMau::Common::ICard::SUIT_ILLEGAL);
 
-		state.setCard(NetMauMau::Common::ICardPtr(NetMauMau::StdCardFactory().create(s,
-					  NetMauMau::Common::ICard::RANK_ILLEGAL)));
+		state.setCard(AbstractAction::getSuitCard(s));
 
 		return BESTJACKCOND;
 
 	} else if(!state.getCard()) {
 
-		NetMauMau::Player::IPlayer::CARDS myCards(cards);
+		IAIState::SCRATCHCARDS myCards(cards.begin(), cards.end(), state.getScratchArena());
 
-		const NetMauMau::Player::IPlayer::CARDS::iterator &e(stable_pull(myCards.begin(),
+		const IAIState::SCRATCHCARDS::iterator &e(stable_pull(myCards.begin(),
 				myCards.end(), NetMauMau::Common::ICard::SEVEN));
 
-		const NetMauMau::Player::IPlayer::CARDS::value_type f =
+		const IAIState::SCRATCHCARDS::value_type f =
 			NetMauMau::Common::find(state.getJackSuit() ? *state.getJackSuit() :
 									state.getUncoveredCard()->getSuit(), myCards.begin(), e);
 
-		const NetMauMau::Player::IPlayer::CARDS::difference_type mySevens =
+		const IAIState::SCRATCHCARDS::difference_type mySevens =
 			std::distance(myCards.begin(), e);
 
-		const NetMauMau::Player::IPlayer::CARDS::difference_type poSevens =
-			DecisionBase::count(state.getPlayedOutCards(), NetMauMau::Common::ICard::SEVEN);
+		const IAIState::SCRATCHCARDS::difference_type poSevens =
+			static_cast<IAIState::SCRATCHCARDS::difference_type>(state.
+					getPlayedOutStats().getCount(NetMauMau::Common::ICard::SEVEN));
 
 		if(f && (state.isPowerPlay() || mySevens + poSevens >
-				 static_cast<NetMauMau::Player::IPlayer::CARDS::difference_type>(2 *
+				 static_cast<IAIState::SCRATCHCARDS::difference_type>(2 *
 						 state.getTalonFactor()))) state.setCard(f);
 
 		state.setPowerPlay(false);
@@ -83,7 +83,7 @@ const IConditionPtr &PowerPlayAction::perform(IAIState &state,
 
 	if(!state.isCardPossible()) {
 		state.setCard();
-		return ACEROUNDCOND;
+		return POWERPLAY_ACEROUNDCOND;
 	}
 
 	return MAXSUITACTION;
@@ -24,25 +24,26 @@
 
 namespace {
 const NetMauMau::AI::IConditionPtr ACEREOUNDCOND(new NetMauMau::AI::AceRoundCondition());
-const NetMauMau::AI::IConditionPtr POWERSUITCOND(new NetMauMau::AI::PowerSuitCondition());
+const NetMauMau::AI::IConditionPtr
+POWERSUITACTION_POWERSUITCOND(new NetMauMau::AI::PowerSuitCondition());
 }
 
 using namespace NetMauMau::AI;
 
-PowerSuitAction::PowerSuitAction() throw() : AbstractAction(), m_determineSuit(true),
-	m_suit(NetMauMau::Common::ICard::SUIT_ILLEGAL) {}
+PowerSuitAction::PowerSuitAction() throw() : AbstractAction(POWERSUITACTION_NODE),
+	m_determineSuit(true), m_suit(NetMauMau::Common::ICard::SUIT_ILLEGAL) {}
 
-PowerSuitAction::PowerSuitAction(NetMauMau::Common::ICard::SUIT suit) throw() : AbstractAction(),
-	m_determineSuit(false), m_suit(suit) {}
+PowerSuitAction::PowerSuitAction(NetMauMau::Common::ICard::SUIT suit) throw()
+	: AbstractAction(POWERSUITACTION_NODE), m_determineSuit(false), m_suit(suit) {}
 
 PowerSuitAction::~PowerSuitAction() throw() {}
 
 const IConditionPtr &PowerSuitAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+		const CardView &) const throw() {
 
 	if(m_determineSuit) {
 
-		NetMauMau::Player::IPlayer::CARDS myCards(state.getPlayerCards());
+		IAIState::SCRATCHCARDS myCards(DecisionBase::scratchCopy(state, state.getPlayerCards()));
 
 		SUITCOUNT suitCount[4];
 		AbstractAction::countSuits(suitCount, myCards);
@@ -60,22 +61,24 @@ const IConditionPtr &PowerSuitAction::perform(IAIState &state,
 				if(f) {
 					state.setPowerSuit(f->getSuit());
 					return f != NetMauMau::Common::ICard::SUIT_ILLEGAL ?
-						   ACEREOUNDCOND : POWERSUITCOND;
+						   ACEREOUNDCOND : POWERSUITACTION_POWERSUITCOND;
 				}
 			}
 
 		} else {
 			NetMauMau::Common::ICard::SUIT s = AbstractAction::getMaxPlayedOffSuit(state);
 			state.setPowerSuit(s);
-			return s != NetMauMau::Common::ICard::SUIT_ILLEGAL ? ACEREOUNDCOND : POWERSUITCOND;
+			return s != NetMauMau::Common::ICard::SUIT_ILLEGAL ? ACEREOUNDCOND :
+				   POWERSUITACTION_POWERSUITCOND;
 		}
 
 	} else {
 		state.setPowerSuit(m_suit);
-		return m_suit != NetMauMau::Common::ICard::SUIT_ILLEGAL ? ACEREOUNDCOND : POWERSUITCOND;
+		return m_suit != NetMauMau::Common::ICard::SUIT_ILLEGAL ? ACEREOUNDCOND :
+			   POWERSUITACTION_POWERSUITCOND;
 	}
 
-	return POWERSUITCOND;
+	return POWERSUITACTION_POWERSUITCOND;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
@@ -34,7 +34,7 @@ public:
 	virtual ~PowerSuitAction() throw() _CONST;
 
 	virtual const IConditionPtr &perform(IAIState &state,
-										 const Player::IPlayer::CARDS &cards) const throw();
+										 const CardView &cards) const throw();
 #if defined(TRACE_AI) && !defined(NDEBUG)
 protected:
 	inline virtual std::string traceLog() const throw() {
@@ -23,22 +23,24 @@
 #include "powerplayaction.h"            // for PowerPlayAction
 
 namespace {
-const NetMauMau::AI::IConditionPtr ACEROUNDCOND(new NetMauMau::AI::AceRoundCondition());
+const NetMauMau::AI::IConditionPtr
+POWERSUITCOND_ACEROUNDCOND(new NetMauMau::AI::AceRoundCondition());
 }
 
 using namespace NetMauMau::AI;
 
 PowerSuitCondition::PowerSuitCondition() throw() : BinaryCondition(NetMauMau::AI::IActionPtr
-			(new NetMauMau::AI::PowerPlayAction()), createNextAction(ACEROUNDCOND)) {}
+			(new NetMauMau::AI::PowerPlayAction()), createNextAction(POWERSUITCOND_ACEROUNDCOND),
+			POWERSUITCONDITION_NODE) {}
 
 PowerSuitCondition::PowerSuitCondition(const IActionPtr &actTrue,
 									   const IActionPtr &actFalse) throw()
-	: BinaryCondition(actTrue, actFalse) {}
+	: BinaryCondition(actTrue, actFalse, POWERSUITCONDITION_NODE) {}
 
 PowerSuitCondition::~PowerSuitCondition() throw() {}
 
 IActionPtr PowerSuitCondition::perform(const IAIState &state,
-									   const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+									   const CardView &) const throw() {
 	return state.getPowerSuit() == NetMauMau::Common::ICard::SUIT_ILLEGAL ? getTrueAction() :
 		   getFalseAction();
 }
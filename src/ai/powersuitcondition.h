@@ -34,7 +34,7 @@ public:
 	virtual ~PowerSuitCondition() throw();
 
 	virtual IActionPtr perform(const IAIState &state,
-							   const Player::IPlayer::CARDS &cards) const throw();
+							   const CardView &cards) const throw();
 
 #if defined(TRACE_AI) && !defined(NDEBUG)
 protected:
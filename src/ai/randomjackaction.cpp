@@ -23,28 +23,26 @@
 
 using namespace NetMauMau::AI;
 
-RandomJackAction::RandomJackAction() throw() : AbstractAction() {}
+RandomJackAction::RandomJackAction() throw() : AbstractAction(RANDOMJACKACTION_NODE) {}
 
 RandomJackAction::~RandomJackAction() throw() {}
 
 const IConditionPtr &RandomJackAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+		const CardView &cards) const throw() {
 
-	NetMauMau::Player::IPlayer::CARDS myCards(cards);
+	IAIState::SCRATCHCARDS myCards(DecisionBase::scratchCopy(state, cards));
 
 	const NetMauMau::Player::IPlayer::CARDS::size_type jackCnt =
 		static_cast<NetMauMau::Player::IPlayer::CARDS::size_type>(DecisionBase::count(myCards,
 				NetMauMau::Common::ICard::JACK));
 
-	const NetMauMau::Player::IPlayer::CARDS::iterator
+	const IAIState::SCRATCHCARDS::iterator
 	&e(AbstractAction::stable_pull(myCards.begin(), myCards.end(), NetMauMau::Common::ICard::JACK));
 
 	if(jackCnt > 1) {
 
 		SUITCOUNT suitCount[4];
-		NetMauMau::Player::IPlayer::CARDS sCards(state.getPlayerCards());
-
-		AbstractAction::countSuits(suitCount, sCards);
+		AbstractAction::countSuits(suitCount, state.getPlayerCards());
 
 		std::sort(std::reverse_iterator<SUITCOUNT *>(suitCount + 4),
 				  std::reverse_iterator<SUITCOUNT *>(suitCount));
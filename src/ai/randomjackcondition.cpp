@@ -21,17 +21,21 @@
 
 #include "randomjackaction.h"           // for RandomJackAction
 
+namespace {
+const NetMauMau::AI::IActionPtr RANDOMJACKACTION(new NetMauMau::AI::RandomJackAction());
+}
+
 using namespace NetMauMau::AI;
 
-RandomJackCondition::RandomJackCondition() throw() : AbstractCondition() {}
+RandomJackCondition::RandomJackCondition() throw() : AbstractCondition(RANDOMJACKCONDITION_NODE) {}
 
 RandomJackCondition::~RandomJackCondition() throw() {}
 
 IActionPtr RandomJackCondition::perform(const IAIState &state,
-										const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+										const CardView &) const throw() {
 	return !state.isNoJack() && (!state.getCard() ||
 								 state.getPowerSuit() != NetMauMau::Common::ICard::SUIT_ILLEGAL) ?
-		   IActionPtr(new RandomJackAction()) : getNullAction();
+		   RANDOMJACKACTION : getNullAction();
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
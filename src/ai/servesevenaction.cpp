@@ -27,12 +27,12 @@ const NetMauMau::AI::IConditionPtr SKIPPLAYERCOND(new NetMauMau::AI::SkipPlayerC
 
 using namespace NetMauMau::AI;
 
-ServeSevenAction::ServeSevenAction() throw() : AbstractAction() {}
+ServeSevenAction::ServeSevenAction() throw() : AbstractAction(SERVESEVENACTION_NODE) {}
 
 ServeSevenAction::~ServeSevenAction() throw() {}
 
 const IConditionPtr &ServeSevenAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &cards) const throw() {
+		const CardView &cards) const throw() {
 
 	const NetMauMau::Player::IPlayer::CARDS::value_type f =
 		AbstractAction::findRankTryAvoidSuit(NetMauMau::Common::ICard::SEVEN, cards,
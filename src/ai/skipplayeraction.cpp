@@ -24,19 +24,19 @@
 
 namespace {
 const NetMauMau::AI::IConditionPtr POWERSUITCOND(new NetMauMau::AI::PowerSuitCondition());
-const NetMauMau::AI::IConditionPtr BESTJACKCOND(new NetMauMau::AI::BestSuitCondition());
+const NetMauMau::AI::IConditionPtr SKIPPLAYER_BESTSUITCOND(new NetMauMau::AI::BestSuitCondition());
 }
 
 using namespace NetMauMau::AI;
 
-SkipPlayerAction::SkipPlayerAction() throw() : AbstractAction() {}
+SkipPlayerAction::SkipPlayerAction() throw() : AbstractAction(SKIPPLAYERACTION_NODE) {}
 
 SkipPlayerAction::~SkipPlayerAction() throw() {}
 
 const IConditionPtr &SkipPlayerAction::perform(IAIState &state,
-		const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+		const CardView &) const throw() {
 
-	NetMauMau::Player::IPlayer::CARDS myCards(state.getPlayerCards());
+	IAIState::SCRATCHCARDS myCards(DecisionBase::scratchCopy(state, state.getPlayerCards()));
 	const NetMauMau::Common::ICard::SUIT avoid = state.getAvoidSuit();
 
 	const NetMauMau::Player::IPlayer::CARDS::value_type nine = state.isDirChgEnabled() ?
@@ -57,10 +57,10 @@ const IConditionPtr &SkipPlayerAction::perform(IAIState &state,
 
 	if(!state.isCardPossible()) {
 		state.setCard();
-		return BESTJACKCOND;
+		return SKIPPLAYER_BESTSUITCOND;
 	}
 
-	return state.hasPlayerFewCards() ? BESTJACKCOND : POWERSUITCOND;
+	return state.hasPlayerFewCards() ? SKIPPLAYER_BESTSUITCOND : POWERSUITCOND;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
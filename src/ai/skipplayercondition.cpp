@@ -20,24 +20,27 @@
 #include "skipplayercondition.h"
 
 #include "bestsuitcondition.h"          // for BestSuitCondition
+#include "nextaction.h"                 // for NextAction
 #include "skipplayeraction.h"           // for SkipPlayerAction
 
 namespace {
+const NetMauMau::AI::IActionPtr SKIPPLAYERACTION(new NetMauMau::AI::SkipPlayerAction());
 const NetMauMau::AI::IConditionPtr BESTSUITCOND(new NetMauMau::AI::BestSuitCondition());
+const NetMauMau::AI::IActionPtr NEXTBESTSUITCOND(new NetMauMau::AI::NextAction(BESTSUITCOND));
 }
 
 using namespace NetMauMau::AI;
 
-SkipPlayerCondition::SkipPlayerCondition() throw() : AbstractCondition() {}
+SkipPlayerCondition::SkipPlayerCondition() throw() : AbstractCondition(SKIPPLAYERCONDITION_NODE) {}
 
 SkipPlayerCondition::~SkipPlayerCondition() throw() {}
 
 IActionPtr SkipPlayerCondition::perform(const IAIState &state,
-										const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+										const CardView &) const throw() {
 	return state.getPlayerCount() > 2 && (state.getRightCount() < state.getCardCount() ||
 										  state.getRightCount() < state.getLeftCount()) &&
-		   DecisionBase::count(state.getPlayedOutCards(), NetMauMau::Common::ICard::SEVEN) ?
-		   IActionPtr(new SkipPlayerAction()) : AbstractCondition::createNextAction(BESTSUITCOND);
+		   state.getPlayedOutStats().getCount(NetMauMau::Common::ICard::SEVEN) ?
+		   SKIPPLAYERACTION : NEXTBESTSUITCOND;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
@@ -34,8 +34,9 @@ public:
 
 	virtual ~StaticCondition() throw() {}
 
-	virtual IActionPtr perform(const IAIState &, const Player::IPlayer::CARDS &) const throw() {
-		return IActionPtr(new Action());
+	virtual IActionPtr perform(const IAIState &, const CardView &) const throw() {
+		static const IActionPtr ACTION(new Action());
+		return ACTION;
 	}
 
 #if defined(TRACE_AI) && !defined(NDEBUG)
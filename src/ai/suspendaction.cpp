@@ -21,12 +21,12 @@
 
 using namespace NetMauMau::AI;
 
-SuspendAction::SuspendAction() throw() : AbstractAction() {}
+SuspendAction::SuspendAction() throw() : AbstractAction(SUSPENDACTION_NODE) {}
 
 SuspendAction::~SuspendAction() throw() {}
 
 const IConditionPtr &SuspendAction::perform(IAIState &,
-		const NetMauMau::Player::IPlayer::CARDS &) const throw() {
+		const CardView &) const throw() {
 	return AbstractAction::getNullCondition();
 }
 
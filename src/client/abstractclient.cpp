@@ -33,6 +33,7 @@
 #include "capabilitiesexception.h"      // for CapabilitiesException
 #include "cardtools.h"                  // for symbolToSuit, suitToSymbol, etc
 #include "clientcardfactory.h"          // for CardFactory
+#include "incompletemessageexception.h" // for IncompleteMessageException
 #include "interceptederrorexception.h"  // for InterceptedErrorException
 #include "pngcheck.h"                   // for checkPNG
 #include "shutdownexception.h"
@@ -268,7 +269,22 @@ throw(NetMauMau::Common::Exception::SocketException) {
 	return _pimpl->m_connection.playerList(this, playerPNG);
 }
 
-void AbstractClientV05::play(timeval *timeout)
+bool AbstractClientV05::openQuerySession(timeval *timeout)
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	if(_pimpl->m_playing) {
+		throw Exception::CapabilitiesException("attempt to open a query session in running game");
+	}
+
+	_pimpl->m_connection.setTimeout(timeout);
+	return _pimpl->m_connection.openQuerySession();
+}
+
+void AbstractClientV05::closeQuerySession() {
+	_pimpl->m_connection.closeQuerySession();
+}
+
+void AbstractClientV05::beginGame(timeval *timeout)
 throw(NetMauMau::Common::Exception::SocketException) {
 
 	{
@@ -282,41 +298,61 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 	AbstractClientV05Impl::PNGDATA().swap(_pimpl->m_pngData);
 
-	std::size_t cturn = 0u;
-	bool initCardShown = false;
-	std::string msg, cjackSuit;
-	const NetMauMau::Common::ICard *lastPlayedCard = 0;
-
-	_playInternalParams pip(msg, &cturn, &initCardShown, cjackSuit, &lastPlayedCard);
+	_pimpl->m_cturn = 0u;
+	_pimpl->m_initCardShown = false;
+	_pimpl->m_msg.clear();
+	_pimpl->m_cjackSuit.clear();
+	_pimpl->m_lastPlayedCard = 0L;
 
 	_pimpl->m_playing = true;
+}
 
-	while(!_pimpl->m_disconnectNow) {
+void AbstractClientV05::endGame() {
 
-		try {
+	// frees the server's session slot, pictures still pending end without one
+	_pimpl->m_connection.closePictures();
+	processPictures();
 
-			_pimpl->m_connection >> pip.msg;
+	_pimpl->m_connection.setNonBlocking(false);
+	_pimpl->m_playing = false;
+	_pimpl->m_disconnectNow = false;
+}
 
-			if(!_pimpl->m_disconnectNow && !pip.msg.empty()) {
+bool AbstractClientV05::dispatch() throw(NetMauMau::Common::Exception::SocketException) {
 
-				bool brk = false;
+	if(_pimpl->m_disconnectNow || _pimpl->m_msg.empty()) return true;
 
-				switch(playInternal(pip)) {
-				case BREAK:
-					brk = true;
-					break;
+	const _playInternalParams pip(_pimpl->m_msg, &_pimpl->m_cturn, &_pimpl->m_initCardShown,
+								  _pimpl->m_cjackSuit, &_pimpl->m_lastPlayedCard);
 
-				case NOT_UNDERSTOOD:
-					logDebug("Client library: " << __PRETTY_FUNCTION__ << ": " << pip.msg);
-					unknownServerMessage(pip.msg);
-					break;
+	switch(playInternal(pip)) {
+	case BREAK:
+		return false;
 
-				default:
-					break;
-				}
+	case NOT_UNDERSTOOD:
+		logDebug("Client library: " << __PRETTY_FUNCTION__ << ": " << pip.msg);
+		unknownServerMessage(pip.msg);
+		break;
 
-				if(brk) break;
-			}
+	default:
+		break;
+	}
+
+	return true;
+}
+
+void AbstractClientV05::play(timeval *timeout)
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	beginGame(timeout);
+
+	while(!_pimpl->m_disconnectNow) {
+
+		try {
+
+			_pimpl->m_connection >> _pimpl->m_msg;
+
+			if(!dispatch()) break;
 
 		} catch(const Exception::InterceptedErrorException &e) {
 
@@ -329,8 +365,98 @@ throw(NetMauMau::Common::Exception::SocketException) {
 		}
 	}
 
-	_pimpl->m_playing = false;
-	_pimpl->m_disconnectNow = false;
+	endGame();
+}
+
+void AbstractClientV05::startPlay(timeval *timeout)
+throw(NetMauMau::Common::Exception::SocketException) {
+	beginGame(timeout);
+	_pimpl->m_connection.setNonBlocking(true);
+}
+
+bool AbstractClientV05::processInput() throw(NetMauMau::Common::Exception::SocketException) {
+
+	if(!_pimpl->m_playing) return false;
+
+	bool playing = true;
+
+	try {
+
+		_pimpl->m_connection.receiveAvailable();
+
+		while(playing && !_pimpl->m_disconnectNow) {
+
+			_pimpl->m_connection.markMessage();
+
+			try {
+
+				_pimpl->m_connection >> _pimpl->m_msg;
+
+				playing = dispatch();
+
+			} catch(const Exception::IncompleteMessageException &) {
+
+				// all handlers read their whole message before they act on it, so the
+				// message can simply be read again once its remainder has arrived
+				_pimpl->m_connection.rewindMessage();
+				break;
+			}
+		}
+
+	} catch(const Exception::InterceptedErrorException &e) {
+
+		playing = false;
+
+		if(!_pimpl->m_disconnectNow) {
+
+			try {
+				checkedError(e.what());
+			} catch(const NetMauMau::Common::Exception::SocketException &) {
+				endGame();
+				throw;
+			}
+		}
+
+	} catch(const NetMauMau::Common::Exception::SocketException &) {
+
+		if(!_pimpl->m_disconnectNow) {
+			endGame();
+			throw;
+		}
+	}
+
+	if(!playing || _pimpl->m_disconnectNow) {
+		endGame();
+		return false;
+	}
+
+	// delivers what already arrived, as well as the fetches which failed right away
+	processPictures();
+
+	return true;
+}
+
+SOCKET AbstractClientV05::getSocketFD() const {
+	return _pimpl->m_connection.getSocketFD();
+}
+
+SOCKET AbstractClientV05::getPictureSocketFD() const {
+	return _pimpl->m_connection.getPictureSocketFD();
+}
+
+void AbstractClientV05::processPictures() {
+
+	std::string player;
+	std::vector<unsigned char> png;
+
+	_pimpl->m_connection.receivePictures();
+
+	while(_pimpl->m_connection.nextPicture(player, png)) {
+
+		endReceivePlayerPicture(player);
+
+		if(!png.empty()) playerPictureReceived(player, png.data(), png.size());
+	}
 }
 
 AbstractClient::PIRET AbstractClientV13::performDirChange(const _playInternalParams &) const {
@@ -437,20 +563,22 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 	std::string plPic;
 
-	_pimpl->m_connection >> p.msg;
+	_pimpl->m_connection >> p.msg >> plPic;
 
 	beginReceivePlayerPicture(p.msg);
 
+	std::vector<unsigned char> plPicPng;
+	bool received;
+
 	try {
-		_pimpl->m_connection >> plPic;
+		received = _pimpl->m_connection.requestPicture(p.msg, plPic, plPicPng);
 	} catch(const NetMauMau::Common::Exception::SocketException &) {
 		endReceivePlayerPicture(p.msg);
 		throw;
 	}
 
-	const std::vector<unsigned char> &plPicPng(NetMauMau::Common::base64_decode(plPic));
-
-	endReceivePlayerPicture(p.msg);
+	// a picture still on its way gets delivered by processPictures()
+	if(received) endReceivePlayerPicture(p.msg);
 
 	const bool hasPlPic = (!plPicPng.empty() && plPic != '-');
 
@@ -470,15 +598,19 @@ AbstractClientV05::performPlayerRejected(const _playInternalParams &p) const {
 
 AbstractClientV05::PIRET AbstractClientV05::performGetCards(const _playInternalParams &p) const {
 
-	_pimpl->m_connection >> p.msg;
+	CARDS cards;
 
-	const CARDS::size_type cnt = _pimpl->m_cards.empty() ? 0 : _pimpl->m_cards.size();
+	_pimpl->m_connection >> p.msg;
 
 	while(p.msg != NetMauMau::Common::Protocol::V15::CARDSGOT) {
-		_pimpl->m_cards.push_back((NetMauMau::Client::CardFactory(p.msg)).create());
+		cards.push_back(NetMauMau::Client::CardFactory::intern(p.msg));
 		_pimpl->m_connection >> p.msg;
 	}
 
+	const CARDS::size_type cnt = _pimpl->m_cards.empty() ? 0 : _pimpl->m_cards.size();
+
+	_pimpl->m_cards.insert(_pimpl->m_cards.end(), cards.begin(), cards.end());
+
 	cardSet(_pimpl->getCards(_pimpl->m_cards, cnt));
 
 	return OK;
@@ -488,15 +620,13 @@ AbstractClientV05::PIRET AbstractClientV05::performInitialCard(const _playIntern
 
 	_pimpl->m_connection >> p.msg;
 
-	const NetMauMau::Common::ICard *ic = (NetMauMau::Client::CardFactory(p.msg)).create();
+	const NetMauMau::Common::ICard *ic = NetMauMau::Client::CardFactory::intern(p.msg);
 
 	if(ic == NetMauMau::Common::ICard::JACK || ic == NetMauMau::Common::ICard::EIGHT) {
 		initialCard(ic);
 		*p.initCardShown = true;
 	}
 
-	delete ic;
-
 	return OK;
 }
 
@@ -510,9 +640,7 @@ AbstractClientV05::PIRET AbstractClientV05::performOpenCard(const _playInternalP
 
 	_pimpl->m_connection >> p.msg;
 
-	delete _pimpl->m_openCard;
-
-	_pimpl->m_openCard = (NetMauMau::Client::CardFactory(p.msg)).create();
+	_pimpl->m_openCard = NetMauMau::Client::CardFactory::intern(p.msg);
 
 	if(!*p.initCardShown) {
 
@@ -559,7 +687,6 @@ AbstractClientV05::performCardAccepted(const _playInternalParams &p) const {
 
 		if(f != _pimpl->m_cards.end()) {
 			cardAccepted(*f);
-			delete *f;
 			_pimpl->m_cards.erase(f);
 		}
 	}
@@ -573,9 +700,7 @@ AbstractClientV05::performCardRejected(const _playInternalParams &p) const {
 	std::string player;
 	_pimpl->m_connection >> player >> p.msg;
 
-	const NetMauMau::Common::ICard *c = (NetMauMau::Client::CardFactory(p.msg)).create();
-	cardRejected(player, c);
-	delete c;
+	cardRejected(player, NetMauMau::Client::CardFactory::intern(p.msg));
 
 	return OK;
 }
@@ -599,9 +724,7 @@ AbstractClientV05::PIRET AbstractClientV05::performPlayedCard(const _playInterna
 	std::string player;
 	_pimpl->m_connection >> player >> p.msg;
 
-	const NetMauMau::Common::ICard *c = (NetMauMau::Client::CardFactory(p.msg)).create();
-	playedCard(player, c);
-	delete c;
+	playedCard(player, NetMauMau::Client::CardFactory::intern(p.msg));
 
 	p.cjackSuit.clear();
 
@@ -646,9 +769,7 @@ AbstractClientV05::performPlayerPicksCard(const _playInternalParams &p) const {
 
 	if(extra.compare(NetMauMau::Common::Protocol::V15::CARDTAKEN) == 0) {
 		_pimpl->m_connection >> p.msg;
-		const NetMauMau::Common::ICard *c = (NetMauMau::Client::CardFactory(p.msg)).create();
-		playerPicksCard(player, c);
-		delete c;
+		playerPicksCard(player, NetMauMau::Client::CardFactory::intern(p.msg));
 	} else {
 		playerPicksCard(player, static_cast<NetMauMau::Common::ICard *>(0L));
 	}
@@ -821,6 +942,8 @@ void AbstractClientV05::beginReceivePlayerPicture(const std::string &) const thr
 void AbstractClientV05::endReceivePlayerPicture(const std::string &) const throw() {}
 void AbstractClientV05::uploadSucceded(const std::string &) const throw() {}
 void AbstractClientV05::uploadFailed(const std::string &) const throw() {}
+void AbstractClientV05::playerPictureReceived(const std::string &, const unsigned char *,
+		std::size_t) const throw() {}
 
 NetMauMau::Common::ICard *AbstractClientV08::playCard(const AbstractClientV05::CARDS &cards) const {
 	return playCard(cards, 0);
@@ -19,23 +19,10 @@
 
 #include "abstractclientv05impl.h"
 
+#include "clientcardfactory.h"          // for CardFactory
 #include "logger.h"
 #include "protocol.h"                   // for PLAYCARDEND, SUSPEND
 
-namespace {
-#pragma GCC diagnostic ignored "-Weffc++"
-#pragma GCC diagnostic push
-struct cardEqualsDescription : std::binary_function < NetMauMau::Common::ICard *,
-		std::string, bool > {
-	inline result_type operator()(const first_argument_type c,
-								  const second_argument_type &d) const {
-		return c->description().compare(d) == 0;
-	}
-};
-
-#pragma GCC diagnostic pop
-}
-
 using namespace NetMauMau::Client;
 
 template<> const MappedMessageProcessor<AbstractClientV05, MP_CNT_V05>::value_type
@@ -117,7 +104,8 @@ AbstractClientV13, MP_CNT_V13 >::m_data[MP_CNT_V13] _INIT_PRIO(102) = {
 AbstractClientV05Impl::AbstractClientV05Impl(const std::string &pName, const std::string &server,
 		uint16_t port, const unsigned char *pngData, std::size_t pngDataLen, unsigned char sockopts)
 	: m_connection(pName, server, port, sockopts), m_pName(pName), m_pngData(), m_cards(),
-	  m_openCard(0L), m_disconnectNow(false), m_playing(false) {
+	  m_openCard(0L), m_disconnectNow(false), m_playing(false), m_msg(), m_cjackSuit(),
+	  m_cturn(0u), m_initCardShown(false), m_lastPlayedCard(0L) {
 
 	if(pngData && pngDataLen) {
 
@@ -134,17 +122,12 @@ AbstractClientV05Impl::AbstractClientV05Impl(const std::string &pName, const std
 AbstractClientV05Impl::~AbstractClientV05Impl() {
 
 	m_connection.setInterrupted(false);
-
-	for(AbstractClient::CARDS::const_iterator i(m_cards.begin());
-			i != m_cards.end(); ++i) delete *i;
-
-	delete m_openCard;
 }
 
 NetMauMau::Client::AbstractClient::CARDS AbstractClientV05Impl::recvPossibleCards(std::string &msg)
 throw(NetMauMau::Common::Exception::SocketException) {
 
-	const NetMauMau::Client::AbstractClient::CARDS &myCards(getCards(m_cards));
+	const NetMauMau::Client::AbstractClient::CARDS &myCards(m_cards);
 	NetMauMau::Client::AbstractClient::CARDS possCards;
 
 	if(myCards.size() < possCards.max_size()) possCards.reserve(myCards.size());
@@ -153,8 +136,8 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 	while(msg != NetMauMau::Common::Protocol::V15::PLAYCARDEND) {
 
-		const AbstractClient::CARDS::const_iterator &f(std::find_if(myCards.begin(),
-				myCards.end(), std::bind2nd(cardEqualsDescription(), msg)));
+		const AbstractClient::CARDS::const_iterator &f(std::find(myCards.begin(), myCards.end(),
+				CardFactory::intern(msg)));
 
 		if(f != myCards.end()) possCards.push_back(*f);
 
@@ -24,6 +24,7 @@
 #include <algorithm>
 
 #include "abstractclient.h"             // for AbstractClient
+#include "protohash.h"                  // for MESSAGEID, messageId
 
 namespace NetMauMau {
 
@@ -33,10 +34,12 @@ class IBase64;
 
 struct _LOCAL _playInternalParams {
 	inline _playInternalParams(std::string &m, std::size_t *t, bool *ics, std::string &js,
-							   const Common::ICard **lpc) : msg(m), cturn(t), initCardShown(ics),
+							   const Common::ICard **lpc) : msg(m),
+		msgId(Common::Protocol::messageId(m.data(), m.length())), cturn(t), initCardShown(ics),
 		cjackSuit(js), lastPlayedCard(lpc) {}
 
 	std::string &msg;
+	const Common::Protocol::MESSAGEID msgId;
 	std::size_t *cturn;
 	bool *initCardShown;
 	std::string &cjackSuit;
@@ -77,32 +80,26 @@ public:
 	const Common::ICard *m_openCard;
 	bool m_disconnectNow;
 	bool m_playing;
+	std::string m_msg;
+	std::string m_cjackSuit;
+	std::size_t m_cturn;
+	bool m_initCardShown;
+	const Common::ICard *m_lastPlayedCard;
 };
 
-template<class> class MappedMessageInitializer;
+template<class, std::size_t> class MappedMessageInitializer;
 template<class, class, std::size_t> struct MappedMessageAllocator;
 
 template<class T, std::size_t N>
 class _LOCAL MappedMessageProcessor {
 	DISALLOW_COPY_AND_ASSIGN(MappedMessageProcessor)
 
-	template<class> friend class MappedMessageInitializer;
+	template<class, std::size_t> friend class MappedMessageInitializer;
 	template<class, class, std::size_t> friend struct MappedMessageAllocator;
 
-#pragma GCC diagnostic ignored "-Weffc++"
-#pragma GCC diagnostic push
-	struct _LOCAL _protoCmp : std::binary_function<const std::string *, const std::string *, bool> {
-		inline result_type operator()(first_argument_type x,
-									  second_argument_type y) const _NONNULL_ALL {
-			return *x < *y;
-		}
-	};
-#pragma GCC diagnostic pop
-
 	typedef AbstractClientV05::PIRET(T::*PROTOFN)(const _playInternalParams &) const;
 	typedef std::pair<const std::string *const, PROTOFN> value_type;
 	typedef MappedMessageAllocator<value_type, T, N> allocator_type;
-	typedef std::map<const std::string *const, PROTOFN, _protoCmp, allocator_type> PROTOMAP;
 
 public:
 	MappedMessageProcessor(const T &t, const AbstractClientV05Impl &pimpl)
@@ -113,90 +110,34 @@ public:
 	AbstractClient::PIRET process(const _playInternalParams &p) const
 	throw(NetMauMau::Common::Exception::SocketException) {
 
-		const typename PROTOMAP::const_iterator &f(m_messageMap.m_protoMap.find(&p.msg));
+		const PROTOFN f = m_messageMap.m_protoTable[p.msgId];
 
-		if(!_pimpl.m_disconnectNow && f != m_messageMap.m_protoMap.end()) return (_t.*f->second)(p);
+		if(!_pimpl.m_disconnectNow && f) return (_t.*f)(p);
 
 		return !_pimpl.m_disconnectNow ? AbstractClient::NOT_UNDERSTOOD : AbstractClient::OK;
 	}
 
 private:
-	static const MappedMessageInitializer<T> m_messageMap;
+	static const MappedMessageInitializer<T, N> m_messageMap;
 
 	const T &_t;
 	const AbstractClientV05Impl &_pimpl;
 };
 
 template<class T, std::size_t N>
-const MappedMessageInitializer<T> MappedMessageProcessor<T, N>::m_messageMap;
-
-template<class, class, std::size_t> struct MappedMessageAllocator;
-
-template<class C, std::size_t N> struct MappedMessageAllocator<void, C, N> {
-
-	typedef void value_type;
-	typedef void *pointer;
-	typedef const void *const_pointer;
-
-	template <class U>
-	struct rebind {
-		typedef MappedMessageAllocator<U, C, N> other;
-	};
-};
+const MappedMessageInitializer<T, N> MappedMessageProcessor<T, N>::m_messageMap;
 
+/**
+ * @brief Holds the messages handled by @c C along with their handlers
+ */
 template<class T, class C, std::size_t N>
 struct MappedMessageAllocator {
-
-	typedef T value_type;
-	typedef T *pointer;
-	typedef const T *const_pointer;
-	typedef T &reference;
-	typedef const T &const_reference;
-	typedef std::size_t size_type;
-	typedef std::ptrdiff_t difference_type;
-
-	template<class U> struct rebind {
-		typedef MappedMessageAllocator<U, C, N> other;
-	};
-
-	MappedMessageAllocator() {}
-
-	template<class U>
-	MappedMessageAllocator(const MappedMessageAllocator<U, C, N> &) {}
-
-	~MappedMessageAllocator() {}
-
-	pointer allocate(size_type n, MappedMessageAllocator<void, C, N> * = 0) {
-		return reinterpret_cast<pointer>(::operator new(n * sizeof(value_type)));
-	}
-
-	static void deallocate(pointer p, size_type) {
-		::operator delete(p);
-	}
-
-	static void construct(pointer p, const_reference val) {
-
-		typedef MappedMessageAllocator<typename MappedMessageProcessor<C, N>::value_type, C, N> sal;
-
-		const const_pointer &v(sal::m_data[sal::m_nxt] != val ? std::find(&sal::m_data[sal::m_nxt],
-							   sal::m_data + N, val) : &sal::m_data[sal::m_nxt++]);
-
-		std::uninitialized_copy(v, v + 1, p);
-	}
-
-	static void destroy(pointer) {}
-
 private:
-	template<class, class, std::size_t> friend struct MappedMessageAllocator;
-	template<class> friend class MappedMessageInitializer;
+	template<class, std::size_t> friend class MappedMessageInitializer;
 
 	static const typename MappedMessageProcessor<C, N>::value_type m_data[];
-	static std::size_t m_nxt;
 };
 
-template<class T, class C, std::size_t N>
-std::size_t MappedMessageAllocator<T, C, N>::m_nxt = 0u;
-
 template<> const MappedMessageProcessor<AbstractClientV05, MP_CNT_V05>::value_type
 MappedMessageAllocator < MappedMessageProcessor<AbstractClientV05, MP_CNT_V05>::value_type,
 					   AbstractClientV05, MP_CNT_V05 >::m_data[];
@@ -213,88 +154,41 @@ template<> const MappedMessageProcessor<AbstractClientV13, MP_CNT_V13>::value_ty
 MappedMessageAllocator < MappedMessageProcessor<AbstractClientV13, MP_CNT_V13>::value_type,
 					   AbstractClientV13, MP_CNT_V13 >::m_data[];
 
-template<class T> class MappedMessageInitializer;
-
-template<> class _LOCAL MappedMessageInitializer<AbstractClientV05> {
-	DISALLOW_COPY_AND_ASSIGN(MappedMessageInitializer<AbstractClientV05>)
-	friend class MappedMessageProcessor<AbstractClientV05, MP_CNT_V05>;
-public:
-	// cppcheck-suppress functionStatic
-	MappedMessageInitializer() : m_protoMap(
-			MappedMessageProcessor<AbstractClientV05, MP_CNT_V05>::allocator_type::m_data,
-			MappedMessageProcessor<AbstractClientV05, MP_CNT_V05>::allocator_type::m_data
-			+ MP_CNT_V05) {}
-	// cppcheck-suppress functionStatic
-	~MappedMessageInitializer() {}
+/**
+ * @brief Table of the handlers of @c T indexed by the message
+ *
+ * The handlers are looked up by the perfect hash of the protocol keywords, messages not
+ * handled by @c T map to @c 0L.
+ */
+template<class T, std::size_t N>
+class _LOCAL MappedMessageInitializer {
+	DISALLOW_COPY_AND_ASSIGN(MappedMessageInitializer)
+	friend class MappedMessageProcessor<T, N>;
 
-private:
-	const MappedMessageProcessor<AbstractClientV05, MP_CNT_V05>::PROTOMAP m_protoMap;
-};
+	typedef MappedMessageProcessor<T, N> MMP;
 
-template<> class _LOCAL MappedMessageInitializer<AbstractClientV07> {
-	DISALLOW_COPY_AND_ASSIGN(MappedMessageInitializer<AbstractClientV07>)
-	friend class MappedMessageProcessor<AbstractClientV07, MP_CNT_V07>;
 public:
-	// cppcheck-suppress functionStatic
-	MappedMessageInitializer() : m_protoMap(
-			MappedMessageProcessor<AbstractClientV07, MP_CNT_V07>::allocator_type::m_data,
-			MappedMessageProcessor<AbstractClientV07, MP_CNT_V07>::allocator_type::m_data
-			+ MP_CNT_V07) {}
-	// cppcheck-suppress functionStatic
-	~MappedMessageInitializer() {}
+	MappedMessageInitializer() : m_protoTable() {
 
-private:
-	const MappedMessageProcessor<AbstractClientV07, MP_CNT_V07>::PROTOMAP m_protoMap;
-};
+		for(std::size_t i = 0u; i < N; ++i) {
 
-template<> class _LOCAL MappedMessageInitializer<AbstractClientV08> {
-	DISALLOW_COPY_AND_ASSIGN(MappedMessageInitializer<AbstractClientV08>)
-	friend class MappedMessageProcessor<AbstractClientV08, MP_CNT_V08>;
-public:
-	// cppcheck-suppress functionStatic
-	MappedMessageInitializer() : m_protoMap(
-			MappedMessageProcessor<AbstractClientV08, MP_CNT_V08>::allocator_type::m_data,
-			MappedMessageProcessor<AbstractClientV08, MP_CNT_V08>::allocator_type::m_data
-			+ MP_CNT_V08) {}
-	// cppcheck-suppress functionStatic
-	~MappedMessageInitializer() {}
+			const typename MMP::value_type &e(MMP::allocator_type::m_data[i]);
 
-private:
-	const MappedMessageProcessor<AbstractClientV08, MP_CNT_V08>::PROTOMAP m_protoMap;
-};
+			m_protoTable[Common::Protocol::messageId(e.first->data(), e.first->length())] =
+				e.second;
+		}
+	}
 
-template<> class _LOCAL MappedMessageInitializer<AbstractClientV13> {
-	DISALLOW_COPY_AND_ASSIGN(MappedMessageInitializer<AbstractClientV13>)
-	friend class MappedMessageProcessor<AbstractClientV13, MP_CNT_V13>;
-public:
-	// cppcheck-suppress functionStatic
-	MappedMessageInitializer()
-		: m_protoMap(MappedMessageProcessor<AbstractClientV13, MP_CNT_V13>::allocator_type::m_data,
-					 MappedMessageProcessor<AbstractClientV13, MP_CNT_V13>::allocator_type::m_data
-					 + MP_CNT_V13) {}
-	// cppcheck-suppress functionStatic
 	~MappedMessageInitializer() {}
 
 private:
-	const MappedMessageProcessor<AbstractClientV13, MP_CNT_V13>::PROTOMAP m_protoMap;
+	typename MMP::PROTOFN m_protoTable[Common::Protocol::ID_UNKNOWN + 1];
 };
 
 }
 
 }
 
-template<class T1, class T2, class C, std::size_t N>
-bool operator==(const NetMauMau::Client::MappedMessageAllocator<T1, C, N> &,
-				const NetMauMau::Client::MappedMessageAllocator<T2, C, N> &) {
-	return true;
-}
-
-template<class T1, class T2, class C, std::size_t N>
-bool operator!=(const NetMauMau::Client::MappedMessageAllocator<T1, C, N> &,
-				const NetMauMau::Client::MappedMessageAllocator<T2, C, N> &) {
-	return false;
-}
-
 #endif /* NETMAUMAU_ABSTRACTCLIENTV05IMPL_H */
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
@@ -21,6 +21,58 @@
 
 #include "cardtools.h"
 
+namespace {
+
+class Card : public NetMauMau::Common::ICard {
+	DISALLOW_COPY_AND_ASSIGN(Card)
+	friend class Deck;
+public:
+	Card() : m_idx(0u), m_suit(HEARTS), m_rank(ACE) {}
+	virtual ~Card() {}
+
+	virtual const std::string &description(bool ansi = false) const {
+		return NetMauMau::Common::getCardDesc(m_idx, ansi);
+	}
+
+	virtual std::size_t getPoints() const {
+		return NetMauMau::Common::getCardPoints(m_rank);
+	}
+
+	virtual SUIT getSuit() const {
+		return m_suit;
+	}
+
+	virtual RANK getRank() const {
+		return m_rank;
+	}
+
+private:
+	std::size_t m_idx;
+	SUIT m_suit;
+	RANK m_rank;
+};
+
+// one card of every kind, shared by all players and all games
+class Deck {
+	DISALLOW_COPY_AND_ASSIGN(Deck)
+public:
+	Deck() {
+		for(std::size_t i = 0u; i < NetMauMau::Common::CARD_INDEX_ILLEGAL; ++i) {
+			m_cards[i].m_idx = i;
+			NetMauMau::Common::getCardFromIndex(i, &m_cards[i].m_suit, &m_cards[i].m_rank);
+		}
+	}
+
+	inline NetMauMau::Common::ICard *operator[](std::size_t idx) {
+		return &m_cards[idx];
+	}
+
+private:
+	Card m_cards[NetMauMau::Common::CARD_INDEX_ILLEGAL];
+} DECK;
+
+}
+
 using namespace NetMauMau::Client;
 
 CardFactory::CardFactory(const std::string &cardDesc) : ICardFactory(), m_cardDesc(cardDesc) {}
@@ -29,37 +81,28 @@ CardFactory::~CardFactory() {}
 
 NetMauMau::Common::ICard *CardFactory::create(NetMauMau::Common::ICard::SUIT,
 		NetMauMau::Common::ICard::RANK) const {
+	return intern(m_cardDesc);
+}
 
-	NetMauMau::Common::ICard::SUIT suit = NetMauMau::Common::ICard::HEARTS;
-	NetMauMau::Common::ICard::RANK rank = NetMauMau::Common::ICard::ACE;
+NetMauMau::Common::ICard *CardFactory::intern(const char *desc, std::size_t len) {
 
-	if(NetMauMau::Common::parseCardDesc(m_cardDesc, &suit, &rank)) {
-		return new Card(suit, rank, m_cardDesc);
-	} else {
-		return 0L;
-	}
-}
+	std::size_t idx = NetMauMau::Common::parseCardIndex(desc, len);
 
-CardFactory::Card::Card(NetMauMau::Common::ICard::SUIT s, NetMauMau::Common::ICard::RANK v,
-						const std::string &desc) : m_suit(s), m_rank(v), m_desc(desc),
-	m_descAnsi(NetMauMau::Common::createCardDesc(m_suit, m_rank, true)) {}
+	if(idx != NetMauMau::Common::CARD_INDEX_ILLEGAL) return DECK[idx];
 
-CardFactory::Card::~Card() {}
+	// anything but the exact wire format takes the slow path
+	NetMauMau::Common::ICard::SUIT suit = NetMauMau::Common::ICard::HEARTS;
+	NetMauMau::Common::ICard::RANK rank = NetMauMau::Common::ICard::ACE;
 
-std::size_t CardFactory::Card::getPoints() const {
-	return NetMauMau::Common::getCardPoints(m_rank);
-}
+	if(NetMauMau::Common::parseCardDesc(std::string(desc, len), &suit, &rank)) {
 
-const std::string &CardFactory::Card::description(bool ansi) const {
-	return !ansi ? m_desc : m_descAnsi;
-}
+		idx = NetMauMau::Common::getCardIndex(suit, rank);
 
-NetMauMau::Common::ICard::SUIT CardFactory::Card::getSuit() const {
-	return m_suit;
-}
+		return idx != NetMauMau::Common::CARD_INDEX_ILLEGAL ? DECK[idx] :
+			   NetMauMau::Common::getIllegalCard();
+	}
 
-NetMauMau::Common::ICard::RANK CardFactory::Card::getRank() const {
-	return m_rank;
+	return 0L;
 }
 
-// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -21,6 +21,7 @@
 #define NETMAUMAU_CLIENTCARDFACTORY_H
 
 #include <cstddef>                      // for size_t
+#include <string>
 
 #include "icardfactory.h"               // for ICardFactory
 
@@ -28,6 +29,13 @@ namespace NetMauMau {
 
 namespace Client {
 
+/**
+ * @brief Resolves card descriptions to shared immutable cards
+ *
+ * There is exactly one card object for every card of a deck, which lives as long as the
+ * library is loaded and must not be deleted. Thus equal cards are identical pointers, even
+ * if more than one deck is played with.
+ */
 class CardFactory : public ICardFactory {
 	DISALLOW_COPY_AND_ASSIGN(CardFactory)
 public:
@@ -37,26 +45,18 @@ public:
 	virtual _NOUNUSED Common::ICard *create(Common::ICard::SUIT s = Common::ICard::HEARTS,
 											Common::ICard::RANK r = Common::ICard::ACE) const;
 
-private:
-	class Card : public Common::ICard {
-		DISALLOW_COPY_AND_ASSIGN(Card)
-	public:
-		explicit Card(Common::ICard::SUIT s, ICard::RANK r, const std::string &desc);
-		virtual ~Card();
-
-		virtual const std::string &description(bool ansi = false) const _CONST;
-		virtual std::size_t getPoints() const _PURE;
-
-		virtual SUIT getSuit() const _PURE;
-		virtual RANK getRank() const _PURE;
+	/**
+	 * @brief Gets the card of a description as sent over the wire
+	 *
+	 * @return the shared card or @c 0L if @c desc doesn't describe a card
+	 */
+	static Common::ICard *intern(const char *desc, std::size_t len);
 
-	private:
-		Common::ICard::SUIT m_suit;
-		Common::ICard::RANK m_rank;
-		std::string m_desc;
-		std::string m_descAnsi;
-	};
+	inline static Common::ICard *intern(const std::string &desc) {
+		return intern(desc.data(), desc.length());
+	}
 
+private:
 	std::string m_cardDesc;
 };
 
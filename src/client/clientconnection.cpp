@@ -40,11 +40,13 @@
 #include "ci_string.h"
 #include "tcpopt_cork.h"
 #include "tcpopt_nodelay.h"
+#include "wirecodec.h"                  // for WireCodec
 #include "abstractclient.h"             // for AbstractClient
 #include "capabilitiesexception.h"      // for CapabilitiesException
 #include "clientconnectionimpl.h"       // for ConnectionImpl
 #include "connectionrejectedexception.h"
 #include "gamerunningexception.h"       // for GameRunningException
+#include "incompletemessageexception.h" // for IncompleteMessageException
 #include "interceptederrorexception.h"  // for InterceptedErrorException
 #include "nonetmaumauserverexception.h" // for NoNetMauMauServerException
 #include "playerlistexception.h"        // for PlayerlistException
@@ -54,11 +56,16 @@
 #include "protocol.h"                   // for ERROR
 
 #define MAX_PNAME 1024
+#define RECVSIZE 8192
 
 #ifndef TEMP_FAILURE_RETRY
 #define TEMP_FAILURE_RETRY
 #endif
 
+#ifndef MSG_DONTWAIT
+#define MSG_DONTWAIT 0x0000000
+#endif
+
 namespace {
 
 class _picListenerHelper {
@@ -80,6 +87,15 @@ private:
 	const bool m_armed;
 };
 
+// recv() returns nothing on an interrupted wait too, only an empty read means the server left
+bool peerClosed(SOCKET fd) {
+
+	char c;
+	const ssize_t l = TEMP_FAILURE_RETRY(::recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT));
+
+	return !l || (l < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+}
+
 #if defined(ESHUTDOWN)
 const std::string SRVCLOSE(NetMauMau::Common::errorString(ESHUTDOWN));
 #else
@@ -90,19 +106,20 @@ const std::string SRVCLOSE("Connection closed by server");
 using namespace NetMauMau::Client;
 
 Connection::Connection(const std::string &pName, const std::string &server, uint16_t port)
-	: AbstractConnection(server.c_str(), port), _pimpl(new ConnectionImpl(this, pName, 0L, 2)) {
+	: AbstractConnection(server.c_str(), port),
+	  _pimpl(new ConnectionImpl(this, pName, server, port, 0L, 2)) {
 	init();
 }
 
 Connection::Connection(const std::string &pName, const std::string &server, uint16_t port,
 					   BASE64RAII &) : AbstractConnection(server.c_str(), port),
-	_pimpl(new ConnectionImpl(this, pName, 0L, 2)) {
+	_pimpl(new ConnectionImpl(this, pName, server, port, 0L, 2)) {
 	init();
 }
 
 Connection::Connection(const std::string &pName, const std::string &server, uint16_t port,
 					   unsigned char sockopts) : AbstractConnection(server.c_str(), port, sockopts),
-	_pimpl(new ConnectionImpl(this, pName, 0L, 2)) {
+	_pimpl(new ConnectionImpl(this, pName, server, port, 0L, 2)) {
 	init();
 }
 
@@ -128,7 +145,7 @@ void Connection::setTimeout(struct timeval *timeout) {
 Connection::PLAYERINFOS Connection::playerList(const IPlayerPicListener *hdl, bool playerPNG)
 throw(NetMauMau::Common::Exception::SocketException) {
 
-	TCPOPT_CORK(getSocketFD());
+	TCPOPT_CORK(_pimpl->m_querySession ? INVALID_SOCKET : getSocketFD());
 
 	PLAYERINFOS plv;
 
@@ -136,16 +153,17 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 		if(playerPNG) {
 
-			char pl[30];
-			const std::size_t len = static_cast<std::size_t>(std::snprintf(pl, 29, "%s %d.%d",
+			char pl[40];
+			const std::size_t len = static_cast<std::size_t>(std::snprintf(pl, 39, "%s %d.%d %s",
 									NetMauMau::Common::Protocol::V15::PLAYERLIST.c_str(),
-									SERVER_VERSION_MAJOR, SERVER_VERSION_MINOR));
+									SERVER_VERSION_MAJOR, SERVER_VERSION_MINOR,
+									NetMauMau::Common::Protocol::V15::PICHASH.c_str()));
 
-			send(pl, len, getSocketFD());
+			_pimpl->sendQuery(pl, len);
 
 		} else {
-			send(NetMauMau::Common::Protocol::V15::PLAYERLIST.c_str(),
-				 NetMauMau::Common::Protocol::V15::PLAYERLIST.length(), getSocketFD());
+			_pimpl->sendQuery(NetMauMau::Common::Protocol::V15::PLAYERLIST.c_str(),
+							  NetMauMau::Common::Protocol::V15::PLAYERLIST.length());
 		}
 
 		std::string pl, pic;
@@ -159,7 +177,7 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 			if(isPLEnd(pic)) break;
 
-			const std::vector<unsigned char> &pp(NetMauMau::Common::base64_decode(pic));
+			const std::vector<unsigned char> &pp(_pimpl->getPicture(pic));
 
 			unsigned char *ppd = 0L;
 
@@ -179,6 +197,9 @@ throw(NetMauMau::Common::Exception::SocketException) {
 			plv.push_back(pInfo);
 		}
 
+		// the pictures of the list shared a session, it mustn't occupy the server any longer
+		if(_pimpl->m_pictureRequests.empty()) _pimpl->closePictures();
+
 	} else {
 		throw Exception::PlayerlistException("Unable to get player list", getSocketFD());
 	}
@@ -209,14 +230,14 @@ throw(NetMauMau::Common::Exception::SocketException) {
 Connection::CAPABILITIES Connection::capabilities()
 throw(NetMauMau::Common::Exception::SocketException) {
 
-	TCPOPT_CORK(getSocketFD());
+	TCPOPT_CORK(_pimpl->m_querySession ? INVALID_SOCKET : getSocketFD());
 
 	Connection::CAPABILITIES caps;
 
 	if(_pimpl->hello()) {
 
-		send(NetMauMau::Common::Protocol::V15::CAP.c_str(),
-			 NetMauMau::Common::Protocol::V15::CAP.length(), getSocketFD());
+		_pimpl->sendQuery(NetMauMau::Common::Protocol::V15::CAP.c_str(),
+						  NetMauMau::Common::Protocol::V15::CAP.length());
 
 		std::string cap;
 		*this >> cap;
@@ -242,7 +263,7 @@ throw(NetMauMau::Common::Exception::SocketException) {
 Connection::SCORES Connection::getScores(SCORE_TYPE::_scoreType type, std::size_t limit)
 throw(NetMauMau::Common::Exception::SocketException) {
 
-	TCPOPT_CORK(getSocketFD());
+	TCPOPT_CORK(_pimpl->m_querySession ? INVALID_SOCKET : getSocketFD());
 
 	try {
 
@@ -271,7 +292,9 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 				os << limit;
 
-				send(os.str().c_str(), os.str().length(), getSocketFD());
+				const std::string &query(os.str());
+
+				_pimpl->sendQuery(query.c_str(), query.length());
 
 				std::string score;
 				*this >> score;
@@ -312,6 +335,8 @@ throw(NetMauMau::Common::Exception::SocketException) {
 void Connection::connect(const IPlayerPicListener *l, const unsigned char *data, std::size_t len)
 throw(NetMauMau::Common::Exception::SocketException) {
 
+	closeQuerySession();
+
 	uint16_t maj = 0, min = 0;
 
 	if(_pimpl->hello(&maj, &min)) {
@@ -323,9 +348,11 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 			char helloStr[100];
 			const std::size_t hlen = static_cast<std::size_t>(std::snprintf(helloStr, 99,
-									 "%s %u.%u", PACKAGE_NAME,
+									 "%s %u.%u %s %s", PACKAGE_NAME,
 									 static_cast<uint16_t>(_pimpl->m_clientVersion << 16u),
-									 static_cast<uint16_t>(_pimpl->m_clientVersion)));
+									 static_cast<uint16_t>(_pimpl->m_clientVersion),
+									 NetMauMau::Common::Protocol::V15::BINARY.c_str(),
+									 NetMauMau::Common::Protocol::V15::PICHASH.c_str()));
 
 			send(helloStr, hlen, getSocketFD());
 
@@ -410,7 +437,10 @@ throw(NetMauMau::Common::Exception::SocketException) {
 #endif
 			}
 
-			if(!(status[0] == 'O' && status[1] == 'K')) {
+			// servers understanding binary frames switch to them after accepting with OB
+			_pimpl->m_binary = status[0] == 'O' && status[1] == 'B';
+
+			if(!(status[0] == 'O' && (status[1] == 'K' || _pimpl->m_binary))) {
 
 				if((status[0] == 'N' && status[1] == 'O')) {
 					throw Exception::ConnectionRejectedException("Remote server rejected " \
@@ -439,6 +469,99 @@ throw(NetMauMau::Common::Exception::SocketException) {
 	}
 }
 
+bool Connection::openQuerySession() throw(NetMauMau::Common::Exception::SocketException) {
+
+	if(_pimpl->m_querySession) return true;
+
+	if(_pimpl->hello()) {
+
+		TCPOPT_NODELAY(getSocketFD());
+
+#ifdef HAVE_ZLIB_H
+		const std::string query(NetMauMau::Common::Protocol::V15::QUERY + " " +
+								NetMauMau::Common::Protocol::V15::DEFLATE);
+#else
+		const std::string &query(NetMauMau::Common::Protocol::V15::QUERY);
+#endif
+
+		send(query.c_str(), query.length(), getSocketFD());
+
+		const std::string &ack(read(getSocketFD()));
+
+		// older servers take it for a malformed play request and refuse it
+		_pimpl->m_querySession = ack == NetMauMau::Common::Protocol::V15::QUERY;
+
+#ifdef HAVE_ZLIB_H
+
+		// the server agreed to deflate its larger responses
+		if(!_pimpl->m_querySession && ack == query) {
+
+			_pimpl->m_querySession = true;
+
+			if(!_pimpl->startInflating()) closeQuerySession();
+		}
+
+#endif
+	}
+
+	return _pimpl->m_querySession;
+}
+
+void Connection::closeQuerySession() {
+
+	if(_pimpl->m_querySession) {
+		_pimpl->m_querySession = false;
+#ifdef HAVE_ZLIB_H
+		_pimpl->stopInflating();
+#endif
+		shutdown(getSocketFD());
+	}
+}
+
+bool Connection::requestPicture(const std::string &player, const std::string &ref,
+								std::vector<unsigned char> &png)
+throw(NetMauMau::Common::Exception::SocketException) {
+	return _pimpl->requestPicture(player, ref, png);
+}
+
+SOCKET Connection::getPictureSocketFD() const {
+	return _pimpl->m_pictures && !_pimpl->m_pictureRequests.empty() ?
+		   _pimpl->m_pictures->getSocketFD() : INVALID_SOCKET;
+}
+
+void Connection::receivePictures() {
+	_pimpl->receivePictures();
+}
+
+bool Connection::nextPicture(std::string &player, std::vector<unsigned char> &png) {
+	return _pimpl->nextPicture(player, png);
+}
+
+void Connection::closePictures() {
+	_pimpl->closePictures();
+}
+
+std::vector<unsigned char> Connection::fetchPicture(const std::string &hash)
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	TCPOPT_CORK(_pimpl->m_querySession ? INVALID_SOCKET : getSocketFD());
+
+	if(_pimpl->hello()) {
+
+		const std::string req(std::string(NetMauMau::Common::Protocol::V15::PICTURE).
+							  append(1, ' ').append(hash));
+
+		_pimpl->sendQuery(req.c_str(), req.length());
+
+		std::string pic;
+		*this >> pic;
+
+		return pic != "-" ? NetMauMau::Common::base64_decode(pic) : std::vector<unsigned char>();
+	}
+
+	throw Exception::PlayerlistException("Unable to get player picture", getSocketFD());
+}
+
 #pragma GCC diagnostic ignored "-Wold-style-cast"
 #pragma GCC diagnostic push
 bool Connection::wire(SOCKET sockfd, const struct sockaddr *addr, socklen_t addrlen) const {
@@ -458,25 +581,31 @@ std::string Connection::wireError(const std::string &err) const {
 Connection &Connection::operator>>(std::string &msg)
 throw(NetMauMau::Common::Exception::SocketException) {
 
-	std::string str;
-	char  buf[1024] = { 0 };
+	bool complete;
+
+	while(!(complete = _pimpl->nextMessage(msg))) {
 
-	ConnectionImpl::BUFFER::iterator f;
+		// the rest of the message has to wait for the next call to receiveAvailable()
+		if(_pimpl->m_nonBlocking) {
 
-	while(_pimpl->m_buf.empty() || (!_pimpl->m_buf.empty() && (f = std::find(_pimpl->m_buf.begin(),
-									_pimpl->m_buf.end(), '\0')) == _pimpl->m_buf.end())) {
-		std::size_t l;
+			if(_pimpl->m_eof) break;
 
-		if((l = recv(buf, 1024, getSocketFD())) > 0) {
-			_pimpl->m_buf.insert(_pimpl->m_buf.end(), buf, buf + l);
+			throw Exception::IncompleteMessageException(getSocketFD());
 		}
-	}
 
-	str.insert(str.begin(), _pimpl->m_buf.begin(), f);
+		std::size_t cap;
+		char *buf = _pimpl->receiveBuffer(RECVSIZE, cap);
+		const std::size_t l = recv(buf, cap, getSocketFD());
 
-	_pimpl->m_buf.erase(_pimpl->m_buf.begin(), f + 1);
+		if(l) {
+			_pimpl->received(l);
+		} else if(peerClosed(getSocketFD())) {
+			_pimpl->m_eof = true;
+			break;
+		}
+	}
 
-	str.swap(msg);
+	if(!complete) msg.clear();
 
 	if(msg.empty()) {
 		throw Exception::InterceptedErrorException("Lost connection to server", getSocketFD());
@@ -491,9 +620,62 @@ throw(NetMauMau::Common::Exception::SocketException) {
 	return *this;
 }
 
+void Connection::setNonBlocking(bool nonBlocking) {
+	_pimpl->m_nonBlocking = nonBlocking;
+	_pimpl->m_eof = false;
+}
+
+void Connection::receiveAvailable() throw(NetMauMau::Common::Exception::SocketException) {
+
+	while(!_pimpl->m_eof) {
+
+		std::size_t cap;
+		char *buf = _pimpl->receiveBuffer(RECVSIZE, cap);
+		const ssize_t l = TEMP_FAILURE_RETRY(::recv(getSocketFD(), buf, cap, MSG_DONTWAIT));
+
+		if(l < 0) {
+
+			if(errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+			throw NetMauMau::Common::Exception::SocketException(NetMauMau::Common::errorString(),
+					getSocketFD(), errno);
+		}
+
+		if(!l) {
+			_pimpl->m_eof = true;
+		} else {
+
+			_pimpl->received(static_cast<std::size_t>(l));
+
+			// without MSG_DONTWAIT only a single read is guaranteed not to block
+			if(!MSG_DONTWAIT || static_cast<std::size_t>(l) < cap) break;
+		}
+	}
+}
+
+void Connection::markMessage() {
+	_pimpl->m_mark = _pimpl->m_buf.mark();
+}
+
+void Connection::rewindMessage() {
+	_pimpl->m_buf.rewind(_pimpl->m_mark);
+}
+
 Connection &Connection::operator<<(const std::string &msg)
 throw(NetMauMau::Common::Exception::SocketException) {
-	send(msg.c_str(), msg.length(), getSocketFD());
+
+	if(_pimpl->m_binary) {
+
+		// the server reads a reply as one frame as well
+		std::string frame;
+
+		NetMauMau::Common::WireCodec::encode(frame, msg.data(), msg.length());
+		send(frame.data(), frame.length(), getSocketFD());
+
+	} else {
+		send(msg.c_str(), msg.length(), getSocketFD());
+	}
+
 	return *this;
 }
 
@@ -30,26 +30,50 @@
 #include <sys/time.h>                   // for timeval
 #include <cerrno>                       // for errno, EINTR
 
+#include "base64.h"                     // for base64_decode
 #include "select.h"
 #include "logger.h"
 #include "errorstring.h"                // for errorString
 #include "timeoutexception.h"           // for TimeoutException
+#include "protocolerrorexception.h"     // for ProtocolErrorException
+#include "incompletemessageexception.h" // for IncompleteMessageException
+#include "protocol.h"                   // for PICTURE
+#include "wirecodec.h"                  // for WireCodec
 
 #ifndef TEMP_FAILURE_RETRY
 #define TEMP_FAILURE_RETRY
 #endif
 
+namespace {
+// fetching a picture must not block forever, even if the connection itself has no timeout
+const time_t PICTURE_FETCH_TIMEOUT = 10;
+}
+
 using namespace NetMauMau::Client;
 
 ConnectionImpl::ConnectionImpl(Connection *piface, const std::string &pName,
-							   const timeval *timeout, uint32_t clientVersion) : _piface(piface),
-	m_pName(pName), m_timeout(timeout), m_clientVersion(clientVersion), m_buf() {}
+							   const std::string &server, uint16_t port, const timeval *timeout,
+							   uint32_t clientVersion) : _piface(piface), m_pName(pName),
+	m_server(server), m_port(port), m_timeout(timeout), m_clientVersion(clientVersion), m_buf(),
+	m_mark(), m_nonBlocking(false), m_eof(false), m_querySession(false),
+	m_binary(false),
+#ifdef HAVE_ZLIB_H
+	m_inflater(0L), m_sections(),
+#endif
+	m_pictureCache(), m_pictures(0L), m_pictureTimeout(), m_pictureRequests() {}
 
 #ifndef __clang__
 #pragma GCC diagnostic ignored "-Wunsafe-loop-optimizations"
 #pragma GCC diagnostic push
 #endif
-ConnectionImpl::~ConnectionImpl() {}
+ConnectionImpl::~ConnectionImpl() {
+
+	closePictures();
+
+#ifdef HAVE_ZLIB_H
+	delete m_inflater;
+#endif
+}
 #ifndef __clang__
 #pragma GCC diagnostic pop
 #endif
@@ -60,6 +84,16 @@ ConnectionImpl::~ConnectionImpl() {}
 bool ConnectionImpl::hello(uint16_t *maj, uint16_t *min)
 throw(NetMauMau::Common::Exception::SocketException) {
 
+	if(m_querySession) {
+
+		if(isQuerySessionAlive()) return true;
+
+		// the server went away in between, try to start over with a new session
+		_piface->closeQuerySession();
+
+		if(_piface->openQuerySession()) return true;
+	}
+
 	_piface->NetMauMau::Common::AbstractConnection::connect();
 
 	fd_set rfds;
@@ -101,4 +135,288 @@ retry:
 }
 #pragma GCC diagnostic pop
 
+void ConnectionImpl::sendQuery(const char *query, std::size_t len) const
+throw(NetMauMau::Common::Exception::SocketException) {
+	// within a session the server reads the terminating NUL as the end of the query
+	_piface->send(query, m_querySession ? len + 1u : len, _piface->getSocketFD());
+}
+
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#pragma GCC diagnostic push
+bool ConnectionImpl::isQuerySessionAlive() const {
+
+	fd_set rfds;
+	struct timeval tv = { 0, 0 };
+
+	FD_ZERO(&rfds);
+	FD_SET(_piface->getSocketFD(), &rfds);
+
+	const int r = NetMauMau::Common::Select::getInstance()->perform(_piface->getSocketFD() + 1,
+				  &rfds, NULL, NULL, &tv);
+
+	if(!r) return true;
+
+	// readable without a pending query, but nothing to read means the server closed it
+	char c;
+
+	return r > 0 && ::recv(_piface->getSocketFD(), &c, 1, MSG_PEEK) > 0;
+}
+#pragma GCC diagnostic pop
+
+bool ConnectionImpl::nextMessage(std::string &msg)
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	if(!m_binary) {
+
+		const char *frame = 0L;
+		std::size_t flen = 0u;
+
+		if(!m_buf.nextFrame(frame, flen)) return false;
+
+		msg.assign(frame, flen);
+
+		return true;
+	}
+
+	if(m_buf.empty()) return false;
+
+	const std::size_t n = NetMauMau::Common::WireCodec::decode(m_buf.front(), m_buf.size(), msg);
+
+	if(n == NetMauMau::Common::WireCodec::MALFORMED) {
+		throw Exception::ProtocolErrorException("Malformed frame", _piface->getSocketFD());
+	}
+
+	m_buf.consume(n);
+
+	return n != 0u;
+}
+
+char *ConnectionImpl::receiveBuffer(std::size_t n, std::size_t &cap) {
+
+#ifdef HAVE_ZLIB_H
+	NetMauMau::Common::FrameBuffer &buf(m_inflater ? m_sections : m_buf);
+#else
+	NetMauMau::Common::FrameBuffer &buf(m_buf);
+#endif
+
+	char *b = buf.prepare(n);
+
+	cap = buf.capacity();
+
+	return b;
+}
+
+void ConnectionImpl::received(std::size_t n) throw(NetMauMau::Common::Exception::SocketException) {
+
+#ifdef HAVE_ZLIB_H
+
+	if(m_inflater) {
+
+		m_sections.commit(n);
+
+		if(!m_inflater->inflate(m_sections, m_buf)) {
+			throw Exception::ProtocolErrorException("Corrupted compressed response",
+													_piface->getSocketFD());
+		}
+
+		return;
+	}
+
+#endif
+
+	m_buf.commit(n);
+}
+
+#ifdef HAVE_ZLIB_H
+bool ConnectionImpl::startInflating() throw() {
+
+	stopInflating();
+
+	try {
+		m_inflater = new NetMauMau::Common::ZSectionInflater();
+	} catch(const NetMauMau::Common::Exception::ZLibException &e) {
+		logDebug(__PRETTY_FUNCTION__ << ": " << e.what());
+	} catch(const std::bad_alloc &) {}
+
+	return m_inflater != 0L;
+}
+
+void ConnectionImpl::stopInflating() throw() {
+	delete m_inflater;
+	m_inflater = 0L;
+	m_sections.clear();
+}
+#endif
+
+Connection *ConnectionImpl::pictureConnection(bool nonBlocking)
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	if(!m_pictures) {
+
+		m_pictureTimeout.tv_sec = PICTURE_FETCH_TIMEOUT;
+		m_pictureTimeout.tv_usec = 0;
+
+		if(m_timeout) m_pictureTimeout = *m_timeout;
+
+		m_pictures = new Connection(m_pName, m_server, m_port);
+		m_pictures->setTimeout(&m_pictureTimeout);
+
+		bool session = false;
+
+		try {
+			session = m_pictures->openQuerySession();
+		} catch(const NetMauMau::Common::Exception::SocketException &) {
+			closePictures();
+			throw;
+		}
+
+		// without a session every picture needs a connection of its own
+		if(!session) {
+			closePictures();
+			return 0L;
+		}
+	}
+
+	m_pictures->setNonBlocking(nonBlocking);
+
+	return m_pictures;
+}
+
+PictureCache::PNGDATA ConnectionImpl::getPicture(const std::string &ref)
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	PictureCache::PNGDATA png;
+
+	if(ref.empty() || ref == "-") return png;
+
+	if(!PictureCache::isHashRef(ref)) {
+		NetMauMau::Common::base64_decode(ref).swap(png);
+		return png;
+	}
+
+	const std::string hash(ref.substr(1));
+
+	if(!m_pictureCache.get(hash, png)) {
+
+		try {
+
+			Connection *con = pictureConnection(false);
+
+			if(con) {
+				con->fetchPicture(hash).swap(png);
+			} else {
+
+				Connection tmp(m_pName, m_server, m_port);
+				tmp.setTimeout(&m_pictureTimeout);
+
+				tmp.fetchPicture(hash).swap(png);
+			}
+
+		} catch(const NetMauMau::Common::Exception::SocketException &e) {
+			logDebug("Client library: " << __PRETTY_FUNCTION__ << ": " << e.what());
+			closePictures();
+		}
+
+		if(!m_pictureCache.put(hash, png)) PictureCache::PNGDATA().swap(png);
+	}
+
+	return png;
+}
+
+bool ConnectionImpl::requestPicture(const std::string &tag, const std::string &ref,
+									PictureCache::PNGDATA &png)
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	// only a non-blocking game gets its pictures delivered later on
+	if(!m_nonBlocking || !PictureCache::isHashRef(ref)) {
+		getPicture(ref).swap(png);
+		return true;
+	}
+
+	const std::string hash(ref.substr(1));
+
+	if(m_pictureCache.get(hash, png)) return true;
+
+	try {
+
+		Connection *con = pictureConnection(true);
+
+		// a server without a free session gets the player without a picture
+		if(!con) return true;
+
+		const std::string req(std::string(NetMauMau::Common::Protocol::V15::PICTURE).
+							  append(1, ' ').append(hash));
+
+		con->_pimpl->sendQuery(req.c_str(), req.length());
+
+	} catch(const NetMauMau::Common::Exception::SocketException &e) {
+		logDebug("Client library: " << __PRETTY_FUNCTION__ << ": " << e.what());
+		closePictures();
+		return true;
+	}
+
+	m_pictureRequests.push_back(std::make_pair(tag, hash));
+
+	return false;
+}
+
+void ConnectionImpl::receivePictures() throw() {
+
+	if(!m_pictures) return;
+
+	try {
+		m_pictures->receiveAvailable();
+	} catch(const NetMauMau::Common::Exception::SocketException &e) {
+		logDebug("Client library: " << __PRETTY_FUNCTION__ << ": " << e.what());
+		closePictures();
+	}
+}
+
+bool ConnectionImpl::nextPicture(std::string &tag, PictureCache::PNGDATA &png) throw() {
+
+	if(m_pictureRequests.empty()) return false;
+
+	std::string pic;
+
+	// once the session is gone the pending requests are answered with no picture at all
+	if(m_pictures) {
+
+		m_pictures->markMessage();
+
+		try {
+			*m_pictures >> pic;
+		} catch(const Exception::IncompleteMessageException &) {
+			m_pictures->rewindMessage();
+			return false;
+		} catch(const NetMauMau::Common::Exception::SocketException &e) {
+			logDebug("Client library: " << __PRETTY_FUNCTION__ << ": " << e.what());
+			closePictures();
+			pic.clear();
+		}
+	}
+
+	tag.swap(m_pictureRequests.front().first);
+
+	if(!pic.empty() && pic != "-") {
+		NetMauMau::Common::base64_decode(pic).swap(png);
+	} else {
+		png.clear();
+	}
+
+	if(!m_pictureCache.put(m_pictureRequests.front().second, png)) png.clear();
+
+	m_pictureRequests.pop_front();
+
+	return true;
+}
+
+void ConnectionImpl::closePictures() throw() {
+
+	if(m_pictures) {
+		m_pictures->closeQuerySession();
+		delete m_pictures;
+		m_pictures = 0L;
+	}
+}
+
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
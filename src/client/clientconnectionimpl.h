@@ -20,9 +20,16 @@
 #ifndef NETMAUMAU_CLIENTCONNECTIONIMPL_H
 #define NETMAUMAU_CLIENTCONNECTIONIMPL_H
 
-#include <deque>
+#include <sys/time.h>                   // for timeval
+#include <deque>                        // for deque
 
 #include "clientconnection.h"           // for Connection, etc
+#include "framebuffer.h"                // for FrameBuffer
+#include "picturecache.h"               // for PictureCache
+
+#ifdef HAVE_ZLIB_H
+#include "zsection.h"                   // for ZSectionInflater
+#endif
 
 namespace NetMauMau {
 
@@ -31,20 +38,59 @@ namespace Client {
 class ConnectionImpl {
 	DISALLOW_COPY_AND_ASSIGN(ConnectionImpl)
 public:
-	explicit ConnectionImpl(Connection *piface, const std::string &pName, const timeval *timeout,
+	explicit ConnectionImpl(Connection *piface, const std::string &pName,
+							const std::string &server, uint16_t port, const timeval *timeout,
 							uint32_t clientVersion);
 	~ConnectionImpl();
 
 	bool hello(uint16_t *maj = 0L, uint16_t *min = 0L) throw(Common::Exception::SocketException);
+	void sendQuery(const char *query, std::size_t len) const
+	throw(Common::Exception::SocketException);
+	bool isQuerySessionAlive() const;
+	bool nextMessage(std::string &msg) throw(Common::Exception::SocketException);
+
+	char *receiveBuffer(std::size_t n, std::size_t &cap);
+	void received(std::size_t n) throw(Common::Exception::SocketException);
+
+#ifdef HAVE_ZLIB_H
+	bool startInflating() throw();
+	void stopInflating() throw();
+#endif
+
+	PictureCache::PNGDATA getPicture(const std::string &ref)
+	throw(Common::Exception::SocketException);
+
+	bool requestPicture(const std::string &tag, const std::string &ref,
+						PictureCache::PNGDATA &png) throw(Common::Exception::SocketException);
+	void receivePictures() throw();
+	bool nextPicture(std::string &tag, PictureCache::PNGDATA &png) throw();
+	void closePictures() throw();
+
+private:
+	Connection *pictureConnection(bool nonBlocking) throw(Common::Exception::SocketException);
 
 public:
-	typedef std::deque<std::string::traits_type::char_type> BUFFER;
 	Connection *const _piface;
 
 	std::string m_pName;
+	const std::string m_server;
+	const uint16_t m_port;
 	const timeval *m_timeout;
 	uint32_t m_clientVersion;
-	BUFFER m_buf;
+	Common::FrameBuffer m_buf;
+	Common::FrameBuffer::MARK m_mark;
+	bool m_nonBlocking;
+	bool m_eof;
+	bool m_querySession;
+	bool m_binary;
+#ifdef HAVE_ZLIB_H
+	Common::ZSectionInflater *m_inflater;
+	Common::FrameBuffer m_sections;
+#endif
+	const PictureCache m_pictureCache;
+	Connection *m_pictures;
+	timeval m_pictureTimeout;
+	std::deque<std::pair<std::string, std::string> > m_pictureRequests;
 };
 
 }
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2014-2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"                     // for PACKAGE
+#endif
+
+#include "picturecache.h"
+
+#include <cstdio>                       // for fopen, fread, fwrite, rename
+#include <cstdlib>                      // for getenv
+
+#if !defined(_WIN32) && (defined(HAVE_SYS_STAT_H) && defined(HAVE_SYS_TYPES_H))
+#include <sys/stat.h>                   // for mkdir
+#include <sys/types.h>
+#include <unistd.h>                     // for getpid
+#define NMM_PICTURE_DISK_CACHE 1
+#endif
+
+#include "sha1.h"                       // for sha1_hex
+
+namespace {
+
+std::string cacheDir() {
+
+#ifdef NMM_PICTURE_DISK_CACHE
+
+	const char *xdg = std::getenv("XDG_CACHE_HOME");
+	const char *home = std::getenv("HOME");
+
+	std::string dir;
+
+	if(xdg && *xdg) {
+		dir = xdg;
+	} else if(home && *home) {
+		dir = std::string(home).append("/.cache");
+	} else {
+		return dir;
+	}
+
+	mkdir(dir.c_str(), 0700);
+	mkdir(dir.append("/" PACKAGE).c_str(), 0700);
+
+	struct stat s;
+
+	if(mkdir(dir.append("/pictures").c_str(), 0700) && (stat(dir.c_str(), &s) ||
+			!S_ISDIR(s.st_mode))) {
+		return std::string();
+	}
+
+	return dir.append(1, '/');
+#else
+	return std::string();
+#endif
+}
+
+}
+
+using namespace NetMauMau::Client;
+
+PictureCache::PictureCache() : m_dir(cacheDir()) {}
+
+PictureCache::~PictureCache() {}
+
+bool PictureCache::isHashRef(const std::string &ref) {
+
+	if(ref.length() != 41u || ref[0] != '#') return false;
+
+	// it becomes a file name, so nothing but lower case hex digits are allowed
+	for(std::string::size_type i = 1u; i < 41u; ++i) {
+		if(!((ref[i] >= '0' && ref[i] <= '9') || (ref[i] >= 'a' && ref[i] <= 'f'))) return false;
+	}
+
+	return true;
+}
+
+bool PictureCache::get(const std::string &hash, PNGDATA &png) const {
+
+	if(m_dir.empty()) return false;
+
+	FILE *in = std::fopen((m_dir + hash + ".png").c_str(), "rb");
+
+	if(!in) return false;
+
+	PNGDATA data;
+	unsigned char buf[4096];
+	std::size_t r;
+
+	while((r = std::fread(buf, 1u, sizeof(buf), in))) data.insert(data.end(), buf, buf + r);
+
+	const bool ok = !std::ferror(in) && !data.empty() &&
+					NetMauMau::Common::sha1_hex(&data.front(), data.size()) == hash;
+
+	std::fclose(in);
+
+	if(ok) png.swap(data);
+
+	return ok;
+}
+
+bool PictureCache::put(const std::string &hash, const PNGDATA &png) const {
+
+	if(png.empty() || NetMauMau::Common::sha1_hex(&png.front(), png.size()) != hash) return false;
+
+#ifdef NMM_PICTURE_DISK_CACHE
+
+	if(m_dir.empty()) return true;
+
+	char pid[24];
+	std::snprintf(pid, sizeof(pid), ".%ld", static_cast<long>(getpid()));
+
+	// concurrent clients must never see a partially written picture
+	const std::string tmp(m_dir + hash + pid);
+
+	FILE *out = std::fopen(tmp.c_str(), "wb");
+
+	if(out) {
+
+		const bool ok = std::fwrite(&png.front(), 1u, png.size(), out) == png.size();
+
+		if(!std::fclose(out) && ok) {
+			std::rename(tmp.c_str(), (m_dir + hash + ".png").c_str());
+		} else {
+			std::remove(tmp.c_str());
+		}
+	}
+
+#endif
+
+	return true;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
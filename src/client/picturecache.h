@@ -0,0 +1,71 @@
+/*
+ * Copyright 2014-2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_CLIENT_PICTURECACHE_H
+#define NETMAUMAU_CLIENT_PICTURECACHE_H
+
+#include <string>
+#include <vector>
+
+#include "linkercontrol.h"
+
+namespace NetMauMau {
+
+namespace Client {
+
+/**
+ * @brief On disk cache of player pictures addressed by their SHA-1
+ *
+ * The pictures are kept below @c $XDG_CACHE_HOME/netmaumau/pictures (or @c ~/.cache if
+ * @c XDG_CACHE_HOME is unset). Without a usable cache directory every lookup fails and
+ * storing is a no-op.
+ */
+class _LOCAL PictureCache {
+	DISALLOW_COPY_AND_ASSIGN(PictureCache)
+public:
+	typedef std::vector<unsigned char> PNGDATA;
+
+	explicit PictureCache();
+	~PictureCache();
+
+	/**
+	 * @brief Checks if @c ref refers to a picture by its hash, i.e. is @c # and a SHA-1
+	 */
+	static bool isHashRef(const std::string &ref) _PURE;
+
+	bool get(const std::string &hash, PNGDATA &png) const;
+
+	/**
+	 * @brief Stores @c png if it matches @c hash
+	 *
+	 * @return @c false if the data doesn't match the hash
+	 */
+	bool put(const std::string &hash, const PNGDATA &png) const;
+
+private:
+	const std::string m_dir;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_CLIENT_PICTURECACHE_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
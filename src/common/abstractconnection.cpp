@@ -58,11 +58,15 @@ IConnection::_info::_info() : sockfd(INVALID_SOCKET), name(), host(), port(0), m
 IConnection::_info::~_info() {}
 
 IConnection::_nameSockFD::_nameSockFD(const std::string &n, const std::string &pp, SOCKET sfd,
-									  uint32_t cv) : name(n), playerPic(pp), sockfd(sfd),
-	clientVersion(cv) {}
+									  uint32_t cv) : name(n), sockfd(sfd), clientVersion(cv),
+	picture(pp), pictureHashes(false), binaryFrames(false) {}
 
-IConnection::_nameSockFD::_nameSockFD() : name(), playerPic(), sockfd(INVALID_SOCKET),
-	clientVersion(0) {}
+IConnection::_nameSockFD::_nameSockFD(const std::string &n, const PlayerPicture &pp, SOCKET sfd,
+									  uint32_t cv, bool ph, bool bf) : name(n), sockfd(sfd),
+	clientVersion(cv), picture(pp), pictureHashes(ph), binaryFrames(bf) {}
+
+IConnection::_nameSockFD::_nameSockFD() : name(), sockfd(INVALID_SOCKET),
+	clientVersion(0), picture(), pictureHashes(false), binaryFrames(false) {}
 
 IConnection::_nameSockFD::~_nameSockFD() {}
 
@@ -126,12 +130,19 @@ void AbstractConnection::wait(long ms) throw(Exception::SocketException) {
 		FD_ZERO(&rfds);
 		FD_SET(getSocketFD(), &rfds);
 
+		const SOCKET ifd = addInterceptFDs(rfds);
+
 		if((sret = TEMP_FAILURE_RETRY(NetMauMau::Common::Select::getInstance()->
-									  perform(getSocketFD() + 1, &rfds, NULL, NULL, &tv))) < 0) {
+									  perform(std::max(getSocketFD(), ifd) + 1, &rfds, NULL, NULL,
+											  &tv))) < 0) {
 			throw Exception::SocketException(NetMauMau::Common::errorString(), getSocketFD(),
 											 errno);
 		} else if(sret > 0) {
-			intercept();
+
+			if(ifd) interceptFDs(rfds);
+
+			if(FD_ISSET(getSocketFD(), &rfds)) intercept();
+
 #if _POSIX_C_SOURCE >= 200112L && defined(__linux)
 
 			if(!(ms = tv.tv_sec * 0xF4240L + tv.tv_usec)) sret = 0;
@@ -253,8 +253,13 @@ again:
 	FD_SET(fd, &rfds);
 	FD_SET(getSocketFD(), &rfds);
 
-	if(!m_interrupt && (sret = NetMauMau::Common::Select::getInstance()->perform(std::max(fd,
-							   getSocketFD()) + 1, &rfds, NULL, NULL, NULL)) > 0) {
+	const SOCKET ifd = addInterceptFDs(rfds);
+	const SOCKET mfd = std::max(std::max(fd, getSocketFD()), ifd);
+
+	if(!m_interrupt && (sret = NetMauMau::Common::Select::getInstance()->perform(mfd + 1, &rfds,
+							   NULL, NULL, NULL)) > 0) {
+
+		if(ifd) interceptFDs(rfds);
 
 		if(FD_ISSET(getSocketFD(), &rfds)) {
 
@@ -262,6 +267,8 @@ again:
 
 			if(!FD_ISSET(fd, &rfds)) goto again;
 
+		} else if(!FD_ISSET(fd, &rfds)) {
+			goto again;
 		}
 
 		unsigned char *ptr = static_cast<unsigned char *>(buf);
@@ -445,6 +452,12 @@ void AbstractSocket::write(SOCKET fd, const std::string &msg) throw(Exception::S
 
 void AbstractSocket::intercept() {}
 
+SOCKET AbstractSocket::addInterceptFDs(fd_set &) const {
+	return 0;
+}
+
+void AbstractSocket::interceptFDs(const fd_set &) throw(Exception::SocketException) {}
+
 void AbstractSocket::setInterrupted(bool b) {
 	m_interrupt = b;
 }
@@ -26,7 +26,7 @@
 
 #include <cmath>
 #include <cstdio>                       // for snprintf, NULL
-#include <map>                          // for map<>::value_type, map, etc
+#include <cstring>                      // for memcmp
 #include <smartptr.h>
 
 namespace {
@@ -94,16 +94,77 @@ public:
 
 } ILLEGAL_CARD;
 
-const
-std::map<const std::string, NetMauMau::Common::ICard::SUIT>::value_type SSP[] _INIT_PRIO(102) = {
-	std::make_pair(SUIT[2], NetMauMau::Common::ICard::SPADES),
-	std::make_pair(SUIT[3], NetMauMau::Common::ICard::CLUBS),
-	std::make_pair(SUIT[1], NetMauMau::Common::ICard::HEARTS),
-	std::make_pair(SUIT[0], NetMauMau::Common::ICard::DIAMONDS),
-	std::make_pair("X", NetMauMau::Common::ICard::SUIT_ILLEGAL)
+std::string buildCardDesc(NetMauMau::Common::ICard::SUIT s, NetMauMau::Common::ICard::RANK r,
+						  bool ansi) {
+
+	std::string d(NetMauMau::Common::suitToSymbol(s, ansi));
+
+	d.reserve(d.size() + 4u + (ansi ? ANSI_DFT.size() : 0u));
+
+	d.append(1, ' ');
+
+	switch(r) {
+	case NetMauMau::Common::ICard::JACK:
+		d.append(1, 'J');
+		break;
+
+	case NetMauMau::Common::ICard::QUEEN:
+		d.append(1, 'Q');
+		break;
+
+	case NetMauMau::Common::ICard::KING:
+		d.append(1, 'K');
+		break;
+
+	case NetMauMau::Common::ICard::ACE:
+		d.append(1, 'A');
+		break;
+
+	case NetMauMau::Common::ICard::SEVEN:
+	case NetMauMau::Common::ICard::EIGHT:
+	case NetMauMau::Common::ICard::NINE:
+	case NetMauMau::Common::ICard::TEN:
+	default:
+		char n[256];
+		std::snprintf(n, 255, "%u", static_cast<unsigned int>(r));
+		d.append(n);
+		break;
+	}
+
+#ifndef DISABLE_ANSI
+
+	if(ansi) d.append(ANSI_DFT);
+
+#endif
+
+	std::string(d.begin(), d.end()).swap(d);
+
+	return d;
+}
+
+// the wire descriptions of all cards, indexed by getCardIndex
+template<bool Ansi>
+class CardDescTable {
+	DISALLOW_COPY_AND_ASSIGN(CardDescTable)
+public:
+	CardDescTable() {
+		for(std::size_t i = 0u; i < NetMauMau::Common::CARD_INDEX_ILLEGAL; ++i) {
+			m_desc[i] = buildCardDesc(static_cast<NetMauMau::Common::ICard::SUIT>(i >> 3u),
+									  static_cast<NetMauMau::Common::ICard::RANK>
+									  (NetMauMau::Common::ICard::SEVEN + (i & 7u)), Ansi);
+		}
+	}
+
+	inline const std::string &operator[](std::size_t i) const {
+		return m_desc[i];
+	}
+
+private:
+	std::string m_desc[NetMauMau::Common::CARD_INDEX_ILLEGAL];
 };
 
-const std::map<const std::string, NetMauMau::Common::ICard::SUIT> suitToSymbolMap(SSP, SSP + 5);
+const CardDescTable<false> CARDDESC _INIT_PRIO(102);
+const CardDescTable<true> CARDDESCANSI _INIT_PRIO(102);
 
 }
 
@@ -169,9 +230,12 @@ std::string NetMauMau::Common::suitToSymbol(ICard::SUIT suit, bool ansi, bool en
 }
 
 NetMauMau::Common::ICard::SUIT NetMauMau::Common::symbolToSuit(const std::string &sym) {
-	const std::map<const std::string, NetMauMau::Common::ICard::SUIT>::const_iterator
-	&f(suitToSymbolMap.find(sym));
-	return f != suitToSymbolMap.end() ? f->second : ICard::HEARTS;
+
+	for(std::size_t i = 0u; i < 4u; ++i) {
+		if(sym == SUIT[i]) return static_cast<ICard::SUIT>(i);
+	}
+
+	return sym == "X" ? ICard::SUIT_ILLEGAL : ICard::HEARTS;
 }
 
 std::size_t NetMauMau::Common::getCardPoints(ICard::RANK v) {
@@ -308,8 +372,87 @@ NetMauMau::Common::ICard *NetMauMau::Common::getIllegalCard() {
 	return &ILLEGAL_CARD;
 }
 
+std::size_t NetMauMau::Common::getCardIndex(ICard::SUIT suit, ICard::RANK rank) {
+
+	if(static_cast<unsigned int>(suit) > ICard::CLUBS || rank < ICard::SEVEN || rank > ICard::ACE) {
+		return CARD_INDEX_ILLEGAL;
+	}
+
+	return (static_cast<std::size_t>(suit) << 3u) + static_cast<std::size_t>(rank - ICard::SEVEN);
+}
+
+void NetMauMau::Common::getCardFromIndex(std::size_t idx, ICard::SUIT *suit, ICard::RANK *rank) {
+	*suit = static_cast<ICard::SUIT>(idx >> 3u);
+	*rank = static_cast<ICard::RANK>(ICard::SEVEN + (idx & 7u));
+}
+
+std::size_t NetMauMau::Common::parseCardIndex(const char *desc, std::size_t len) {
+
+	for(std::size_t s = 0u; s < 4u; ++s) {
+
+		const std::string::size_type sl = SUIT[s].size();
+
+		if(len > sl + 1u && desc[sl] == ' ' && !std::memcmp(desc, SUIT[s].data(), sl)) {
+
+			const char *r = desc + sl + 1u;
+			std::size_t ri;
+
+			if(len == sl + 2u) {
+
+				switch(*r) {
+				case '7':
+				case '8':
+				case '9':
+					ri = static_cast<std::size_t>(*r - '7');
+					break;
+
+				case 'J':
+					ri = 4u;
+					break;
+
+				case 'Q':
+					ri = 5u;
+					break;
+
+				case 'K':
+					ri = 6u;
+					break;
+
+				case 'A':
+					ri = 7u;
+					break;
+
+				default:
+					return CARD_INDEX_ILLEGAL;
+				}
+
+			} else if(len == sl + 3u && r[0] == '1' && r[1] == '0') {
+				ri = 3u;
+			} else {
+				return CARD_INDEX_ILLEGAL;
+			}
+
+			return (s << 3u) + ri;
+		}
+	}
+
+	return CARD_INDEX_ILLEGAL;
+}
+
+const std::string &NetMauMau::Common::getCardDesc(std::size_t idx, bool ansi) {
+	return ansi ? CARDDESCANSI[idx] : CARDDESC[idx];
+}
+
 bool NetMauMau::Common::parseCardDesc(const std::string &desc, ICard::SUIT *suit,
 									  ICard::RANK *rank) {
+
+	const std::size_t idx = parseCardIndex(desc.data(), desc.size());
+
+	if(idx != CARD_INDEX_ILLEGAL) {
+		getCardFromIndex(idx, suit, rank);
+		return true;
+	}
+
 	if(desc != IC) {
 
 		const std::string::size_type p = desc.find(' ');
@@ -355,50 +498,9 @@ bool NetMauMau::Common::parseCardDesc(const std::string &desc, ICard::SUIT *suit
 
 std::string NetMauMau::Common::createCardDesc(ICard::SUIT s, ICard::RANK r, bool ansi) {
 
-	std::string d(suitToSymbol(s, ansi));
-
-	d.reserve(d.size() + 4u + (ansi ? ANSI_DFT.size() : 0u));
-
-	d.append(1, ' ');
-
-	switch(r) {
-	case ICard::JACK:
-		d.append(1, 'J');
-		break;
-
-	case ICard::QUEEN:
-		d.append(1, 'Q');
-		break;
-
-	case ICard::KING:
-		d.append(1, 'K');
-		break;
-
-	case ICard::ACE:
-		d.append(1, 'A');
-		break;
-
-	case ICard::SEVEN:
-	case ICard::EIGHT:
-	case ICard::NINE:
-	case ICard::TEN:
-	default:
-		char n[256];
-		std::snprintf(n, 255, "%u", static_cast<unsigned int>(r));
-		d.append(n);
-		break;
-	}
-
-#ifndef DISABLE_ANSI
-
-	if(ansi) d.append(ANSI_DFT);
-
-#endif
-
-	std::string(d.begin(), d.end()).swap(d);
-
-	return d;
+	const std::size_t idx = getCardIndex(s, r);
 
+	return idx != CARD_INDEX_ILLEGAL ? getCardDesc(idx, ansi) : buildCardDesc(s, r, ansi);
 }
 
 std::string NetMauMau::Common::ansiSuit(const std::string &suit) {
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2014-2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_COMMON_FRAMEBUFFER_H
+#define NETMAUMAU_COMMON_FRAMEBUFFER_H
+
+#include <algorithm>                    // for max
+#include <cstddef>                      // for size_t
+#include <cstring>                      // for memchr, memmove
+#include <utility>                      // for pair
+#include <vector>
+
+#include "linkercontrol.h"
+
+namespace NetMauMau {
+
+namespace Common {
+
+/**
+ * @brief Receive buffer splitting a byte stream into @c NUL terminated frames
+ *
+ * Received data is appended behind the unread bytes and frames are handed out in place. The
+ * search for the terminator resumes where the previous one stopped, so every byte is scanned
+ * only once. Unread bytes are moved to the front only if the free space at the end doesn't
+ * suffice, which makes reading a message linear in its size.
+ */
+class FrameBuffer {
+	DISALLOW_COPY_AND_ASSIGN(FrameBuffer)
+public:
+	/**
+	 * @brief Position to return to with rewind()
+	 */
+	typedef std::pair<std::size_t, std::size_t> MARK;
+
+	explicit FrameBuffer(std::size_t initialSize = 4096u) : m_buf(initialSize), m_head(0u),
+		m_tail(0u), m_scan(0u) {}
+
+	~FrameBuffer() {}
+
+	/**
+	 * @brief Makes room for at least @c n more bytes
+	 *
+	 * Frames returned by nextFrame() before are invalidated.
+	 *
+	 * @return where to write the new bytes to, call commit() afterwards
+	 */
+	char *prepare(std::size_t n) {
+
+		if(m_head == m_tail) m_head = m_tail = m_scan = 0u;
+
+		if(m_buf.size() - m_tail < n) {
+
+			const std::size_t unread = m_tail - m_head;
+
+			if(m_head && unread) std::memmove(&m_buf[0], &m_buf[m_head], unread);
+
+			m_scan -= m_head;
+			m_tail = unread;
+			m_head = 0u;
+
+			if(m_buf.size() - m_tail < n) {
+				m_buf.resize(std::max(m_buf.size() * 2u, m_tail + n));
+			}
+		}
+
+		return &m_buf[m_tail];
+	}
+
+	/**
+	 * @brief Gets the free space at the end, which is at least what was requested in prepare()
+	 */
+	inline std::size_t capacity() const throw() {
+		return m_buf.size() - m_tail;
+	}
+
+	/**
+	 * @brief Appends @c n bytes written after a call to prepare()
+	 */
+	inline void commit(std::size_t n) throw() {
+		m_tail += n;
+	}
+
+	/**
+	 * @brief Gets the next complete frame and consumes it
+	 *
+	 * The frame is valid until the next call to prepare().
+	 *
+	 * @param data receives the start of the frame
+	 * @param len receives the length of the frame without its terminator
+	 *
+	 * @return @c false if there is no complete frame yet
+	 */
+	bool nextFrame(const char *&data, std::size_t &len) throw() {
+
+		const char *nul = m_scan < m_tail ? static_cast<const char *>
+						  (std::memchr(&m_buf[m_scan], 0, m_tail - m_scan)) : 0L;
+
+		if(!nul) {
+			m_scan = m_tail;
+			return false;
+		}
+
+		const std::size_t end = static_cast<std::size_t>(nul - &m_buf[0]);
+
+		data = &m_buf[m_head];
+		len  = end - m_head;
+
+		m_head = m_scan = end + 1u;
+
+		return true;
+	}
+
+	/**
+	 * @brief Gets the unread bytes for parsing frames which aren't @c NUL terminated
+	 *
+	 * The bytes are valid until the next call to prepare(), there are size() of them.
+	 */
+	inline const char *front() const throw() {
+		return &m_buf[m_head];
+	}
+
+	/**
+	 * @brief Consumes @c n of the unread bytes
+	 */
+	inline void consume(std::size_t n) throw() {
+		m_head += n;
+		m_scan = std::max(m_scan, m_head);
+	}
+
+	/**
+	 * @brief Remembers the current read position
+	 */
+	inline MARK mark() const throw() {
+		return MARK(m_head, m_scan);
+	}
+
+	/**
+	 * @brief Makes the frames consumed since @c m be read again
+	 *
+	 * There must be no call to prepare() in between.
+	 */
+	inline void rewind(const MARK &m) throw() {
+		m_head = m.first;
+		m_scan = m.second;
+	}
+
+	inline bool empty() const throw() {
+		return m_head == m_tail;
+	}
+
+	inline std::size_t size() const throw() {
+		return m_tail - m_head;
+	}
+
+	inline void clear() throw() {
+		m_head = m_tail = m_scan = 0u;
+	}
+
+private:
+	std::vector<char> m_buf;
+	std::size_t m_head;
+	std::size_t m_tail;
+	std::size_t m_scan;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_COMMON_FRAMEBUFFER_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,217 @@
+####################################################################################################
+#
+# Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+#
+# This file is part of NetMauMau.
+#
+# NetMauMau is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as
+# published by the Free Software Foundation, either version 3 of
+# the License, or (at your option) any later version.
+#
+# NetMauMau is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+#
+####################################################################################################
+#
+# Reads protocol.cpp and emits a perfect hash over the protocol keywords, i.e. the constants
+# consisting of upper case letters and underscores only.
+#
+# The hash is h = (h * 33 + c) mod 2^32 over the bytes of a message, starting with a seed
+# which is searched for until all keywords fall into distinct slots of the table. The slot is
+# (h + h / 2^12) mod 256, which is exact in awk's floating point arithmetic as well.
+#
+# The keywords are numbered in the order of protocol.cpp. The binary wire protocol transmits
+# these numbers, so new keywords have to be appended there.
+#
+
+BEGIN {
+
+	keys = 0;
+	SLOTS = 256;
+
+	for(i = 0; i < 256; ++i) ord[sprintf("%c", i)] = i;
+}
+
+/^const std::string [A-Z_0-9]+ _INIT_PRIO\([0-9]+\) = "[A-Z_]+";/ {
+
+	v = $0;
+	sub(/^[^"]*"/, "", v);
+	sub(/".*$/, "", v);
+
+	if(!(v in seen)) {
+		seen[v] = 1;
+		key[keys++] = v;
+	}
+}
+
+function hash(s, seed, h, i, n) {
+
+	h = seed;
+	n = length(s);
+
+	for(i = 1; i <= n; ++i) h = (h * 33 + ord[substr(s, i, 1)]) % 4294967296;
+
+	return (h + int(h / 4096)) % SLOTS;
+}
+
+function findSeed(seed, i, h, ok) {
+
+	for(seed = 0; seed < 65536; ++seed) {
+
+		split("", slot);
+		ok = 1;
+
+		for(i = 0; i < keys && ok; ++i) {
+
+			h = hash(key[i], seed);
+
+			if(h in slot) {
+				ok = 0;
+			} else {
+				slot[h] = i;
+			}
+		}
+
+		if(ok) return seed;
+	}
+
+	return -1;
+}
+
+function license() {
+
+	print "/*";
+	print " * Copyright " year " by Heiko Schäfer <heiko@rangun.de>";
+	print " *";
+	print " * This file is part of NetMauMau.";
+	print " *";
+	print " * NetMauMau is free software: you can redistribute it and/or modify";
+	print " * it under the terms of the GNU Lesser General Public License as";
+	print " * published by the Free Software Foundation, either version 3 of";
+	print " * the License, or (at your option) any later version.";
+	print " *";
+	print " * NetMauMau is distributed in the hope that it will be useful,";
+	print " * but WITHOUT ANY WARRANTY; without even the implied warranty of";
+	print " * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the";
+	print " * GNU Lesser General Public License for more details.";
+	print " *";
+	print " * You should have received a copy of the GNU Lesser General Public License";
+	print " * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.";
+	print " */\n";
+}
+
+END {
+
+	if(year == "") year = "2015";
+
+	seed = findSeed();
+
+	if(seed < 0) {
+		print "genprotohash.awk: no perfect hash found" > "/dev/stderr";
+		exit 1;
+	}
+
+	license();
+
+	print "#ifndef NETMAUMAU_COMMON_PROTOHASH_H";
+	print "#define NETMAUMAU_COMMON_PROTOHASH_H\n";
+
+	print "#include <cstddef>                      // for size_t";
+	print "#include <cstring>                      // for memcmp\n";
+
+	print "#include <stdint.h>                     // for uint32_t\n";
+
+	print "namespace NetMauMau {\n";
+
+	print "namespace Common {\n";
+
+	print "namespace Protocol {\n";
+
+	print "/**";
+	print " * @brief The keywords of the protocol";
+	print " *";
+	print " * @c ID_UNKNOWN is the number of keywords as well.";
+	print " */";
+	print "typedef enum {";
+
+	for(i = 0; i < keys; ++i) print "\tID_" key[i] ",";
+
+	print "\tID_UNKNOWN";
+	print "} MESSAGEID;\n";
+
+	print "/**";
+	print " * @brief Gets the text of a protocol keyword";
+	print " *";
+	print " * @param id the keyword, must not be @c ID_UNKNOWN";
+	print " * @param len receives the length of the keyword";
+	print " *";
+	print " * @return the keyword, it is not terminated";
+	print " */";
+	print "inline const char *keyword(MESSAGEID id, std::size_t &len) throw() {\n";
+
+	print "\tstatic const char *const KEY[ID_UNKNOWN] = {";
+
+	for(i = 0; i < keys; ++i) print "\t\t\"" key[i] "\"" (i < keys - 1 ? "," : "");
+
+	print "\t};\n";
+
+	print "\tstatic const unsigned char LEN[ID_UNKNOWN] = {";
+
+	for(i = 0; i < keys; ++i) printf "%s%d%s", (i % 16 ? " " : "\t\t"), length(key[i]), \
+		   (i < keys - 1 ? (i % 16 == 15 ? ",\n" : ",") : "\n");
+
+	print "\t};\n";
+
+	print "\tlen = LEN[id];\n";
+
+	print "\treturn KEY[id];";
+	print "}\n";
+
+	print "/**";
+	print " * @brief Identifies a protocol keyword by a perfect hash";
+	print " *";
+	print " * Costs one pass over the bytes of the message and at most one @c memcmp.";
+	print " *";
+	print " * @return the keyword or @c ID_UNKNOWN if @c msg isn't a keyword";
+	print " */";
+	print "inline MESSAGEID messageId(const char *msg, std::size_t len) throw() {\n";
+
+	printf "\tstatic const unsigned char SLOT[%d] = {", SLOTS;
+
+	for(i = 0; i < SLOTS; ++i) {
+		printf "%s%d", (i % 16 ? " " : "\n\t\t"), (i in slot ? slot[i] : keys);
+		if(i < SLOTS - 1) printf ",";
+	}
+
+	print "\n\t};\n";
+
+	print "\tuint32_t h = " seed "u;\n";
+
+	print "\tfor(std::size_t i = 0u; i < len; ++i) {";
+	print "\t\th = h * 33u + static_cast<unsigned char>(msg[i]);";
+	print "\t}\n";
+
+	print "\tconst MESSAGEID id = static_cast<MESSAGEID>(SLOT[(h + (h >> 12)) & " SLOTS - 1 "u]);\n";
+
+	print "\tif(id == ID_UNKNOWN) return id;\n";
+
+	print "\tstd::size_t klen;";
+	print "\tconst char *const key = keyword(id, klen);\n";
+
+	print "\treturn (klen == len && !std::memcmp(key, msg, len)) ? id : ID_UNKNOWN;";
+	print "}\n";
+
+	print "}\n";
+
+	print "}\n";
+
+	print "}\n";
+
+	print "#endif /* NETMAUMAU_COMMON_PROTOHASH_H */";
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_COMMON_INTRUSIVEPTR_H
+#define NETMAUMAU_COMMON_INTRUSIVEPTR_H
+
+#include "refcounted.h"
+
+namespace NetMauMau {
+
+namespace Common {
+
+/**
+ * @brief Smart pointer to objects derived from RefCounted
+ *
+ * Offers the interface of SmartPtr, but keeps the reference count in the pointee. Thus
+ * taking ownership doesn't allocate and copying touches only the pointee.
+ */
+template<class T>
+class IntrusivePtr {
+public:
+	typedef T element_type;
+	typedef element_type *element_pointer;
+
+	explicit IntrusivePtr(element_pointer p = 0L) throw() : m_ptr(p) {
+		if(m_ptr) m_ptr->acquireRef();
+	}
+
+	IntrusivePtr(const IntrusivePtr &o) throw() : m_ptr(o.m_ptr) {
+		if(m_ptr) m_ptr->acquireRef();
+	}
+
+	template<class O> IntrusivePtr(const IntrusivePtr<O> &o) throw() : m_ptr(o) {
+		if(m_ptr) m_ptr->acquireRef();
+	}
+
+	~IntrusivePtr() throw() {
+		release();
+	}
+
+	IntrusivePtr &operator=(const IntrusivePtr &o) throw() {
+		reset(o.m_ptr);
+		return *this;
+	}
+
+	template<class O> IntrusivePtr &operator=(const IntrusivePtr<O> &o) throw() {
+		reset(o);
+		return *this;
+	}
+
+	const element_type &operator*() const throw() {
+		return *m_ptr;
+	}
+
+	const element_type *operator->() const throw() {
+		return m_ptr;
+	}
+
+	operator element_type *() const throw() {
+		return m_ptr;
+	}
+
+	bool unique() const throw() {
+		return m_ptr ? m_ptr->getRefCount() == 1U : true;
+	}
+
+private:
+	void reset(element_pointer p) throw() {
+
+		// acquire first, the old pointee may own the new one
+		if(p) p->acquireRef();
+
+		release();
+		m_ptr = p;
+	}
+
+	void release() throw() {
+		if(m_ptr && m_ptr->releaseRef()) delete m_ptr;
+	}
+
+private:
+	element_pointer m_ptr;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_COMMON_INTRUSIVEPTR_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
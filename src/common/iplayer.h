@@ -41,7 +41,7 @@ public:
 	typedef NetMauMau::IPlayedOutCards::CARDS CARDS;
 	typedef enum { MAUMAU, NOMATCH, SUSPEND } REASON;
 	typedef enum { LEFT = 0, RIGHT = 1, NEXT = 2 } NEIGHBOUR;
-	typedef enum { HUMAN, EASY, HARD } TYPE;
+	typedef enum { HUMAN, EASY, HARD, EXPERT } TYPE;
 
 	typedef struct _neighbourRankSuit {
 
@@ -96,6 +96,7 @@ public:
 								   const NetMauMau::Common::ICard::SUIT *suit) const = 0;
 
 	virtual std::size_t getCardCount() const = 0;
+	virtual const CARDS &getPlayerCards() const = 0;
 	virtual std::size_t getPoints() const = 0;
 
 	virtual void reset() = 0;
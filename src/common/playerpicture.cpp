@@ -0,0 +1,88 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "playerpicture.h"
+
+#include <algorithm>                    // for swap
+
+#include "base64.h"                     // for base64_decode
+#include "refcounted.h"                 // for AtomicRefCountPolicy
+#include "sha1.h"                       // for sha1_hex
+
+namespace {
+const std::string NOPICTURE;
+}
+
+using namespace NetMauMau::Common;
+
+struct PlayerPicture::_blob {
+
+	explicit _blob(const std::string &b64) : refCount(1U), base64(b64), data(), hash() {
+
+		const std::vector<BYTE> &d(base64_decode(base64));
+
+		data.assign(d.begin(), d.end());
+		hash = sha1_hex(d.empty() ? 0L : &d.front(), d.size());
+	}
+
+	mutable AtomicRefCountPolicy::count_type refCount;
+	const std::string base64;
+	std::string data;
+	std::string hash;
+
+private:
+	_blob(const _blob &);
+	_blob &operator=(const _blob &);
+};
+
+PlayerPicture::PlayerPicture() throw() : m_blob(0L) {}
+
+PlayerPicture::PlayerPicture(const std::string &base64) : m_blob(base64.empty() ? 0L :
+			new _blob(base64)) {}
+
+PlayerPicture::PlayerPicture(const PlayerPicture &o) throw() : m_blob(o.m_blob) {
+	if(m_blob) AtomicRefCountPolicy::increment(m_blob->refCount);
+}
+
+PlayerPicture::~PlayerPicture() throw() {
+	if(m_blob && AtomicRefCountPolicy::decrement(m_blob->refCount)) delete m_blob;
+}
+
+PlayerPicture &PlayerPicture::operator=(const PlayerPicture &o) throw() {
+	PlayerPicture(o).swap(*this);
+	return *this;
+}
+
+void PlayerPicture::swap(PlayerPicture &o) throw() {
+	std::swap(m_blob, o.m_blob);
+}
+
+const std::string &PlayerPicture::getBase64() const throw() {
+	return m_blob ? m_blob->base64 : NOPICTURE;
+}
+
+const std::string &PlayerPicture::getData() const throw() {
+	return m_blob ? m_blob->data : NOPICTURE;
+}
+
+const std::string &PlayerPicture::getHash() const throw() {
+	return m_blob ? m_blob->hash : NOPICTURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -41,6 +41,9 @@ const std::string SCORES _INIT_PRIO(101) = "SCORES";
 const std::string SCORESEND _INIT_PRIO(101) = "SCORESEND";
 const std::string CAP _INIT_PRIO(101) = "CAP";
 const std::string CAPEND _INIT_PRIO(101) = "CAPEND";
+const std::string PICHASH _INIT_PRIO(101) = "PICHASH";
+const std::string PICTURE _INIT_PRIO(101) = "PICTURE";
+const std::string QUERY _INIT_PRIO(101) = "QUERY";
 
 const std::string ACEROUND _INIT_PRIO(101) = "ACEROUND";
 const std::string ACEROUNDENDED _INIT_PRIO(101) = "ACEROUNDENDED";
@@ -83,6 +86,8 @@ const std::string TALONSHUFFLED _INIT_PRIO(101) = "TALONSHUFFLED";
 const std::string TRUE _INIT_PRIO(101) = "TRUE";
 const std::string TURN _INIT_PRIO(101) = "TURN";
 const std::string VM_ADDPIC _INIT_PRIO(101) = "VM_ADDPIC";
+const std::string BINARY _INIT_PRIO(101) = "BINARY";
+const std::string DEFLATE _INIT_PRIO(101) = "DEFLATE";
 
 }
 
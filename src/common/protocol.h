@@ -51,6 +51,9 @@ extern const std::string SCORES;
 extern const std::string SCORESEND;
 extern const std::string CAP;
 extern const std::string CAPEND;
+extern const std::string PICHASH;
+extern const std::string PICTURE;
+extern const std::string QUERY;
 
 extern const std::string ACEROUND;
 extern const std::string ACEROUNDENDED;
@@ -93,6 +96,8 @@ extern const std::string TALONSHUFFLED;
 extern const std::string TRUE;
 extern const std::string TURN;
 extern const std::string VM_ADDPIC;
+extern const std::string BINARY;
+extern const std::string DEFLATE;
 
 }
 
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_COMMON_REFCOUNTED_H
+#define NETMAUMAU_COMMON_REFCOUNTED_H
+
+namespace NetMauMau {
+
+namespace Common {
+
+/**
+ * @brief Reference count for objects used by one thread only
+ */
+struct PlainRefCountPolicy {
+
+	typedef unsigned int count_type;
+
+	static inline void increment(count_type &c) throw() {
+		++c;
+	}
+
+	/// @return @c true if the last reference got released
+	static inline bool decrement(count_type &c) throw() {
+		return --c == 0U;
+	}
+
+	static inline count_type get(const count_type &c) throw() {
+		return c;
+	}
+};
+
+/**
+ * @brief Reference count for objects shared between threads
+ */
+struct AtomicRefCountPolicy {
+
+	typedef unsigned int count_type;
+
+	static inline void increment(count_type &c) throw() {
+		__sync_add_and_fetch(&c, 1U);
+	}
+
+	/// @return @c true if the last reference got released
+	static inline bool decrement(count_type &c) throw() {
+		return __sync_sub_and_fetch(&c, 1U) == 0U;
+	}
+
+	static inline count_type get(const count_type &c) throw() {
+		return *static_cast<const volatile count_type *>(&c);
+	}
+};
+
+template<class> class IntrusivePtr;
+
+/**
+ * @brief Base of objects carrying their own reference count
+ *
+ * The count lives in the object itself, so managing it by an IntrusivePtr needs no
+ * additional allocation. The object gets deleted through a pointer to the type the
+ * IntrusivePtr is instantiated with, so that type needs a virtual destructor if
+ * derived objects are managed by it.
+ *
+ * @tparam RefCountPolicy either PlainRefCountPolicy or AtomicRefCountPolicy
+ */
+template<class RefCountPolicy = PlainRefCountPolicy>
+class RefCounted {
+	template<class> friend class IntrusivePtr;
+public:
+	typedef RefCountPolicy refcount_policy;
+
+protected:
+	RefCounted() throw() : m_refCount(0U) {}
+	RefCounted(const RefCounted &) throw() : m_refCount(0U) {}
+	~RefCounted() throw() {}
+
+	RefCounted &operator=(const RefCounted &) throw() {
+		return *this;
+	}
+
+private:
+	inline void acquireRef() const throw() {
+		RefCountPolicy::increment(m_refCount);
+	}
+
+	inline bool releaseRef() const throw() {
+		return RefCountPolicy::decrement(m_refCount);
+	}
+
+	inline typename RefCountPolicy::count_type getRefCount() const throw() {
+		return RefCountPolicy::get(m_refCount);
+	}
+
+private:
+	mutable typename RefCountPolicy::count_type m_refCount;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_COMMON_REFCOUNTED_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
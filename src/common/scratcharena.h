@@ -0,0 +1,171 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_COMMON_SCRATCHARENA_H
+#define NETMAUMAU_COMMON_SCRATCHARENA_H
+
+#include <cstddef>                      // for size_t, ptrdiff_t
+#include <limits>                       // for numeric_limits
+#include <new>                          // for placement new
+#include <vector>
+
+#include "linkercontrol.h"
+
+namespace NetMauMau {
+
+namespace Common {
+
+/**
+ * @brief Bump allocator for short-lived scratch data
+ *
+ * Memory is handed out linearly from chunks and never freed individually. Calling reset()
+ * makes all chunks available again, so once the arena has grown to the size a task needs,
+ * repeating that task does not touch the heap anymore.
+ */
+class ScratchArena {
+	DISALLOW_COPY_AND_ASSIGN(ScratchArena)
+public:
+	explicit ScratchArena(std::size_t chunkSize = 4096u) : m_chunks(), m_chunkSize(chunkSize),
+		m_current(0u), m_used(0u) {}
+
+	~ScratchArena() {
+		for(std::vector<CHUNK>::const_iterator i(m_chunks.begin()); i != m_chunks.end(); ++i) {
+			delete [] i->data;
+		}
+	}
+
+	void *allocate(std::size_t n) {
+
+		n = (n + ALIGN - 1u) & ~(ALIGN - 1u);
+
+		while(m_current < m_chunks.size() && m_used + n > m_chunks[m_current].size) {
+			++m_current;
+			m_used = 0u;
+		}
+
+		if(m_current == m_chunks.size()) {
+			const CHUNK c = { new char[n > m_chunkSize ? n : m_chunkSize],
+							  n > m_chunkSize ? n : m_chunkSize
+							};
+			m_chunks.push_back(c);
+			m_used = 0u;
+		}
+
+		void *p = m_chunks[m_current].data + m_used;
+		m_used += n;
+
+		return p;
+	}
+
+	/**
+	 * @brief Releases everything allocated so far
+	 */
+	inline void reset() throw() {
+		m_current = m_used = 0u;
+	}
+
+	inline std::size_t getChunkCount() const throw() {
+		return m_chunks.size();
+	}
+
+private:
+	enum { ALIGN = 16u };
+
+	typedef struct _chunk {
+		char *data;
+		std::size_t size;
+	} CHUNK;
+
+	std::vector<CHUNK> m_chunks;
+	const std::size_t m_chunkSize;
+	std::size_t m_current;
+	std::size_t m_used;
+};
+
+/**
+ * @brief Standard allocator drawing from a ScratchArena
+ *
+ * Deallocation is a no-op, the memory is reclaimed by ScratchArena::reset.
+ */
+template<class T>
+class ScratchAllocator {
+	template<class> friend class ScratchAllocator;
+public:
+	typedef T value_type;
+	typedef T *pointer;
+	typedef const T *const_pointer;
+	typedef T &reference;
+	typedef const T &const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template<class U> struct rebind {
+		typedef ScratchAllocator<U> other;
+	};
+
+	ScratchAllocator(ScratchArena &arena) throw() : m_arena(&arena) {}
+
+	template<class U> ScratchAllocator(const ScratchAllocator<U> &o) throw()
+		: m_arena(o.m_arena) {}
+
+	inline pointer address(reference x) const {
+		return &x;
+	}
+
+	inline const_pointer address(const_reference x) const {
+		return &x;
+	}
+
+	inline pointer allocate(size_type n, const void * = 0L) {
+		return static_cast<pointer>(m_arena->allocate(n * sizeof(T)));
+	}
+
+	inline void deallocate(pointer, size_type) throw() {}
+
+	inline size_type max_size() const throw() {
+		return std::numeric_limits<size_type>::max() / sizeof(T);
+	}
+
+	inline void construct(pointer p, const T &v) {
+		new(static_cast<void *>(p)) T(v);
+	}
+
+	inline void destroy(pointer p) {
+		p->~T();
+	}
+
+	template<class U> inline bool operator==(const ScratchAllocator<U> &o) const throw() {
+		return m_arena == o.m_arena;
+	}
+
+	template<class U> inline bool operator!=(const ScratchAllocator<U> &o) const throw() {
+		return m_arena != o.m_arena;
+	}
+
+private:
+	ScratchArena *m_arena;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_COMMON_SCRATCHARENA_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include "sha1.h"
+
+#include <stdint.h>                     // for uint32_t, uint64_t
+#include <cstring>                      // for memcpy, memset
+
+namespace {
+
+inline uint32_t rol(uint32_t v, unsigned int n) {
+	return (v << n) | (v >> (32u - n));
+}
+
+void transform(uint32_t *h, const unsigned char *blk) {
+
+	uint32_t w[80];
+
+	for(unsigned int i = 0u; i < 16u; ++i) {
+		w[i] = (static_cast<uint32_t>(blk[i * 4u]) << 24u) |
+			   (static_cast<uint32_t>(blk[i * 4u + 1u]) << 16u) |
+			   (static_cast<uint32_t>(blk[i * 4u + 2u]) << 8u) |
+			   static_cast<uint32_t>(blk[i * 4u + 3u]);
+	}
+
+	for(unsigned int i = 16u; i < 80u; ++i) {
+		w[i] = rol(w[i - 3u] ^ w[i - 8u] ^ w[i - 14u] ^ w[i - 16u], 1u);
+	}
+
+	uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+
+	for(unsigned int i = 0u; i < 80u; ++i) {
+
+		uint32_t f, k;
+
+		if(i < 20u) {
+			f = (b & c) | (~b & d);
+			k = 0x5A827999u;
+		} else if(i < 40u) {
+			f = b ^ c ^ d;
+			k = 0x6ED9EBA1u;
+		} else if(i < 60u) {
+			f = (b & c) | (b & d) | (c & d);
+			k = 0x8F1BBCDCu;
+		} else {
+			f = b ^ c ^ d;
+			k = 0xCA62C1D6u;
+		}
+
+		const uint32_t t = rol(a, 5u) + f + e + k + w[i];
+
+		e = d;
+		d = c;
+		c = rol(b, 30u);
+		b = a;
+		a = t;
+	}
+
+	h[0] += a;
+	h[1] += b;
+	h[2] += c;
+	h[3] += d;
+	h[4] += e;
+}
+
+}
+
+std::string NetMauMau::Common::sha1_hex(const unsigned char *buf, std::size_t bufLen) {
+
+	uint32_t h[5] = { 0x67452301u, 0xEFCDAB89u, 0x98BADCFEu, 0x10325476u, 0xC3D2E1F0u };
+
+	const std::size_t full = bufLen & ~static_cast<std::size_t>(63u);
+
+	for(std::size_t i = 0u; i < full; i += 64u) transform(h, buf + i);
+
+	// the padded tail takes one or two more blocks
+	unsigned char tail[128];
+	const std::size_t rest = bufLen - full;
+	const std::size_t tlen = rest < 56u ? 64u : 128u;
+
+	std::memset(tail, 0, sizeof(tail));
+
+	if(rest) std::memcpy(tail, buf + full, rest);
+
+	tail[rest] = 0x80u;
+
+	const uint64_t bits = static_cast<uint64_t>(bufLen) << 3u;
+
+	for(unsigned int i = 0u; i < 8u; ++i) {
+		tail[tlen - 1u - i] = static_cast<unsigned char>(bits >> (i * 8u));
+	}
+
+	transform(h, tail);
+
+	if(tlen == 128u) transform(h, tail + 64);
+
+	static const char HEX[] = "0123456789abcdef";
+
+	std::string digest(40u, '0');
+
+	for(unsigned int i = 0u; i < 40u; ++i) {
+		digest[i] = HEX[(h[i >> 3u] >> (28u - ((i & 7u) << 2u))) & 0xFu];
+	}
+
+	return digest;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
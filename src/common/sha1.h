@@ -0,0 +1,56 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * @brief SHA-1 digest used to address player pictures by their content
+ *
+ * @author Heiko Schäfer <heiko@rangun.de>
+ */
+
+#ifndef NETMAUMAU_COMMON_SHA1_H
+#define NETMAUMAU_COMMON_SHA1_H
+
+#include <cstddef>                      // for size_t
+#include <string>
+
+#include "linkercontrol.h"
+
+namespace NetMauMau {
+
+namespace Common {
+
+/**
+ * @brief Calculates the SHA-1 digest of a buffer
+ *
+ * @param buf the buffer
+ * @param bufLen length of the buffer
+ * @return the digest as 40 lower case hex digits
+ *
+ * @since 0.25
+ */
+_EXPORT std::string sha1_hex(const unsigned char *buf, std::size_t bufLen);
+
+}
+
+}
+
+#endif /* NETMAUMAU_COMMON_SHA1_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
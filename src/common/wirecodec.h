@@ -0,0 +1,259 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_COMMON_WIRECODEC_H
+#define NETMAUMAU_COMMON_WIRECODEC_H
+
+#include <string>
+
+#include <stdint.h>                     // for uint32_t
+
+#include "cardtools.h"                  // for parseCardIndex, getCardDesc
+#include "protohash.h"                  // for messageId, keyword
+
+namespace NetMauMau {
+
+namespace Common {
+
+/**
+ * @brief Translates the messages of the text protocol to binary frames and back
+ *
+ * Every @c NUL terminated token of the text protocol becomes exactly one frame, so the binary
+ * protocol carries the same messages in the same order. A frame starts with the size of its
+ * payload as varint, thus a receiver knows if a frame is complete without looking into it. The
+ * first byte of the payload tells its kind:
+ *
+ * Byte              | Payload
+ * ----------------- | -----
+ * <tt>0x00-0x3f</tt> | the protocol keyword with this ID
+ * <tt>0x40-0x5f</tt> | the card with the index of the byte minus @c 0x40
+ * <tt>0x80</tt>      | an unsigned decimal number, its value follows as varint
+ * <tt>0x81</tt>      | any other text, its bytes follow
+ *
+ * A varint stores 7 bits per byte, least significant first, the high bit tells that another
+ * byte follows. As the IDs of the keywords are sent, new keywords must be appended to the
+ * protocol only.
+ */
+class WireCodec {
+	DISALLOW_COPY_AND_ASSIGN(WireCodec)
+public:
+	enum { KEYWORD = 0x00, CARD = 0x40, NUMBER = 0x80, TEXT = 0x81 };
+
+	/**
+	 * @brief Returned by decode() if the data isn't a valid frame
+	 */
+	static const std::size_t MALFORMED = static_cast<std::size_t>(-1);
+
+	/**
+	 * @brief Appends the frames of a message to @c out
+	 *
+	 * Each part of @c msg separated by @c NUL becomes one frame, as each would have been
+	 * terminated by @c NUL in the text protocol.
+	 */
+	static void encode(std::string &out, const char *msg, std::size_t len) {
+
+		const char *const end = msg + len;
+
+		for(const char *tok = msg;; ++tok) {
+
+			const char *nul = tok;
+
+			while(nul != end && *nul) ++nul;
+
+			encodeToken(out, tok, static_cast<std::size_t>(nul - tok));
+
+			if(nul == end) break;
+
+			tok = nul;
+		}
+	}
+
+	/**
+	 * @brief Decodes the frame at the start of @c data
+	 *
+	 * @param data the received bytes
+	 * @param len the number of received bytes
+	 * @param msg receives the token of the frame
+	 *
+	 * @return the size of the frame, @c 0 if it isn't complete yet or @c MALFORMED
+	 */
+	static std::size_t decode(const char *data, std::size_t len, std::string &msg) {
+
+		uint32_t plen;
+		const std::size_t hl = getVarint(data, len, plen);
+
+		if(!hl || hl == MALFORMED) return hl;
+
+		if(!plen) return MALFORMED;
+
+		if(len - hl < plen) return 0u;
+
+		const char *const p = data + hl;
+		const unsigned char tag = static_cast<unsigned char>(*p);
+
+		if(tag < Protocol::ID_UNKNOWN) {
+
+			if(plen != 1u) return MALFORMED;
+
+			std::size_t klen;
+			const char *const key = Protocol::keyword(static_cast<Protocol::MESSAGEID>(tag),
+									klen);
+
+			msg.assign(key, klen);
+
+		} else if(tag >= CARD && static_cast<std::size_t>(tag - CARD) < CARD_INDEX_ILLEGAL) {
+
+			if(plen != 1u) return MALFORMED;
+
+			msg = getCardDesc(static_cast<std::size_t>(tag - CARD), false);
+
+		} else if(tag == NUMBER) {
+
+			uint32_t v;
+
+			if(getVarint(p + 1, plen - 1u, v) != plen - 1u) return MALFORMED;
+
+			// printed backwards into the end of the buffer
+			char num[10];
+			char *d = num + sizeof(num);
+
+			do {
+				*--d = static_cast<char>('0' + v % 10u);
+			} while(v /= 10u);
+
+			msg.assign(d, static_cast<std::size_t>(num + sizeof(num) - d));
+
+		} else if(tag == TEXT) {
+			msg.assign(p + 1, plen - 1u);
+		} else {
+			return MALFORMED;
+		}
+
+		return hl + plen;
+	}
+
+	/**
+	 * @brief Appends @c v as varint to @c out
+	 */
+	static void putVarint(std::string &out, uint32_t v) {
+
+		while(v >= 0x80u) {
+			out.append(1, static_cast<char>((v & 0x7fu) | 0x80u));
+			v >>= 7u;
+		}
+
+		out.append(1, static_cast<char>(v));
+	}
+
+	/**
+	 * @brief Reads a varint
+	 *
+	 * @return the number of bytes read, @c 0 if it isn't complete yet or @c MALFORMED
+	 */
+	static std::size_t getVarint(const char *data, std::size_t len, uint32_t &v) throw() {
+
+		v = 0u;
+
+		for(std::size_t i = 0u; i < 5u; ++i) {
+
+			if(i == len) return 0u;
+
+			const unsigned char b = static_cast<unsigned char>(data[i]);
+
+			v |= static_cast<uint32_t>(b & 0x7fu) << (7u * i);
+
+			if(!(b & 0x80u)) return i + 1u;
+		}
+
+		return MALFORMED;
+	}
+
+private:
+	// the keyword IDs must not run into the card frames
+	typedef char KEYWORDS_FIT[static_cast<int>(Protocol::ID_UNKNOWN) <= CARD ? 1 : -1];
+
+	static void encodeToken(std::string &out, const char *tok, std::size_t len) {
+
+		// keywords start with an upper case letter and numbers with a digit, so the first
+		// byte spares the lookups which can't match
+		const char c = len ? *tok : '\0';
+
+		if(c >= 'A' && c <= 'Z') {
+
+			const Protocol::MESSAGEID id = Protocol::messageId(tok, len);
+
+			if(id != Protocol::ID_UNKNOWN) {
+				const char frame[2] = { 1, static_cast<char>(KEYWORD + id) };
+				out.append(frame, 2u);
+				return;
+			}
+
+		} else if(c >= '0' && c <= '9') {
+
+			uint32_t n = 0u;
+
+			if(isNumber(tok, len, n)) {
+
+				char var[7] = { 0, static_cast<char>(NUMBER) };
+				std::size_t vl = 1u;
+
+				for(; n >= 0x80u; n >>= 7u) var[++vl] = static_cast<char>((n & 0x7fu) | 0x80u);
+
+				var[++vl] = static_cast<char>(n);
+				var[0] = static_cast<char>(vl);
+
+				out.append(var, vl + 1u);
+				return;
+			}
+		}
+
+		const std::size_t ci = parseCardIndex(tok, len);
+
+		if(ci != CARD_INDEX_ILLEGAL) {
+			const char frame[2] = { 1, static_cast<char>(CARD + ci) };
+			out.append(frame, 2u);
+			return;
+		}
+
+		putVarint(out, static_cast<uint32_t>(len + 1u));
+		out.append(1, static_cast<char>(TEXT)).append(tok, len);
+	}
+
+	// only numbers which are printed back the same are sent as varint
+	static bool isNumber(const char *tok, std::size_t len, uint32_t &n) throw() {
+
+		if(!len || len > 9u || (len > 1u && *tok == '0')) return false;
+
+		for(std::size_t i = 0u; i < len; ++i) {
+
+			if(tok[i] < '0' || tok[i] > '9') return false;
+
+			n = n * 10u + static_cast<uint32_t>(tok[i] - '0');
+		}
+
+		return true;
+	}
+};
+}
+
+}
+
+#endif /* NETMAUMAU_COMMON_WIRECODEC_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
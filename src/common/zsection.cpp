@@ -0,0 +1,210 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <cstring>                      // for memcpy
+
+#ifdef ENABLE_THREADS
+#include <pthread.h>
+#endif
+
+#include "zsection.h"
+
+#include "protohash.h"                  // for keyword
+#include "wirecodec.h"                  // for WireCodec
+
+#define Z_INFLATE_CHUNK 32768
+
+namespace {
+
+std::string dict;
+
+#ifdef ENABLE_THREADS
+pthread_once_t dictOnce = PTHREAD_ONCE_INIT;
+#endif
+
+// zlib prefers the most frequent strings at the end of the dictionary
+void buildDictionary() {
+
+	for(int i = 0; i < NetMauMau::Common::Protocol::ID_UNKNOWN; ++i) {
+
+		std::size_t len;
+		const char *key = NetMauMau::Common::Protocol::
+						  keyword(static_cast<NetMauMau::Common::Protocol::MESSAGEID>(i), len);
+
+		dict.append(key, len).append(1, 0);
+	}
+
+	// the base64 encoded signature and header chunk every picture starts with
+	dict.append("iVBORw0KGgoAAAANSUhEUgAA");
+}
+
+// sessions of several threads may start at once, so it is built exactly once
+const std::string &dictionary() {
+
+#ifdef ENABLE_THREADS
+	pthread_once(&dictOnce, buildDictionary);
+#else
+	if(dict.empty()) buildDictionary();
+#endif
+
+	return dict;
+}
+
+}
+
+using namespace NetMauMau::Common;
+
+ZSectionDeflater::ZSectionDeflater(std::size_t threshold,
+								   int compressionLevel) throw(Exception::ZLibException)
+	: m_zstream(), m_buf(), m_threshold(threshold) {
+
+	m_zstream.zalloc = Z_NULL;
+	m_zstream.zfree  = Z_NULL;
+	m_zstream.opaque = Z_NULL;
+
+	int err;
+
+	if(unlikely((err = deflateInit2(&m_zstream, compressionLevel, Z_DEFLATED, -15, 9,
+									Z_DEFAULT_STRATEGY)) != Z_OK)) {
+		throw Exception::ZLibException(zError(err));
+	}
+
+	const std::string &dict(dictionary());
+
+	if(unlikely((err = deflateSetDictionary(&m_zstream,
+											reinterpret_cast<const Bytef *>(dict.data()),
+											static_cast<uInt>(dict.length()))) != Z_OK)) {
+		deflateEnd(&m_zstream);
+		throw Exception::ZLibException(zError(err));
+	}
+}
+
+ZSectionDeflater::~ZSectionDeflater() {
+	deflateEnd(&m_zstream);
+}
+
+void ZSectionDeflater::append(std::string &out, const char *data,
+							  std::size_t len) throw(Exception::ZLibException) {
+
+	if(len < m_threshold) {
+		WireCodec::putVarint(out, static_cast<uint32_t>(len << 1u));
+		out.append(data, len);
+		return;
+	}
+
+	// a sync flush ends on a byte boundary, so the section can be inflated on its own
+	m_buf.resize(deflateBound(&m_zstream, static_cast<uLong>(len)) + 16u);
+
+	m_zstream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+	m_zstream.avail_in  = static_cast<uInt>(len);
+	m_zstream.next_out  = &m_buf[0];
+	m_zstream.avail_out = static_cast<uInt>(m_buf.size());
+
+	const int err = deflate(&m_zstream, Z_SYNC_FLUSH);
+
+	if(unlikely(err != Z_OK || m_zstream.avail_in)) {
+		throw Exception::ZLibException(zError(err != Z_OK ? err : Z_BUF_ERROR));
+	}
+
+	const std::size_t zlen = m_buf.size() - m_zstream.avail_out;
+
+	WireCodec::putVarint(out, static_cast<uint32_t>((zlen << 1u) | 1u));
+	out.append(reinterpret_cast<const char *>(&m_buf[0]), zlen);
+}
+
+ZSectionInflater::ZSectionInflater() throw(Exception::ZLibException) : m_zstream() {
+
+	m_zstream.zalloc = Z_NULL;
+	m_zstream.zfree  = Z_NULL;
+	m_zstream.opaque = Z_NULL;
+
+	int err;
+
+	if(unlikely((err = inflateInit2(&m_zstream, -15)) != Z_OK)) {
+		throw Exception::ZLibException(zError(err));
+	}
+
+	const std::string &dict(dictionary());
+
+	if(unlikely((err = inflateSetDictionary(&m_zstream,
+											reinterpret_cast<const Bytef *>(dict.data()),
+											static_cast<uInt>(dict.length()))) != Z_OK)) {
+		inflateEnd(&m_zstream);
+		throw Exception::ZLibException(zError(err));
+	}
+}
+
+ZSectionInflater::~ZSectionInflater() {
+	inflateEnd(&m_zstream);
+}
+
+bool ZSectionInflater::inflate(FrameBuffer &in, FrameBuffer &out) {
+
+	while(!in.empty()) {
+
+		uint32_t v;
+		const std::size_t vl = WireCodec::getVarint(in.front(), in.size(), v);
+
+		if(vl == WireCodec::MALFORMED) return false;
+
+		const std::size_t plen = v >> 1u;
+
+		if(!vl || in.size() - vl < plen) break;
+
+		const char *payload = in.front() + vl;
+
+		if(!(v & 1u)) {
+
+			std::memcpy(out.prepare(plen), payload, plen);
+			out.commit(plen);
+
+		} else {
+
+			m_zstream.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(payload));
+			m_zstream.avail_in = static_cast<uInt>(plen);
+
+			do {
+
+				char *buf = out.prepare(Z_INFLATE_CHUNK);
+				const std::size_t cap = out.capacity();
+
+				m_zstream.next_out  = reinterpret_cast<Bytef *>(buf);
+				m_zstream.avail_out = static_cast<uInt>(cap);
+
+				const int err = ::inflate(&m_zstream, Z_SYNC_FLUSH);
+
+				// no progress is only fine if all the input is used up
+				if(err != Z_OK && !(err == Z_BUF_ERROR && !m_zstream.avail_in)) return false;
+
+				out.commit(cap - m_zstream.avail_out);
+
+			} while(m_zstream.avail_in || !m_zstream.avail_out);
+		}
+
+		in.consume(vl + plen);
+	}
+
+	return true;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
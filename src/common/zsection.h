@@ -0,0 +1,92 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_COMMON_ZSECTION_H
+#define NETMAUMAU_COMMON_ZSECTION_H
+
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "framebuffer.h"                // for FrameBuffer
+#include "zlibexception.h"
+
+namespace NetMauMau {
+
+namespace Common {
+
+/**
+ * @brief Packs the responses sent in a compressing query session into sections
+ *
+ * Each section starts with a varint holding its length shifted left by one, the lowest bit
+ * tells whether the section is deflated. Responses shorter than the threshold are sent as
+ * they are, longer ones are deflated with a stream living as long as the session, so later
+ * responses get compressed against the earlier ones. Both ends prime their streams with the
+ * same dictionary of the common protocol strings.
+ */
+class _EXPORT ZSectionDeflater {
+	DISALLOW_COPY_AND_ASSIGN(ZSectionDeflater)
+public:
+	explicit ZSectionDeflater(std::size_t threshold = 256u,
+							  int compressionLevel = Z_DEFAULT_COMPRESSION)
+	throw(Exception::ZLibException);
+	~ZSectionDeflater();
+
+	/**
+	 * @brief Appends the section holding @c len bytes of @c data to @c out
+	 */
+	void append(std::string &out, const char *data,
+				std::size_t len) throw(Exception::ZLibException);
+
+private:
+	z_stream m_zstream;
+	std::vector<Bytef> m_buf;
+	const std::size_t m_threshold;
+};
+
+/**
+ * @brief Unpacks the sections written by ZSectionDeflater
+ */
+class _EXPORT ZSectionInflater {
+	DISALLOW_COPY_AND_ASSIGN(ZSectionInflater)
+public:
+	explicit ZSectionInflater() throw(Exception::ZLibException);
+	~ZSectionInflater();
+
+	/**
+	 * @brief Moves the content of all complete sections from @c in to @c out
+	 *
+	 * An incomplete section at the end of @c in stays there.
+	 *
+	 * @return @c false if the sections are corrupted
+	 */
+	bool inflate(FrameBuffer &in, FrameBuffer &out);
+
+private:
+	z_stream m_zstream;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_COMMON_ZSECTION_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
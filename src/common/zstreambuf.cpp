@@ -17,69 +17,221 @@
  * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
 #include <ostream>
+#include <vector>
+
+#ifdef ENABLE_THREADS
+#include <pthread.h>
+#endif
 
 #include "zstreambuf.h"
 
 #define Z_DEFLATE_CHUNK 32768
 
+namespace {
+
+// streams kept per thread, each holds about 400 KiB of zlib state
+const std::size_t MAXPOOLED = 4u;
+
+#ifdef ENABLE_THREADS
+pthread_key_t poolKey;
+pthread_once_t poolKeyOnce = PTHREAD_ONCE_INIT;
+#endif
+
+int windowBits(NetMauMau::Common::Zstreambuf::FORMAT format) {
+	return format == NetMauMau::Common::Zstreambuf::GZIP ? 31 :
+		   format == NetMauMau::Common::Zstreambuf::ZLIB ? 15 : -15;
+}
+
+}
+
 using namespace NetMauMau::Common;
 
-Zstreambuf::Zstreambuf(const std::ostream &os, int compressionLevel,
-					   bool flush) throw(NetMauMau::Common::Exception::ZLibException) : m_zstream(),
-	m_sbuf(os.rdbuf()), m_buf(new char_type[Z_DEFLATE_CHUNK]), m_deflateBound(0), m_flush(flush) {
+struct Zstreambuf::PooledStream {
+	z_stream zs;
+	std::vector<char_type> in;
+	std::vector<Bytef> out;
+	int level;
+	int windowBits;
+};
 
-	m_zstream.zalloc = Z_NULL;
-	m_zstream.zfree  = Z_NULL;
-	m_zstream.opaque = Z_NULL;
+class Zstreambuf::Pool {
+	DISALLOW_COPY_AND_ASSIGN(Pool)
+public:
+	Pool() : m_streams() {}
 
-	int err;
+	~Pool() {
+		for(std::vector<PooledStream *>::const_iterator i(m_streams.begin());
+				i != m_streams.end(); ++i) destroy(*i);
+	}
+
+	static Pool &get() {
+#ifdef ENABLE_THREADS
+		pthread_once(&poolKeyOnce, createKey);
+
+		Pool *p = static_cast<Pool *>(pthread_getspecific(poolKey));
+
+		if(unlikely(!p)) {
+			p = new Pool();
+			pthread_setspecific(poolKey, p);
+		}
+
+		return *p;
+#else
+		static Pool pool;
+		return pool;
+#endif
+	}
+
+	PooledStream *acquire(int level, int windowBits) throw(Exception::ZLibException) {
+
+		for(std::vector<PooledStream *>::iterator i(m_streams.begin()); i != m_streams.end();
+				++i) {
+
+			if((*i)->level == level && (*i)->windowBits == windowBits) {
+				PooledStream *ps = *i;
+				m_streams.erase(i);
+				return ps;
+			}
+		}
+
+		PooledStream *ps = new PooledStream();
+
+		ps->level = level;
+		ps->windowBits = windowBits;
+		ps->zs.zalloc = Z_NULL;
+		ps->zs.zfree  = Z_NULL;
+		ps->zs.opaque = Z_NULL;
+
+		int err;
+
+		if(unlikely((err = deflateInit2(&ps->zs, level, Z_DEFLATED, windowBits, 9,
+										Z_DEFAULT_STRATEGY)) != Z_OK)) {
+			delete ps;
+			throw Exception::ZLibException(zError(err));
+		}
+
+		ps->in.resize(Z_DEFLATE_CHUNK);
+		ps->out.resize(deflateBound(&ps->zs, Z_DEFLATE_CHUNK));
+
+		return ps;
+	}
 
-	if(unlikely((err = deflateInit2(&m_zstream, compressionLevel, Z_DEFLATED, -15, 9,
-									Z_DEFAULT_STRATEGY)) != Z_OK)) {
-		throw NetMauMau::Common::Exception::ZLibException(zError(err));
+	void release(PooledStream *ps, bool reuse) throw() {
+
+		if(reuse && m_streams.size() < MAXPOOLED && deflateReset(&ps->zs) == Z_OK) {
+			m_streams.push_back(ps);
+		} else {
+			destroy(ps);
+		}
+	}
+
+private:
+	static void destroy(PooledStream *ps) throw() {
+		deflateEnd(&ps->zs);
+		delete ps;
+	}
+
+#ifdef ENABLE_THREADS
+	static void createKey() {
+		pthread_key_create(&poolKey, deletePool);
+	}
+
+	static void deletePool(void *p) {
+		delete static_cast<Pool *>(p);
 	}
+#endif
 
-	m_deflateBound = deflateBound(&m_zstream, Z_DEFLATE_CHUNK);
+	std::vector<PooledStream *> m_streams;
+};
 
-	setp(m_buf, m_buf + Z_DEFLATE_CHUNK - 1);
+Zstreambuf::Zstreambuf(const std::ostream &os, int compressionLevel, bool flush,
+					   FORMAT format) throw(NetMauMau::Common::Exception::ZLibException) :
+	m_stream(Pool::get().acquire(compressionLevel, windowBits(format))), m_sbuf(os.rdbuf()),
+	m_flush(flush), m_failed(false) {
+	setp(&m_stream->in[0], &m_stream->in[0] + Z_DEFLATE_CHUNK - 1);
 }
 
 Zstreambuf::~Zstreambuf() {
-	deflateEnd(&m_zstream);
-	delete [] m_buf;
+	Pool::get().release(m_stream, !m_failed);
+}
+
+int Zstreambuf::compressionLevel(std::size_t len) throw() {
+
+	if(len < 16384u) return Z_BEST_COMPRESSION;
+
+	return len < 262144u ? Z_DEFAULT_COMPRESSION : Z_BEST_SPEED;
+}
+
+void Zstreambuf::compress(std::string &out, const char *data, std::size_t len,
+						  FORMAT format) throw(NetMauMau::Common::Exception::ZLibException) {
+
+	Pool &pool(Pool::get());
+	PooledStream *const ps = pool.acquire(compressionLevel(len), windowBits(format));
+
+	ps->zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+	ps->zs.avail_in = static_cast<uInt>(len);
+
+	int err;
+
+	try {
+
+		do {
+
+			ps->zs.next_out = &ps->out[0];
+			ps->zs.avail_out = static_cast<uInt>(ps->out.size());
+
+			err = deflate(&ps->zs, Z_FINISH);
+
+			out.append(reinterpret_cast<const char *>(&ps->out[0]),
+					   ps->out.size() - ps->zs.avail_out);
+
+		} while(err == Z_OK);
+
+	} catch(...) {
+		pool.release(ps, false);
+		throw;
+	}
+
+	pool.release(ps, err == Z_STREAM_END);
+
+	if(unlikely(err != Z_STREAM_END)) throw Exception::ZLibException(zError(err));
 }
 
 Zstreambuf::int_type Zstreambuf::deflateBuffer(int flush) {
 
-	int_type num = pptr() - pbase();
+	if(unlikely(m_failed)) return std::char_traits<char_type>::eof();
 
-	Byte *outBuf = new Byte[m_deflateBound];
+	const int_type num = pptr() - pbase();
+	z_stream &zs(m_stream->zs);
 
-	m_zstream.avail_in = static_cast<uLong>(num);
-	m_zstream.next_in = reinterpret_cast<Byte *>(m_buf);
+	zs.avail_in = static_cast<uInt>(num);
+	zs.next_in = reinterpret_cast<Bytef *>(pbase());
 
 	do {
 
-		m_zstream.avail_out = m_deflateBound;
-		m_zstream.next_out = outBuf;
+		zs.avail_out = static_cast<uInt>(m_stream->out.size());
+		zs.next_out = &m_stream->out[0];
 
-		if(unlikely(deflate(&m_zstream, flush) == Z_STREAM_ERROR)) {
-			deflateEnd(&m_zstream);
+		if(unlikely(deflate(&zs, flush) == Z_STREAM_ERROR)) {
+			m_failed = true;
 			return std::char_traits<char_type>::eof();
 		}
 
-		std::streamsize have = static_cast<std::streamsize>(m_deflateBound - m_zstream.avail_out);
+		const std::streamsize have = static_cast<std::streamsize>(m_stream->out.size() -
+									 zs.avail_out);
 
-		if(unlikely(m_sbuf->sputn(reinterpret_cast<char_type *>(outBuf), have) != have)) {
-			deflateEnd(&m_zstream);
+		if(unlikely(m_sbuf->sputn(reinterpret_cast<char_type *>(&m_stream->out[0]), have) !=
+					have)) {
+			m_failed = true;
 			return std::char_traits<char_type>::eof();
 		}
 
-	} while(m_zstream.avail_out == 0);
-
-	delete [] outBuf;
-	outBuf = NULL;
+	} while(zs.avail_out == 0);
 
 	pbump(-num);
 	return num;
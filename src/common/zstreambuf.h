@@ -20,8 +20,9 @@
 #ifndef NETMAUMAU_COMMON_ZSTREAMBUF_H
 #define NETMAUMAU_COMMON_ZSTREAMBUF_H
 
+#include <cstddef>                      // for size_t
 #include <streambuf>
-#include <vector>
+#include <string>
 
 #include <zlib.h>
 
@@ -31,13 +32,55 @@ namespace NetMauMau {
 
 namespace Common {
 
+/**
+ * @brief Output stream buffer compressing everything written to it
+ *
+ * The deflate streams and their buffers are taken from a pool kept per thread and are only
+ * reset after use, so creating a Zstreambuf per response doesn't allocate zlib's state over
+ * and over again.
+ */
 class _EXPORT Zstreambuf : public std::streambuf {
 	DISALLOW_COPY_AND_ASSIGN(Zstreambuf)
 public:
+	/**
+	 * @brief Framing of the compressed data
+	 *
+	 * @c RAW is a plain deflate stream, @c ZLIB is what HTTP calls @c deflate and @c GZIP
+	 * is what HTTP calls @c gzip.
+	 *
+	 * @since 0.25
+	 */
+	typedef enum { RAW, ZLIB, GZIP } FORMAT;
+
 	Zstreambuf(const std::ostream &os, int compressionLevel = Z_DEFAULT_COMPRESSION,
-			   bool flush = false) throw(Exception::ZLibException);
+			   bool flush = false, FORMAT format = RAW) throw(Exception::ZLibException);
 	virtual ~Zstreambuf();
 
+	/**
+	 * @brief Gets a compression level worth its time for a payload of @c len bytes
+	 *
+	 * Small payloads get the best compression as it costs next to nothing for them, large
+	 * ones get a faster level to not stall the thread serving them.
+	 *
+	 * @since 0.25
+	 */
+	static int compressionLevel(std::size_t len) throw() _CONST;
+
+	/**
+	 * @brief Compresses a complete payload at once
+	 *
+	 * The level is chosen by compressionLevel().
+	 *
+	 * @param out the compressed data gets appended to
+	 * @param data the payload
+	 * @param len the length of the payload
+	 * @param format the framing of the compressed data
+	 *
+	 * @since 0.25
+	 */
+	static void compress(std::string &out, const char *data, std::size_t len,
+						 FORMAT format = GZIP) throw(Exception::ZLibException);
+
 protected:
 	virtual int sync();
 	virtual int_type overflow(int_type);
@@ -46,11 +89,13 @@ private:
 	int_type deflateBuffer(int flush);
 
 private:
-	z_stream m_zstream;
+	struct PooledStream;
+	class Pool;
+
+	PooledStream *const m_stream;
 	std::streambuf *m_sbuf;
-	char_type *m_buf;
-	uLong m_deflateBound;
 	bool m_flush;
+	bool m_failed;
 };
 
 }
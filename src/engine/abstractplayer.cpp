@@ -19,10 +19,13 @@
 
 #include "abstractplayer.h"
 
+#include <algorithm>                    // for random_shuffle, iter_swap
 #include <numeric>                      // for accumulate
 #include <stdbool.h>
 
 #include "iruleset.h"                   // for IRuleSet
+#include "enginecontext.h"              // for EngineContext
+#include "enginestate.h"                // for EngineState::getCard
 #include "cardtools.h"
 #include "random_gen.h"                 // for genRandom
 #include "nullcardcountobserver.h"
@@ -31,6 +34,35 @@ namespace {
 
 const NetMauMau::IPlayedOutCards::CARDS PLAYEDOUTCARDS;
 
+class NullPlayedOutStats : public NetMauMau::IPlayedOutStats {
+	DISALLOW_COPY_AND_ASSIGN(NullPlayedOutStats)
+public:
+	inline NullPlayedOutStats() : IPlayedOutStats() {}
+
+	virtual std::size_t getCount() const _CONST {
+		return 0u;
+	}
+
+	virtual std::size_t getCount(NetMauMau::Common::ICard::SUIT) const _CONST {
+		return 0u;
+	}
+
+	virtual std::size_t getCount(NetMauMau::Common::ICard::RANK) const _CONST {
+		return 0u;
+	}
+
+	virtual std::size_t getCount(NetMauMau::Common::ICard::SUIT,
+								 NetMauMau::Common::ICard::RANK) const _CONST {
+		return 0u;
+	}
+
+	virtual uint32_t getPlayedOut() const _CONST {
+		return 0u;
+	}
+};
+
+const NullPlayedOutStats PLAYEDOUTSTATS;
+
 #pragma GCC diagnostic ignored "-Weffc++"
 #pragma GCC diagnostic push
 struct pointSum : std::binary_function < std::size_t, NetMauMau::Player::IPlayer::CARDS::value_type,
@@ -83,12 +115,14 @@ using namespace NetMauMau::Player;
 AbstractPlayer::AbstractPlayer(const std::string &name, const NetMauMau::IPlayedOutCards *poc)
 	: IPlayer(), m_lastPlayedSuit(NetMauMau::Common::ICard::SUIT_ILLEGAL),
 	  m_lastPlayedRank(NetMauMau::Common::ICard::RANK_ILLEGAL), m_name(name), m_cards(),
-	  m_cardsTaken(false), m_ruleset(0L), m_playerHasFewCards(false), m_nineIsSuspend(false),
-	  m_neighbourCount(), m_dirChgEnabled(false), m_playerCount(0), m_engineCtx(0L),
+	  m_handVersion(1ul), m_possCardsCache(), m_possCardsKey(), m_cardsTaken(false),
+	  m_ruleset(0L), m_playerHasFewCards(false), m_nineIsSuspend(false), m_neighbourCount(),
+	  m_dirChgEnabled(false), m_playerCount(0), m_engineCtx(0L),
 	  m_cardCountObserver(NetMauMau::NullCardCountObserver::getInstance()), m_poc(poc),
 	  m_avoidSuit(NetMauMau::Common::ICard::SUIT_ILLEGAL),
 	  m_avoidRank(NetMauMau::Common::ICard::RANK_ILLEGAL), m_neighbourRankSuit() {
 	m_cards.reserve(32);
+	m_possCardsCache.reserve(32);
 }
 
 AbstractPlayer::~AbstractPlayer() {}
@@ -107,6 +141,7 @@ void AbstractPlayer::setCardCountObserver(const NetMauMau::ICardCountObserver *c
 
 void AbstractPlayer::setEngineContext(const NetMauMau::EngineContext *engineCtx) {
 	m_engineCtx = engineCtx;
+	m_possCardsKey = POSSCARDSKEY();
 }
 
 void AbstractPlayer::informAIStat(const IPlayer *, std::size_t count, Common::ICard::SUIT lpSuit,
@@ -153,15 +188,29 @@ const IPlayer::CARDS &AbstractPlayer::getPlayerCards() const {
 	return m_cards;
 }
 
-IPlayer::CARDS AbstractPlayer::getPossibleCards(const NetMauMau::Common::ICardPtr &uncoveredCard,
-		const NetMauMau::Common::ICard::SUIT *suit) const {
+const IPlayer::CARDS &
+AbstractPlayer::getPossibleCards(const NetMauMau::Common::ICardPtr &uncoveredCard,
+								 const NetMauMau::Common::ICard::SUIT *suit) const {
 
-	CARDS posCards;
+	POSSCARDSKEY key;
 
-	if(m_cards.size() <= posCards.max_size()) posCards.reserve(m_cards.size());
+	key.handVersion = m_handVersion;
+	key.ruleStateVersion = m_engineCtx ? m_engineCtx->getRuleStateVersion() : 0ul;
+	key.ruleset = m_ruleset;
+	key.uncoveredCard = NetMauMau::EngineState::getCard(uncoveredCard->getSuit(),
+						uncoveredCard->getRank());
+	key.suit = suit ? *suit : NetMauMau::Common::ICard::SUIT_ILLEGAL;
 
-	return std::for_each(m_cards.begin(), m_cards.end(), _pushIfPossible(posCards, uncoveredCard,
-						 m_ruleset, suit)).cards;
+	if(!m_engineCtx || !(key == m_possCardsKey)) {
+
+		m_possCardsCache.clear();
+		std::for_each(m_cards.begin(), m_cards.end(), _pushIfPossible(m_possCardsCache,
+					  uncoveredCard, m_ruleset, suit));
+
+		m_possCardsKey = key;
+	}
+
+	return m_possCardsCache;
 }
 
 bool AbstractPlayer::isAceRoundAllowed() const {
@@ -179,10 +228,9 @@ IPlayer::REASON AbstractPlayer::getNoCardReason(const NetMauMau::Common::ICardPt
 void AbstractPlayer::receiveCardSet(const CARDS &cards) {
 
 	m_cards.insert(m_cards.end(), cards.begin(), cards.end());
+	handChanged();
 
 	if(!cards.empty()) notifyCardCountChange();
-
-	shuffleCards();
 }
 
 void AbstractPlayer::notifyCardCountChange() const throw() {
@@ -198,12 +246,20 @@ bool AbstractPlayer::cardAccepted(const NetMauMau::Common::ICard *playedCard) {
 	m_lastPlayedRank = playedCard->getRank();
 
 	if(i != m_cards.end()) {
-		m_cards.erase(i);
+
+		// the order of an AI's hand is meaningless, so no need to close the gap
+		if(getType() != HUMAN) {
+			std::iter_swap(i, m_cards.end() - 1);
+			m_cards.pop_back();
+		} else {
+			m_cards.erase(i);
+		}
+
+		handChanged();
+
 		notifyCardCountChange();
 	}
 
-	if(!m_cards.empty()) shuffleCards();
-
 	m_cardsTaken = false;
 
 	return m_cards.empty();
@@ -213,6 +269,7 @@ void AbstractPlayer::talonShuffled() {}
 
 void AbstractPlayer::pushCard(const NetMauMau::Common::ICardPtr &card) {
 	m_cards.push_back(card);
+	handChanged();
 }
 
 const NetMauMau::EngineContext *AbstractPlayer::getEngineContext() const {
@@ -227,6 +284,10 @@ const NetMauMau::IPlayedOutCards::CARDS &AbstractPlayer::getPlayedOutCards() con
 	return m_poc ? m_poc->getCards() : PLAYEDOUTCARDS;
 }
 
+const NetMauMau::IPlayedOutStats &AbstractPlayer::getPlayedOutStats() const {
+	return m_poc ? m_poc->getStats() : PLAYEDOUTSTATS;
+}
+
 std::size_t AbstractPlayer::getLeftCount() const {
 	return m_neighbourCount[LEFT];
 }
@@ -259,8 +320,9 @@ bool AbstractPlayer::isDirChgEnabled() const {
 	return m_dirChgEnabled;
 }
 
-void AbstractPlayer::shuffleCards() {
-	std::random_shuffle(m_cards.begin(), m_cards.end(),
+void AbstractPlayer::randomizeOrder(CARDS &cards) {
+
+	std::random_shuffle(cards.begin(), cards.end(),
 						NetMauMau::Common::genRandom<CARDS::difference_type>);
 }
 
@@ -273,6 +335,7 @@ void AbstractPlayer::reset() throw() {
 	m_neighbourRankSuit = NEIGHBOURRANKSUIT();
 	m_dirChgEnabled = false;
 	m_cards.clear();
+	handChanged();
 
 	notifyCardCountChange();
 }
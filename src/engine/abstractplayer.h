@@ -82,10 +82,17 @@ public:
 protected:
 	explicit AbstractPlayer(const std::string &name, const IPlayedOutCards *poc);
 
-	virtual void shuffleCards();
+	/**
+	 * @brief Shuffles @c cards
+	 *
+	 * The hand itself is not shuffled, randomness is applied only where a decision is made
+	 * on it.
+	 */
+	static void randomizeOrder(CARDS &cards);
 
 	const RuleSet::IRuleSet *getRuleSet() const _PURE;
 	const IPlayedOutCards::CARDS &getPlayedOutCards() const;
+	const IPlayedOutStats &getPlayedOutStats() const;
 	std::size_t getPlayerCount() const _PURE;
 	std::size_t getLeftCount() const _PURE;
 	std::size_t getRightCount() const _PURE;
@@ -100,9 +107,24 @@ protected:
 
 	const EngineContext *getEngineContext() const _PURE;
 
-	// cppcheck-suppress functionConst
-	CARDS getPossibleCards(const Common::ICardPtr &uncoveredCard,
-						   const Common::ICard::SUIT *suit) const;
+	/**
+	 * @brief Gets the cards of the hand playable on @c uncoveredCard
+	 *
+	 * The result is computed once per turn: it is kept until the hand, the uncovered card,
+	 * the wished suit or the state of the rule set change. Players not taking part in an
+	 * engine's game have no engine context and get their possible cards computed each time.
+	 *
+	 * @note the reference is valid until the next call
+	 */
+	const CARDS &getPossibleCards(const Common::ICardPtr &uncoveredCard,
+								  const Common::ICard::SUIT *suit) const;
+
+	/**
+	 * @brief Gets a number that changes whenever cards are added to or removed from the hand
+	 */
+	inline unsigned long getHandVersion() const {
+		return m_handVersion;
+	}
 
 	void notifyCardCountChange() const throw();
 	bool isAceRoundAllowed() const;
@@ -121,9 +143,33 @@ protected:
 	mutable Common::ICard::SUIT m_lastPlayedSuit;
 	mutable Common::ICard::RANK m_lastPlayedRank;
 
+private:
+	typedef struct _possCardsKey {
+		inline _possCardsKey() : handVersion(0ul), ruleStateVersion(0ul), ruleset(0L),
+			uncoveredCard(0xFFu), suit(Common::ICard::SUIT_ILLEGAL) {}
+
+		inline bool operator==(const _possCardsKey &o) const {
+			return handVersion == o.handVersion && ruleStateVersion == o.ruleStateVersion &&
+				   ruleset == o.ruleset && uncoveredCard == o.uncoveredCard && suit == o.suit;
+		}
+
+		unsigned long handVersion;
+		unsigned long ruleStateVersion;
+		const RuleSet::IRuleSet *ruleset;
+		unsigned char uncoveredCard; ///< <tt>suit * 8 + (rank - 7)</tt> of the uncovered card
+		Common::ICard::SUIT suit;
+	} POSSCARDSKEY;
+
+	inline void handChanged() {
+		if(!++m_handVersion) m_handVersion = 1ul;
+	}
+
 private:
 	const std::string m_name;
 	CARDS m_cards;
+	unsigned long m_handVersion;
+	mutable CARDS m_possCardsCache;
+	mutable POSSCARDSKEY m_possCardsKey;
 	mutable bool m_cardsTaken;
 	const RuleSet::IRuleSet *m_ruleset;
 	bool m_playerHasFewCards;
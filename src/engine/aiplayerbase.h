@@ -88,6 +88,7 @@ public:
 
 	virtual const CARDS &getPlayerCards() const;
 	virtual const IPlayedOutCards::CARDS &getPlayedOutCards() const;
+	virtual const IPlayedOutStats &getPlayedOutStats() const;
 	virtual void setPossibleCards(const CARDS &possCards);
 
 	virtual std::size_t getPlayerCount() const;
@@ -110,14 +111,13 @@ protected:
 						  const AI::IActionPtr &falseAct, const IPlayedOutCards *poc)
 		: AbstractPlayer(name, poc), AI::BaseAIPlayer<RootCond, RootCondJack>(trueAct, falseAct),
 		  m_powerSuit(Common::ICard::SUIT_ILLEGAL), m_powerPlay(false),
-		  m_tryAceRound(false) {}
+		  m_tryAceRound(false), m_decisionCards() {}
 
 	explicit AIPlayerBase(const std::string &name, const IPlayedOutCards *poc)
 		: AbstractPlayer(name, poc), AI::BaseAIPlayer<RootCond, RootCondJack>(),
 		  m_powerSuit(Common::ICard::SUIT_ILLEGAL), m_powerPlay(false),
-		  m_tryAceRound(false) {}
+		  m_tryAceRound(false), m_decisionCards() {}
 
-	virtual void shuffleCards();
 	virtual std::size_t getTalonFactor() const;
 	virtual bool nineIsSuspend() const;
 	virtual bool isDirChgEnabled() const;
@@ -132,6 +132,7 @@ private:
 	mutable bool m_powerPlay;
 	mutable bool m_tryAceRound;
 	Player::IPlayer::CARDS m_possCards;
+	mutable Player::IPlayer::CARDS m_decisionCards;
 };
 
 template<class RootCond, class RootCondJack>
@@ -195,11 +196,6 @@ inline void AIPlayerBase<RootCond, RootCondJack>::receiveCardSet(const CARDS &ca
 	AbstractPlayer::receiveCardSet(cards);
 }
 
-template<class RootCond, class RootCondJack>
-inline void AIPlayerBase<RootCond, RootCondJack>::shuffleCards() {
-	AbstractPlayer::shuffleCards();
-}
-
 template<class RootCond, class RootCondJack>
 inline Common::ICardPtr AIPlayerBase < RootCond,
 	   RootCondJack >::requestCard(const Common::ICardPtr &uc, const Common::ICard::SUIT *js,
@@ -209,16 +205,21 @@ std::size_t, bool noSuspend) const {
 	AI::BaseAIPlayer<RootCond, RootCondJack>::m_uncoveredCard = uc;
 	AI::BaseAIPlayer<RootCond, RootCondJack>::m_jackSuit =
 		js ? const_cast<Common::ICard::SUIT *>(js) : 0L;
+	AI::BaseAIPlayer<RootCond, RootCondJack>::m_scratchArena.reset();
+
+	m_decisionCards = getPossibleCards(uc, js);
+
+	randomizeOrder(m_decisionCards);
 
 	Common::ICardPtr bestCard(AI::BaseAIPlayer<RootCond, RootCondJack>::getDecisionChain()->
-							  getCard(getPossibleCards(uc, js)));
+							  getCard(m_decisionCards));
 
 	AI::BaseAIPlayer<RootCond, RootCondJack>::m_playedCard =
 		AI::BaseAIPlayer<RootCond, RootCondJack>::m_card = Common::ICardPtr();
 
 	if(bestCard && bestCard == Common::ICard::JACK && uc == Common::ICard::JACK) {
 		bestCard = AI::BaseAIPlayer<RootCond, RootCondJack>::getDecisionChain()->
-				   getCard(getPossibleCards(uc, js), true);
+				   getCard(m_decisionCards, true);
 	}
 
 	const Common::ICardPtr &rc(getRuleSet() ? (getRuleSet()->checkCard(uc,
@@ -269,10 +270,16 @@ getJackChoice(const Common::ICardPtr &uncoveredCard, const Common::ICardPtr &pla
 	AI::BaseAIPlayer<RootCond, RootCondJack>::m_card =
 		AI::BaseAIPlayer<RootCond, RootCondJack>::m_playedCard = playedCard;
 	AI::BaseAIPlayer<RootCond, RootCondJack>::m_uncoveredCard = uncoveredCard;
+	AI::BaseAIPlayer<RootCond, RootCondJack>::m_scratchArena.reset();
+
+	if(uc) {
+		m_decisionCards = getPossibleCards(uc, NULL);
+	} else {
+		m_decisionCards.clear();
+	}
 
 	const Common::ICardPtr &rc(AI::BaseAIPlayer < RootCond,
-							   RootCondJack >::getJackDecisionChain()->getCard(uc ?
-									   getPossibleCards(uc, NULL) : Player::IPlayer::CARDS(),
+							   RootCondJack >::getJackDecisionChain()->getCard(m_decisionCards,
 									   true));
 	assert(rc);
 
@@ -380,10 +387,19 @@ RootCondJack >::getPlayedOutCards() const {
 	return AbstractPlayer::getPlayedOutCards();
 }
 
+template<class RootCond, class RootCondJack>
+inline const IPlayedOutStats &AIPlayerBase<RootCond, RootCondJack>::getPlayedOutStats() const {
+	return AbstractPlayer::getPlayedOutStats();
+}
+
 template<class RootCond, class RootCondJack>
 inline void AIPlayerBase < RootCond,
 RootCondJack >::setPossibleCards(const Player::IPlayer::CARDS &pc) {
-	m_possCards.insert(m_possCards.end(), pc.begin(), pc.end());
+
+	// only cards not known yet are added, so the list stops growing once all cards were seen
+	for(Player::IPlayer::CARDS::const_iterator i(pc.begin()); i != pc.end(); ++i) {
+		if(!Common::find(*i, m_possCards.begin(), m_possCards.end())) m_possCards.push_back(*i);
+	}
 }
 
 template<class RootCond, class RootCondJack>
@@ -0,0 +1,303 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>
+
+#include "compactstate.h"
+
+namespace {
+
+const unsigned char JACKIDX = NetMauMau::Common::ICard::JACK - NetMauMau::Common::ICard::SEVEN;
+
+inline NetMauMau::Player::CompactState::CARD lowestCard(NetMauMau::Player::CompactState::HAND h) {
+	return static_cast<NetMauMau::Player::CompactState::CARD>(__builtin_ctz(h));
+}
+
+inline void shuffle(NetMauMau::Player::CompactState::CARD *cards, unsigned int n,
+					NetMauMau::Player::CompactState::RNG &rng) {
+	for(unsigned int i = n; i > 1u; --i) std::swap(cards[i - 1u], cards[rng.below(i)]);
+}
+
+}
+
+using namespace NetMauMau::Player;
+
+CompactState::CompactState(const OBSERVATION &obs, RNG &rng) : m_hand(),
+	m_playedOut(obs.playedOut), m_talon(), m_talonSize(0u), m_uncovered(obs.uncovered),
+	m_jackSuit(obs.jackSuit), m_takeCount(obs.takeCount),
+	m_players(static_cast<unsigned char>(std::max<unsigned int>(2u,
+										 std::min<unsigned int>(obs.players, MAXPLAYERS)))),
+	m_toMove(0u), m_winner(NOPLAYER), m_direction(1), m_suspend(false),
+	m_dirChange(obs.dirChange), m_reshuffled(false) {
+
+	HAND unknown = ~(obs.hand | obs.playedOut | (obs.uncovered != NOCARD ? bit(obs.uncovered) :
+					 0u));
+	unsigned int n = 0u;
+
+	m_hand[0] = obs.hand;
+
+	while(unknown) {
+		m_talon[n++] = lowestCard(unknown);
+		unknown &= unknown - 1u;
+	}
+
+	shuffle(m_talon, n, rng);
+
+	for(unsigned char p = 1u; p < m_players; ++p) {
+		for(unsigned int k = 0u; k < obs.count[p] && n; ++k) m_hand[p] |= bit(m_talon[--n]);
+	}
+
+	m_talonSize = static_cast<unsigned char>(n);
+}
+
+CompactState::KEY CompactState::getKey() const {
+
+	const KEY k = {
+		static_cast<uint64_t>(m_hand[0]) | (static_cast<uint64_t>(m_hand[1]) << 32u),
+		static_cast<uint32_t>((m_uncovered & 31u) | ((m_jackSuit & 7u) << 5u) |
+							  ((m_takeCount & 63u) << 8u) | (m_suspend ? 1u << 14u : 0u) |
+							  ((m_toMove & 7u) << 15u) | (m_direction < 0 ? 1u << 18u : 0u) |
+							  ((m_talonSize & 63u) << 19u))
+	};
+
+	return k;
+}
+
+bool CompactState::isPlayable(CARD c) const {
+
+	if(m_uncovered == NOCARD) return true;
+
+	if((c & 7u) == JACKIDX) return (m_uncovered & 7u) != JACKIDX;
+
+	if(m_jackSuit != NOSUIT) return (c >> 3u) == m_jackSuit;
+
+	return (c >> 3u) == (m_uncovered >> 3u) || (c & 7u) == (m_uncovered & 7u);
+}
+
+unsigned int CompactState::getMoves(MOVE *moves) const {
+
+	unsigned int n = 0u;
+
+	for(HAND h = m_hand[m_toMove]; h; h &= h - 1u) {
+
+		const CARD c = lowestCard(h);
+
+		if(isPlayable(c)) {
+			if((c & 7u) == JACKIDX) {
+				for(unsigned char s = 0u; s < 4u; ++s) moves[n++] = makeMove(c, s);
+			} else {
+				moves[n++] = c;
+			}
+		}
+	}
+
+	moves[n++] = PASS;
+
+	return n;
+}
+
+void CompactState::apply(MOVE m, RNG &rng) {
+
+	const unsigned char p = m_toMove;
+
+	if(m == PASS) {
+
+		// taking the pending sevens replaces picking a card
+		if(m_takeCount) {
+
+			take(p, m_takeCount, rng);
+			m_takeCount = 0u;
+
+		} else {
+
+			const CARD c = draw(rng);
+
+			if(c != NOCARD) {
+
+				m_hand[p] |= bit(c);
+
+				if(isPlayable(c)) play(p, c, NOSUIT);
+			}
+		}
+
+	} else {
+
+		const CARD c = getMoveCard(m);
+
+		if(m_takeCount && getRank(c) != Common::ICard::SEVEN) {
+			take(p, m_takeCount, rng);
+			m_takeCount = 0u;
+		}
+
+		play(p, c, getMoveSuit(m));
+	}
+
+	if(m_winner == NOPLAYER) nextPlayer();
+}
+
+unsigned char CompactState::playout(RNG &rng, unsigned int maxPlies) {
+
+	CARD cand[DECKSIZE];
+
+	for(unsigned int ply = 0u; m_winner == NOPLAYER && ply < maxPlies; ++ply) {
+
+		unsigned int n = 0u;
+		CARD jack = NOCARD, seven = NOCARD;
+
+		for(HAND h = m_hand[m_toMove]; h; h &= h - 1u) {
+
+			const CARD c = lowestCard(h);
+
+			if(!isPlayable(c)) continue;
+
+			if((c & 7u) == JACKIDX) {
+				jack = c;
+			} else {
+				if(getRank(c) == Common::ICard::SEVEN) seven = c;
+
+				cand[n++] = c;
+			}
+		}
+
+		if(m_takeCount && seven != NOCARD) {
+			apply(seven, rng);
+		} else if(n) {
+			apply(cand[rng.below(n)], rng);
+		} else if(jack != NOCARD) {
+			apply(makeMove(jack, getBestSuit(m_toMove)), rng);
+		} else {
+			apply(PASS, rng);
+		}
+	}
+
+	if(m_winner == NOPLAYER) {
+
+		unsigned char best = 0u;
+
+		for(unsigned char p = 1u; p < m_players; ++p) {
+			if(getCardCount(p) < getCardCount(best)) best = p;
+		}
+
+		return best;
+	}
+
+	return m_winner;
+}
+
+unsigned char CompactState::getBestSuit(unsigned char p) const {
+
+	unsigned int cnt[4] = { 0u, 0u, 0u, 0u };
+
+	for(HAND h = m_hand[p]; h; h &= h - 1u) {
+
+		const CARD c = lowestCard(h);
+
+		if((c & 7u) != JACKIDX) ++cnt[c >> 3u];
+	}
+
+	return static_cast<unsigned char>(std::distance(cnt, std::max_element(cnt, cnt + 4)));
+}
+
+CompactState::CARD CompactState::draw(RNG &rng) {
+
+	if(!m_talonSize && m_playedOut) {
+
+		m_reshuffled = true;
+
+		for(; m_playedOut; m_playedOut &= m_playedOut - 1u) {
+			m_talon[m_talonSize++] = lowestCard(m_playedOut);
+		}
+
+		shuffle(m_talon, m_talonSize, rng);
+	}
+
+	return m_talonSize ? m_talon[--m_talonSize] : static_cast<CARD>(NOCARD);
+}
+
+void CompactState::take(unsigned char p, unsigned int n, RNG &rng) {
+
+	for(unsigned int i = 0u; i < n; ++i) {
+
+		const CARD c = draw(rng);
+
+		if(c == NOCARD) break;
+
+		m_hand[p] |= bit(c);
+	}
+}
+
+void CompactState::play(unsigned char p, CARD c, unsigned char suit) {
+
+	m_hand[p] &= ~bit(c);
+
+	if(m_uncovered != NOCARD) m_playedOut |= bit(m_uncovered);
+
+	m_uncovered = c;
+	m_jackSuit = NOSUIT;
+
+	if(!m_hand[p]) {
+		m_winner = p;
+		return;
+	}
+
+	switch(getRank(c)) {
+	case Common::ICard::SEVEN:
+		m_takeCount = static_cast<unsigned char>(m_takeCount + 2u);
+		break;
+
+	case Common::ICard::EIGHT:
+		m_suspend = true;
+		break;
+
+	case Common::ICard::NINE:
+
+		if(m_dirChange) {
+			if(m_players > 2u) {
+				m_direction = static_cast<signed char>(-m_direction);
+			} else {
+				m_suspend = true;
+			}
+		}
+
+		break;
+
+	case Common::ICard::JACK:
+		m_jackSuit = suit == NOSUIT ? getBestSuit(p) : suit;
+		break;
+
+	default:
+		break;
+	}
+}
+
+void CompactState::nextPlayer() {
+
+	m_toMove = static_cast<unsigned char>((m_toMove + m_players + m_direction) % m_players);
+
+	if(m_suspend) {
+		m_suspend = false;
+		m_toMove = static_cast<unsigned char>((m_toMove + m_players + m_direction) % m_players);
+	}
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_PLAYER_COMPACTSTATE_H
+#define NETMAUMAU_PLAYER_COMPACTSTATE_H
+
+#include <stdint.h>
+
+#include "icard.h"
+
+namespace NetMauMau {
+
+namespace Player {
+
+/**
+ * @brief Compact model of a single deck game for simulations
+ *
+ * Cards are identified by <tt>suit * 8 + (rank - 7)</tt>, hands are bitsets of these ids.
+ * Player @c 0 is always the player the simulation is run for, the other players follow in
+ * playing order. Ace rounds are not modelled.
+ */
+class CompactState {
+public:
+	typedef unsigned char CARD;
+	typedef unsigned char MOVE;
+	typedef uint32_t HAND;
+
+	enum {
+		DECKSIZE = 32u,
+		MAXPLAYERS = 8u,
+		MAXMOVES = 64u,
+		NOCARD = 0xFFu,
+		NOSUIT = 0xFFu,
+		NOPLAYER = 0xFFu,
+		PASS = 0x80u
+	};
+
+	class RNG {
+	public:
+		inline explicit RNG(uint32_t seed) : m_state(seed ? seed : 0x9E3779B9u) {}
+
+		inline uint32_t next() {
+			m_state ^= m_state << 13;
+			m_state ^= m_state >> 17;
+			m_state ^= m_state << 5;
+			return m_state;
+		}
+
+		inline uint32_t below(uint32_t n) {
+			return n ? next() % n : 0u;
+		}
+
+	private:
+		uint32_t m_state;
+	};
+
+	/**
+	 * @brief What player @c 0 knows about the game
+	 */
+	typedef struct _observation {
+
+		inline _observation() : hand(0u), playedOut(0u), uncovered(NOCARD), jackSuit(NOSUIT),
+			takeCount(0u), players(0u), count(), dirChange(false) {}
+
+		HAND hand; ///< cards of player @c 0
+		HAND playedOut; ///< played out cards below the uncovered card
+		CARD uncovered;
+		unsigned char jackSuit;
+		unsigned char takeCount;
+		unsigned char players;
+		unsigned char count[MAXPLAYERS]; ///< amount of cards per player
+		bool dirChange;
+
+	} OBSERVATION;
+
+	/**
+	 * @brief Packed position of a two player game
+	 *
+	 * Both hands as bitsets, the uncovered card, the jack suit, pending take and suspend,
+	 * direction, player to move and the talon size.
+	 */
+	typedef struct _key {
+		uint64_t hands;
+		uint32_t misc;
+	} KEY;
+
+	/**
+	 * @brief Creates a determinization of @c obs
+	 *
+	 * The hidden cards are dealt randomly to the opponents and the talon.
+	 */
+	explicit CompactState(const OBSERVATION &obs, RNG &rng);
+
+	static inline CARD getCard(Common::ICard::SUIT s, Common::ICard::RANK r) {
+		return static_cast<CARD>((static_cast<unsigned int>(s) << 3u) +
+								 (static_cast<unsigned int>(r) - Common::ICard::SEVEN));
+	}
+
+	static inline Common::ICard::SUIT getSuit(CARD c) {
+		return static_cast<Common::ICard::SUIT>(c >> 3u);
+	}
+
+	static inline Common::ICard::RANK getRank(CARD c) {
+		return static_cast<Common::ICard::RANK>((c & 7u) + Common::ICard::SEVEN);
+	}
+
+	static inline HAND bit(CARD c) {
+		return static_cast<HAND>(1u) << c;
+	}
+
+	static inline MOVE makeMove(CARD c, unsigned char suit = 0u) {
+		return static_cast<MOVE>(c | (getRank(c) == Common::ICard::JACK ? (suit << 5u) : 0u));
+	}
+
+	static inline CARD getMoveCard(MOVE m) {
+		return static_cast<CARD>(m & 31u);
+	}
+
+	static inline unsigned char getMoveSuit(MOVE m) {
+		return static_cast<unsigned char>((m >> 5u) & 3u);
+	}
+
+	inline unsigned char getPlayers() const {
+		return m_players;
+	}
+
+	inline unsigned char getPlayerToMove() const {
+		return m_toMove;
+	}
+
+	inline unsigned char getWinner() const {
+		return m_winner;
+	}
+
+	inline bool isTerminal() const {
+		return m_winner != NOPLAYER;
+	}
+
+	inline std::size_t getCardCount(unsigned char p) const {
+		return static_cast<std::size_t>(__builtin_popcount(m_hand[p]));
+	}
+
+	/**
+	 * @brief Checks if the played out cards got reshuffled into the talon
+	 *
+	 * The order of the reshuffled cards is random, thus a state is no longer a determinization
+	 * of the observation alone once this happened.
+	 */
+	inline bool hasReshuffled() const {
+		return m_reshuffled;
+	}
+
+	KEY getKey() const _PURE;
+
+	bool isPlayable(CARD c) const _PURE;
+
+	/**
+	 * @brief Generates all legal moves of the player to move
+	 *
+	 * Jacks are generated once per wishable suit. @c PASS (take/pick a card) is always legal.
+	 *
+	 * @param moves buffer of at least @c MAXMOVES entries
+	 * @return the amount of generated moves
+	 */
+	unsigned int getMoves(MOVE *moves) const;
+
+	void apply(MOVE m, RNG &rng);
+
+	/**
+	 * @brief Plays the game out with a fast randomized policy
+	 *
+	 * @return the winner, or the player with fewest cards if @c maxPlies is exceeded
+	 */
+	unsigned char playout(RNG &rng, unsigned int maxPlies = 256u);
+
+	unsigned char getBestSuit(unsigned char p) const _PURE;
+
+private:
+	CARD draw(RNG &rng);
+	void take(unsigned char p, unsigned int n, RNG &rng);
+	void play(unsigned char p, CARD c, unsigned char suit);
+	void nextPlayer();
+
+private:
+	HAND m_hand[MAXPLAYERS];
+	HAND m_playedOut;
+	CARD m_talon[DECKSIZE];
+	unsigned char m_talonSize;
+	CARD m_uncovered;
+	unsigned char m_jackSuit;
+	unsigned char m_takeCount;
+	unsigned char m_players;
+	unsigned char m_toMove;
+	unsigned char m_winner;
+	signed char m_direction;
+	bool m_suspend;
+	bool m_dirChange;
+	bool m_reshuffled;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_PLAYER_COMPACTSTATE_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,275 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "endgamesolver.h"
+
+namespace {
+
+enum { EXACT, LOWER, UPPER };
+
+const int WIN = 1;
+const int INF = 2;
+const unsigned long CHECK_TIME = 4095ul;
+
+// one random number per bit of the packed position
+class Zobrist {
+	DISALLOW_COPY_AND_ASSIGN(Zobrist)
+public:
+	Zobrist() : m_keys() {
+
+		uint64_t x = 0x2545F4914F6CDD1DULL;
+
+		for(unsigned int i = 0u; i < 96u; ++i) {
+
+			// splitmix64
+			uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+
+			z = (z ^ (z >> 30u)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27u)) * 0x94D049BB133111EBULL;
+			m_keys[i] = z ^ (z >> 31u);
+		}
+	}
+
+	inline uint64_t operator()(const NetMauMau::Player::CompactState::KEY &k) const {
+
+		uint64_t h = 0u;
+
+		for(uint64_t b = k.hands; b; b &= b - 1u) h ^= m_keys[__builtin_ctzll(b)];
+
+		for(uint32_t b = k.misc; b; b &= b - 1u) h ^= m_keys[64u + __builtin_ctz(b)];
+
+		return h;
+	}
+
+private:
+	uint64_t m_keys[96];
+};
+
+const Zobrist zobrist;
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+std::size_t roundUp(std::size_t n) {
+
+	std::size_t s = 1u;
+
+	while(s < n) s <<= 1u;
+
+	return s;
+}
+
+}
+
+using namespace NetMauMau::Player;
+
+EndgameSolver::EndgameSolver(std::size_t tableSize, unsigned int maxDepth)
+	: m_table(roundUp(std::max<std::size_t>(1024u, tableSize))), m_mask(m_table.size() - 1u),
+	  m_maxDepth(std::min(255u, std::max(1u, maxDepth))), m_generation(0u), m_rng(1u),
+	  m_nodes(0ul), m_probes(0ul), m_hits(0ul), m_solved(0ul), m_elapsed(0.0), m_deadline(0.0),
+	  m_aborted(false) {}
+
+EndgameSolver::~EndgameSolver() {}
+
+double EndgameSolver::estimateNodes(const CompactState::OBSERVATION &obs) {
+
+	const double c0 = obs.count[0], c1 = obs.count[1];
+	const unsigned int unknown = static_cast<unsigned int>(__builtin_popcount(~(obs.hand |
+								 obs.playedOut | CompactState::bit(obs.uncovered))));
+	const unsigned int talon = unknown > obs.count[1] ? unknown - obs.count[1] : 0u;
+
+	// every card can be played at about every turn, every talon card may be drawn
+	return std::pow(c0 + 1.0, c0) * std::pow(c1 + 1.0, c1) *
+		   std::pow(2.0, static_cast<double>(std::min(talon, 24u)));
+}
+
+bool EndgameSolver::solve(const CompactState::OBSERVATION &obs, long budget, uint32_t seed,
+						  CompactState::MOVE &move) {
+
+	const double start = now();
+	const unsigned int unknown = static_cast<unsigned int>(__builtin_popcount(~(obs.hand |
+								 obs.playedOut | CompactState::bit(obs.uncovered))));
+	const bool exact = unknown <= obs.count[1];
+
+	CompactState::RNG rng(seed);
+	CompactState::MOVE moves[CompactState::MAXMOVES];
+	int score[256];
+	bool legal[256];
+
+	std::fill(score, score + 256, 0);
+	std::fill(legal, legal + 256, false);
+
+	m_nodes = m_probes = m_hits = m_solved = 0ul;
+	m_deadline = start + static_cast<double>(budget) / 1000.0;
+	m_aborted = false;
+
+	do {
+
+		CompactState s(obs, rng);
+
+		if(!++m_generation) {
+			const ENTRY e = { 0u, 0u, 0u, 0, 0u, EXACT, CompactState::PASS };
+			std::fill(m_table.begin(), m_table.end(), e);
+			m_generation = 1u;
+		}
+
+		const unsigned int n = s.getMoves(moves);
+		int val[CompactState::MAXMOVES];
+
+		for(unsigned int i = 0u; i < n && !m_aborted; ++i) {
+
+			CompactState c(s);
+
+			c.apply(moves[i], m_rng);
+
+			const int v = negamax(c, -INF, INF, m_maxDepth);
+
+			val[i] = c.getPlayerToMove() ? -v : v;
+		}
+
+		if(m_aborted) break;
+
+		for(unsigned int i = 0u; i < n; ++i) {
+			legal[moves[i]] = true;
+			score[moves[i]] += val[i];
+		}
+
+		++m_solved;
+
+	} while(!exact && now() < m_deadline);
+
+	m_elapsed = now() - start;
+
+	if(!m_solved) return false;
+
+	bool found = false;
+
+	// on equal scores cards are preferred to passing
+	for(unsigned int m = 0u; m < 256u; ++m) {
+		if(legal[m] && (!found || score[m] > score[move])) {
+			move = static_cast<CompactState::MOVE>(m);
+			found = true;
+		}
+	}
+
+	return true;
+}
+
+int EndgameSolver::negamax(const CompactState &s, int alpha, int beta, unsigned int depth) {
+
+	if(!(++m_nodes & CHECK_TIME) && now() >= m_deadline) m_aborted = true;
+
+	if(m_aborted) return 0;
+
+	if(s.isTerminal()) return s.getWinner() == s.getPlayerToMove() ? WIN : -WIN;
+
+	// the order of the reshuffled cards is unknown
+	if(!depth || s.hasReshuffled()) return 0;
+
+	const CompactState::KEY k = s.getKey();
+	ENTRY &e(m_table[zobrist(k) & m_mask]);
+	CompactState::MOVE ttMove = CompactState::NOCARD;
+
+	++m_probes;
+
+	if(e.generation == m_generation && e.hands == k.hands && e.misc == k.misc) {
+
+		++m_hits;
+		ttMove = e.best;
+
+		// a proven win or loss holds for any remaining depth
+		if(e.depth >= depth || e.value) {
+
+			if(e.flag == EXACT) return e.value;
+
+			if(e.flag == LOWER) {
+				alpha = std::max<int>(alpha, e.value);
+			} else {
+				beta = std::min<int>(beta, e.value);
+			}
+
+			if(alpha >= beta) return e.value;
+		}
+	}
+
+	CompactState::MOVE moves[CompactState::MAXMOVES];
+	const unsigned int n = s.getMoves(moves);
+
+	for(unsigned int i = 1u; i < n; ++i) {
+		if(moves[i] == ttMove) {
+			std::swap(moves[0], moves[i]);
+			break;
+		}
+	}
+
+	const int alpha0 = alpha;
+	int best = -INF;
+	CompactState::MOVE bestMove = moves[0];
+
+	for(unsigned int i = 0u; i < n; ++i) {
+
+		CompactState c(s);
+
+		c.apply(moves[i], m_rng);
+
+		// the same player moves again if the opponent got suspended
+		const int v = c.getPlayerToMove() == s.getPlayerToMove() ?
+					  negamax(c, alpha, beta, depth - 1u) : -negamax(c, -beta, -alpha, depth - 1u);
+
+		if(m_aborted) return 0;
+
+		if(v > best) {
+			best = v;
+			bestMove = moves[i];
+		}
+
+		if((alpha = std::max(alpha, v)) >= beta) break;
+	}
+
+	e.hands = k.hands;
+	e.misc = k.misc;
+	e.generation = m_generation;
+	e.value = static_cast<signed char>(best);
+	e.depth = static_cast<unsigned char>(depth);
+	e.flag = static_cast<unsigned char>(best <= alpha0 ? UPPER : (best >= beta ? LOWER : EXACT));
+	e.best = bestMove;
+
+	return best;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_PLAYER_ENDGAMESOLVER_H
+#define NETMAUMAU_PLAYER_ENDGAMESOLVER_H
+
+#include <vector>
+
+#include "compactstate.h"
+
+namespace NetMauMau {
+
+namespace Player {
+
+/**
+ * @brief Alpha-beta solver for two player endgames
+ *
+ * Each determinization of the observation is solved exactly (win, loss or undecided within
+ * @c maxDepth plies) with a fixed-size, Zobrist-hashed transposition table. Drawing from an
+ * empty talon reshuffles the played out cards like the engine does, but as the order of the
+ * reshuffled cards is unknown, such positions are rated as undecided. If no card is hidden in
+ * the talon a single determinization is exact, otherwise the root moves are rated by the
+ * amount of determinizations they win.
+ */
+class EndgameSolver {
+	DISALLOW_COPY_AND_ASSIGN(EndgameSolver)
+public:
+	explicit EndgameSolver(std::size_t tableSize = 1u << 17u, unsigned int maxDepth = 48u);
+	~EndgameSolver();
+
+	/**
+	 * @brief Rough estimate of the nodes needed to solve a determinization of @c obs
+	 */
+	static double estimateNodes(const CompactState::OBSERVATION &obs) _PURE;
+
+	/**
+	 * @brief Solves the observation of player @c 0
+	 *
+	 * @param obs the observation of a two player game
+	 * @param budget the time budget in milliseconds
+	 * @param seed seed of the determinizations
+	 * @param move receives the best move
+	 *
+	 * @return @c false if not even one determinization could be solved within @c budget
+	 */
+	bool solve(const CompactState::OBSERVATION &obs, long budget, uint32_t seed,
+			   CompactState::MOVE &move);
+
+	inline unsigned long getNodes() const {
+		return m_nodes;
+	}
+
+	inline double getNodesPerSecond() const {
+		return m_elapsed > 0.0 ? static_cast<double>(m_nodes) / m_elapsed : 0.0;
+	}
+
+	inline double getHitRate() const {
+		return m_probes ? static_cast<double>(m_hits) / m_probes : 0.0;
+	}
+
+	inline unsigned long getDeterminizations() const {
+		return m_solved;
+	}
+
+	/**
+	 * @brief Gets the milliseconds spent by the last call of solve()
+	 */
+	inline long getElapsed() const {
+		return static_cast<long>(m_elapsed * 1000.0);
+	}
+
+private:
+	typedef struct _entry {
+		uint64_t hands;
+		uint32_t misc;
+		uint16_t generation;
+		signed char value;
+		unsigned char depth;
+		unsigned char flag;
+		CompactState::MOVE best;
+	} ENTRY;
+
+	int negamax(const CompactState &s, int alpha, int beta, unsigned int depth);
+
+private:
+	std::vector<ENTRY> m_table;
+	const std::size_t m_mask;
+	const unsigned int m_maxDepth;
+	uint16_t m_generation;
+	CompactState::RNG m_rng;
+	unsigned long m_nodes;
+	unsigned long m_probes;
+	unsigned long m_hits;
+	unsigned long m_solved;
+	double m_elapsed;
+	double m_deadline;
+	bool m_aborted;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_PLAYER_ENDGAMESOLVER_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
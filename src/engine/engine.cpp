@@ -85,8 +85,9 @@ using namespace NetMauMau;
 Engine::Engine(EngineContext &ctx) throw(Common::Exception::SocketException) : ITalonChange(),
 	IAceRoundListener(), ICardCountObserver(), m_ctx(ctx), m_nextTurn(0L), m_state(ACCEPT_PLAYERS),
 	m_talon(new Talon(this, ctx.getTalonFactor())), m_players(), m_turn(1), m_curTurn(0),
-	m_ultimate(false), m_alwaysWait(false), m_initialNextMessage(ctx.getNextMessage()),
-	m_gameIndex(0LL), m_dirChangeEnabled(false), m_talonUnderflow(false), m_aiCount(0) {
+	m_winner(0L), m_ultimate(false), m_alwaysWait(false),
+	m_initialNextMessage(ctx.getNextMessage()), m_gameIndex(0LL), m_dirChangeEnabled(false),
+	m_talonUnderflow(false), m_reversed(false), m_aiCount(0) {
 	m_players.reserve(5);
 
 	try {
@@ -241,6 +242,7 @@ bool Engine::distributeCards() throw(Common::Exception::SocketException) {
 
 		m_turn = 1u;
 		m_curTurn = 0u;
+		m_reversed = false;
 		m_state = PLAYING;
 
 		getRuleSet()->setCurPlayers(m_players.size());
@@ -362,6 +364,94 @@ const IPlayedOutCards *Engine::getPlayedOutCards() const {
 	return m_talon;
 }
 
+bool Engine::exportState(EngineState &state) const {
+
+	if(m_state != PLAYING || !m_nextTurn || m_players.size() > EngineState::MAXPLAYERS) {
+		return false;
+	}
+
+	RuleSet::IRuleSet *ruleSet = const_cast<Engine *>(this)->getRuleSet();
+
+	state.clear();
+
+	if(ruleSet->isAceRound() || !m_talon->exportState(state)) return false;
+
+	for(PLAYERS::size_type i = 0u; i < m_players.size(); ++i) {
+
+		const Player::IPlayer::CARDS &cards(m_players[i]->getPlayerCards());
+
+		for(Player::IPlayer::CARDS::const_iterator c(cards.begin()); c != cards.end(); ++c) {
+			if(!state.addCard(static_cast<unsigned char>(i),
+							  EngineState::getCard((*c)->getSuit(), (*c)->getRank()))) return false;
+		}
+	}
+
+	const bool jackMode = ruleSet->isJackMode();
+
+	state.players = static_cast<unsigned char>(m_players.size());
+	state.decks = static_cast<unsigned char>(m_ctx.getTalonFactor());
+	state.turn = static_cast<uint16_t>(m_turn);
+	state.takeCount = static_cast<unsigned char>(ruleSet->takeCardCount());
+	state.jackSuit = static_cast<unsigned char>(jackMode ? ruleSet->getJackSuit() :
+					 Common::ICard::SUIT_ILLEGAL);
+	state.reversed = m_reversed;
+	state.suspend = ruleSet->hasToSuspend();
+	state.dirChangeIsSuspend = ruleSet->getDirChangeIsSuspend();
+	state.talonUnderflow = m_talonUnderflow;
+
+	m_nextTurn->exportState(state);
+
+	return true;
+}
+
+bool Engine::importState(const EngineState &state) throw(Common::Exception::SocketException) {
+
+	if(m_state != PLAYING || !m_nextTurn || state.players != m_players.size() ||
+			state.nextPlayer >= state.players || !m_talon->canImportState(state)) return false;
+
+	RuleSet::IRuleSet *ruleSet = getRuleSet();
+
+	// nothing is changed yet if the rule set can't take the state
+	if(!ruleSet->setState(state.takeCount, state.suspend,
+						  static_cast<Common::ICard::SUIT>(state.jackSuit))) return false;
+
+	m_talon->importState(state);
+	m_ctx.ruleStateChanged();
+
+	ruleSet->setDirChangeIsSuspend(state.dirChangeIsSuspend);
+
+	if(state.reversed != m_reversed) {
+		std::reverse(m_players.begin(), m_players.end());
+		m_reversed = state.reversed;
+	}
+
+	for(PLAYERS::size_type i = 0u; i < m_players.size(); ++i) {
+
+		Player::IPlayer::CARDS cards;
+
+		for(unsigned int d = 0u; d < EngineState::MAXDECKS; ++d) {
+			for(EngineState::HAND h = state.hand[i][d]; h; h &= h - 1u) {
+				cards.push_back(Talon::getCard(static_cast<EngineState::CARD>(__builtin_ctz(h))));
+			}
+		}
+
+		m_players[i]->reset();
+		m_players[i]->setRuleSet(ruleSet);
+		m_players[i]->setEngineContext(&m_ctx);
+		m_players[i]->setCardCountObserver(this);
+		m_players[i]->setDirChangeEnabled(m_dirChangeEnabled);
+		m_players[i]->setNineIsSuspend(state.dirChangeIsSuspend);
+		m_players[i]->receiveCardSet(cards);
+	}
+
+	m_turn = m_curTurn = state.turn;
+	m_talonUnderflow = state.talonUnderflow;
+
+	m_nextTurn->importState(state);
+
+	return true;
+}
+
 void Engine::reset() throw() {
 
 	m_state = ACCEPT_PLAYERS;
@@ -375,12 +465,14 @@ void Engine::reset() throw() {
 		logDebug(e);
 	}
 
+	m_ctx.ruleStateChanged();
+
 	removePlayers();
 
 	m_curTurn = 0u;
 	m_turn = 1u;
 
-	m_alwaysWait = m_talonUnderflow = false;
+	m_alwaysWait = m_talonUnderflow = m_reversed = false;
 
 	m_ctx.setNextMessage(m_initialNextMessage);
 
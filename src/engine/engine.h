@@ -23,6 +23,7 @@
 #include <cstddef>                      // for size_t, NULL
 #include <vector>                       // for vector
 
+#include "enginestate.h"                // for EngineState
 #include "iaceroundlistener.h"          // for IAceRoundListener
 #include "icardcountobserver.h"         // for ICardCountObserver
 #include "italonchange.h"               // for ITalonChange
@@ -94,6 +95,17 @@ public:
 	void initialTurn() throw(Common::Exception::SocketException);
 	bool nextTurn() throw(Common::Exception::SocketException);
 
+	inline std::size_t getTurn() const throw() {
+		return m_turn;
+	}
+
+	/**
+	 * @brief Gets the player who just won, while the observers get notified of the removal
+	 */
+	inline const Player::IPlayer *getWinner() const throw() {
+		return m_winner;
+	}
+
 	void message(const std::string &msg) const throw(Common::Exception::SocketException);
 	void error(const std::string &msg) const throw();
 
@@ -102,6 +114,26 @@ public:
 
 	const NetMauMau::IPlayedOutCards *getPlayedOutCards() const _PURE;
 
+	/**
+	 * @brief Takes a snapshot of the running game
+	 *
+	 * @return @c false if the game isn't running, is in an ace round or exceeds the limits
+	 * of EngineState
+	 */
+	bool exportState(EngineState &state) const;
+
+	/**
+	 * @brief Continues the running game from a snapshot
+	 *
+	 * The engine has to run a game with the same players in the same order and the same
+	 * amount of decks the snapshot was taken from. The players' hands are replaced,
+	 * the players get reset.
+	 *
+	 * @return @c false if the snapshot doesn't match the game or the rule set cannot restore
+	 * its state, the game is left unchanged then
+	 */
+	bool importState(const EngineState &state) throw(Common::Exception::SocketException);
+
 	void reset() throw();
 
 protected:
@@ -147,6 +179,7 @@ private:
 	PLAYERS m_players;
 	std::size_t m_turn;
 	std::size_t m_curTurn;
+	const Player::IPlayer *m_winner;
 
 	bool m_ultimate;
 	bool m_alwaysWait;
@@ -155,6 +188,7 @@ private:
 	DB::GAMEIDX m_gameIndex;
 	bool m_dirChangeEnabled;
 	bool m_talonUnderflow;
+	bool m_reversed;
 
 	std::size_t m_aiCount;
 };
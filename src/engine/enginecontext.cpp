@@ -50,12 +50,13 @@ EngineContext::EngineContext(Event::IEventHandler &eventHandler, bool dirChange,
 			(aceRound == 'Q' ? Common::ICard::QUEEN : (aceRound == 'K' ?
 					Common::ICard::KING : Common::ICard::RANK_ILLEGAL))), m_ruleset(0L),
 	m_aceRound(aceRound), m_talonFactor(cc.decks),
-	m_initialCardCount(cc.initialCards) {}
+	m_initialCardCount(cc.initialCards), m_ruleStateVersion(1ul) {}
 
 EngineContext::EngineContext(const EngineContext &o) : m_eventHandler(o.m_eventHandler),
 	m_dirChange(o.m_dirChange), m_aiDelay(o.m_aiDelay), m_nextMessage(o.m_nextMessage),
 	m_aceRoundRank(o.m_aceRoundRank), m_ruleset(o.m_ruleset), m_aceRound(o.m_aceRound),
-	m_talonFactor(o.m_talonFactor), m_initialCardCount(o.m_initialCardCount) {}
+	m_talonFactor(o.m_talonFactor), m_initialCardCount(o.m_initialCardCount),
+	m_ruleStateVersion(o.m_ruleStateVersion) {}
 
 EngineContext::~EngineContext() {
 	delete m_ruleset;
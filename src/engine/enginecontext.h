@@ -82,6 +82,17 @@ public:
 		return m_talonFactor;
 	}
 
+	/**
+	 * @brief Gets a number that changes whenever the engine changed the state of the rule set
+	 */
+	inline unsigned long getRuleStateVersion() const {
+		return m_ruleStateVersion;
+	}
+
+	inline void ruleStateChanged() {
+		if(!++m_ruleStateVersion) m_ruleStateVersion = 1ul;
+	}
+
 private:
 	static std::vector<std::string> getLuaScriptPaths();
 
@@ -95,6 +106,7 @@ private:
 	const char m_aceRound;
 	const std::size_t m_talonFactor;
 	const std::size_t m_initialCardCount;
+	unsigned long m_ruleStateVersion;
 };
 
 }
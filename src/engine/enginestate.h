@@ -0,0 +1,120 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_ENGINESTATE_H
+#define NETMAUMAU_ENGINESTATE_H
+
+#include <cstring>
+#include <stdint.h>
+
+#include "icard.h"
+
+namespace NetMauMau {
+
+/**
+ * @brief Snapshot of a running game as plain value
+ *
+ * Cards are identified by <tt>suit * 8 + (rank - 7)</tt>. A hand is a bitset of these ids per
+ * deck, i.e. layer @c n holds the cards a player has at least <tt>n + 1</tt> times.
+ * Players are stored in the current playing order of the engine.
+ *
+ * The type holds no pointers, copying it is a plain @c memcpy.
+ *
+ * @see Engine::exportState
+ * @see Engine::importState
+ */
+typedef struct _engineState {
+
+	typedef unsigned char CARD;
+	typedef uint32_t HAND;
+
+	enum {
+		MAXPLAYERS = 8u,
+		MAXDECKS = 4u,
+		MAXCARDS = 32u * MAXDECKS,
+		NOCARD = 0xFFu
+	};
+
+	static inline CARD getCard(Common::ICard::SUIT s, Common::ICard::RANK r) {
+		return static_cast<CARD>((static_cast<unsigned int>(s) << 3u) +
+								 (static_cast<unsigned int>(r) - Common::ICard::SEVEN));
+	}
+
+	static inline Common::ICard::SUIT getSuit(CARD c) {
+		return static_cast<Common::ICard::SUIT>(c >> 3u);
+	}
+
+	static inline Common::ICard::RANK getRank(CARD c) {
+		return static_cast<Common::ICard::RANK>((c & 7u) + Common::ICard::SEVEN);
+	}
+
+	inline void clear() {
+		std::memset(this, 0, sizeof(*this));
+	}
+
+	inline bool addCard(unsigned char p, CARD c) {
+
+		for(unsigned int d = 0u; d < MAXDECKS; ++d) {
+			if(!(hand[p][d] & (static_cast<HAND>(1u) << c))) {
+				hand[p][d] |= static_cast<HAND>(1u) << c;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline std::size_t getCardCount(unsigned char p) const {
+
+		std::size_t n = 0u;
+
+		for(unsigned int d = 0u; d < MAXDECKS; ++d) {
+			n += static_cast<std::size_t>(__builtin_popcount(hand[p][d]));
+		}
+
+		return n;
+	}
+
+	HAND hand[MAXPLAYERS][MAXDECKS];
+	CARD talon[MAXCARDS]; ///< the talon, top card last
+	CARD uncovered[MAXCARDS]; ///< the played out cards, uncovered card last
+	uint16_t turn;
+	unsigned char talonSize;
+	unsigned char uncoveredSize;
+	unsigned char players;
+	unsigned char decks;
+	unsigned char nextPlayer; ///< index of the player to move next
+	unsigned char takeCount; ///< cards to take due to played sevens
+	unsigned char jackSuit; ///< wished suit, or Common::ICard::SUIT_ILLEGAL
+	bool reversed; ///< the playing order got reversed by an odd number of direction changes
+	bool suspend;
+	bool jackMode;
+	bool initialJack;
+	bool dirChangeIsSuspend;
+	bool talonUnderflow;
+
+} EngineState;
+
+typedef char _engineStateFitsInOneKilobyte[sizeof(EngineState) < 1024u ? 1 : -1];
+
+}
+
+#endif /* NETMAUMAU_ENGINESTATE_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
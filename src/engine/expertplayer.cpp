@@ -0,0 +1,323 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"                     // IWYU pragma: keep
+#endif
+
+#include <algorithm>
+
+#if defined(TRACE_AI) && !defined(NDEBUG)
+#include <cstdio>
+#endif
+
+#include "expertplayer.h"
+
+#include "jackonlycondition.h"          // for JackOnlyCondition
+#include "powerjackcondition.h"         // for PowerJackCondition
+
+#include "random_gen.h"                 // for genRandom
+
+namespace {
+#pragma GCC diagnostic ignored "-Weffc++"
+#pragma GCC diagnostic push
+struct _isPlayer : std::binary_function<std::pair<const NetMauMau::Player::IPlayer *,
+		std::size_t>, const NetMauMau::Player::IPlayer *, bool> {
+	inline result_type operator()(const first_argument_type &x,
+								  const second_argument_type &y) const {
+		return x.first == y;
+	}
+};
+#pragma GCC diagnostic pop
+
+// the endgame solver may use at most 1/SOLVER_SHARE of the budget, the search gets the rest
+const long SOLVER_SHARE = 2L;
+}
+
+using namespace NetMauMau::Player;
+
+ExpertPlayer::ExpertPlayer(const std::string &name, const NetMauMau::IPlayedOutCards *poc,
+						   long budget, unsigned int threads, double solverNodes)
+	: AIPlayerBase<AI::JackOnlyCondition, AI::PowerJackCondition>(name, poc),
+	  m_budget(std::max(1L, budget)), m_solverNodes(solverNodes), m_search(threads),
+	  m_solver(), m_treeValid(false),
+	  m_lastMove(CompactState::PASS), m_playedOutSize(0u), m_oppCount(0u), m_pendingTake(0u),
+	  m_jackChoice(Common::ICard::SUIT_ILLEGAL), m_stats() {}
+
+ExpertPlayer::~ExpertPlayer() throw() {}
+
+IPlayer::TYPE ExpertPlayer::getType() const throw() {
+	return EXPERT;
+}
+
+NetMauMau::Common::ICardPtr
+ExpertPlayer::requestCard(const NetMauMau::Common::ICardPtr &uc,
+						  const NetMauMau::Common::ICard::SUIT *js, std::size_t takeCount,
+						  bool noSuspend) const {
+
+	CompactState::OBSERVATION obs;
+
+	m_jackChoice = Common::ICard::SUIT_ILLEGAL;
+
+	if(noSuspend || !observe(obs, uc, js, takeCount)) {
+		m_treeValid = false;
+		return AIPlayerBase<AI::JackOnlyCondition, AI::PowerJackCondition>::requestCard(uc, js,
+				takeCount, noSuspend);
+	}
+
+	if(getPossibleCards(uc, js).empty()) {
+		m_treeValid = false;
+		return Common::ICardPtr();
+	}
+
+	CompactState::MOVE m = CompactState::PASS;
+	long spent = 0L;
+
+	if(solveEndgame(obs, m, spent)) {
+
+		m_search.reset();
+
+	} else {
+
+		if(m_treeValid) {
+			reuseTree(obs);
+		} else {
+			m_search.reset();
+		}
+
+		m = m_search.search(obs, std::max(1L, m_budget - spent),
+							Common::genRandom<uint32_t>(0xFFFFFFFFu));
+
+#if defined(TRACE_AI) && !defined(NDEBUG)
+
+		if(!getenv("NMM_NO_TRACE")) logDebug("-> trace of AI \"" << getName() << "\" -> ISMCTS: "
+												 << m_search.getPlayouts() << " playouts ("
+												 << static_cast<unsigned long>
+												 (m_search.getPlayoutsPerSecond())
+												 << "/s) on " << m_search.getThreads()
+												 << " thread(s) <-");
+
+#endif
+	}
+
+	if(m == CompactState::PASS) {
+		m_treeValid = false;
+		return Common::ICardPtr();
+	}
+
+	const CompactState::CARD c = CompactState::getMoveCard(m);
+	const Common::ICardPtr card(findCard(c));
+	const CARDS &pc(getPossibleCards(uc, js));
+
+	// the model doesn't know every rule, a move the rules reject is left to the decision chain
+	if(!card || std::find(pc.begin(), pc.end(), card) == pc.end()) {
+		m_treeValid = false;
+		return AIPlayerBase<AI::JackOnlyCondition, AI::PowerJackCondition>::requestCard(uc, js,
+				takeCount, noSuspend);
+	}
+
+	m_lastMove = m;
+	m_playedOutSize = getPlayedOutStats().getCount();
+	m_oppCount = obs.count[1];
+	m_pendingTake = CompactState::getRank(c) == Common::ICard::SEVEN ? takeCount + 2u : 0u;
+	m_treeValid = obs.players == 2u;
+
+	if(CompactState::getRank(c) == Common::ICard::JACK) {
+		m_jackChoice = static_cast<Common::ICard::SUIT>(CompactState::getMoveSuit(m));
+	}
+
+	return card;
+}
+
+NetMauMau::Common::ICard::SUIT
+ExpertPlayer::getJackChoice(const NetMauMau::Common::ICardPtr &uncoveredCard,
+							const NetMauMau::Common::ICardPtr &playedCard) const {
+
+	if(m_jackChoice != Common::ICard::SUIT_ILLEGAL && playedCard == Common::ICard::JACK) {
+
+		m_lastPlayedSuit = m_jackChoice;
+		m_jackChoice = Common::ICard::SUIT_ILLEGAL;
+
+		return m_lastPlayedSuit;
+	}
+
+	return AIPlayerBase<AI::JackOnlyCondition,
+		   AI::PowerJackCondition>::getJackChoice(uncoveredCard, playedCard);
+}
+
+void ExpertPlayer::informAIStat(const IPlayer *player, std::size_t count,
+								NetMauMau::Common::ICard::SUIT lpSuit,
+								NetMauMau::Common::ICard::RANK lpRank) {
+
+	AIPlayerBase<AI::JackOnlyCondition, AI::PowerJackCondition>::informAIStat(player, count,
+			lpSuit, lpRank);
+
+	// the engine informs about all opponents in playing order after each turn
+	if(std::find_if(m_stats.begin(), m_stats.end(), std::bind2nd(_isPlayer(), player)) !=
+			m_stats.end()) m_stats.clear();
+
+	m_stats.push_back(std::make_pair(player, count));
+}
+
+void ExpertPlayer::talonShuffled() {
+	m_treeValid = false;
+	AIPlayerBase<AI::JackOnlyCondition, AI::PowerJackCondition>::talonShuffled();
+}
+
+void ExpertPlayer::reset() throw() {
+
+	m_search.reset();
+	m_treeValid = false;
+	m_jackChoice = Common::ICard::SUIT_ILLEGAL;
+	m_stats.clear();
+
+	AIPlayerBase<AI::JackOnlyCondition, AI::PowerJackCondition>::reset();
+}
+
+bool ExpertPlayer::observe(CompactState::OBSERVATION &obs, const Common::ICardPtr &uc,
+						   const Common::ICard::SUIT *js, std::size_t takeCount) const {
+
+	const std::size_t players = getPlayerCount();
+
+	if(!uc || players < 2u || players > CompactState::MAXPLAYERS || getTalonFactor() != 1u ||
+			(getRuleSet() && getRuleSet()->isAceRound())) return false;
+
+	for(CARDS::const_iterator i(getPlayerCards().begin()); i != getPlayerCards().end(); ++i) {
+
+		const CompactState::HAND b = CompactState::bit(CompactState::getCard((*i)->getSuit(),
+									 (*i)->getRank()));
+
+		if(obs.hand & b) return false;
+
+		obs.hand |= b;
+	}
+
+	obs.uncovered = CompactState::getCard(uc->getSuit(), uc->getRank());
+	obs.playedOut = getPlayedOutStats().getPlayedOut() & ~CompactState::bit(obs.uncovered);
+
+	obs.jackSuit = static_cast<unsigned char>(js && *js != Common::ICard::SUIT_ILLEGAL ?
+				   static_cast<unsigned int>(*js) :
+				   static_cast<unsigned int>(CompactState::NOSUIT));
+	obs.takeCount = static_cast<unsigned char>(std::min<std::size_t>(takeCount, 0xFFu));
+	obs.players = static_cast<unsigned char>(players);
+	obs.dirChange = isDirChgEnabled();
+	obs.count[0] = static_cast<unsigned char>(getPlayerCards().size());
+
+	const std::size_t k = players - 1u;
+
+	if(m_stats.size() == k && k > 1u) {
+
+		// find our seat between the left and right neighbour
+		std::size_t seat = 0u;
+
+		for(std::size_t g = 0u; g < k; ++g) {
+			if(m_stats[(g + k - 1u) % k].second == getLeftCount() &&
+					m_stats[g].second == getRightCount()) {
+				seat = g;
+				break;
+			}
+		}
+
+		for(std::size_t i = 0u; i < k; ++i) {
+			obs.count[i + 1u] = static_cast<unsigned char>(m_stats[(seat + i) % k].second);
+		}
+
+	} else {
+
+		for(std::size_t i = 1u; i < players; ++i) {
+			obs.count[i] = static_cast<unsigned char>(getRightCount());
+		}
+
+		obs.count[players - 1u] = static_cast<unsigned char>(getLeftCount());
+	}
+
+	return true;
+}
+
+void ExpertPlayer::reuseTree(const CompactState::OBSERVATION &obs) const {
+
+	const IPlayedOutCards::CARDS &poc(getPlayedOutCards());
+	const Common::ICard::RANK myRank = CompactState::getRank(CompactState::getMoveCard(m_lastMove));
+
+	bool ok = poc.size() >= m_playedOutSize && m_search.advance(0u, m_lastMove);
+
+	if(ok) {
+
+		const std::size_t delta = poc.size() - m_playedOutSize;
+
+		if(myRank == Common::ICard::EIGHT || (myRank == Common::ICard::NINE && obs.dirChange)) {
+			ok = delta == 1u;
+		} else if(delta == 1u) {
+			ok = m_search.advance(1u, CompactState::PASS);
+		} else if(delta == 2u && !poc.empty()) {
+
+			const CompactState::CARD oc = CompactState::getCard(poc.front()->getSuit(),
+										  poc.front()->getRank());
+			const std::size_t expected = m_oppCount + (CompactState::getRank(oc) ==
+										 Common::ICard::SEVEN ? 0u : m_pendingTake);
+
+			ok = m_search.advance(1u, obs.count[1] + 1u == expected ?
+								  CompactState::makeMove(oc, obs.jackSuit & 3u) :
+								  static_cast<CompactState::MOVE>(CompactState::PASS));
+		} else {
+			ok = false;
+		}
+	}
+
+	if(!ok) m_search.reset();
+}
+
+bool ExpertPlayer::solveEndgame(const CompactState::OBSERVATION &obs, CompactState::MOVE &m,
+								long &spent) const {
+
+	if(obs.players != 2u || EndgameSolver::estimateNodes(obs) > m_solverNodes) return false;
+
+	const bool solved = m_solver.solve(obs, std::max(1L, m_budget / SOLVER_SHARE),
+									   Common::genRandom<uint32_t>(0xFFFFFFFFu), m);
+
+	spent = m_solver.getElapsed();
+
+#if defined(TRACE_AI) && !defined(NDEBUG)
+
+	if(!getenv("NMM_NO_TRACE")) logDebug("-> trace of AI \"" << getName() << "\" -> endgame: "
+											 << (solved ? "solved " : "aborted ")
+											 << m_solver.getDeterminizations()
+											 << " determinization(s), " << m_solver.getNodes()
+											 << " nodes (" << static_cast<unsigned long>
+											 (m_solver.getNodesPerSecond()) << "/s), TT hit rate "
+											 << m_solver.getHitRate() << " <-");
+
+#endif
+
+	return solved;
+}
+
+NetMauMau::Common::ICardPtr ExpertPlayer::findCard(CompactState::CARD c) const {
+
+	const Common::ICard::SUIT s = CompactState::getSuit(c);
+	const Common::ICard::RANK r = CompactState::getRank(c);
+
+	for(CARDS::const_iterator i(getPlayerCards().begin()); i != getPlayerCards().end(); ++i) {
+		if((*i)->getSuit() == s && (*i)->getRank() == r) return *i;
+	}
+
+	return Common::ICardPtr();
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_PLAYER_EXPERTPLAYER_H
+#define NETMAUMAU_PLAYER_EXPERTPLAYER_H
+
+#include "aiplayerbase.h"               // for AIPlayerBase
+#include "endgamesolver.h"
+#include "ismcts.h"
+
+namespace NetMauMau {
+
+namespace AI {
+class JackOnlyCondition;
+class PowerJackCondition;
+}
+
+namespace Player {
+
+/**
+ * @brief AI player searching its moves by information set Monte Carlo tree search
+ *
+ * Each decision is limited to @c budget milliseconds. Situations the compact game model
+ * cannot express (more than one deck, ace rounds, talon underflow, unknown player count)
+ * are decided by the decision chain of the hard AI.
+ *
+ * Two player endgames estimated to need at most @c solverNodes nodes are solved by
+ * alpha-beta search within half of the budget, the tree search gets the remaining time if
+ * the solver gives up.
+ */
+class ExpertPlayer : public AIPlayerBase<AI::JackOnlyCondition, AI::PowerJackCondition> {
+	DISALLOW_COPY_AND_ASSIGN(ExpertPlayer)
+public:
+	explicit ExpertPlayer(const std::string &name, const IPlayedOutCards *poc,
+						  long budget = 500L, unsigned int threads = 0u,
+						  double solverNodes = 1e9);
+	virtual ~ExpertPlayer() throw();
+
+	virtual TYPE getType() const throw() _CONST;
+
+	virtual Common::ICardPtr requestCard(const Common::ICardPtr &uncoveredCard,
+										 const Common::ICard::SUIT *jackSuit,
+										 std::size_t takeCount, bool noSuspend) const;
+	virtual Common::ICard::SUIT getJackChoice(const Common::ICardPtr &uncoveredCard,
+			const Common::ICardPtr &playedCard) const;
+
+	virtual void informAIStat(const IPlayer *player, std::size_t count, Common::ICard::SUIT lpSuit,
+							  Common::ICard::RANK lpRank);
+
+	virtual void talonShuffled();
+
+	virtual void reset() throw();
+
+	inline long getBudget() const {
+		return m_budget;
+	}
+
+	inline unsigned long getPlayouts() const {
+		return m_search.getPlayouts();
+	}
+
+	inline double getPlayoutsPerSecond() const {
+		return m_search.getPlayoutsPerSecond();
+	}
+
+	inline double getSolverNodesPerSecond() const {
+		return m_solver.getNodesPerSecond();
+	}
+
+	inline double getSolverHitRate() const {
+		return m_solver.getHitRate();
+	}
+
+private:
+	bool observe(CompactState::OBSERVATION &obs, const Common::ICardPtr &uc,
+				 const Common::ICard::SUIT *js, std::size_t takeCount) const;
+	void reuseTree(const CompactState::OBSERVATION &obs) const;
+	bool solveEndgame(const CompactState::OBSERVATION &obs, CompactState::MOVE &m,
+					  long &spent) const;
+	Common::ICardPtr findCard(CompactState::CARD c) const;
+
+private:
+	typedef std::vector<std::pair<const IPlayer *, std::size_t> > STATS;
+
+	const long m_budget;
+	const double m_solverNodes;
+	mutable ISMCTS m_search;
+	mutable EndgameSolver m_solver;
+	mutable bool m_treeValid;
+	mutable CompactState::MOVE m_lastMove;
+	mutable std::size_t m_playedOutSize;
+	mutable std::size_t m_oppCount;
+	mutable std::size_t m_pendingTake;
+	mutable Common::ICard::SUIT m_jackChoice;
+	STATS m_stats;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_PLAYER_EXPERTPLAYER_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -25,6 +25,7 @@
 
 #include "icard.h"
 #include "smartptr.h"
+#include "iplayedoutstats.h"
 
 namespace NetMauMau {
 
@@ -170,6 +171,7 @@ public:
 	virtual ~IPlayedOutCards() {}
 
 	virtual const CARDS &getCards() const = 0;
+	virtual const IPlayedOutStats &getStats() const = 0;
 
 protected:
 	explicit IPlayedOutCards() {}
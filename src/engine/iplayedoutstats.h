@@ -0,0 +1,58 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_IPLAYEDOUTSTATS_H
+#define NETMAUMAU_IPLAYEDOUTSTATS_H
+
+#include <cstddef>                      // for size_t
+#include <stdint.h>
+
+#include "icard.h"
+
+namespace NetMauMau {
+
+/**
+ * @brief Running statistics of the played out cards, including the uncovered card
+ */
+class IPlayedOutStats {
+	DISALLOW_COPY_AND_ASSIGN(IPlayedOutStats)
+public:
+	virtual ~IPlayedOutStats() {}
+
+	virtual std::size_t getCount() const = 0;
+	virtual std::size_t getCount(Common::ICard::SUIT suit) const = 0;
+	virtual std::size_t getCount(Common::ICard::RANK rank) const = 0;
+	virtual std::size_t getCount(Common::ICard::SUIT suit, Common::ICard::RANK rank) const = 0;
+
+	/**
+	 * @brief Bitset of the played out cards
+	 *
+	 * Bit <tt>suit * 8 + (rank - 7)</tt> is set if the card got played out at least once.
+	 */
+	virtual uint32_t getPlayedOut() const = 0;
+
+protected:
+	explicit IPlayedOutStats() {}
+};
+
+}
+
+#endif /* NETMAUMAU_IPLAYEDOUTSTATS_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -71,6 +71,8 @@ public:
 	virtual std::size_t getMaxPlayers() const = 0;
 	virtual void setCurPlayers(std::size_t players) = 0;
 
+	virtual bool setState(std::size_t takeCount, bool suspend, Common::ICard::SUIT jackSuit) = 0;
+
 	virtual void reset() throw() = 0;
 
 protected:
@@ -0,0 +1,382 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <ctime>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#ifdef ENABLE_THREADS
+#include <pthread.h>
+#endif
+
+#include "ismcts.h"
+
+namespace {
+
+const double UCT_C = 0.7;
+const uint32_t NIL = 0xFFFFFFFFu;
+const unsigned int MAXDEPTH = 128u;
+const unsigned int BATCH = 16u;
+
+typedef struct _node {
+	uint32_t child;
+	uint32_t sibling;
+	uint32_t visits;
+	uint32_t avail;
+	float reward;
+	NetMauMau::Player::CompactState::MOVE move;
+	unsigned char player;
+} NODE;
+
+const NODE ROOT = {
+	NIL, NIL, 0u, 0u, 0.0f, NetMauMau::Player::CompactState::PASS,
+	NetMauMau::Player::CompactState::NOPLAYER
+};
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+#ifdef ENABLE_THREADS
+unsigned int getCores() {
+#if defined(HAVE_UNISTD_H) && defined(_SC_NPROCESSORS_ONLN)
+	const long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n > 0 ? static_cast<unsigned int>(n) : 1u;
+#else
+	return 1u;
+#endif
+}
+#endif
+
+}
+
+using namespace NetMauMau::Player;
+
+class ISMCTS::Tree {
+	DISALLOW_COPY_AND_ASSIGN(Tree)
+public:
+	explicit Tree(std::size_t maxNodes) : m_nodes(), m_maxNodes(std::max<std::size_t>(2u,
+				maxNodes)), m_playouts(0ul), m_obs(0L), m_deadline(0.0), m_seed(0u) {
+		m_nodes.reserve(m_maxNodes);
+		clear();
+	}
+
+	inline void clear() {
+		m_nodes.clear();
+		m_nodes.push_back(ROOT);
+	}
+
+	void iterate(CompactState::RNG &rng);
+	bool advance(unsigned char player, CompactState::MOVE move);
+
+	static void *run(void *arg);
+
+	std::vector<NODE> m_nodes;
+	const std::size_t m_maxNodes;
+	unsigned long m_playouts;
+	const CompactState::OBSERVATION *m_obs;
+	double m_deadline;
+	uint32_t m_seed;
+
+private:
+	uint32_t findChild(uint32_t node, unsigned char player, CompactState::MOVE move) const _PURE;
+	uint32_t addChild(uint32_t node, unsigned char player, CompactState::MOVE move);
+};
+
+uint32_t ISMCTS::Tree::findChild(uint32_t node, unsigned char player,
+								 CompactState::MOVE move) const {
+
+	uint32_t c = m_nodes[node].child;
+
+	while(c != NIL && !(m_nodes[c].move == move && m_nodes[c].player == player)) {
+		c = m_nodes[c].sibling;
+	}
+
+	return c;
+}
+
+uint32_t ISMCTS::Tree::addChild(uint32_t node, unsigned char player, CompactState::MOVE move) {
+
+	const uint32_t c = static_cast<uint32_t>(m_nodes.size());
+	const NODE n = { NIL, m_nodes[node].child, 0u, 1u, 0.0f, move, player };
+
+	m_nodes.push_back(n);
+	m_nodes[node].child = c;
+
+	return c;
+}
+
+void ISMCTS::Tree::iterate(CompactState::RNG &rng) {
+
+	CompactState s(*m_obs, rng);
+	CompactState::MOVE moves[CompactState::MAXMOVES], untried[CompactState::MAXMOVES];
+	uint32_t path[MAXDEPTH], node = 0u;
+	unsigned int depth = 0u;
+
+	while(!s.isTerminal() && depth < MAXDEPTH) {
+
+		const unsigned int n = s.getMoves(moves);
+		const unsigned char p = s.getPlayerToMove();
+
+		unsigned int nUntried = 0u;
+		uint32_t best = NIL;
+		double bestVal = -1.0;
+
+		for(unsigned int i = 0u; i < n; ++i) {
+
+			const uint32_t c = findChild(node, p, moves[i]);
+
+			if(c == NIL) {
+				untried[nUntried++] = moves[i];
+				continue;
+			}
+
+			NODE &cn(m_nodes[c]);
+
+			++cn.avail;
+
+			const double val = cn.visits ? static_cast<double>(cn.reward) / cn.visits +
+							   UCT_C * std::sqrt(std::log(static_cast<double>(cn.avail)) /
+												 cn.visits) : 1e9;
+
+			if(val > bestVal) {
+				bestVal = val;
+				best = c;
+			}
+		}
+
+		if(nUntried && m_nodes.size() < m_maxNodes) {
+
+			const CompactState::MOVE m = untried[rng.below(nUntried)];
+
+			path[depth++] = addChild(node, p, m);
+			s.apply(m, rng);
+			break;
+		}
+
+		if(best == NIL) break;
+
+		s.apply(m_nodes[best].move, rng);
+		path[depth++] = node = best;
+	}
+
+	const unsigned char winner = s.isTerminal() ? s.getWinner() : s.playout(rng);
+
+	++m_nodes[0].visits;
+
+	for(unsigned int i = 0u; i < depth; ++i) {
+
+		NODE &n(m_nodes[path[i]]);
+
+		++n.visits;
+
+		if(n.player == winner) n.reward += 1.0f;
+	}
+
+	++m_playouts;
+}
+
+bool ISMCTS::Tree::advance(unsigned char player, CompactState::MOVE move) {
+
+	const uint32_t r = findChild(0u, player, move);
+
+	if(r == NIL) {
+		clear();
+		return false;
+	}
+
+	std::vector<NODE> nodes;
+	std::vector<std::pair<uint32_t, uint32_t> > stack(1u, std::make_pair(r, 0u));
+
+	nodes.reserve(m_maxNodes);
+	nodes.push_back(m_nodes[r]);
+	nodes[0].child = nodes[0].sibling = NIL;
+
+	while(!stack.empty()) {
+
+		const std::pair<uint32_t, uint32_t> t(stack.back());
+		uint32_t prev = NIL;
+
+		stack.pop_back();
+
+		for(uint32_t c = m_nodes[t.first].child; c != NIL; c = m_nodes[c].sibling) {
+
+			const uint32_t n = static_cast<uint32_t>(nodes.size());
+
+			nodes.push_back(m_nodes[c]);
+			nodes[n].child = nodes[n].sibling = NIL;
+
+			if(prev == NIL) {
+				nodes[t.second].child = n;
+			} else {
+				nodes[prev].sibling = n;
+			}
+
+			prev = n;
+			stack.push_back(std::make_pair(c, n));
+		}
+	}
+
+	m_nodes.swap(nodes);
+
+	return true;
+}
+
+void *ISMCTS::Tree::run(void *arg) {
+
+	Tree *t = static_cast<Tree *>(arg);
+	CompactState::RNG rng(t->m_seed);
+
+	t->m_playouts = 0ul;
+
+	do {
+		for(unsigned int i = 0u; i < BATCH; ++i) t->iterate(rng);
+	} while(now() < t->m_deadline);
+
+	return NULL;
+}
+
+ISMCTS::ISMCTS(unsigned int threads, std::size_t maxNodes) : m_trees(), m_playouts(0ul),
+	m_elapsed(0.0) {
+
+#ifdef ENABLE_THREADS
+	const unsigned int n = threads ? threads : getCores();
+#else
+	_UNUSED(threads);
+	const unsigned int n = 1u;
+#endif
+
+	for(unsigned int i = 0u; i < n; ++i) m_trees.push_back(new Tree(maxNodes));
+}
+
+ISMCTS::~ISMCTS() {
+	for(std::vector<Tree *>::const_iterator i(m_trees.begin()); i != m_trees.end(); ++i) {
+		delete *i;
+	}
+}
+
+CompactState::MOVE ISMCTS::search(const CompactState::OBSERVATION &obs, long budget,
+								  uint32_t seed) {
+
+	const double start = now();
+
+	for(std::vector<Tree *>::size_type i = 0u; i < m_trees.size(); ++i) {
+		m_trees[i]->m_obs = &obs;
+		m_trees[i]->m_deadline = start + static_cast<double>(budget) / 1000.0;
+		m_trees[i]->m_seed = seed + static_cast<uint32_t>(i) * 0x9E3779B9u;
+	}
+
+#ifdef ENABLE_THREADS
+	std::vector<pthread_t> threads(m_trees.size());
+	std::vector<bool> started(m_trees.size(), false);
+
+	for(std::vector<Tree *>::size_type i = 1u; i < m_trees.size(); ++i) {
+		started[i] = !pthread_create(&threads[i], NULL, Tree::run, m_trees[i]);
+	}
+
+#endif
+
+	Tree::run(m_trees.front());
+
+#ifdef ENABLE_THREADS
+
+	for(std::vector<Tree *>::size_type i = 1u; i < m_trees.size(); ++i) {
+		if(started[i]) pthread_join(threads[i], NULL);
+	}
+
+#endif
+
+	double visits[256] = { 0.0 };
+
+	m_playouts = 0ul;
+
+	for(std::vector<Tree *>::size_type i = 0u; i < m_trees.size(); ++i) {
+
+#ifdef ENABLE_THREADS
+
+		if(i && !started[i]) continue;
+
+#endif
+
+		const std::vector<NODE> &nodes(m_trees[i]->m_nodes);
+
+		for(uint32_t c = nodes[0].child; c != NIL; c = nodes[c].sibling) {
+			if(!nodes[c].player) visits[nodes[c].move] += nodes[c].visits;
+		}
+
+		m_playouts += m_trees[i]->m_playouts;
+	}
+
+	m_elapsed = now() - start;
+
+	CompactState::MOVE best = CompactState::PASS;
+
+	for(unsigned int m = 0u; m < 256u; ++m) {
+		if(visits[m] > visits[best]) best = static_cast<CompactState::MOVE>(m);
+	}
+
+	return best;
+}
+
+bool ISMCTS::advance(unsigned char player, CompactState::MOVE move) {
+
+	bool found = false;
+
+	for(std::vector<Tree *>::const_iterator i(m_trees.begin()); i != m_trees.end(); ++i) {
+		found = (*i)->advance(player, move) || found;
+	}
+
+	return found;
+}
+
+void ISMCTS::reset() {
+	for(std::vector<Tree *>::const_iterator i(m_trees.begin()); i != m_trees.end(); ++i) {
+		(*i)->clear();
+	}
+}
+
+std::size_t ISMCTS::getTreeSize() const {
+
+	std::size_t s = 0u;
+
+	for(std::vector<Tree *>::const_iterator i(m_trees.begin()); i != m_trees.end(); ++i) {
+		s += (*i)->m_nodes.size();
+	}
+
+	return s;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_PLAYER_ISMCTS_H
+#define NETMAUMAU_PLAYER_ISMCTS_H
+
+#include <vector>
+
+#include "compactstate.h"
+
+namespace NetMauMau {
+
+namespace Player {
+
+/**
+ * @brief Single observer information set Monte Carlo tree search
+ *
+ * Every iteration samples a determinization of the observation and descends the tree along
+ * the moves legal in it. The search is root parallel: each thread grows its own tree, the
+ * root statistics are merged when the time budget is exhausted.
+ */
+class ISMCTS {
+	DISALLOW_COPY_AND_ASSIGN(ISMCTS)
+public:
+	explicit ISMCTS(unsigned int threads = 0u, std::size_t maxNodes = 1u << 16u);
+	~ISMCTS();
+
+	/**
+	 * @brief Searches the best move of player @c 0
+	 *
+	 * @param obs the observation of player @c 0
+	 * @param budget the time budget in milliseconds
+	 * @param seed seed of the random generators
+	 */
+	CompactState::MOVE search(const CompactState::OBSERVATION &obs, long budget,
+							  uint32_t seed);
+
+	/**
+	 * @brief Moves the roots of the trees along an observed move
+	 *
+	 * @return @c false if the move is unknown to all trees, the trees are cleared then
+	 */
+	bool advance(unsigned char player, CompactState::MOVE move);
+
+	void reset();
+
+	inline unsigned long getPlayouts() const {
+		return m_playouts;
+	}
+
+	inline double getPlayoutsPerSecond() const {
+		return m_elapsed > 0.0 ? static_cast<double>(m_playouts) / m_elapsed : 0.0;
+	}
+
+	inline unsigned int getThreads() const {
+		return static_cast<unsigned int>(m_trees.size());
+	}
+
+	std::size_t getTreeSize() const _PURE;
+
+private:
+	class Tree;
+
+	std::vector<Tree *> m_trees;
+	unsigned long m_playouts;
+	double m_elapsed;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_PLAYER_ISMCTS_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
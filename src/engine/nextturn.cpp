@@ -84,6 +84,7 @@ NextTurn::NextTurn(Engine *const engine) throw(Common::Exception::SocketExceptio
 
 	m_uncoveredCard = m_engine->m_talon->getUncoveredCard();
 	m_engine->getRuleSet()->checkInitial(m_player, m_uncoveredCard);
+	m_engine->m_ctx.ruleStateChanged();
 
 	checkAndPerformDirChange(m_player, false);
 
@@ -343,12 +344,15 @@ throw(Common::Exception::SocketException) {
 		}
 	}
 
+	if(cardAccepted) m_engine->m_ctx.ruleStateChanged();
+
 	return cardAccepted;
 }
 
 void NextTurn::jackModeOff() const throw(Common::Exception::SocketException) {
 
 	m_engine->getRuleSet()->setJackModeOff();
+	m_engine->m_ctx.ruleStateChanged();
 
 	try {
 		m_engine->getEventHandler().setJackModeOff();
@@ -357,6 +361,22 @@ void NextTurn::jackModeOff() const throw(Common::Exception::SocketException) {
 	}
 }
 
+void NextTurn::exportState(EngineState &state) const {
+	state.nextPlayer = static_cast<unsigned char>(m_nxtPlayer);
+	state.jackMode = m_jackMode;
+	state.initialJack = m_initialJack;
+}
+
+void NextTurn::importState(const EngineState &state) {
+
+	m_nxtPlayer = state.nextPlayer;
+	m_jackMode = state.jackMode;
+	m_initialJack = state.initialJack;
+	m_jackSuit = static_cast<Common::ICard::SUIT>(state.jackSuit);
+	m_uncoveredCard = m_engine->m_talon->getUncoveredCard();
+	m_player = m_engine->m_players[m_nxtPlayer];
+}
+
 void NextTurn::informAIStat() const {
 	std::for_each(m_engine->m_players.begin(), m_engine->m_players.end(),
 				  _informAIStat(m_engine->m_players));
@@ -367,7 +387,10 @@ throw(Common::Exception::SocketException) {
 
 	Engine::PLAYERS::iterator f(m_engine->m_players.begin());
 	std::advance(f, std::min(m_engine->m_players.size() - 1u, m_nxtPlayer));
+
+	m_engine->m_winner = player;
 	m_engine->erasePlayer(f);
+	m_engine->m_winner = 0L;
 
 	const Engine::PLAYERS::size_type plsCnt = m_engine->m_players.size();
 	RuleSet::IRuleSet *const ruleSet = m_engine->getRuleSet();
@@ -453,6 +476,7 @@ throw(Common::Exception::SocketException) {
 		if(m_engine->m_dirChangeEnabled && m_engine->m_players.size() > 2u) {
 
 			std::reverse(m_engine->m_players.begin(), m_engine->m_players.end());
+			m_engine->m_reversed = !m_engine->m_reversed;
 
 			m_nxtPlayer = static_cast<std::size_t>(std::distance(m_engine->m_players.begin(),
 												   std::find(m_engine->m_players.begin(),
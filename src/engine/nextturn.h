@@ -33,6 +33,9 @@ public:
 
 	bool compute() throw(Common::Exception::SocketException);
 
+	void exportState(EngineState &state) const;
+	void importState(const EngineState &state);
+
 private:
 	void informAIStat() const;
 
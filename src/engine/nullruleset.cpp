@@ -115,6 +115,10 @@ std::size_t NullRuleSet::getMaxPlayers() const {
 
 void NullRuleSet::setCurPlayers(std::size_t) {}
 
+bool NullRuleSet::setState(std::size_t, bool, NetMauMau::Common::ICard::SUIT) {
+	return true;
+}
+
 void NullRuleSet::reset() throw() {}
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
@@ -70,6 +70,9 @@ public:
 	virtual std::size_t getMaxPlayers() const _CONST;
 	virtual void setCurPlayers(std::size_t players) _CONST;
 
+	virtual bool setState(std::size_t takeCount, bool suspend,
+						  Common::ICard::SUIT jackSuit) _CONST;
+
 	virtual void reset() throw() _CONST;
 
 private:
@@ -44,6 +44,32 @@ private:
 };
 #pragma GCC diagnostic pop
 
+bool exportCards(const NetMauMau::IPlayedOutCards::CARDS &cards,
+				 NetMauMau::EngineState::CARD *ids, unsigned char &size) {
+
+	if(cards.size() > NetMauMau::EngineState::MAXCARDS) return false;
+
+	size = static_cast<unsigned char>(cards.size());
+
+	for(NetMauMau::IPlayedOutCards::CARDS::size_type i = 0u; i < cards.size(); ++i) {
+		ids[i] = NetMauMau::EngineState::getCard(cards[i]->getSuit(), cards[i]->getRank());
+	}
+
+	return true;
+}
+
+NetMauMau::Talon::CARDSTACK importCards(const NetMauMau::EngineState::CARD *ids,
+										unsigned char size) {
+
+	NetMauMau::Talon::CARDSTACK::container_type cards;
+
+	cards.reserve(size);
+
+	for(unsigned char i = 0u; i < size; ++i) cards.push_back(NetMauMau::Talon::getCard(ids[i]));
+
+	return NetMauMau::Talon::CARDSTACK(cards);
+}
+
 }
 
 template<> const NetMauMau::CardsAllocator<NetMauMau::Common::ICardPtr>::value_type
@@ -122,7 +148,8 @@ using namespace NetMauMau;
 
 Talon::Talon(ITalonChange *tchg, std::size_t factor) throw() : m_talonChangeListener(tchg),
 	m_playedOutCards(), m_cardStack(Talon::createCards(factor)), m_uncovered(m_playedOutCards),
-	m_uncoveredDirty(false), m_factor(factor) {
+	m_uncoveredDirty(false), m_factor(factor), m_cardCount(), m_suitCount(), m_rankCount(),
+	m_playedOutBits(0u) {
 	m_talonChangeListener->talonEmpty(false);
 }
 
@@ -149,36 +176,68 @@ Talon::CARDSTACK::container_type Talon::createCards(std::size_t factor) throw()
 
 Talon::~Talon() throw() {}
 
-#ifndef __clang__
-#pragma GCC diagnostic ignored "-Wunsafe-loop-optimizations"
-#pragma GCC diagnostic push
-#endif
 const IPlayedOutCards::CARDS &Talon::getCards() const throw() {
 
 	if(m_uncoveredDirty) {
 
-		CARDS aux;
-		CARDSTACK tmp(m_uncovered);
-
-		if(tmp.size() <= aux.max_size()) aux.reserve(tmp.size());
+		const CARDSTACK::container_type &uncovered(m_uncovered.getCards());
 
-		while(!tmp.empty()) {
-			aux.push_back(tmp.top());
-			tmp.pop();
-		}
-
-		m_playedOutCards.swap(aux);
+		m_playedOutCards.assign(uncovered.rbegin(), uncovered.rend());
 		m_uncoveredDirty = false;
 	}
 
 	return m_playedOutCards;
 }
-#ifndef __clang__
-#pragma GCC diagnostic pop
-#endif
+
+const IPlayedOutStats &Talon::getStats() const throw() {
+	return *this;
+}
+
+std::size_t Talon::getCount() const throw() {
+	return m_uncovered.size();
+}
+
+std::size_t Talon::getCount(Common::ICard::SUIT suit) const throw() {
+	return suit < 4 ? m_suitCount[suit] : 0u;
+}
+
+std::size_t Talon::getCount(Common::ICard::RANK rank) const throw() {
+	return (rank >= Common::ICard::SEVEN && rank <= Common::ICard::ACE) ?
+		   m_rankCount[rank - Common::ICard::SEVEN] : 0u;
+}
+
+std::size_t Talon::getCount(Common::ICard::SUIT suit, Common::ICard::RANK rank) const throw() {
+	return (suit < 4 && rank >= Common::ICard::SEVEN && rank <= Common::ICard::ACE) ?
+		   m_cardCount[EngineState::getCard(suit, rank)] : 0u;
+}
+
+uint32_t Talon::getPlayedOut() const throw() {
+	return m_playedOutBits;
+}
+
+void Talon::countCard(const Common::ICardPtr &card) throw() {
+
+	if(!card || card->getSuit() >= 4 || card->getRank() < Common::ICard::SEVEN ||
+			card->getRank() > Common::ICard::ACE) return;
+
+	const EngineState::CARD c = EngineState::getCard(card->getSuit(), card->getRank());
+
+	++m_cardCount[c];
+	++m_suitCount[card->getSuit()];
+	++m_rankCount[card->getRank() - Common::ICard::SEVEN];
+	m_playedOutBits |= static_cast<uint32_t>(1u) << c;
+}
+
+void Talon::clearCount() throw() {
+	std::fill(m_cardCount, m_cardCount + 32, 0u);
+	std::fill(m_suitCount, m_suitCount + 4, 0u);
+	std::fill(m_rankCount, m_rankCount + 8, 0u);
+	m_playedOutBits = 0u;
+}
 
 Common::ICardPtr Talon::uncoverCard() throw() {
 	m_uncovered.push(top());
+	countCard(top());
 	pop();
 	m_uncoveredDirty = true;
 	m_talonChangeListener->uncoveredCard(m_uncovered.top());
@@ -190,6 +249,7 @@ void Talon::playCard(const Common::ICardPtr &card) throw() {
 	assert(!(card == Common::ICard::RANK_ILLEGAL || card == Common::ICard::SUIT_ILLEGAL));
 
 	m_uncovered.push(card);
+	countCard(card);
 	m_uncoveredDirty = true;
 	m_talonChangeListener->talonEmpty(false);
 }
@@ -220,6 +280,8 @@ Common::ICardPtr Talon::takeCard() throw() {
 		m_talonChangeListener->talonEmpty(cards.empty());
 
 		m_uncovered.push(uc);
+		clearCount();
+		countCard(uc);
 		m_talonChangeListener->uncoveredCard(m_uncovered.top());
 	}
 
@@ -241,11 +303,56 @@ void Talon::emitUnderFlow() const throw() {
 	if(m_talonChangeListener && thresholdReached()) m_talonChangeListener->underflow();
 }
 
+const Common::ICardPtr &Talon::getCard(EngineState::CARD c) throw() {
+	return c < 32u ? CardsAllocator<Common::ICardPtr>::m_deck[c] :
+		   CardsAllocator<Common::ICardPtr>::m_nullCard;
+}
+
+bool Talon::exportState(EngineState &state) const throw() {
+	return m_factor <= EngineState::MAXDECKS &&
+		   exportCards(m_cardStack.getCards(), state.talon, state.talonSize) &&
+		   exportCards(m_uncovered.getCards(), state.uncovered, state.uncoveredSize);
+}
+
+bool Talon::canImportState(const EngineState &state) const throw() {
+
+	if(!state.uncoveredSize || state.decks != m_factor || state.talonSize > EngineState::MAXCARDS ||
+			state.uncoveredSize > EngineState::MAXCARDS) return false;
+
+	for(unsigned char i = 0u; i < state.talonSize; ++i) if(state.talon[i] >= 32u) return false;
+
+	for(unsigned char i = 0u; i < state.uncoveredSize; ++i) {
+		if(state.uncovered[i] >= 32u) return false;
+	}
+
+	return true;
+}
+
+bool Talon::importState(const EngineState &state) throw() {
+
+	if(!canImportState(state)) return false;
+
+	m_cardStack = importCards(state.talon, state.talonSize);
+	m_uncovered = importCards(state.uncovered, state.uncoveredSize);
+	m_uncoveredDirty = true;
+
+	clearCount();
+
+	for(unsigned char i = 0u; i < state.uncoveredSize; ++i) {
+		countCard(getCard(state.uncovered[i]));
+	}
+
+	m_talonChangeListener->talonEmpty(m_cardStack.empty());
+
+	return true;
+}
+
 void Talon::reset() throw() {
 
 	m_talonChangeListener->talonEmpty(false);
 	m_playedOutCards.clear();
 	m_uncoveredDirty = false;
+	clearCount();
 
 	m_uncovered = CARDSTACK();
 	m_cardStack = CARDSTACK(Talon::createCards(m_factor));
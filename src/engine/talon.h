@@ -23,16 +23,31 @@
 #include <cstddef>                      // for size_t
 #include <stack>                        // for stack
 
+#include "enginestate.h"                // for EngineState
 #include "iplayedoutcards.h"            // for IPlayedOutCards::CARDS, etc
 
 namespace NetMauMau {
 
 class ITalonChange;
 
-class Talon : public virtual IPlayedOutCards {
+class Talon : public virtual IPlayedOutCards, private IPlayedOutStats {
 	DISALLOW_COPY_AND_ASSIGN(Talon)
 public:
-	typedef std::stack<CARDS::value_type, CARDS> CARDSTACK;
+#pragma GCC diagnostic ignored "-Weffc++"
+#pragma GCC diagnostic push
+	class CARDSTACK : public std::stack<CARDS::value_type, CARDS> {
+	public:
+		inline explicit CARDSTACK(const container_type &cards = container_type())
+			: std::stack<CARDS::value_type, CARDS>(cards) {}
+
+		/**
+		 * @brief The cards of the stack, the top card last
+		 */
+		inline const container_type &getCards() const throw() {
+			return c;
+		}
+	};
+#pragma GCC diagnostic pop
 
 	explicit Talon(ITalonChange *tchg, std::size_t factor) throw();
 	virtual ~Talon() throw();
@@ -54,6 +69,7 @@ public:
 	}
 
 	virtual const CARDS &getCards() const throw();
+	virtual const IPlayedOutStats &getStats() const throw();
 
 	Common::ICardPtr uncoverCard() throw();
 
@@ -69,6 +85,12 @@ public:
 		m_cardStack.push(c);
 	}
 
+	bool exportState(EngineState &state) const throw();
+	bool canImportState(const EngineState &state) const throw() _PURE;
+	bool importState(const EngineState &state) throw();
+
+	static const Common::ICardPtr &getCard(EngineState::CARD c) throw() _PURE;
+
 	void reset() throw();
 
 private:
@@ -76,6 +98,16 @@ private:
 
 	void emitUnderFlow() const throw();
 
+	virtual std::size_t getCount() const throw();
+	virtual std::size_t getCount(Common::ICard::SUIT suit) const throw() _PURE;
+	virtual std::size_t getCount(Common::ICard::RANK rank) const throw() _PURE;
+	virtual std::size_t getCount(Common::ICard::SUIT suit, Common::ICard::RANK rank) const
+	throw() _PURE;
+	virtual uint32_t getPlayedOut() const throw() _PURE;
+
+	void countCard(const Common::ICardPtr &card) throw();
+	void clearCount() throw();
+
 private:
 	ITalonChange *m_talonChangeListener;
 	mutable CARDS m_playedOutCards;
@@ -83,6 +115,10 @@ private:
 	CARDSTACK m_uncovered;
 	mutable bool m_uncoveredDirty;
 	const std::size_t m_factor;
+	std::size_t m_cardCount[32];
+	std::size_t m_suitCount[4];
+	std::size_t m_rankCount[8];
+	uint32_t m_playedOutBits;
 };
 
 }
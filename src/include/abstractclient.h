@@ -93,6 +93,9 @@ public:
 
 	/**
 	 * @brief A vector of @c Common::ICard pointers
+	 *
+	 * @note All cards passed to a client are owned by the library and must not be deleted,
+	 * equal cards are always the same object.
 	 */
 	typedef std::vector<Common::ICard *> CARDS;
 
@@ -128,6 +131,86 @@ public:
 	 */
 	void play(timeval *timeout = NULL) throw(NetMauMau::Common::Exception::SocketException);
 
+	/**
+	 * @name Non-blocking game play
+	 *
+	 * Instead of calling @c play(), which blocks until the game is over, a client can be driven
+	 * by an external event loop, which allows to host many clients in a single thread.
+	 *
+	 * After @c startPlay() returned, @c processInput() must be called once and then every time
+	 * the descriptor returned by @c getSocketFD() becomes readable. It never waits for data,
+	 * but the callbacks it invokes run on the calling thread.
+	 *
+	 * Pictures of joining players which are not in the cache yet are fetched in the
+	 * background, the player joins without one and the picture follows with
+	 * @c playerPictureReceived(). As long as @c getPictureSocketFD() is valid it has to be
+	 * waited on as well, and @c processPictures() called if it becomes readable.
+	 *
+	 * @note All pictures are fetched over a single query session, opening it waits for the
+	 * server's greeting.
+	 *
+	 * @{
+	 */
+
+	/**
+	 * @brief Joins a game on the server without waiting for it to begin
+	 *
+	 * The connection is established synchronously.
+	 *
+	 * @param timeout the time to wait for a connection, if @c NULL there will be no timeout
+	 *
+	 * @throw Common::Exception::SocketException if the connection failed
+	 * @see play() for the other exceptions
+	 *
+	 * @since 0.25
+	 */
+	void startPlay(timeval *timeout = NULL) throw(NetMauMau::Common::Exception::SocketException);
+
+	/**
+	 * @brief Processes all messages received so far
+	 *
+	 * Reads the data available on the socket and fires the callbacks of every complete
+	 * message. A partially received message is kept and processed as soon as its remainder
+	 * has arrived.
+	 *
+	 * @throw Common::Exception::SocketException if the connection failed
+	 *
+	 * @return @c false if the game is over or the client got disconnected
+	 *
+	 * @since 0.25
+	 */
+	bool processInput() throw(NetMauMau::Common::Exception::SocketException);
+
+	/**
+	 * @brief Gets the socket descriptor to wait for readability on
+	 *
+	 * @return the socket descriptor
+	 *
+	 * @since 0.25
+	 */
+	SOCKET getSocketFD() const _PURE;
+
+	/**
+	 * @brief Gets the socket descriptor player pictures are fetched on
+	 *
+	 * @return the socket descriptor or @c INVALID_SOCKET if no picture is pending
+	 *
+	 * @since 0.25
+	 */
+	SOCKET getPictureSocketFD() const;
+
+	/**
+	 * @brief Delivers the player pictures received so far
+	 *
+	 * Every finished fetch ends with @c endReceivePlayerPicture(), followed by
+	 * @c playerPictureReceived() if the player has a picture.
+	 *
+	 * @since 0.25
+	 */
+	void processPictures();
+
+	/// @}
+
 	/**
 	 * @brief Disconnects the client from the server
 	 */
@@ -183,6 +266,38 @@ public:
 	PLAYERLIST playerList(timeval *timeout = NULL)
 	throw(NetMauMau::Common::Exception::SocketException);
 
+	/**
+	 * @brief Keeps the connection for server queries open
+	 *
+	 * As long as the session is open, @c capabilities(), @c playerList() and @c getScores()
+	 * share a single connection to the server instead of connecting for every query, which
+	 * is what a lobby refreshing its view periodically wants. A session lost in between is
+	 * reopened transparently by the next query. If both ends are built with zlib, larger
+	 * responses like pictures and long score lists are deflated within the session.
+	 *
+	 * @note Joining a game closes the session.
+	 *
+	 * @param timeout the time to wait for a connection, if @c NULL there will be no timeout
+	 *
+	 * @throw Common::Exception::SocketException if the connection failed
+	 * @throw Client::Exception::TimeoutException if the connection attempt timed out
+	 * @throw Client::Exception::CapabilitiesException if called within a running game
+	 *
+	 * @return @c false if the server doesn't support query sessions, the queries connect
+	 * separately then
+	 *
+	 * @since 0.25
+	 */
+	bool openQuerySession(timeval *timeout = NULL)
+	throw(NetMauMau::Common::Exception::SocketException);
+
+	/**
+	 * @brief Closes the connection kept open by @c openQuerySession()
+	 *
+	 * @since 0.25
+	 */
+	void closeQuerySession();
+
 	/**
 	 * @ingroup util
 	 * @brief Returns the version of the client's implemented protocol
@@ -560,6 +675,20 @@ protected:
 	 */
 	virtual void uploadFailed(const std::string &player) const throw() _CONST;
 
+	/**
+	 * @brief A player image fetched in the background has arrived
+	 *
+	 * Only in non-blocking game play, where the player joined without the image.
+	 *
+	 * @param player the player the image is downloaded for
+	 * @param pngData PNG data of the players picture
+	 * @param len length of the PNG data
+	 *
+	 * @since 0.25
+	 */
+	virtual void playerPictureReceived(const std::string &player, const unsigned char *pngData,
+									   std::size_t len) const throw() _CONST;
+
 	/// @}
 
 	/**
@@ -578,6 +707,10 @@ private:
 	void checkedError(const std::string &msg) const
 	throw(NetMauMau::Common::Exception::SocketException);
 
+	void beginGame(timeval *timeout) throw(NetMauMau::Common::Exception::SocketException);
+	void endGame();
+	bool dispatch() throw(NetMauMau::Common::Exception::SocketException);
+
 	virtual PIRET playInternal(const _playInternalParams &p)
 	throw(NetMauMau::Common::Exception::SocketException);
 
@@ -35,6 +35,7 @@
 #else
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/select.h>
 #endif
 
 #include "socketexception.h"
@@ -97,6 +98,25 @@ protected:
 	virtual std::string wireError(const std::string &err) const = 0;
 	virtual void intercept() _CONST;
 
+	/**
+	 * @brief Adds further descriptors to watch while waiting for data
+	 *
+	 * @param rfds the set to add the descriptors to
+	 * @return the highest descriptor added or @c 0 if none was added
+	 *
+	 * @since 0.25
+	 */
+	virtual SOCKET addInterceptFDs(fd_set &rfds) const;
+
+	/**
+	 * @brief Handles the descriptors added by addInterceptFDs which became readable
+	 *
+	 * @param rfds the set of readable descriptors
+	 *
+	 * @since 0.25
+	 */
+	virtual void interceptFDs(const fd_set &rfds) throw(Exception::SocketException);
+
 	std::size_t recv(void *buf, std::size_t len,
 					 SOCKET fd) throw(Exception::SocketException) _NOUNUSED;
 	static void send(const void *buf, std::size_t len, SOCKET fd) throw(Exception::SocketException);
@@ -136,6 +136,59 @@ _EXPORT _NOUNUSED bool parseCardDesc(const std::string &desc, NetMauMau::Common:
 _EXPORT std::string createCardDesc(NetMauMau::Common::ICard::SUIT suite,
 								   NetMauMau::Common::ICard::RANK rank, bool ansi);
 
+/**
+ * @ingroup util
+ * @brief Number of distinct cards in a deck, and the index of no card at all
+ *
+ * @see getCardIndex
+ */
+const std::size_t CARD_INDEX_ILLEGAL = 32u;
+
+/**
+ * @ingroup util
+ * @brief Gets the position of a card in a deck ordered by @c SUIT and @c RANK
+ *
+ * @param suit the @c SUIT
+ * @param rank the @c RANK
+ * @return the index in <tt>[0, 32)</tt> or @c CARD_INDEX_ILLEGAL
+ */
+_EXPORT std::size_t getCardIndex(NetMauMau::Common::ICard::SUIT suit,
+								 NetMauMau::Common::ICard::RANK rank) _CONST;
+
+/**
+ * @ingroup util
+ * @brief Gets the @c SUIT and @c RANK of a card index
+ *
+ * @param[in] idx the index as returned by getCardIndex, must be valid
+ * @param[out] suit pointer to store the resulting @c SUIT
+ * @param[out] rank pointer to store the resulting @c RANK
+ */
+_EXPORT void getCardFromIndex(std::size_t idx, NetMauMau::Common::ICard::SUIT *suit,
+							  NetMauMau::Common::ICard::RANK *rank) _NONNULL(2, 3);
+
+/**
+ * @ingroup util
+ * @brief Parses a card description as sent over the wire
+ *
+ * Only exact wire descriptions are recognized, the parsing works on the raw bytes and
+ * doesn't create any temporaries.
+ *
+ * @param desc the textual description of the card, needs not to be terminated
+ * @param len the length of @c desc in bytes
+ * @return the index of the card or @c CARD_INDEX_ILLEGAL
+ */
+_EXPORT std::size_t parseCardIndex(const char *desc, std::size_t len) _PURE;
+
+/**
+ * @ingroup util
+ * @brief Gets the precomputed description of a card index
+ *
+ * @param idx the index as returned by getCardIndex, must be valid
+ * @param ansi if @c true get the ANSI color representation
+ * @return the card description
+ */
+_EXPORT const std::string &getCardDesc(std::size_t idx, bool ansi) _PURE;
+
 /// @}
 
 /**
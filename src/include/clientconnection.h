@@ -42,6 +42,7 @@ class IBase64;
 class Connection : public Common::AbstractConnection {
 	DISALLOW_COPY_AND_ASSIGN(Connection)
 	friend class ConnectionImpl;
+	friend class AbstractClientV05;
 public:
 	using AbstractConnection::connect;
 	using AbstractSocket::getSocketFD;
@@ -151,6 +152,24 @@ private:
 	bool nextPlayer(std::string &player, bool playerPic)
 	throw(NetMauMau::Common::Exception::SocketException);
 
+	bool requestPicture(const std::string &player, const std::string &ref,
+						std::vector<unsigned char> &png)
+	throw(NetMauMau::Common::Exception::SocketException);
+	SOCKET getPictureSocketFD() const;
+	void receivePictures();
+	bool nextPicture(std::string &player, std::vector<unsigned char> &png);
+	void closePictures();
+	std::vector<unsigned char> fetchPicture(const std::string &hash)
+	throw(NetMauMau::Common::Exception::SocketException);
+
+	bool openQuerySession() throw(NetMauMau::Common::Exception::SocketException);
+	void closeQuerySession();
+
+	void setNonBlocking(bool nonBlocking);
+	void receiveAvailable() throw(NetMauMau::Common::Exception::SocketException);
+	void markMessage();
+	void rewindMessage();
+
 private:
 	ConnectionImpl *const _pimpl;
 };
@@ -30,6 +30,7 @@
 #include <stdint.h>
 
 #include "inullable.h"
+#include "playerpicture.h"
 #include "socketexception.h"
 
 /**
@@ -134,18 +135,33 @@ public:
 
 	typedef struct _EXPORT _nameSockFD {
 		explicit _nameSockFD();
+		/// decodes and hashes a non-empty @c playerPic, pass a PlayerPicture to share one
 		explicit _nameSockFD(const std::string &name, const std::string &playerPic, SOCKET sockfd,
 							 uint32_t clientVersion);
+		explicit _nameSockFD(const std::string &name, const PlayerPicture &playerPic,
+							 SOCKET sockfd, uint32_t clientVersion, bool pictureHashes = false,
+							 bool binaryFrames = false);
 		~_nameSockFD();
 
 		inline operator SOCKET() const {
 			return sockfd;
 		}
 
+		/**
+		 * @brief Gets the base64 encoded picture, empty if there is none
+		 *
+		 * @since 0.25
+		 */
+		inline const std::string &getPlayerPic() const {
+			return picture.getBase64();
+		}
+
 		std::string name;
-		mutable std::string playerPic;
 		SOCKET sockfd;
 		uint32_t clientVersion;
+		mutable PlayerPicture picture; ///< the decoded picture, @since 0.25
+		bool pictureHashes; ///< the client gets sent picture hashes instead of pictures
+		bool binaryFrames; ///< the client talks in binary frames instead of text, @since 0.25
 
 	} NAMESOCKFD;
 
@@ -153,6 +153,14 @@ namespace Commons {
 #endif
 #endif
 
+#ifndef _FLATTEN
+#if GCC_VERSION < 40100
+#define _FLATTEN
+#else
+#define _FLATTEN __attribute__ ((flatten))
+#endif
+#endif
+
 #ifndef _DEPRECATED
 #define _DEPRECATED __attribute__((deprecated))
 #endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * @author Heiko Schäfer <heiko@rangun.de>
+ */
+
+#ifndef NETMAUMAU_COMMON_PLAYERPICTURE_H
+#define NETMAUMAU_COMMON_PLAYERPICTURE_H
+
+#include <string>
+
+#include "linkercontrol.h"
+
+namespace NetMauMau {
+
+namespace Common {
+
+/**
+ * @brief Shared handle to an immutable player picture
+ *
+ * The picture is kept once in its base64 form as transmitted and once decoded. It gets
+ * decoded and hashed when the handle is created from the base64 data; copying a handle only
+ * increments a reference count, which is safe to do from different threads.
+ *
+ * @since 0.25
+ */
+class _EXPORT PlayerPicture {
+public:
+	/**
+	 * @brief Creates a handle to no picture
+	 */
+	PlayerPicture() throw();
+
+	/**
+	 * @brief Creates a picture from its base64 representation
+	 *
+	 * An empty @c base64 creates a handle to no picture.
+	 *
+	 * @param base64 the base64 encoded picture
+	 */
+	explicit PlayerPicture(const std::string &base64);
+
+	PlayerPicture(const PlayerPicture &o) throw();
+	~PlayerPicture() throw();
+
+	PlayerPicture &operator=(const PlayerPicture &o) throw();
+
+	void swap(PlayerPicture &o) throw();
+
+	/**
+	 * @brief Checks if there is no picture
+	 */
+	inline bool empty() const throw() {
+		return !m_blob;
+	}
+
+	/**
+	 * @brief Gets the base64 representation, empty if there is no picture
+	 */
+	const std::string &getBase64() const throw() _PURE;
+
+	/**
+	 * @brief Gets the decoded picture, empty if there is no picture
+	 */
+	const std::string &getData() const throw() _PURE;
+
+	/**
+	 * @brief Gets the SHA-1 of the decoded picture, empty if there is no picture
+	 *
+	 * Clients supporting picture hashes get sent this instead of the picture itself.
+	 */
+	const std::string &getHash() const throw() _PURE;
+
+private:
+	struct _blob;
+	const _blob *m_blob;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_COMMON_PLAYERPICTURE_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
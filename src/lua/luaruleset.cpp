@@ -64,6 +64,7 @@ const char *FUNCTIONS[] = {
 	"takeIfLost",
 	"takeAfterSevenIfNoMatch",
 	"getMaxPlayers",
+	"setState",
 };
 
 enum FUNCTIONNAMES {
@@ -90,7 +91,8 @@ enum FUNCTIONNAMES {
 	TAKEIFLOST,
 	TAKEAFTERSEVENIFNOMATCH,
 	ENDFUNCTIONS,
-	GETMAXPLAYERS = ENDFUNCTIONS
+	GETMAXPLAYERS = ENDFUNCTIONS,
+	SETSTATE
 };
 
 #pragma GCC diagnostic ignored "-Weffc++"
@@ -552,6 +554,27 @@ void LuaRuleSet::setCurPlayers(std::size_t players) throw(NetMauMau::Lua::Except
 	l.call(fname, 1, 0);
 }
 
+bool LuaRuleSet::setState(std::size_t takeCount, bool suspend,
+						  NetMauMau::Common::ICard::SUIT jackSuit)
+throw(NetMauMau::Lua::Exception::LuaException) {
+
+	const char *fname = FUNCTIONS[SETSTATE];
+
+	lua_getglobal(l, fname);
+
+	if(lua_isnil(l, -1)) {
+		lua_pop(l, 1);
+		return false;
+	}
+
+	lua_pushinteger(l, static_cast<lua_Integer>(takeCount));
+	lua_pushboolean(l, suspend);
+	lua_pushinteger(l, static_cast<lua_Integer>(jackSuit));
+	l.call(fname, 3, 0);
+
+	return true;
+}
+
 void LuaRuleSet::reset() throw() {
 
 	const char *fname = FUNCTIONS[INIT];
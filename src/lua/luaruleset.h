@@ -84,6 +84,9 @@ public:
 	virtual std::size_t getMaxPlayers() const throw(Lua::Exception::LuaException);
 	virtual void setCurPlayers(std::size_t players) throw(Lua::Exception::LuaException);
 
+	virtual bool setState(std::size_t takeCount, bool suspend, Common::ICard::SUIT jackSuit)
+	throw(Lua::Exception::LuaException);
+
 	virtual void reset() throw();
 
 private:
@@ -169,6 +169,22 @@ function setCurPlayers(num)
   m_curPlayers = num
 end
 
+--- Restores the rule engine's state (optional)
+-- Needed to import a saved game state into the engine.
+-- @param takeCardCount the amount of cards the next player has to take (integer)
+-- @param hasToSuspend true if the next player has to suspend (bool)
+-- @param jackSuit the wished Jack suit or SUIT.SUIT_ILLEGAL if not in Jack mode (SUIT)
+function setState(takeCardCount, hasToSuspend, jackSuit)
+  m_takeCardCount = takeCardCount
+  m_hasToSuspend = hasToSuspend
+  m_hasSuspended = false
+  m_jackMode = (jackSuit ~= SUIT.SUIT_ILLEGAL)
+  m_jackSuit = jackSuit
+  m_jackSuitOrig = not m_jackMode
+  m_aceRoundPlayer = nil
+  m_dirChange = false
+end
+
 local function isDirChange(playedCard)
   return nmm_dirChangePossible and playedCard.RANK == RANK.NINE
 end
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>                    // for find, min
+#include <cstring>                      // for memcpy
+#include <new>                          // for nothrow
+
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif
+
+#ifndef _WIN32
+#define MHD_PLATFORM_H 1
+#endif
+
+#include <microhttpd.h>
+
+#include "eventstream.h"
+#include "logger.h"
+
+#ifdef ENABLE_THREADS
+#include "mutexlocker.h"
+#endif
+
+#ifndef MHD_CONTENT_READER_END_WITH_ERROR
+#define MHD_CONTENT_READER_END_WITH_ERROR -2
+#endif
+
+namespace {
+
+#ifdef ENABLE_THREADS
+NetMauMau::Common::Mutex clientsMutex;
+#endif
+
+const std::size_t BLOCKSIZE = 4096u;
+
+}
+
+using namespace NetMauMau::Server;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Weffc++"
+struct EventStream::Client {
+
+	inline Client(EventStream *s, MHD_Connection *c, const std::string &initial) : stream(s),
+		connection(c), buffer(initial), suspended(false), dropped(false) {}
+
+	EventStream *const stream;
+	MHD_Connection *const connection;
+	std::string buffer;
+	bool suspended;
+	bool dropped;
+};
+#pragma GCC diagnostic pop
+
+EventStream::EventStream(std::size_t maxClients, std::size_t maxBuffered) : m_clients(),
+	m_maxClients(maxClients), m_maxBuffered(maxBuffered) {}
+
+EventStream::~EventStream() throw() {}
+
+int EventStream::queue(MHD_Connection *connection, const std::string &initial) throw() {
+
+	Client *client = 0L;
+
+	{
+#ifdef ENABLE_THREADS
+		MUTEXLOCKER(clientsMutex);
+#endif
+
+		if(m_clients.size() < m_maxClients &&
+				(client = new(std::nothrow) Client(this, connection, initial))) {
+			m_clients.push_back(client);
+		}
+	}
+
+	MHD_Response *response = client ? MHD_create_response_from_callback(MHD_SIZE_UNKNOWN,
+							 BLOCKSIZE, read, client, release) : 0L;
+
+	if(!response) {
+
+		if(client) release(client);
+
+		response = MHD_create_response_from_buffer(0u, 0L, MHD_RESPMEM_PERSISTENT);
+
+		const int ret = MHD_queue_response(connection, MHD_HTTP_SERVICE_UNAVAILABLE, response);
+
+		MHD_destroy_response(response);
+
+		return ret;
+	}
+
+	MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE,
+							"text/event-stream; charset=utf-8");
+	MHD_add_response_header(response, MHD_HTTP_HEADER_CACHE_CONTROL, "no-cache");
+
+	// the client gets released by the web server as soon as the connection is gone
+	const int ret = MHD_queue_response(connection, MHD_HTTP_OK, response);
+
+	MHD_destroy_response(response);
+
+	return ret;
+}
+
+void EventStream::publish(const char *event, const std::string &data) throw() {
+
+	const std::string &msg(format(event, data));
+
+#ifdef ENABLE_THREADS
+	MUTEXLOCKER(clientsMutex);
+#endif
+
+	for(std::vector<Client *>::const_iterator i(m_clients.begin()); i != m_clients.end(); ++i) {
+
+		Client *const c = *i;
+
+		if(c->dropped) continue;
+
+		if(c->buffer.size() + msg.size() > m_maxBuffered) {
+
+			logDebug("webserver: dropping slow event stream client");
+
+			c->dropped = true;
+			std::string().swap(c->buffer);
+
+		} else {
+			c->buffer.append(msg);
+		}
+
+		// a suspended client has read everything, it gets the event or learns it got dropped
+		if(c->suspended) {
+			c->suspended = false;
+#if MHD_VERSION >= 0x00093400
+			MHD_resume_connection(c->connection);
+#endif
+		}
+	}
+}
+
+void EventStream::close() throw() {
+#ifdef ENABLE_THREADS
+	MUTEXLOCKER(clientsMutex);
+#endif
+
+	for(std::vector<Client *>::const_iterator i(m_clients.begin()); i != m_clients.end(); ++i) {
+
+		Client *const c = *i;
+
+		c->dropped = true;
+
+		if(c->suspended) {
+			c->suspended = false;
+#if MHD_VERSION >= 0x00093400
+			MHD_resume_connection(c->connection);
+#endif
+		}
+	}
+}
+
+std::string EventStream::format(const char *event, const std::string &data) {
+
+	std::string msg("event: ");
+
+	msg.reserve(data.size() + 32u);
+	msg.append(event).append("\ndata: ");
+
+	for(std::string::const_iterator i(data.begin()); i != data.end(); ++i) {
+		if(*i == '\n') {
+			msg.append("\ndata: ");
+		} else if(*i != '\r') {
+			msg.push_back(*i);
+		}
+	}
+
+	return msg.append("\n\n");
+}
+
+ssize_t EventStream::read(void *cls, uint64_t, char *buf, size_t max) {
+
+	Client *const c = static_cast<Client *>(cls);
+
+#ifdef ENABLE_THREADS
+	MUTEXLOCKER(clientsMutex);
+#endif
+
+	if(c->dropped) return MHD_CONTENT_READER_END_WITH_ERROR;
+
+	if(c->buffer.empty()) {
+
+		// suspending under the lock makes sure publish() sees it and resumes the client
+		c->suspended = true;
+#if MHD_VERSION >= 0x00093400
+		MHD_suspend_connection(c->connection);
+#endif
+
+		return 0;
+	}
+
+	const std::size_t n = std::min(max, c->buffer.size());
+
+	std::memcpy(buf, c->buffer.data(), n);
+	c->buffer.erase(0u, n);
+
+	return static_cast<ssize_t>(n);
+}
+
+void EventStream::release(void *cls) {
+
+	Client *const c = static_cast<Client *>(cls);
+
+	{
+#ifdef ENABLE_THREADS
+		MUTEXLOCKER(clientsMutex);
+#endif
+
+		std::vector<Client *> &clients(c->stream->m_clients);
+		const std::vector<Client *>::iterator &f(std::find(clients.begin(), clients.end(), c));
+
+		if(f != clients.end()) clients.erase(f);
+	}
+
+	delete c;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_SERVER_EVENTSTREAM_H
+#define NETMAUMAU_SERVER_EVENTSTREAM_H
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>                     // for uint64_t
+#include <sys/types.h>                  // for ssize_t
+
+#include "linkercontrol.h"
+
+struct MHD_Connection;
+
+namespace NetMauMau {
+
+namespace Server {
+
+/**
+ * @brief Pushes the events of the server to the web clients as <tt>Server-Sent Events</tt>
+ *
+ * Every client gets its own buffer, which publish() appends to and the web server drains.
+ * A client with nothing to read is suspended and gets resumed by the next event, so an idle
+ * stream neither polls nor times out. A client which falls behind by more than the buffer
+ * size gets dropped instead of holding back the others or growing without bounds.
+ */
+class EventStream {
+	DISALLOW_COPY_AND_ASSIGN(EventStream)
+public:
+	/**
+	 * @param maxClients the maximum number of streams open at the same time
+	 * @param maxBuffered the maximum number of bytes waiting to be sent to a client
+	 */
+	explicit EventStream(std::size_t maxClients = 16u, std::size_t maxBuffered = 65536u);
+	~EventStream() throw();
+
+	/**
+	 * @brief Opens a stream on @c connection, which starts with @c initial
+	 *
+	 * If there are too many streams open already the client gets a
+	 * <tt>503 Service Unavailable</tt>.
+	 *
+	 * @param initial formatted events describing the current state
+	 */
+	int queue(MHD_Connection *connection, const std::string &initial) throw();
+
+	/**
+	 * @brief Sends an event to all clients
+	 *
+	 * @param event the name of the event
+	 * @param data the data of the event, every line of it becomes a line of data
+	 */
+	void publish(const char *event, const std::string &data) throw();
+
+	/**
+	 * @brief Ends all streams
+	 *
+	 * Resumes the suspended clients, which the web server can't be stopped with. Has to be
+	 * called before the web server gets stopped.
+	 */
+	void close() throw();
+
+	/**
+	 * @brief Formats an event for the stream
+	 */
+	static std::string format(const char *event, const std::string &data);
+
+private:
+	struct Client;
+
+	static ssize_t read(void *cls, uint64_t pos, char *buf, size_t max);
+	static void release(void *cls);
+
+private:
+	std::vector<Client *> m_clients;
+	const std::size_t m_maxClients;
+	const std::size_t m_maxBuffered;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_SERVER_EVENTSTREAM_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -32,6 +32,7 @@
 #include "abstractsocket.h"             // for AbstractSocket
 #include "easyplayer.h"                 // for EasyPlayer
 #include "hardplayer.h"
+#include "expertplayer.h"
 #include "gamecontext.h"                // for GameConfig
 #include "ieventhandler.h"              // for IEventHandler
 #include "logger.h"
@@ -88,12 +89,21 @@ Game::Game(GameContext &ctx) throw(NetMauMau::Common::Exception::SocketException
 							spos && (aiSanName.substr(spos + 1)[0] == 'e' ||
 									 aiSanName.substr(spos + 1)[0] == 'E')) {
 						type = NetMauMau::Player::IPlayer::EASY;
+					} else if(spos != GameContext::AINAMES::value_type::npos &&
+							  aiSanName.length() > spos && (aiSanName.substr(spos + 1)[0] == 'x' ||
+									  aiSanName.substr(spos + 1)[0] == 'X')) {
+						type = NetMauMau::Player::IPlayer::EXPERT;
 					}
 
 					m_aiPlayers.push_back(type == NetMauMau::Player::IPlayer::HARD ?
 										  static_cast<NetMauMau::Player::AbstractPlayer *>
 										  (new NetMauMau::Player::HardPlayer(aiSanName.
 												  substr(0, spos), m_engine.getPlayedOutCards())) :
+										  type == NetMauMau::Player::IPlayer::EXPERT ?
+										  static_cast<NetMauMau::Player::AbstractPlayer *>
+										  (new NetMauMau::Player::ExpertPlayer(aiSanName.
+												  substr(0, spos), m_engine.getPlayedOutCards(),
+												  ctx.getAIThinkTime())) :
 										  static_cast<NetMauMau::Player::AbstractPlayer *>
 										  (new NetMauMau::Player::EasyPlayer(aiSanName.
 												  substr(0, spos), m_engine.getPlayedOutCards())));
@@ -101,7 +111,9 @@ Game::Game(GameContext &ctx) throw(NetMauMau::Common::Exception::SocketException
 					logInfo(NetMauMau::Common::Logger::time(TIMEFORMAT) << "Adding AI player \""
 							<< m_aiPlayers.back()->getName() << "\" ("
 							<< (m_aiPlayers.back()->getType() ==
-								NetMauMau::Player::IPlayer::HARD ? "hard" : "easy") << ")");
+								NetMauMau::Player::IPlayer::HARD ? "hard" :
+								m_aiPlayers.back()->getType() ==
+								NetMauMau::Player::IPlayer::EXPERT ? "expert" : "easy") << ")");
 
 					m_engine.addPlayer(m_aiPlayers.back());
 					++aiAdded;
@@ -205,11 +217,18 @@ void Game::start(bool ultimate) throw(NetMauMau::Common::Exception::SocketExcept
 
 		m_engine.initialTurn();
 
+		std::size_t turn = 0u;
+
 		while(ultimate ? m_engine.getPlayerCount() >= 2u :
 				m_engine.getPlayerCount() == minPlayers) {
 
 			if(!m_engine.nextTurn()) break;
 
+			if(turn != m_engine.getTurn()) {
+				turn = m_engine.getTurn();
+				notify(TURN);
+			}
+
 			if(m_interrupted) {
 				shutdown();
 				break;
@@ -33,7 +33,7 @@ namespace Server {
 
 class GameContext;
 
-typedef enum { PLAYERADDED, PLAYERREMOVED, GAMESTARTED, GAMEENDED, READY } NOTIFYWHAT;
+typedef enum { PLAYERADDED, PLAYERREMOVED, GAMESTARTED, GAMEENDED, READY, TURN } NOTIFYWHAT;
 
 class Game : public Common::Observable<Game, NOTIFYWHAT> {
 	DISALLOW_COPY_AND_ASSIGN(Game)
@@ -67,6 +67,10 @@ public:
 		return m_running;
 	}
 
+	inline std::size_t getTurn() const {
+		return m_engine.getTurn();
+	}
+
 	inline DB::GAMEIDX getGameIndex() const {
 		return m_gameIndex;
 	}
@@ -23,12 +23,14 @@ using namespace NetMauMau::Server;
 
 GameContext::GameContext(NetMauMau::Event::IEventHandler &evtHdlr, long aiDelay, bool dirChange,
 						 NetMauMau::Common::CARDCONFIG &cc, bool aiPlayer, const AINAMES &aiNames,
-						 char aceRound)  throw() : m_aiPlayer(aiPlayer), m_aiNames(aiNames),
+						 char aceRound, long aiThinkTime)  throw() : m_aiPlayer(aiPlayer),
+	m_aiNames(aiNames), m_aiThinkTime(aiThinkTime),
 	m_engineCtx(evtHdlr, dirChange, aiDelay, !aiPlayer || !getAINames().empty(), aceRound, cc),
 	m_cardConfig(cc) {}
 
 GameContext::GameContext(const GameContext &o)  throw() : m_aiPlayer(o.m_aiPlayer),
-	m_aiNames(o.m_aiNames), m_engineCtx(o.m_engineCtx), m_cardConfig(o.m_cardConfig) {}
+	m_aiNames(o.m_aiNames), m_aiThinkTime(o.m_aiThinkTime), m_engineCtx(o.m_engineCtx),
+	m_cardConfig(o.m_cardConfig) {}
 
 GameContext::~GameContext() throw() {}
 
@@ -40,7 +40,8 @@ public:
 	explicit GameContext(const GameContext &) throw();
 	explicit GameContext(Event::IEventHandler &evtHdlr, long aiDelay, bool dirChange,
 						 Common::CARDCONFIG &cc, bool aiPlayer = false,
-						 const AINAMES &aiNames = AINAMES(), char aceRound = 0) throw();
+						 const AINAMES &aiNames = AINAMES(), char aceRound = 0,
+						 long aiThinkTime = 500L) throw();
 	~GameContext() throw();
 
 	inline bool hasAIPlayer() const throw() {
@@ -51,6 +52,10 @@ public:
 		return m_aiNames;
 	}
 
+	inline long getAIThinkTime() const throw() {
+		return m_aiThinkTime;
+	}
+
 	inline EngineContext &getEngineContext() throw() {
 		return m_engineCtx;
 	}
@@ -62,6 +67,7 @@ public:
 private:
 	const bool m_aiPlayer;
 	const AINAMES m_aiNames;
+	const long m_aiThinkTime;
 	EngineContext m_engineCtx;
 	Common::CARDCONFIG &m_cardConfig;
 };
@@ -140,6 +140,7 @@ namespace NetMauMau {
 volatile bool interrupt = false;
 
 double aiDelay = 1.0;
+long aiThinkTime = 500L;
 bool aceRound = false;
 int decks = 1;
 bool dirChange = false;
@@ -167,10 +168,15 @@ char *dpErr = 0L;
 #ifdef HAVE_LIBMICROHTTPD
 bool httpd = false;
 int hport = HTTPD_PORT;
+int hepoll = 0;
+int hthreads = 0;
+int hconnections = 64;
+int hperip = 16;
+int htimeout = 30;
 #endif
 
 void updatePlayerCap(Server::Connection::CAPABILITIES &caps, std::size_t count,
-					 Server::Connection &con) {
+					 Server::Connection &con, bool force) {
 
 #ifdef ENABLE_THREADS
 	MUTEXLOCKER(capsLock);
@@ -179,7 +185,15 @@ void updatePlayerCap(Server::Connection::CAPABILITIES &caps, std::size_t count,
 	std::ostringstream os;
 
 	os << count;
-	NetMauMau::Common::efficientAddOrUpdate(caps, "CUR_PLAYERS", os.str());
+
+	Server::Connection::CAPABILITIES::iterator f(caps.lower_bound("CUR_PLAYERS"));
+
+	// the pre-serialized responses get only rebuilt if something has changed
+	if(f != caps.end() && f->first == "CUR_PLAYERS" && f->second == os.str()) {
+		if(!force) return;
+	} else {
+		NetMauMau::Common::efficientAddOrUpdate(caps, "CUR_PLAYERS", os.str(), f);
+	}
 
 #ifdef HAVE_LIBMICROHTTPD
 
@@ -476,6 +490,7 @@ void dump(std::ostream &out) {
 
 	out << std::boolalpha << "== Options ==\n";
 	out << "AI-delay: " << static_cast<float>(aiDelay) << " sec\n";
+	out << "AI think time: " << aiThinkTime << " ms\n";
 	out << "A/K/Q rounds: " << aceRound << "\n";
 
 	std::string arRankStr;
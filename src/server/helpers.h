@@ -39,6 +39,7 @@ extern char *arRank;
 extern int decks;
 extern int initialCardCount;
 extern double aiDelay;
+extern long aiThinkTime;
 extern char bind[];
 extern char *host;
 extern int port;
@@ -52,6 +53,11 @@ extern char *dpErr;
 #ifdef HAVE_LIBMICROHTTPD
 extern bool httpd;
 extern int hport;
+extern int hepoll;
+extern int hthreads;
+extern int hconnections;
+extern int hperip;
+extern int htimeout;
 #endif
 
 #ifndef _WIN32
@@ -59,7 +65,7 @@ extern const char *interface;
 #endif
 
 void updatePlayerCap(Server::Connection::CAPABILITIES &caps, std::size_t count,
-					 Server::Connection &con);
+					 Server::Connection &con, bool force = false);
 
 char *inetdParsedString(char *str);
 void sh_interrupt(int);
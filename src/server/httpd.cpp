@@ -27,6 +27,8 @@
 
 #include <fstream>
 #include <cstring>
+#include <algorithm>
+#include <iterator>
 
 #include <stdint.h>
 #include <sys/types.h>
@@ -45,15 +47,17 @@
 #include <netdb.h>
 #endif
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 #include "httpd.h"
-#include "base64.h"
 #include "logger.h"
 #include "helpers.h"
 #include "iplayer.h"
 #include "mimemagic.h"
 #include "pathtools.h"
 #include "cachepolicyfactory.h"
-#include "defaultplayerimage.h"
 #include "abstractsocketimpl.h"
 
 #ifdef HAVE_ZLIB_H
@@ -69,7 +73,6 @@ namespace {
 
 #ifdef ENABLE_THREADS
 NetMauMau::Common::RWLock capsRWLock;
-NetMauMau::Common::Mutex  httpdMutex;
 NetMauMau::Common::Mutex  updateMutex;
 #endif
 
@@ -106,19 +109,27 @@ private:
 };
 
 struct listPlayers : std::unary_function<NetMauMau::Server::Httpd::PLAYERS::value_type, void> {
-	inline explicit listPlayers(std::ostream &o) : os(o), pos(0u) {}
+	inline listPlayers(std::ostream &o, const NetMauMau::Server::ImageStore &i) : os(o),
+		images(i), pos(0u) {}
 	inline result_type operator()(const argument_type &p) const {
+
+		// the hash makes the link change with the picture, which is cached for long
+		const std::string &h(images.getHash(p->getName()));
+
 		os << "<tr><td align=\"right\">&nbsp;" << ++pos
 		   << ".&nbsp;</td><td align=\"center\">&nbsp;<a href=\"/images/" << p->getName()
-		   << "\"><img height=\"30\" src=\"/images/" << p->getName() << "\">"
+		   << (h.empty() ? "" : "?v=") << h << "\"><img height=\"30\" src=\"/images/"
+		   << p->getName() << (h.empty() ? "" : "?v=") << h << "\">"
 		   << "</a><b>&nbsp;</td><td>&nbsp;" << p->getName() << "</b>&nbsp;<i>("
 		   << (p->getType() == NetMauMau::Player::IPlayer::HUMAN ? "human player" :
-			   (p->getType() == NetMauMau::Player::IPlayer::HARD ? "hard AI" : "easy AI"))
+			   (p->getType() == NetMauMau::Player::IPlayer::HARD ? "hard AI" :
+				(p->getType() == NetMauMau::Player::IPlayer::EXPERT ? "expert AI" : "easy AI")))
 		   << ")</i>&nbsp;</td></tr>";
 	}
 
 private:
 	std::ostream &os;
+	const NetMauMau::Server::ImageStore &images;
 	mutable std::size_t pos;
 };
 #pragma GCC diagnostic pop
@@ -165,10 +176,31 @@ void panic(void */*cls*/, const char *file, unsigned int line, const char *reaso
 }
 #endif
 
-int processRequestHeader(void *cls, enum MHD_ValueKind /*kind*/,
-						 const char *key, const char *value) {
-	reinterpret_cast<NetMauMau::Server::Httpd *>(cls)->insertReqHdrPair(key, value);
-	return MHD_YES;
+unsigned int threadPoolSize() {
+
+	if(NetMauMau::hthreads > 0) return static_cast<unsigned int>(NetMauMau::hthreads);
+
+#if defined(HAVE_UNISTD_H) && defined(_SC_NPROCESSORS_ONLN)
+	const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if(cores > 0) return static_cast<unsigned int>(cores);
+
+#endif
+
+	return 5u;
+}
+
+bool useEpoll() {
+
+	if(!NetMauMau::hepoll) return false;
+
+#if MHD_VERSION >= 0x00093300 && defined(__linux__)
+	return true;
+#else
+	logWarningN(NetMauMau::Common::nextLogBuf(), NetMauMau::Common::Logger::time(TIMEFORMAT)
+				<< "webserver: epoll is not available, falling back to select");
+	return false;
+#endif
 }
 
 int answer_to_connection(void *cls, struct MHD_Connection *connection, const char *url,
@@ -181,16 +213,7 @@ int answer_to_connection(void *cls, struct MHD_Connection *connection, const cha
 #endif
 						 void **/*con_cls*/) {
 
-#ifdef ENABLE_THREADS
-	MUTEXLOCKER(httpdMutex);
-	NetMauMau::Common::MutexLocker ul(updateMutex);
-#endif
-
 	NetMauMau::Server::Httpd *httpd = reinterpret_cast<NetMauMau::Server::Httpd *>(cls);
-	const bool havePlayers = !httpd->getPlayers().empty();
-
-	httpd->clearReqHdrMap();
-	MHD_get_connection_values(connection, MHD_HEADER_KIND, processRequestHeader, cls);
 
 #if MHD_VERSION > 0x00000200
 	// logging disabled for older MHD, maybe we should use the AcceptPolicy callback?
@@ -206,79 +229,68 @@ int answer_to_connection(void *cls, struct MHD_Connection *connection, const cha
 			 << "webserver: request from \'" << hbuf << "\' to resource \'" << url << "\'");
 #endif
 
-	NetMauMau::Server::CachePolicyFactory::ICachePolicyPtr cp;
-	std::vector<std::string::traits_type::char_type> bin;
+#if MHD_VERSION >= 0x00093400
 
-#ifdef HAVE_ZLIB_H
-	const NetMauMau::Server::Httpd::REQHEADERMAP::const_iterator
-	&accEnc(httpd->getReqHdrMap().find("Accept-Encoding"));
+	if(!std::strcmp("/events", url)) return httpd->queueEvents(connection);
 
-	bool gzipReq = accEnc != httpd->getReqHdrMap().end() && accEnc->second.find("deflate") !=
-				   NetMauMau::Server::Httpd::REQHEADERMAP::mapped_type::npos;
-#else
-	const bool gzipReq = false;
 #endif
 
-	char *contentType = 0L;
-	bool binGzip = false, binary = false;
-
-	std::ostringstream oss;
-	oss.unsetf(std::ios_base::skipws);
-
-	std::streambuf *sb = 0L;
+	// the pictures are served from their prepared responses without any lock
+	if(!std::strncmp("/images/", url, 8)) {
 
-#ifdef HAVE_ZLIB_H
+#if MHD_VERSION > 0x00000200
+		return httpd->getImages().queue(connection, std::strrchr(url, '/') + 1);
+#else
+		char *myUrl = unquoteUrl(url);
+		const int ret = httpd->getImages().queue(connection, std::strrchr(myUrl, '/') + 1);
 
-	try {
+		free(myUrl);
 
-		sb = gzipReq ? new NetMauMau::Common::Zstreambuf(oss, Z_BEST_COMPRESSION, true) : 0L;
+		return ret;
 #endif
+	}
 
-		std::ostream os(sb ? sb : oss.rdbuf());
+	NetMauMau::Server::CachePolicyFactory::ICachePolicyPtr cp;
+	std::vector<std::string::traits_type::char_type> bin;
 
-		if(!std::strncmp("/images/", url, 8)) {
+#ifdef HAVE_ZLIB_H
+	const char *accEnc = MHD_lookup_connection_value(connection, MHD_HEADER_KIND,
+						 MHD_HTTP_HEADER_ACCEPT_ENCODING);
 
-			cp = NetMauMau::Server::CachePolicyFactory::getInstance()->
-				 createPrivateCachePolicy(1800L);
+	const char *encoding = 0L;
+	NetMauMau::Common::Zstreambuf::FORMAT zformat = NetMauMau::Common::Zstreambuf::GZIP;
 
-			binary = true;
+	if(accEnc) {
 
-#if MHD_VERSION > 0x00000200
-			const char *name = std::strrchr(url, '/');
-#else
-			char *myUrl = unquoteUrl(url);
-			const char *name = std::strrchr(myUrl, '/');
-#endif
+		const NetMauMau::Common::ci_string ae(accEnc);
 
-			if(name && *(name + 1)) {
+		if(ae.find("gzip") != NetMauMau::Common::ci_string::npos) {
+			encoding = "gzip";
+		} else if(ae.find("deflate") != NetMauMau::Common::ci_string::npos) {
+			encoding = "deflate";
+			zformat = NetMauMau::Common::Zstreambuf::ZLIB;
+		}
+	}
 
-				const NetMauMau::Server::Httpd::IMAGES::const_iterator
-				&f(httpd->getImages().find(name + 1));
+#endif
 
-				if(f != httpd->getImages().end()) {
-					bin.assign(f->second.begin(), f->second.end());
-				} else {
-					bin.assign(NetMauMau::Common::DefaultPlayerImage.begin(),
-							   NetMauMau::Common::DefaultPlayerImage.end());
-				}
+	char *contentType = 0L;
+	bool binary = false;
 
-			} else {
-				bin.assign(NetMauMau::Common::DefaultPlayerImage.begin(),
-						   NetMauMau::Common::DefaultPlayerImage.end());
-			}
+	std::ostringstream oss;
+	oss.unsetf(std::ios_base::skipws);
 
-			const std::string &mime(NetMauMau::Common::MimeMagic::getInstance()->
-									getMime(reinterpret_cast<const unsigned char *>(bin.data()),
-											bin.size()));
+	{
+		// only the page gets rendered exclusively, it gets sent and compressed concurrently
+#ifdef ENABLE_THREADS
+		NetMauMau::Common::MutexLocker ul(updateMutex);
+#endif
 
-			contentType = !mime.empty() ? strdup((mime + "; charset=binary").c_str()) :
-						  strdup("image/png; charset=binary");
+		const bool havePlayers = !httpd->getPlayers().empty();
 
-#if MHD_VERSION <= 0x00000200
-			free(myUrl);
-#endif
+		std::ostream os(oss.rdbuf());
 
-		} else if(!std::strncmp("/robots.txt", url, 11)) {
+		if(!std::strncmp("/robots.txt", url, 11)) {
 
 			cp = NetMauMau::Server::CachePolicyFactory::getInstance()->createNoCachePolicy();
 			contentType = strdup("text/plain");
@@ -296,56 +308,15 @@ int answer_to_connection(void *cls, struct MHD_Connection *connection, const cha
 
 			if(!fav.fail()) {
 
-#ifdef HAVE_ZLIB_H
-
-				if(gzipReq) {
-
-					std::streambuf *fisb = 0L;
-
-					try {
-
-						binGzip = true;
-
-						std::ostringstream fioss;
-						fioss.unsetf(std::ios_base::skipws);
-
-						fisb = new NetMauMau::Common::Zstreambuf(fioss, Z_BEST_COMPRESSION, true);
-
-						std::ostream foss(fisb);
-
-						std::copy
-						(std::istreambuf_iterator<std::string::traits_type::char_type>(fav),
-						 std::istreambuf_iterator<std::string::traits_type::char_type>(),
-						 std::ostreambuf_iterator<std::string::traits_type::char_type>(foss));
-
-						foss.flush();
-						delete fisb;
+				bin.assign(std::istreambuf_iterator<std::string::traits_type::char_type>(fav),
+						   std::istreambuf_iterator<std::string::traits_type::char_type>());
 
-						const std::string &v(fioss.str());
-						bin.assign(v.begin(), v.end());
+				const std::string &mime(NetMauMau::Common::MimeMagic::getInstance()->
+										getMime(reinterpret_cast<const unsigned char *>
+												(bin.data()), bin.size()));
 
-					} catch(const NetMauMau::Common::Exception::ZLibException &) {
-						binGzip = false;
-						delete fisb;
-					}
-
-				} else {
-#endif
-					bin.assign(std::istreambuf_iterator<std::string::traits_type::char_type>(fav),
-							   std::istreambuf_iterator<std::string::traits_type::char_type>());
-#ifdef HAVE_ZLIB_H
-				}
-
-#endif
-
-				if(!gzipReq) {
-					const std::string &mime(NetMauMau::Common::MimeMagic::getInstance()->
-											getMime(reinterpret_cast<const unsigned char *>
-													(bin.data()), bin.size()));
-
-					if(!mime.empty()) {
-						LKFIM = contentType = strdup((mime + "; charset=binary").c_str());
-					}
+				if(!mime.empty()) {
+					LKFIM = contentType = strdup((mime + "; charset=binary").c_str());
 				}
 
 			} else {
@@ -401,6 +372,10 @@ int answer_to_connection(void *cls, struct MHD_Connection *connection, const cha
 
 			if(havePlayers) os << "<li><a href=\"#players\">Players online</a></li>";
 
+#if MHD_VERSION >= 0x00093400
+			os << "<li><a href=\"#events\">Live events</a></li>";
+#endif
+
 			if(!sc.empty()) os << "<li><a href=\"#scores\">Hall of Fame</a></li>";
 
 			os << "<li><a href=\"#capa\">Server capabilities</a></li>";
@@ -414,11 +389,27 @@ int answer_to_connection(void *cls, struct MHD_Connection *connection, const cha
 				   << ")</i></h2><p align=\"center\"><table>";
 
 				std::for_each(httpd->getPlayers().begin(), httpd->getPlayers().end(),
-							  listPlayers(os));
+							  listPlayers(os, httpd->getImages()));
 
 				os << "</table></p></a>" << B2TOP << "<hr />";
 			}
 
+#if MHD_VERSION >= 0x00093400
+			os << "<a name=\"events\"><h2 align=\"center\">Live events</h2></a>"
+			   << "<p align=\"center\"><ul id=\"events\"></ul></p><script>"
+			   << "if(window.EventSource){var l=document.getElementById('events'),"
+			   << "s=new EventSource('/events');function add(t){"
+			   << "var i=document.createElement('li');i.appendChild(document.createTextNode(t));"
+			   << "l.insertBefore(i,l.firstChild);"
+			   << "while(l.childNodes.length>20)l.removeChild(l.lastChild);}"
+			   << "s.addEventListener('join',function(e){add(e.data+' joined');});"
+			   << "s.addEventListener('leave',function(e){add(e.data+' left');});"
+			   << "s.addEventListener('win',function(e){add(e.data+' wins');});"
+			   << "s.addEventListener('turn',function(e){add('Turn '+e.data);});"
+			   << "s.addEventListener('state',function(e){add('Game is '+e.data);});}"
+			   << "</script>" << B2TOP << "<hr />";
+#endif
+
 			if(!sc.empty()) {
 				os << "<a name=\"scores\"><center><h2>Hall of Fame</h2><table width=\"50%\">"
 				   << "<tr><th>&nbsp;</th><th>PLAYER</th><th>SCORE</th></tr>";
@@ -453,47 +444,47 @@ int answer_to_connection(void *cls, struct MHD_Connection *connection, const cha
 		}
 
 		os.flush();
+	}
+
+	const std::string &page(binary ? std::string() : oss.str());
+	const char *body = binary ? bin.data() : page.data();
+	std::size_t len = binary ? bin.size() : page.size();
 
 #ifdef HAVE_ZLIB_H
-	} catch(const NetMauMau::Common::Exception::ZLibException &e) {
+	std::string zbody;
 
-		oss << e.what();
-		gzipReq = false;
+	if(encoding && len) {
 
-		if(!cp) cp = NetMauMau::Server::CachePolicyFactory::getInstance()->createNoCachePolicy();
-	}
+		try {
 
-#endif
+			NetMauMau::Common::Zstreambuf::compress(zbody, body, len, zformat);
 
-	delete sb;
+			body = zbody.data();
+			len  = zbody.size();
 
-	void *data = 0L;
+		} catch(const NetMauMau::Common::Exception::ZLibException &e) {
 
-	if(binary) {
+			logWarningN(NetMauMau::Common::nextLogBuf(),
+						NetMauMau::Common::Logger::time(TIMEFORMAT)
+						<< "webserver: failed to compress \'" << url << "\': " << e.what());
 
-		if((data = malloc(bin.size()))) {
-			std::memcpy(data, bin.data(), bin.size());
+			encoding = 0L;
 		}
 
-#ifdef HAVE_ZLIB_H
-	} else if(gzipReq) {
-
-		if((data = std::malloc(oss.str().size()))) {
-			std::memcpy(data, oss.str().data(), oss.str().size());
-		}
+	} else {
+		encoding = 0L;
+	}
 
 #endif
+
+	void *data = len ? std::malloc(len) : 0L;
+
+	if(data) {
+		std::memcpy(data, body, len);
 	} else {
-#ifdef HAVE_STRNDUP
-		data = static_cast<void *>(strndup(oss.str().c_str(), oss.str().length()));
-#else
-		data = static_cast<void *>(strdup(oss.str().c_str()));
-#endif
+		len = 0u;
 	}
 
-	const std::size_t len = binary ? (data ? bin.size() : 0u) : gzipReq ? oss.str().size() :
-								oss.str().length();
-
 #if MHD_VERSION < 0x00091400
 	MHD_Response *response = MHD_create_response_from_data(len, data, true, false);
 #else
@@ -504,8 +495,7 @@ int answer_to_connection(void *cls, struct MHD_Connection *connection, const cha
 
 #ifdef HAVE_ZLIB_H
 
-	if(gzipReq && (!binary || binGzip)) MHD_add_response_header(response,
-				MHD_HTTP_HEADER_CONTENT_ENCODING, "deflate");
+	if(encoding) MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_ENCODING, encoding);
 
 #endif
 
@@ -528,9 +518,10 @@ int answer_to_connection(void *cls, struct MHD_Connection *connection, const cha
 using namespace NetMauMau::Server;
 
 Httpd::Httpd() : Common::IObserver<Game>(), Common::IObserver<Engine>(),
-	Common::IObserver<Connection>(), Common::SmartSingleton<Httpd>(), m_daemon(0L), m_reqHdrMap(),
-	m_gameSource(0L), m_engineSource(0L), m_connectionSource(0L), m_players(), m_images(), m_caps(),
-	m_gameRunning(false), m_waiting(true), m_url() {
+	Common::IObserver<Connection>(), Common::SmartSingleton<Httpd>(), m_daemon(0L),
+	m_gameSource(0L), m_engineSource(0L), m_connectionSource(0L), m_players(), m_images(),
+	m_events(static_cast<std::size_t>(std::max(1, NetMauMau::hconnections / 2))),
+	m_playerNames(), m_caps(), m_gameRunning(false), m_waiting(true), m_url() {
 
 #if MHD_VERSION > 0x00000200
 	MHD_set_panic_func(panic, this);
@@ -538,16 +529,35 @@ Httpd::Httpd() : Common::IObserver<Game>(), Common::IObserver<Engine>(),
 
 	struct addrinfo *ai = NULL;
 
+	const bool epoll = NetMauMau::httpd && useEpoll();
+	const unsigned int threads = threadPoolSize();
+
+#if MHD_VERSION >= 0x00093300 && defined(__linux__)
+	unsigned int flags = epoll ? MHD_USE_EPOLL_INTERNALLY_LINUX_ONLY : MHD_USE_SELECT_INTERNALLY;
+#else
+	unsigned int flags = MHD_USE_SELECT_INTERNALLY;
+#endif
+
+#if MHD_VERSION >= 0x00093400
+	// the event streams get suspended while there is nothing to send
+	flags |= MHD_USE_SUSPEND_RESUME;
+#endif
+
+	// keep-alive is on as long as no response asks to close, the timeout reaps idle ones
 	if(NetMauMau::httpd && !NetMauMau::Common::AbstractSocketImpl::getAddrInfo(NetMauMau::host &&
 			*NetMauMau::host ? NetMauMau::host : 0L, static_cast<uint16_t>(NetMauMau::hport), &ai,
-			true) && ai && !(m_daemon = MHD_start_daemon(MHD_USE_SELECT_INTERNALLY,
+			true) && ai && !(m_daemon = MHD_start_daemon(flags,
 										static_cast<unsigned short>(NetMauMau::hport), NULL, NULL,
 										&answer_to_connection, this,
-										MHD_OPTION_CONNECTION_LIMIT, 10,
+										MHD_OPTION_CONNECTION_LIMIT, static_cast<unsigned int>
+										(std::max(1, NetMauMau::hconnections)),
 #if MHD_VERSION > 0x00000200
 										MHD_OPTION_SOCK_ADDR, ai->ai_addr,
-										MHD_OPTION_PER_IP_CONNECTION_LIMIT, 10,
-										MHD_OPTION_THREAD_POOL_SIZE, 5,
+										MHD_OPTION_PER_IP_CONNECTION_LIMIT,
+										static_cast<unsigned int>(std::max(0, NetMauMau::hperip)),
+										MHD_OPTION_CONNECTION_TIMEOUT,
+										static_cast<unsigned int>(std::max(0, NetMauMau::htimeout)),
+										MHD_OPTION_THREAD_POOL_SIZE, threads,
 #endif
 										MHD_OPTION_END))) {
 
@@ -568,7 +578,8 @@ Httpd::Httpd() : Common::IObserver<Game>(), Common::IObserver<Engine>(),
 #else
 				 << "localhost"
 #endif
-				 << ":" << NetMauMau::hport);
+				 << ":" << NetMauMau::hport << " (" << (epoll ? "epoll" : "select") << ", "
+				 << threads << " threads)");
 
 		std::ostringstream uos;
 
@@ -587,7 +598,10 @@ Httpd::Httpd() : Common::IObserver<Game>(), Common::IObserver<Engine>(),
 }
 
 Httpd::~Httpd() throw() {
-	if(m_daemon) MHD_stop_daemon(m_daemon);
+	if(m_daemon) {
+		m_events.close();
+		MHD_stop_daemon(m_daemon);
+	}
 }
 
 void Httpd::setSource(const NetMauMau::Common::IObserver<Connection>::source_type *s) {
@@ -608,15 +622,8 @@ void Httpd::update(const NetMauMau::Common::IObserver<Connection>::what_type &wh
 	MUTEXLOCKER(updateMutex);
 #endif
 
-	const std::vector<NetMauMau::Common::BYTE> &b64(NetMauMau::Common::base64_decode(what.second));
-
-	if(b64.empty()) {
-		NetMauMau::Common::efficientAddOrUpdate(m_images, what.first,
-												NetMauMau::Common::DefaultPlayerImage);
-	} else {
-		NetMauMau::Common::efficientAddOrUpdate(m_images, what.first,
-												std::string(b64.begin(), b64.end()));
-	}
+	// the picture got decoded already on upload
+	m_images.add(what.first, what.second);
 }
 
 void Httpd::update(const NetMauMau::Common::IObserver<NetMauMau::Engine>::what_type &what) {
@@ -624,6 +631,36 @@ void Httpd::update(const NetMauMau::Common::IObserver<NetMauMau::Engine>::what_t
 	MUTEXLOCKER(updateMutex);
 #endif
 
+	std::vector<std::string> names, changed;
+
+	names.reserve(what.size());
+
+	for(PLAYERS::const_iterator i(what.begin()); i != what.end(); ++i) {
+		names.push_back((*i)->getName());
+	}
+
+	std::sort(names.begin(), names.end());
+
+	// the engine tells the winner while it removes it, every other player removed has left
+	const NetMauMau::Player::IPlayer *winner = m_engineSource ? m_engineSource->getWinner() : 0L;
+
+	std::set_difference(m_playerNames.begin(), m_playerNames.end(), names.begin(), names.end(),
+						std::back_inserter(changed));
+
+	for(std::vector<std::string>::const_iterator i(changed.begin()); i != changed.end(); ++i) {
+		m_events.publish(winner && winner->getName() == *i ? "win" : "leave", *i);
+	}
+
+	changed.clear();
+
+	std::set_difference(names.begin(), names.end(), m_playerNames.begin(), m_playerNames.end(),
+						std::back_inserter(changed));
+
+	for(std::vector<std::string>::const_iterator i(changed.begin()); i != changed.end(); ++i) {
+		m_events.publish("join", *i);
+	}
+
+	m_playerNames.swap(names);
 	m_players = what;
 }
 
@@ -635,7 +672,19 @@ void Httpd::update(NetMauMau::Common::IObserver<Game>::what_type what) {
 	switch(what) {
 	case PLAYERADDED:
 	case PLAYERREMOVED:
-		break;
+		return;
+
+	case TURN:
+
+		if(m_gameSource) {
+
+			std::ostringstream os;
+
+			os << m_gameSource->getTurn();
+			m_events.publish("turn", os.str());
+		}
+
+		return;
 
 	case READY:
 		m_waiting = false;
@@ -648,11 +697,60 @@ void Httpd::update(NetMauMau::Common::IObserver<Game>::what_type what) {
 
 	case GAMEENDED:
 		m_players.clear();
+		m_playerNames.clear();
 		m_images.clear();
 		m_waiting = true;
 		m_gameRunning = false;
+		publishScores();
 		break;
 	}
+
+	m_events.publish("state", getState());
+}
+
+int Httpd::queueEvents(MHD_Connection *connection) {
+#ifdef ENABLE_THREADS
+	MUTEXLOCKER(updateMutex);
+#endif
+
+	std::string players;
+
+	for(std::vector<std::string>::const_iterator i(m_playerNames.begin());
+			i != m_playerNames.end(); ++i) {
+		players.append(i != m_playerNames.begin() ? "\n" : "").append(*i);
+	}
+
+	// registered under the lock, so the stream misses no event after the snapshot
+	return m_events.queue(connection, EventStream::format("state", getState()) +
+						  EventStream::format("players", players));
+}
+
+void Httpd::publishScores() {
+
+	bool haveScores;
+
+	{
+#ifdef ENABLE_THREADS
+		NetMauMau::Common::ReadLock crl(capsRWLock);
+#endif
+		haveScores = m_caps.find("HAVE_SCORES") != m_caps.end();
+	}
+
+	if(!haveScores) return;
+
+	const NetMauMau::DB::SQLite::SCORES &sc(NetMauMau::DB::SQLite::getInstance()->
+											getScores(NetMauMau::DB::SQLite::NORM));
+	std::ostringstream os;
+
+	for(NetMauMau::DB::SQLite::SCORES::const_iterator i(sc.begin()); i != sc.end(); ++i) {
+		os << (i != sc.begin() ? "\n" : "") << i->name << '\t' << i->score;
+	}
+
+	m_events.publish("scores", os.str());
+}
+
+const char *Httpd::getState() const {
+	return m_gameRunning ? "running" : (m_waiting ? "waiting" : "ready");
 }
 
 void Httpd::setCapabilities(const NetMauMau::Common::AbstractConnection::CAPABILITIES &caps) {
@@ -25,9 +25,12 @@
 #include "game.h"
 #include "eff_map.h"
 #include "ci_string.h"
+#include "imagestore.h"
+#include "eventstream.h"
 #include "serverconnection.h"
 
 struct MHD_Daemon;
+struct MHD_Connection;
 
 namespace NetMauMau {
 
@@ -41,9 +44,6 @@ class Httpd : public Common::IObserver<Game>, public Common::IObserver<Engine>,
 	friend class Common::SmartSingleton<Httpd>;
 public:
 	typedef NetMauMau::Common::IObserver<NetMauMau::Engine>::what_type PLAYERS;
-	typedef std::map < NetMauMau::Common::IObserver<Connection>::what_type::first_type,
-			NetMauMau::Common::IObserver<Connection>::what_type::second_type > IMAGES;
-	typedef std::map<std::string, NetMauMau::Common::ci_string> REQHEADERMAP;
 
 	virtual ~Httpd() throw();
 
@@ -67,36 +67,36 @@ public:
 		return m_players;
 	}
 
-	inline const IMAGES &getImages() const {
+	inline const ImageStore &getImages() const {
 		return m_images;
 	}
 
+	/**
+	 * @brief Opens an event stream on @c connection
+	 *
+	 * The stream starts with the state of the game and the players online, followed by the
+	 * events @c join, @c win and @c leave, @c turn, @c state and the @c scores after every game.
+	 */
+	int queueEvents(MHD_Connection *connection);
+
 	void setCapabilities(const Common::AbstractConnection::CAPABILITIES &caps);
 	const Common::AbstractConnection::CAPABILITIES &getCapabilities() const;
 
-	inline const REQHEADERMAP &getReqHdrMap() const {
-		return m_reqHdrMap;
-	}
-
-	inline void clearReqHdrMap() {
-		m_reqHdrMap.clear();
-	}
-
-	inline void insertReqHdrPair(const char *key, const char *value) {
-		NetMauMau::Common::efficientAddOrUpdate(m_reqHdrMap, key, value);
-	}
-
 private:
 	Httpd();
 
+	void publishScores();
+	const char *getState() const _PURE;
+
 private:
 	MHD_Daemon *m_daemon;
-	REQHEADERMAP m_reqHdrMap;
 	const Common::IObserver<Game>::source_type *m_gameSource;
 	const Common::IObserver<Engine>::source_type *m_engineSource;
 	const Common::IObserver<Connection>::source_type *m_connectionSource;
 	PLAYERS m_players;
-	IMAGES m_images;
+	ImageStore m_images;
+	EventStream m_events;
+	std::vector<std::string> m_playerNames;
 	Common::AbstractConnection::CAPABILITIES m_caps;
 	bool m_gameRunning;
 	bool m_waiting;
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>                    // for lower_bound, min
+#include <cstring>                      // for memcpy, strcmp, strstr
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif
+
+#ifndef _WIN32
+#define MHD_PLATFORM_H 1
+#endif
+
+#include <microhttpd.h>
+
+#include "imagestore.h"
+#include "sha1.h"
+#include "mimemagic.h"
+#include "refcounted.h"
+#include "cachepolicyfactory.h"
+#include "defaultplayerimage.h"
+
+#ifndef MHD_CONTENT_READER_END_OF_STREAM
+#define MHD_CONTENT_READER_END_OF_STREAM -1
+#endif
+
+namespace {
+
+// the links on the web page carry the hash, so a changed picture gets fetched anew anyway
+const long MAXAGE = 86400L;
+
+const std::size_t BLOCKSIZE = 32768u;
+
+struct nameLess {
+	template<class Entry> inline bool operator()(const Entry &e, const char *name) const throw() {
+		return std::strcmp(e.first.c_str(), name) < 0;
+	}
+};
+
+ssize_t readPicture(void *cls, uint64_t pos, char *buf, size_t max) {
+
+	const std::string &data(static_cast<const NetMauMau::Common::PlayerPicture *>(cls)->
+							getData());
+
+	if(pos >= data.size()) return MHD_CONTENT_READER_END_OF_STREAM;
+
+	const std::size_t n = std::min(max, data.size() - static_cast<std::size_t>(pos));
+
+	std::memcpy(buf, data.data() + pos, n);
+
+	return static_cast<ssize_t>(n);
+}
+
+void freePicture(void *cls) {
+	delete static_cast<NetMauMau::Common::PlayerPicture *>(cls);
+}
+
+MHD_Response *persistentResponse(const std::string &data) {
+#if MHD_VERSION < 0x00091400
+	return MHD_create_response_from_data(data.size(), const_cast<char *>(data.data()), false,
+										 false);
+#else
+	return MHD_create_response_from_buffer(data.size(), const_cast<char *>(data.data()),
+										   MHD_RESPMEM_PERSISTENT);
+#endif
+}
+
+}
+
+using namespace NetMauMau::Server;
+
+class ImageStore::Asset : public Common::RefCounted<Common::AtomicRefCountPolicy> {
+	DISALLOW_COPY_AND_ASSIGN(Asset)
+public:
+	Asset(MHD_Response *response, const std::string &data, const std::string &h) :
+		RefCounted<Common::AtomicRefCountPolicy>(), ok(response),
+		notModified(ok ? persistentResponse(std::string()) : 0L), hash(h),
+		etag("\"" + h + "\"") {
+
+		if(!ok) return;
+
+		const std::string &mime(Common::MimeMagic::getInstance()->
+								getMime(reinterpret_cast<const unsigned char *>(data.data()),
+										data.size()));
+
+		const CachePolicyFactory::ICachePolicyPtr
+		cp(CachePolicyFactory::getInstance()->createPrivateCachePolicy(MAXAGE));
+
+		MHD_add_response_header(ok, MHD_HTTP_HEADER_CONTENT_TYPE, ((!mime.empty() ? mime :
+								std::string("image/png")) + "; charset=binary").c_str());
+		MHD_add_response_header(ok, MHD_HTTP_HEADER_CACHE_CONTROL, cp->getCacheControl());
+		MHD_add_response_header(ok, MHD_HTTP_HEADER_ETAG, etag.c_str());
+
+		if(notModified) {
+			MHD_add_response_header(notModified, MHD_HTTP_HEADER_CACHE_CONTROL,
+									cp->getCacheControl());
+			MHD_add_response_header(notModified, MHD_HTTP_HEADER_ETAG, etag.c_str());
+		}
+	}
+
+	~Asset() throw() {
+		if(ok) MHD_destroy_response(ok);
+		if(notModified) MHD_destroy_response(notModified);
+	}
+
+	MHD_Response *const ok;
+	MHD_Response *const notModified;
+	const std::string hash;
+	const std::string etag;
+};
+
+ImageStore::ImageStore() : m_assets(new ASSETS()), m_retired(), m_readers(0u),
+	m_default(new Asset(persistentResponse(Common::DefaultPlayerImage),
+						Common::DefaultPlayerImage,
+						Common::sha1_hex(reinterpret_cast<const unsigned char *>
+								(Common::DefaultPlayerImage.data()),
+								Common::DefaultPlayerImage.size()))) {}
+
+ImageStore::~ImageStore() throw() {
+
+	delete m_assets;
+
+	for(std::vector<ASSETS *>::const_iterator i(m_retired.begin()); i != m_retired.end(); ++i) {
+		delete *i;
+	}
+}
+
+void ImageStore::add(const std::string &name, const Common::PlayerPicture &picture) {
+
+	ASSETS *next = new ASSETS(*m_assets);
+	const ASSETS::iterator &i(std::lower_bound(next->begin(), next->end(), name.c_str(),
+							  nameLess()));
+	const bool found = i != next->end() && i->first == name;
+
+	MHD_Response *response = 0L;
+
+	if(!(picture.empty() || picture.getData().empty())) {
+
+		// the response keeps its own handle, so the picture outlives a replaced asset
+		Common::PlayerPicture *const pic = new Common::PlayerPicture(picture);
+
+		if(!(response = MHD_create_response_from_callback(pic->getData().size(),
+						std::min(BLOCKSIZE, pic->getData().size()), readPicture, pic,
+						freePicture))) delete pic;
+	}
+
+	if(response) {
+
+		const ASSETPTR asset(new Asset(response, picture.getData(), picture.getHash()));
+
+		if(found) {
+			i->second = asset;
+		} else {
+			next->insert(i, std::make_pair(name, asset));
+		}
+
+	} else if(found) {
+		next->erase(i);
+	}
+
+	publish(next);
+}
+
+void ImageStore::clear() {
+	publish(new ASSETS());
+}
+
+void ImageStore::publish(ASSETS *assets) {
+
+	ASSETS *const prev = m_assets;
+
+	m_retired.push_back(prev);
+	m_assets = assets;
+
+	// pairs with the increment in queue(): a reader not counted here sees the new snapshot
+	__sync_synchronize();
+
+	if(!m_readers) {
+
+		for(std::vector<ASSETS *>::const_iterator i(m_retired.begin()); i != m_retired.end();
+				++i) {
+			delete *i;
+		}
+
+		m_retired.clear();
+	}
+}
+
+int ImageStore::queue(MHD_Connection *connection, const char *name) const throw() {
+
+	__sync_add_and_fetch(&m_readers, 1u);
+
+	const ASSETS &assets(*m_assets);
+	const ASSETS::const_iterator &i(std::lower_bound(assets.begin(), assets.end(), name,
+									nameLess()));
+	const Asset &a(i != assets.end() && i->first == name ? *i->second : *m_default);
+
+	const char *inm = MHD_lookup_connection_value(connection, MHD_HEADER_KIND,
+					  MHD_HTTP_HEADER_IF_NONE_MATCH);
+	const bool notModified = inm && a.notModified && std::strstr(inm, a.etag.c_str());
+
+	const int ret = a.ok ? MHD_queue_response(connection, notModified ? MHD_HTTP_NOT_MODIFIED :
+					MHD_HTTP_OK, notModified ? a.notModified : a.ok) : MHD_NO;
+
+	__sync_sub_and_fetch(&m_readers, 1u);
+
+	return ret;
+}
+
+std::string ImageStore::getHash(const std::string &name) const {
+
+	const ASSETS::const_iterator &i(std::lower_bound(m_assets->begin(), m_assets->end(),
+									name.c_str(), nameLess()));
+
+	return i != m_assets->end() && i->first == name ? i->second->hash : std::string();
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NETMAUMAU_SERVER_IMAGESTORE_H
+#define NETMAUMAU_SERVER_IMAGESTORE_H
+
+#include <string>
+#include <vector>
+
+#include "intrusiveptr.h"
+#include "playerpicture.h"
+
+struct MHD_Connection;
+struct MHD_Response;
+
+namespace NetMauMau {
+
+namespace Server {
+
+/**
+ * @brief The player pictures ready to be served by the web server
+ *
+ * Every picture is turned into a response once when it gets added, together with its MIME
+ * type and an @c ETag made of its hash. Serving a picture only looks up that response and
+ * queues it, the picture itself is never copied.
+ *
+ * Calls to add() and clear() have to be serialized by the caller. They publish a new sorted
+ * snapshot of the pictures, which queue() reads without taking a lock. A replaced snapshot
+ * is deleted as soon as no queue() is running anymore.
+ */
+class ImageStore {
+	DISALLOW_COPY_AND_ASSIGN(ImageStore)
+public:
+	ImageStore();
+	~ImageStore() throw();
+
+	void add(const std::string &name, const Common::PlayerPicture &picture);
+	void clear();
+
+	/**
+	 * @brief Queues the picture of @c name, or the default picture, on @c connection
+	 *
+	 * If the client sent the current @c ETag in @c If-None-Match it gets a
+	 * <tt>304 Not Modified</tt> instead.
+	 */
+	int queue(MHD_Connection *connection, const char *name) const throw();
+
+	/**
+	 * @brief Gets the hash of the picture of @c name, empty if there is none
+	 *
+	 * Must not be called concurrently to add() or clear().
+	 */
+	std::string getHash(const std::string &name) const;
+
+private:
+	class Asset;
+	typedef Common::IntrusivePtr<Asset> ASSETPTR;
+	typedef std::vector<std::pair<std::string, ASSETPTR> > ASSETS;
+
+	void publish(ASSETS *assets);
+
+private:
+	ASSETS *volatile m_assets;
+	std::vector<ASSETS *> m_retired;
+	mutable volatile unsigned int m_readers;
+	const ASSETPTR m_default;
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_SERVER_IMAGESTORE_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -140,13 +140,17 @@ poptOption poptOptions[] = {
 	{
 		"ai-name", 'A', POPT_ARG_STRING | POPT_ARGFLAG_SHOW_DEFAULT, &aiName, 'A',
 		"Set the name of one AI player. Can be given multiple times. " \
-		"Optionally append :E[asy] or :H[ard] to the name to set the strength. " \
-		"Whitespaces can get substituted by \'%\', \'%\' itself by \"%%\"", "NAME[:E|H]"
+		"Optionally append :E[asy], :H[ard] or :X (expert) to the name to set the strength. " \
+		"Whitespaces can get substituted by \'%\', \'%\' itself by \"%%\"", "NAME[:E|H|X]"
 	},
 	{
 		"ai-delay", 'D', POPT_ARG_DOUBLE | POPT_ARGFLAG_SHOW_DEFAULT, &NetMauMau::aiDelay,
 		0, "Delay after AI turns", "SECONDS"
 	},
+	{
+		"ai-think-time", 0, POPT_ARG_LONG | POPT_ARGFLAG_SHOW_DEFAULT, &NetMauMau::aiThinkTime,
+		0, "Time the expert AI may think about a move", "MILLISECONDS"
+	},
 #ifndef _WIN32
 	{
 		"inetd", 0,  POPT_ARG_NONE,  NULL, 'i',
@@ -169,6 +173,26 @@ poptOption poptOptions[] = {
 		"webserver", 'W', POPT_ARG_INT | POPT_ARGFLAG_SHOW_DEFAULT | POPT_ARGFLAG_OPTIONAL,
 		&NetMauMau::hport, 'W', "Enable the webserver at PORT", "PORT"
 	},
+	{
+		"webserver-epoll", 0, POPT_ARG_NONE, &NetMauMau::hepoll, 0,
+		"Let the webserver wait for connections by epoll instead of select (Linux only)", NULL
+	},
+	{
+		"webserver-threads", 0, POPT_ARG_INT | POPT_ARGFLAG_SHOW_DEFAULT, &NetMauMau::hthreads, 0,
+		"Amount of threads serving the webserver, 0 for one per core", "AMOUNT"
+	},
+	{
+		"webserver-connections", 0, POPT_ARG_INT | POPT_ARGFLAG_SHOW_DEFAULT,
+		&NetMauMau::hconnections, 0, "Maximum of concurrent webserver connections", "AMOUNT"
+	},
+	{
+		"webserver-per-ip", 0, POPT_ARG_INT | POPT_ARGFLAG_SHOW_DEFAULT, &NetMauMau::hperip, 0,
+		"Maximum of concurrent webserver connections from one IP", "AMOUNT"
+	},
+	{
+		"webserver-timeout", 0, POPT_ARG_INT | POPT_ARGFLAG_SHOW_DEFAULT, &NetMauMau::htimeout, 0,
+		"Close idle webserver connections after SECONDS, 0 to keep them open", "SECONDS"
+	},
 #endif
 #ifndef _WIN32
 	{
@@ -458,7 +482,7 @@ int main(int argc, const char **argv) {
 			Server::GameContext ctx(evtHdlr, static_cast<long>(::fabs(aiDelay * 1e06)),
 									dirChange, cconf, aiOpponent, aiNames,
 									static_cast<char>(aceRound ? ::toupper(arRank ?
-											arRank[0] : 'A') : 0));
+											arRank[0] : 'A') : 0), aiThinkTime);
 			Server::Game game(ctx);
 
 #ifdef HAVE_LIBMICROHTTPD
@@ -539,7 +563,7 @@ int main(int argc, const char **argv) {
 
 			try {
 #endif
-				updatePlayerCap(caps, game.getPlayerCount(), con);
+				updatePlayerCap(caps, game.getPlayerCount(), con, true);
 #ifdef ENABLE_THREADS
 			} catch(NetMauMau::Common::MutexException &) {}
 
@@ -29,6 +29,7 @@
 
 #include <sys/stat.h>                   // for stat
 
+#include <algorithm>                    // for find, max
 #include <cerrno>                       // for errno, ENOENT, ENOMEM
 #include <cstdio>                       // for NULL, fclose, feof, fopen, etc
 #include <cstring>                      // for strerror, strdup, strlen
@@ -49,6 +50,11 @@
 #include "tcpopt_cork.h"
 #include "tcpopt_nodelay.h"
 #include "protocol.h"                   // for BYE, VM_ADDPIC
+#include "wirecodec.h"                  // for WireCodec
+
+#ifdef HAVE_ZLIB_H
+#include "zsection.h"                   // for ZSectionDeflater
+#endif
 
 #ifndef TEMP_FAILURE_RETRY
 #define TEMP_FAILURE_RETRY
@@ -81,7 +87,7 @@ void *playerThread(void *arg) throw() {
 			if(!ptd->stp) {
 
 				try {
-					ptd->con.write(ptd->nfd.sockfd, ptd->msg);
+					ptd->con.write(ptd->nfd.sockfd, ptd->msg, ptd->nfd.binaryFrames);
 				} catch(const NetMauMau::Common::Exception::SocketException &e) {
 					delete ptd->exc;
 					ptd->exc = new(std::nothrow) NetMauMau::Common::Exception::SocketException(e);
@@ -185,6 +191,12 @@ const std::string aiBase64
 
 const char *TRANSMISSION  = "Player picture transmission for \"";
 
+const std::size_t MAXQUERYSESSIONS = 32u;
+const std::string::size_type MAXQUERYLENGTH = 1024u;
+
+// replies are a card, a number or a suit
+const uint32_t MAXREPLYLENGTH = 64u;
+
 #if !(defined(WIN32) || defined(NDEBUG))
 const char *LOSTCONPLAYER = "Lost connection to player \"";
 #endif
@@ -195,6 +207,54 @@ const char *NOPNG = " or no PNG image";
 const char *NOPNG = "";
 #endif
 
+bool wantsPictureHashes(const std::string &hello) {
+
+	const std::string::size_type p = hello.rfind(' ');
+
+	return p != std::string::npos && hello.compare(p + 1, std::string::npos,
+			NetMauMau::Common::Protocol::V15::PICHASH) == 0;
+}
+
+bool isQuerySession(const std::string &hello) {
+	return hello.compare(0, NetMauMau::Common::Protocol::V15::QUERY.length(),
+						 NetMauMau::Common::Protocol::V15::QUERY) == 0 &&
+		   (hello.length() == NetMauMau::Common::Protocol::V15::QUERY.length() ||
+			hello[NetMauMau::Common::Protocol::V15::QUERY.length()] == ' ');
+}
+
+#ifdef HAVE_ZLIB_H
+bool wantsDeflate(const std::string &hello) {
+
+	const std::string::size_type p = hello.rfind(' ');
+
+	return p != std::string::npos && hello.compare(p + 1, std::string::npos,
+			NetMauMau::Common::Protocol::V15::DEFLATE) == 0;
+}
+#endif
+
+bool wantsBinaryFrames(const std::string &hello) {
+
+	const std::string::size_type p = hello.find(" " + NetMauMau::Common::Protocol::V15::BINARY);
+	const std::string::size_type e = p + 1u + NetMauMau::Common::Protocol::V15::BINARY.length();
+
+	return p != std::string::npos && (e == hello.length() || hello[e] == ' ');
+}
+
+// clients supporting picture hashes fetch the pictures they don't have cached yet
+std::string &appendPicture(std::string &msg, const NetMauMau::Common::PlayerPicture &pic,
+						   bool hashes) {
+
+	if(pic.empty()) return msg.append(1, '-');
+
+	if(hashes) return msg.append(1, '#').append(pic.getHash());
+
+	const std::string::size_type resMsg = msg.length() + pic.getBase64().length() + 1;
+
+	if(resMsg <= msg.max_size()) msg.reserve(resMsg);
+
+	return msg.append(pic.getBase64());
+}
+
 #pragma GCC diagnostic ignored "-Weffc++"
 #pragma GCC diagnostic push
 struct _isPlayer : std::binary_function < NetMauMau::Common::IConnection::NAMESOCKFD, std::string,
@@ -217,8 +277,14 @@ struct _logOutPlayer : std::unary_function<NetMauMau::Common::IConnection::NAMES
 using namespace NetMauMau::Server;
 
 Connection::Connection(uint32_t minVer, bool inetd, uint16_t port, const char *server)
-	: AbstractConnection(server, port, true), m_caps(), m_clientMinVer(minVer), m_inetd(inetd),
-	  m_aiPlayerImages(new(std::nothrow) const std::string*[4]())
+	: AbstractConnection(server, port, true), m_caps(),
+	  m_capsResponse(NetMauMau::Common::Protocol::V15::CAPEND + std::string(1, 0)),
+	  m_playerListResponse(), m_clientMinVer(minVer), m_inetd(inetd), m_aiPlayerImages(),
+	  m_querySessions(), m_queryBuffers(),
+#ifdef HAVE_ZLIB_H
+	  m_deflaters(),
+#endif
+	  m_answeringQueries(false)
 #ifdef ENABLE_THREADS
 	  , m_data(), m_attr()
 #endif
@@ -257,6 +323,9 @@ Connection::Connection(uint32_t minVer, bool inetd, uint16_t port, const char *s
 
 #endif
 
+	// the last one is the default for AI players without an own image
+	NetMauMau::Common::PlayerPicture(aiBase64).swap(m_aiPlayerImages[4]);
+
 #if !defined(_WIN32) && (defined(HAVE_SYS_STAT_H) && defined(HAVE_SYS_TYPES_H))
 
 	struct stat s;
@@ -265,8 +334,6 @@ Connection::Connection(uint32_t minVer, bool inetd, uint16_t port, const char *s
 
 	for(int i = 0; i < 4; ++i) {
 
-		m_aiPlayerImages[i] = 0L;
-
 		char *fname = strdup(std::string(dataDir).append(1, 0x30 + i).append(".png").c_str());
 
 		if(stat(fname, &s) != -1) {
@@ -291,9 +358,9 @@ Connection::Connection(uint32_t minVer, bool inetd, uint16_t port, const char *s
 
 						if(NetMauMau::Common::checkPNG(picData,
 													   static_cast<std::size_t>(s.st_size))) {
-							m_aiPlayerImages[i] = new(std::nothrow)
-							std::string(NetMauMau::Common::base64_encode(picData,
-										static_cast<std::size_t>(s.st_size)));
+							NetMauMau::Common::PlayerPicture(NetMauMau::Common::
+									base64_encode(picData, static_cast<std::size_t>(s.st_size))).
+							swap(m_aiPlayerImages[i]);
 						} else {
 							logWarning(NetMauMau::Common::Logger::time(TIMEFORMAT)
 									   << "Image for AI player " << i << ": " << fname
@@ -324,10 +391,6 @@ Connection::Connection(uint32_t minVer, bool inetd, uint16_t port, const char *s
 		free(fname);
 	}
 
-#else
-
-	for(int i = 0; i < 4; ++i) m_aiPlayerImages[i] = 0L;
-
 #endif
 }
 
@@ -346,9 +409,9 @@ Connection::~Connection() {
 			_UNUSED(nd);
 
 #ifdef ENABLE_THREADS
-			signalMessage(m_data, i->sockfd, NetMauMau::Common::Protocol::V15::BYE);
+			signalMessage(m_data, *i, NetMauMau::Common::Protocol::V15::BYE);
 #else
-			send(NetMauMau::Common::Protocol::V15::BYE.c_str(), 3, i->sockfd);
+			write(i->sockfd, NetMauMau::Common::Protocol::V15::BYE, i->binaryFrames);
 #endif
 
 		} catch(const NetMauMau::Common::Exception::SocketException &) {}
@@ -358,9 +421,7 @@ Connection::~Connection() {
 	shutdownThreads();
 #endif
 
-	for(int i = 0; i < 4; ++i) delete m_aiPlayerImages[i];
-
-	delete [] m_aiPlayerImages;
+	while(!m_querySessions.empty()) closeQuerySession(m_querySessions.back());
 
 #ifdef ENABLE_THREADS
 	pthread_attr_destroy(&m_attr);
@@ -455,8 +516,17 @@ int Connection::wait(timeval *tv) {
 	FD_ZERO(&rfds);
 	FD_SET(getSocketFD(), &rfds);
 
-	return NetMauMau::Common::Select::getInstance()->perform(getSocketFD() + 1, &rfds,
-			NULL, NULL, tv);
+	const SOCKET ifd = addInterceptFDs(rfds);
+	const int ret = NetMauMau::Common::Select::getInstance()->perform(std::max(getSocketFD(),
+					ifd) + 1, &rfds, NULL, NULL, tv);
+
+	// new connections first, pending queries get answered on the next call
+	if(ret > 0 && !FD_ISSET(getSocketFD(), &rfds)) {
+		interceptFDs(rfds);
+		return 0;
+	}
+
+	return ret;
 }
 #pragma GCC diagnostic pop
 
@@ -503,11 +573,13 @@ Connection::ACCEPT_STATE Connection::accept(INFO &info,
 
 				const std::string rHello = read(cfd);
 
-				if(rHello != NetMauMau::Common::Protocol::V15::CAP &&
+				if(rHello != NetMauMau::Common::Protocol::V15::CAP && !isQuerySession(rHello) &&
 						rHello.compare(0, NetMauMau::Common::Protocol::V15::PLAYERLIST.length(),
 									   NetMauMau::Common::Protocol::V15::PLAYERLIST) != 0 &&
 						rHello.compare(0, NetMauMau::Common::Protocol::V15::SCORES.length(),
-									   NetMauMau::Common::Protocol::V15::SCORES) != 0) {
+									   NetMauMau::Common::Protocol::V15::SCORES) != 0 &&
+						rHello.compare(0, NetMauMau::Common::Protocol::V15::PICTURE.length(),
+									   NetMauMau::Common::Protocol::V15::PICTURE) != 0) {
 
 					const std::string::size_type spc = rHello.find(' ');
 					const std::string::size_type dot = rHello.find('.');
@@ -570,6 +642,7 @@ Connection::ACCEPT_STATE Connection::accept(INFO &info,
 						if(cver >= minver && cver <= maxver && !refuse) {
 
 							std::string playerPic, picLength;
+							NetMauMau::Common::PlayerPicture picture;
 
 							if(cver >= 4 && info.name[0] == '+') {
 
@@ -612,12 +685,20 @@ Connection::ACCEPT_STATE Connection::accept(INFO &info,
 
 										char cc[20] = "0\0";
 
-										if(pl > MAXPICBYTES || !isPNG(playerPic)) {
+										// decode it once, all lookups share this picture
+										if(pl <= MAXPICBYTES) {
+											NetMauMau::Common::PlayerPicture(playerPic).
+											swap(picture);
+										}
+
+										std::string().swap(playerPic);
+
+										if(pl > MAXPICBYTES || !isPNG(picture)) {
 
 											const NetMauMau::Common::TCPOptNodelay imgtl_nd(cfd);
 											_UNUSED(imgtl_nd);
 
-											std::string().swap(playerPic);
+											NetMauMau::Common::PlayerPicture().swap(picture);
 
 											send(cc, 20, cfd);
 
@@ -637,10 +718,12 @@ Connection::ACCEPT_STATE Connection::accept(INFO &info,
 											const NetMauMau::Common::TCPOptNodelay imgsucc_nd(cfd);
 											_UNUSED(imgsucc_nd);
 #ifndef _WIN32
-											std::snprintf(cc, 20, "%zu", playerPic.length());
+											std::snprintf(cc, 20, "%zu",
+														  picture.getBase64().length());
 #else
 											std::snprintf(cc, 20, "%lu",
-														  (unsigned long)playerPic.length());
+														  (unsigned long)picture.getBase64().
+														  length());
 #endif
 											send(cc, 20, cfd);
 
@@ -650,14 +733,16 @@ Connection::ACCEPT_STATE Connection::accept(INFO &info,
 												logWarning(
 													NetMauMau::Common::Logger::time(TIMEFORMAT)
 													<< TRANSMISSION << info.name
-													<< "\" failed: got " << playerPic.length()
+													<< "\" failed: got "
+													<< picture.getBase64().length()
 													<< " bytes; expected " << pl << " bytes)");
-												std::string().swap(playerPic);
+												NetMauMau::Common::PlayerPicture().swap(picture);
 											} else {
 												logInfo(NetMauMau::Common::Logger::time(TIMEFORMAT)
 														<< TRANSMISSION << info.name
 														<< "\" successful ("
-														<< playerPic.length() << " bytes)");
+														<< picture.getBase64().length()
+														<< " bytes)");
 											}
 										}
 
@@ -666,7 +751,7 @@ Connection::ACCEPT_STATE Connection::accept(INFO &info,
 										const NetMauMau::Common::TCPOptNodelay imgba_nd(cfd);
 										_UNUSED(imgba_nd);
 
-										std::string().swap(playerPic);
+										NetMauMau::Common::PlayerPicture().swap(picture);
 
 										char cc[20] = "0\0";
 										send(cc, 20, cfd);
@@ -685,7 +770,7 @@ Connection::ACCEPT_STATE Connection::accept(INFO &info,
 									const NetMauMau::Common::TCPOptNodelay imgfail_nd(cfd);
 									_UNUSED(imgfail_nd);
 
-									std::string().swap(playerPic);
+									NetMauMau::Common::PlayerPicture().swap(picture);
 
 									char cc[20] = "0\0";
 									send(cc, 20, cfd);
@@ -698,20 +783,22 @@ Connection::ACCEPT_STATE Connection::accept(INFO &info,
 										throwPlayerDisconnect(info);
 									}
 								}
-
-							} else {
-								std::string().swap(playerPic);
 							}
 
-							const NAMESOCKFD nsf(info.name, playerPic, cfd, cver);
+							const bool binary = wantsBinaryFrames(rHello);
+							const NAMESOCKFD nsf(info.name, picture, cfd, cver,
+												 wantsPictureHashes(rHello), binary);
 							const bool isOk = registerPlayer(nsf, getAIPlayers());
 
-							if(isOk) notify(std::make_pair(info.name, playerPic));
+							if(isOk) {
+								invalidatePlayerList();
+								notify(std::make_pair(info.name, picture));
+							}
 
 							const NetMauMau::Common::TCPOptNodelay okin_nd(cfd);
 							_UNUSED(okin_nd);
 
-							send(isOk ? "OK" : "IN", 2, cfd);
+							send(isOk ? (binary ? "OB" : "OK") : "IN", 2, cfd);
 
 							if(isOk) {
 								accepted = PLAY;
@@ -758,156 +845,313 @@ Connection::ACCEPT_STATE Connection::accept(INFO &info,
 						if(!gameRunning) shutdown(cfd);
 					}
 
-				} else if(rHello.compare(0, NetMauMau::Common::Protocol::V15::PLAYERLIST.length(),
-										 NetMauMau::Common::Protocol::V15::PLAYERLIST) == 0) {
+				} else if(isQuerySession(rHello)) {
 
-					const NetMauMau::Common::TCPOptCork sc_pl(cfd);
-					_UNUSED(sc_pl);
+					const NetMauMau::Common::TCPOptNodelay qry_nd(cfd);
+					_UNUSED(qry_nd);
 
-					const std::string::size_type spc = rHello.find(' ');
-					const std::string::size_type dot = rHello.find('.');
-
-					const PLAYERINFOS pi(getRegisteredPlayers());
-					const uint32_t cver = rHello.length() > 10 ?
-										  MAKE_VERSION(getMajorFromHello(rHello, dot, spc),
-													   getMinorFromHello(rHello, dot)) : 0;
+					if(m_querySessions.size() < MAXQUERYSESSIONS) {
 
-					for(PLAYERINFOS::const_iterator i(pi.begin()); i != pi.end(); ++i) {
+						std::string ack(NetMauMau::Common::Protocol::V15::QUERY);
 
-						std::string piz(i->name);
-						piz.append(1, 0);
+						m_querySessions.push_back(cfd);
+#ifdef HAVE_ZLIB_H
 
-						if(cver >= 4) {
+						if(wantsDeflate(rHello)) {
 
-							const std::string::size_type resPiz = piz.length() +
-																  i->playerPic.length() + 1;
+							try {
+								m_deflaters[cfd] = new NetMauMau::Common::ZSectionDeflater();
+								ack.append(1, ' ').
+								append(NetMauMau::Common::Protocol::V15::DEFLATE);
+							} catch(const NetMauMau::Common::Exception::ZLibException &e) {
+								logDebug(NetMauMau::Common::Logger::time(TIMEFORMAT)
+										 << "Query session without compression: " << e.what());
+							}
+						}
 
-							if(resPiz <= piz.max_size()) piz.reserve(resPiz);
+#endif
 
-							piz.append(i->playerPic.empty() ? "-" : i->playerPic).append(1, 0);
+						try {
+							send(ack.c_str(), ack.length(), cfd);
+						} catch(const NetMauMau::Common::Exception::SocketException &) {
+							closeQuerySession(cfd);
+							throw;
 						}
 
-						send(piz.c_str(), piz.length(), cfd);
+						accepted = QUERY;
+
+					} else {
+
+						send("NO", 2, cfd);
+
+						if(!gameRunning) shutdown(cfd);
+
+						accepted = REFUSED;
 					}
 
-					std::size_t j = 0;
+				} else {
 
-					for(PLAYERNAMES::const_iterator i(getAIPlayers().begin());
-							i != getAIPlayers().end(); ++i, ++j) {
+					accepted = answerQuery(cfd, rHello);
 
-						std::string piz(*i);
-						piz.append(1, 0);
+					if(!gameRunning) shutdown(cfd);
+				}
 
-						if(cver >= 4) {
+			} else {
+				if(!gameRunning) shutdown(cfd);
 
-							if(j >= 4) j = 0;
+				throw NetMauMau::Common::Exception::SocketException
+				(NetMauMau::Common::errorString(err, true), INVALID_SOCKET, errno);
+			}
 
-							const std::string::size_type resPiz = piz.length() +
-																  (m_aiPlayerImages[j] &&
-																   !m_aiPlayerImages[j]->empty() ?
-																   m_aiPlayerImages[j]->length() :
-																   aiBase64.length()) + 1;
+		} catch(const NetMauMau::Common::Exception::SocketException &) {
+			if(!gameRunning) shutdown(cfd);
 
-							if(resPiz <= piz.max_size()) piz.reserve(resPiz);
+			throw;
+		}
+	}
 
-							piz.append(m_aiPlayerImages[j] && !m_aiPlayerImages[j]->empty() ?
-									   (*m_aiPlayerImages[j]) : aiBase64).append(1, 0);
+	return accepted;
+}
 
-							notify(std::make_pair(*i, (m_aiPlayerImages[j] &&
-													   !m_aiPlayerImages[j]->empty()) ?
-												  (*m_aiPlayerImages[j]) : aiBase64));
-						}
+Connection::ACCEPT_STATE Connection::answerQuery(SOCKET cfd, const std::string &query)
+throw(NetMauMau::Common::Exception::SocketException) {
 
-						send(piz.c_str(), piz.length(), cfd);
-					}
+	if(query.compare(0, NetMauMau::Common::Protocol::V15::PLAYERLIST.length(),
+					 NetMauMau::Common::Protocol::V15::PLAYERLIST) == 0) {
 
-					std::vector<std::string::traits_type::char_type>
-					plEnd(NetMauMau::Common::Protocol::V15::PLAYERLISTEND.begin(),
-						  NetMauMau::Common::Protocol::V15::PLAYERLISTEND.end());
+		const std::string::size_type spc = query.find(' ');
+		const std::string::size_type dot = query.find('.');
 
-					plEnd.push_back('\0');
+		const uint32_t cver = query.length() > 10 ?
+							  MAKE_VERSION(getMajorFromHello(query, dot, spc),
+										   getMinorFromHello(query, dot)) : 0;
 
-					if(cver >= 4) {
-						plEnd.push_back('-');
-						plEnd.push_back('\0');
-					}
+		const std::string &pl(getPlayerListResponse(cver, cver && wantsPictureHashes(query)));
 
-					send(plEnd.data(), plEnd.size(), cfd);
+		sendResponse(cfd, pl);
 
-					if(!gameRunning) shutdown(cfd);
+		return PLAYERLIST;
 
-					accepted = PLAYERLIST;
+	} else if(query.compare(0, NetMauMau::Common::Protocol::V15::PICTURE.length(),
+							NetMauMau::Common::Protocol::V15::PICTURE) == 0) {
 
-				} else if(rHello.compare(0, NetMauMau::Common::Protocol::V15::SCORES.length(),
-										 NetMauMau::Common::Protocol::V15::SCORES) == 0) {
+		const NetMauMau::Common::TCPOptCork pic_ck(cfd);
+		_UNUSED(pic_ck);
 
-					const NetMauMau::Common::TCPOptCork sc_ck(cfd);
-					_UNUSED(sc_ck);
+		const std::string::size_type spc = query.find(' ');
 
-					const NetMauMau::DB::SQLite::SCORE_TYPE st =
-						rHello.compare(7, rHello.find(' ', 7) - 7, "ABS") == 0 ?
-						NetMauMau::DB::SQLite::ABS : NetMauMau::DB::SQLite::NORM;
+		std::string pic;
 
-					const std::size_t limit = std::strtoul(rHello.substr(rHello.rfind(' ')).c_str(),
-														   NULL, 10);
+		appendPicture(pic, spc != std::string::npos ?
+					  findPicture(query.substr(spc + 1)) :
+					  NetMauMau::Common::PlayerPicture(), false).append(1, 0);
 
-					const
-					NetMauMau::DB::SQLite::SCORES &scores(NetMauMau::DB::SQLite::getInstance()->
-														  getScores(st, limit));
+		sendResponse(cfd, pic);
 
-					std::ostringstream osscores;
+		return PICTURE;
 
-					for(NetMauMau::DB::SQLite::SCORES::const_iterator i(scores.begin());
-							i != scores.end(); ++i) {
-						osscores << i->name << '=' << i->score << '\0';
-					}
+	} else if(query.compare(0, NetMauMau::Common::Protocol::V15::SCORES.length(),
+							NetMauMau::Common::Protocol::V15::SCORES) == 0) {
 
-					osscores << NetMauMau::Common::Protocol::V15::SCORESEND << '\0';
+		const NetMauMau::Common::TCPOptCork sc_ck(cfd);
+		_UNUSED(sc_ck);
 
-					send(osscores.str().c_str(), osscores.str().length(), cfd);
+		const NetMauMau::DB::SQLite::SCORE_TYPE st =
+			(query.length() > 7 && query.compare(7, query.find(' ', 7) - 7, "ABS") == 0) ?
+			NetMauMau::DB::SQLite::ABS : NetMauMau::DB::SQLite::NORM;
 
-					if(!gameRunning) shutdown(cfd);
+		const std::string::size_type lsp = query.rfind(' ');
+		const std::size_t limit = lsp != std::string::npos ?
+								  std::strtoul(query.c_str() + lsp + 1, NULL, 10) : 0u;
 
-					accepted = SCORES;
+		const
+		NetMauMau::DB::SQLite::SCORES &scores(NetMauMau::DB::SQLite::getInstance()->
+											  getScores(st, limit));
 
-				} else {
+		std::ostringstream osscores;
 
-					NetMauMau::Common::TCPOptCork cap_ck(cfd);
-					_UNUSED(cap_ck);
+		for(NetMauMau::DB::SQLite::SCORES::const_iterator i(scores.begin());
+				i != scores.end(); ++i) {
+			osscores << i->name << '=' << i->score << '\0';
+		}
 
-					std::ostringstream oscap;
+		osscores << NetMauMau::Common::Protocol::V15::SCORESEND << '\0';
 
-					for(CAPABILITIES::const_iterator i(m_caps.begin()); i != m_caps.end(); ++i) {
-						oscap << i->first << '=' << i->second << '\0';
-					}
+		sendResponse(cfd, osscores.str());
 
-					oscap << NetMauMau::Common::Protocol::V15::CAPEND << '\0';
+		return SCORES;
 
-					send(oscap.str().c_str(), oscap.str().length(), cfd);
+	} else if(query == NetMauMau::Common::Protocol::V15::CAP) {
 
-					if(!gameRunning) shutdown(cfd);
+		sendResponse(cfd, m_capsResponse);
 
-					accepted = CAP;
-				}
+		return CAP;
+	}
 
-			} else {
-				if(!gameRunning) shutdown(cfd);
+	return NONE;
+}
 
-				throw NetMauMau::Common::Exception::SocketException
-				(NetMauMau::Common::errorString(err, true), INVALID_SOCKET, errno);
+void Connection::sendResponse(SOCKET cfd, const std::string &resp)
+throw(NetMauMau::Common::Exception::SocketException) {
+#ifdef HAVE_ZLIB_H
+
+	const DEFLATERS::const_iterator &f(m_deflaters.find(cfd));
+
+	if(f != m_deflaters.end()) {
+
+		std::string section;
+
+		try {
+			f->second->append(section, resp.data(), resp.length());
+		} catch(const NetMauMau::Common::Exception::ZLibException &e) {
+			throw NetMauMau::Common::Exception::SocketException(e.what(), cfd);
+		}
+
+		send(section.data(), section.length(), cfd);
+
+		return;
+	}
+
+#endif
+
+	send(resp.data(), resp.length(), cfd);
+}
+
+const std::string &Connection::getPlayerListResponse(uint32_t cver, bool picHash) {
+
+	std::string &pl(m_playerListResponse[cver >= 4 ? (picHash ? 2 : 1) : 0]);
+
+	if(!pl.empty()) return pl;
+
+	for(PLAYERINFOS::const_iterator i(getRegisteredPlayers().begin());
+			i != getRegisteredPlayers().end(); ++i) {
+
+		pl.append(i->name).append(1, 0);
+
+		if(cver >= 4) appendPicture(pl, i->picture, picHash).append(1, 0);
+	}
+
+	std::size_t j = 0;
+
+	for(PLAYERNAMES::const_iterator i(getAIPlayers().begin()); i != getAIPlayers().end();
+			++i, ++j) {
+
+		pl.append(*i).append(1, 0);
+
+		if(cver >= 4) {
+
+			if(j >= 4) j = 0;
+
+			appendPicture(pl, getAIPlayerPicture(j), picHash).append(1, 0);
+
+			notify(std::make_pair(*i, getAIPlayerPicture(j)));
+		}
+	}
+
+	pl.append(NetMauMau::Common::Protocol::V15::PLAYERLISTEND).append(1, 0);
+
+	if(cver >= 4) pl.append(1, '-').append(1, 0);
+
+	return pl;
+}
+
+void Connection::invalidatePlayerList() const throw() {
+	for(std::size_t i = 0u; i < 3u; ++i) std::string().swap(m_playerListResponse[i]);
+}
+
+void Connection::setCapabilities(const CAPABILITIES &caps) {
+
+	m_caps = caps;
+	m_capsResponse.clear();
+
+	for(CAPABILITIES::const_iterator i(m_caps.begin()); i != m_caps.end(); ++i) {
+		m_capsResponse.append(i->first).append(1, '=').append(i->second).append(1, 0);
+	}
+
+	m_capsResponse.append(NetMauMau::Common::Protocol::V15::CAPEND).append(1, 0);
+}
+
+SOCKET Connection::addInterceptFDs(fd_set &rfds) const {
+
+	SOCKET mfd = 0;
+
+	if(m_answeringQueries) return mfd;
+
+	for(QUERYSESSIONS::const_iterator i(m_querySessions.begin()); i != m_querySessions.end();
+			++i) {
+		FD_SET(*i, &rfds);
+		mfd = std::max(mfd, *i);
+	}
+
+	return mfd;
+}
+
+void Connection::interceptFDs(const fd_set &rfds)
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	// answering may close sessions, so iterate over a copy
+	const QUERYSESSIONS qs(m_querySessions);
+
+	m_answeringQueries = true;
+
+	for(QUERYSESSIONS::const_iterator i(qs.begin()); i != qs.end(); ++i) {
+
+		if(!FD_ISSET(*i, const_cast<fd_set *>(&rfds))) continue;
+
+		try {
+
+			// a query ends with a NUL byte, it may arrive in several pieces
+			std::string &buf(m_queryBuffers[*i]);
+			std::string::size_type end;
+			bool answered = true;
+
+			buf.append(read(*i));
+
+			while(answered && (end = buf.find('\0')) != std::string::npos) {
+
+				const std::string query(buf, 0, end);
+
+				buf.erase(0, end + 1);
+				answered = answerQuery(*i, query) != NONE;
 			}
 
-		} catch(const NetMauMau::Common::Exception::SocketException &) {
-			if(!gameRunning) shutdown(cfd);
+			if(!answered || buf.length() > MAXQUERYLENGTH) closeQuerySession(*i);
 
-			throw;
+		} catch(const NetMauMau::Common::Exception::SocketException &e) {
+			logDebug(NetMauMau::Common::Logger::time(TIMEFORMAT) << "Query session closed: "
+					 << e.what());
+			closeQuerySession(*i);
 		}
 	}
 
-	return accepted;
+	m_answeringQueries = false;
+}
+
+void Connection::closeQuerySession(SOCKET fd) throw() {
+
+	const QUERYSESSIONS::iterator &f(std::find(m_querySessions.begin(), m_querySessions.end(),
+										 fd));
+
+	if(f != m_querySessions.end()) {
+
+		m_querySessions.erase(f);
+		m_queryBuffers.erase(fd);
+#ifdef HAVE_ZLIB_H
+
+		const DEFLATERS::iterator &d(m_deflaters.find(fd));
+
+		if(d != m_deflaters.end()) {
+			delete d->second;
+			m_deflaters.erase(d);
+		}
+
+#endif
+		shutdown(fd);
+	}
 }
 
 void Connection::removePlayer(const NetMauMau::Common::IConnection::INFO &info) {
+	invalidatePlayerList();
 	NetMauMau::DB::SQLite::getInstance()->logOutPlayer(NAMESOCKFD(info.name, "", info.sockfd,
 			MAKE_VERSION(info.maj, info.min)));
 	NetMauMau::Common::AbstractConnection::removePlayer(info);
@@ -918,6 +1162,7 @@ void Connection::removePlayer(const NetMauMau::Common::IConnection::INFO &info)
 }
 
 void Connection::removePlayer(SOCKET sockfd) {
+	invalidatePlayerList();
 	NetMauMau::DB::SQLite::getInstance()->logOutPlayer(getPlayerInfo(sockfd));
 	NetMauMau::Common::AbstractConnection::removePlayer(sockfd);
 
@@ -926,6 +1171,11 @@ void Connection::removePlayer(SOCKET sockfd) {
 #endif
 }
 
+void Connection::addAIPlayers(const PLAYERNAMES &aiPlayers) {
+	invalidatePlayerList();
+	NetMauMau::Common::AbstractConnection::addAIPlayers(aiPlayers);
+}
+
 NetMauMau::Common::IConnection::NAMESOCKFD
 Connection::getPlayerInfo(const std::string &name) const {
 
@@ -971,20 +1221,18 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 					if(wantPic && pp != getPlayers().end()) {
 
-						const std::string &smsg(msg.replace(j->second.length() - 9,
-															std::string::npos,
-															pp->playerPic.empty() ? "-" :
-															pp->playerPic));
+						const std::string &smsg(appendPicture(msg.erase(j->second.length() - 9),
+												pp->picture, i->pictureHashes));
 #ifdef ENABLE_THREADS
-						signalMessage(m_data, i->sockfd, smsg);
+						signalMessage(m_data, *i, smsg);
 #else
-						write(i->sockfd, smsg);
+						write(i->sockfd, smsg, i->binaryFrames);
 #endif
 					} else {
 #ifdef ENABLE_THREADS
-						signalMessage(m_data, i->sockfd, msg);
+						signalMessage(m_data, *i, msg);
 #else
-						write(i->sockfd, msg);
+						write(i->sockfd, msg, i->binaryFrames);
 #endif
 					}
 
@@ -997,9 +1245,9 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 			if(!vMsg && nullV != vm.end()) {
 #ifdef ENABLE_THREADS
-				signalMessage(m_data, i->sockfd, nullV->second);
+				signalMessage(m_data, *i, nullV->second);
 #else
-				write(i->sockfd, nullV->second);
+				write(i->sockfd, nullV->second, i->binaryFrames);
 #endif
 			}
 		}
@@ -1010,9 +1258,74 @@ throw(NetMauMau::Common::Exception::SocketException) {
 #endif
 }
 
+void Connection::write(SOCKET fd, const std::string &msg) const
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	// only for the rare callers not knowing the player, all others pass its binaryFrames
+	for(PLAYERINFOS::const_iterator i(getRegisteredPlayers().begin());
+			i != getRegisteredPlayers().end(); ++i) {
+		if(i->sockfd == fd) return write(fd, msg, i->binaryFrames);
+	}
+
+	write(fd, msg, false);
+}
+
+void Connection::write(SOCKET fd, const std::string &msg,
+					   bool binary) throw(NetMauMau::Common::Exception::SocketException) {
+
+	if(!binary) {
+		NetMauMau::Common::AbstractConnection::write(fd, msg);
+		return;
+	}
+
+	// clients which negotiated binary frames get every NUL separated token as one frame
+	std::string frames;
+
+	frames.reserve(msg.length() + 8u);
+	NetMauMau::Common::WireCodec::encode(frames, msg.data(), msg.length());
+
+	send(frames.data(), frames.length(), fd);
+}
+
+std::string Connection::readReply(SOCKET fd, bool binary)
+throw(NetMauMau::Common::Exception::SocketException) {
+
+	if(!binary) return read(fd);
+
+	// a reply of a client using binary frames is exactly one frame, maybe sent in pieces
+	std::string frame, msg;
+	std::size_t n = 0u;
+
+	for(;;) {
+
+		uint32_t plen;
+		const std::size_t hl = NetMauMau::Common::WireCodec::getVarint(frame.data(),
+							   frame.length(), plen);
+
+		// don't wait for more than any reply can take
+		if(hl == NetMauMau::Common::WireCodec::MALFORMED || (hl && plen > MAXREPLYLENGTH)) break;
+
+		if(hl && (n = NetMauMau::Common::WireCodec::decode(frame.data(), frame.length(),
+					  msg))) break;
+
+		frame.append(read(fd));
+	}
+
+	if(n != frame.length()) {
+		throw NetMauMau::Common::Exception::SocketException("Malformed reply", fd);
+	}
+
+	return msg;
+}
+
 void Connection::clearPlayerPictures() const {
+
+	invalidatePlayerList();
+
 	for(PLAYERINFOS::const_iterator i(getRegisteredPlayers().begin());
-			i != getRegisteredPlayers().end(); ++i) std::string().swap(i->playerPic);
+			i != getRegisteredPlayers().end(); ++i) {
+		NetMauMau::Common::PlayerPicture().swap(i->picture);
+	}
 }
 
 Connection &Connection::operator<<(const std::string &msg)
@@ -1027,9 +1340,9 @@ throw(NetMauMau::Common::Exception::SocketException) {
 		_UNUSED(nd);
 
 #ifdef ENABLE_THREADS
-		signalMessage(m_data, i->sockfd, msg);
+		signalMessage(m_data, *i, msg);
 #else
-		write(i->sockfd, msg);
+		write(i->sockfd, msg, i->binaryFrames);
 #endif
 	}
 
@@ -1043,11 +1356,12 @@ throw(NetMauMau::Common::Exception::SocketException) {
 void Connection::intercept() throw(NetMauMau::Common::Exception::SocketException) {
 
 	INFO info;
+	ACCEPT_STATE state = NONE;
 
 	info.sockfd = INVALID_SOCKET;
 
 	try {
-		switch(accept(info, true)) {
+		switch(state = accept(info, true)) {
 		case NONE:
 			logInfo(NetMauMau::Common::Logger::time(TIMEFORMAT) << "Connection from "
 					<< info.host << ":" << info.port);
@@ -1077,6 +1391,16 @@ void Connection::intercept() throw(NetMauMau::Common::Exception::SocketException
 			logInfo(NetMauMau::Common::Logger::time(TIMEFORMAT) << "Scores request from "
 					<< info.host << ":" << info.port);
 			break;
+
+		case PICTURE:
+			logInfo(NetMauMau::Common::Logger::time(TIMEFORMAT) << "Player picture request from "
+					<< info.host << ":" << info.port);
+			break;
+
+		case QUERY:
+			logInfo(NetMauMau::Common::Logger::time(TIMEFORMAT) << "Query session from "
+					<< info.host << ":" << info.port);
+			break;
 		}
 
 	} catch(const NetMauMau::Common::Exception::SocketException &e) {
@@ -1094,15 +1418,36 @@ void Connection::intercept() throw(NetMauMau::Common::Exception::SocketException
 #endif
 	}
 
-	shutdown(info.sockfd);
+	if(state != QUERY) shutdown(info.sockfd);
+}
+
+const NetMauMau::Common::PlayerPicture &Connection::getAIPlayerPicture(std::size_t i) const {
+	return m_aiPlayerImages[i].empty() ? m_aiPlayerImages[4] : m_aiPlayerImages[i];
+}
+
+NetMauMau::Common::PlayerPicture Connection::findPicture(const std::string &hash) const {
+
+	for(PLAYERINFOS::const_iterator i(getRegisteredPlayers().begin());
+			i != getRegisteredPlayers().end(); ++i) {
+		if(i->picture.getHash() == hash) return i->picture;
+	}
+
+	for(std::size_t i = 0u; i < 5u; ++i) {
+		if(m_aiPlayerImages[i].getHash() == hash) return m_aiPlayerImages[i];
+	}
+
+	return NetMauMau::Common::PlayerPicture();
 }
 
-bool Connection::isPNG(const std::string &pic) {
-	const std::vector<NetMauMau::Common::BYTE> &pngData(NetMauMau::Common::base64_decode(pic));
-	return !(pngData.empty() || !NetMauMau::Common::checkPNG(pngData.data(), pngData.size()));
+bool Connection::isPNG(const NetMauMau::Common::PlayerPicture &pic) {
+	const std::string &pngData(pic.getData());
+	return !(pngData.empty() ||
+			 !NetMauMau::Common::checkPNG(reinterpret_cast<const unsigned char *>(pngData.data()),
+										  pngData.size()));
 }
 
 void Connection::reset() throw() {
+	invalidatePlayerList();
 	std::for_each(getRegisteredPlayers().begin(), getRegisteredPlayers().end(), _logOutPlayer());
 
 #ifdef ENABLE_THREADS
@@ -1178,9 +1523,9 @@ void Connection::waitPlayerThreads() const throw(NetMauMau::Common::Exception::S
 	}
 }
 
-void Connection::signalMessage(PTD &data, SOCKET fd, const std::string &msg) {
+void Connection::signalMessage(PTD &data, const NAMESOCKFD &nfd, const std::string &msg) {
 
-	const PTD::iterator &f(std::find_if(data.begin(), data.end(), _socketCmp(fd)));
+	const PTD::iterator &f(std::find_if(data.begin(), data.end(), _socketCmp(nfd.sockfd)));
 
 	if(f != data.end()) {
 
@@ -1190,14 +1535,14 @@ void Connection::signalMessage(PTD &data, SOCKET fd, const std::string &msg) {
 
 			(*f)->msg = msg;
 
-			if((*f)->get.signal()) write(fd, msg);
+			if((*f)->get.signal()) write(nfd.sockfd, msg, nfd.binaryFrames);
 
 		} catch(NetMauMau::Common::MutexException &) {
-			write(fd, msg);
+			write(nfd.sockfd, msg, nfd.binaryFrames);
 		}
 
 	} else {
-		write(fd, msg);
+		write(nfd.sockfd, msg, nfd.binaryFrames);
 	}
 }
 #endif
@@ -26,6 +26,7 @@
 
 #include <cstddef>                      // for NULL
 #include <functional>                   // for greater
+#include <map>                          // for map
 
 #ifdef ENABLE_THREADS
 #include "condition.h"
@@ -43,10 +44,16 @@ struct timeval;
 
 namespace NetMauMau {
 
+#ifdef HAVE_ZLIB_H
+namespace Common {
+class ZSectionDeflater;
+}
+#endif
+
 namespace Server {
 
 class Connection : public Common::AbstractConnection,
-	public Common::Observable<Connection, std::pair<std::string, std::string> > {
+	public Common::Observable<Connection, std::pair<std::string, Common::PlayerPicture> > {
 	DISALLOW_COPY_AND_ASSIGN(Connection)
 public:
 	using Common::AbstractConnection::wait;
@@ -111,7 +118,7 @@ public:
 	typedef std::vector<NetMauMau::Server::Connection::PLAYERTHREADDATA *> PTD;
 #endif
 
-	typedef enum { NONE, PLAY, CAP, REFUSED, PLAYERLIST, SCORES } ACCEPT_STATE;
+	typedef enum { NONE, PLAY, CAP, REFUSED, PLAYERLIST, SCORES, PICTURE, QUERY } ACCEPT_STATE;
 	typedef std::map<uint32_t, std::string, std::greater<uint32_t> > VERSIONEDMESSAGE;
 
 	explicit Connection(uint32_t minVer, bool inetd, uint16_t port = SERVER_PORT,
@@ -124,6 +131,7 @@ public:
 
 	virtual void removePlayer(const INFO &info);
 	virtual void removePlayer(SOCKET sockfd);
+	virtual void addAIPlayers(const PLAYERNAMES &aiPlayers);
 
 	inline const PLAYERINFOS &getPlayers() const {
 		return getRegisteredPlayers();
@@ -140,12 +148,15 @@ public:
 
 	Connection &operator<<(const std::string &msg) throw(Common::Exception::SocketException);
 
+	void write(SOCKET fd, const std::string &msg) const throw(Common::Exception::SocketException);
+	static void write(SOCKET fd, const std::string &msg,
+					  bool binary) throw(Common::Exception::SocketException);
+	std::string readReply(SOCKET fd, bool binary) throw(Common::Exception::SocketException);
+
 	ACCEPT_STATE
 	accept(INFO &v, bool gameRunning = false) throw(Common::Exception::SocketException);
 
-	inline void setCapabilities(const CAPABILITIES &caps) {
-		m_caps = caps;
-	}
+	void setCapabilities(const CAPABILITIES &caps);
 
 	inline static uint32_t getServerVersion() {
 		return MAKE_VERSION(SERVER_VERSION_MAJOR, SERVER_VERSION_MINOR);
@@ -163,10 +174,12 @@ protected:
 	virtual bool wire(SOCKET sockfd, const struct sockaddr *addr, socklen_t addrlen) const;
 	virtual std::string wireError(const std::string &err) const;
 	virtual void intercept() throw(Common::Exception::SocketException);
+	virtual SOCKET addInterceptFDs(fd_set &rfds) const;
+	virtual void interceptFDs(const fd_set &rfds) throw(Common::Exception::SocketException);
 
 #ifdef ENABLE_THREADS
 	friend class EventHandler;
-	static void signalMessage(PTD &data, SOCKET fd, const std::string &msg);
+	static void signalMessage(PTD &data, const NAMESOCKFD &nfd, const std::string &msg);
 	void waitPlayerThreads() const throw(Common::Exception::SocketException);
 	void removeThread(SOCKET fd);
 
@@ -177,7 +190,24 @@ protected:
 #endif
 
 private:
-	static bool isPNG(const std::string &pic);
+	typedef std::vector<SOCKET> QUERYSESSIONS;
+	typedef std::map<SOCKET, std::string> QUERYBUFFERS;
+#ifdef HAVE_ZLIB_H
+	typedef std::map<SOCKET, Common::ZSectionDeflater *> DEFLATERS;
+#endif
+
+	static bool isPNG(const Common::PlayerPicture &pic);
+
+	ACCEPT_STATE answerQuery(SOCKET cfd, const std::string &query)
+	throw(Common::Exception::SocketException);
+	void sendResponse(SOCKET cfd, const std::string &resp)
+	throw(Common::Exception::SocketException);
+	const std::string &getPlayerListResponse(uint32_t cver, bool picHash);
+	void invalidatePlayerList() const throw();
+	void closeQuerySession(SOCKET fd) throw();
+
+	const Common::PlayerPicture &getAIPlayerPicture(std::size_t i) const;
+	Common::PlayerPicture findPicture(const std::string &hash) const;
 
 #ifdef ENABLE_THREADS
 	void shutdownThreads() throw();
@@ -185,9 +215,17 @@ private:
 
 private:
 	CAPABILITIES m_caps;
+	std::string m_capsResponse;
+	mutable std::string m_playerListResponse[3];
 	const uint32_t m_clientMinVer;
 	const bool m_inetd;
-	const std::string **const m_aiPlayerImages;
+	Common::PlayerPicture m_aiPlayerImages[5];
+	QUERYSESSIONS m_querySessions;
+	QUERYBUFFERS m_queryBuffers;
+#ifdef HAVE_ZLIB_H
+	DEFLATERS m_deflaters;
+#endif
+	bool m_answeringQueries;
 
 #ifdef ENABLE_THREADS
 	mutable PTD m_data;
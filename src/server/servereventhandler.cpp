@@ -82,8 +82,8 @@ throw(NetMauMau::Common::Exception::SocketException) {
 // 				m_connection.signalMessage(m_connection.getData(), i->sockfd, type);
 // 				m_connection.signalMessage(m_connection.getData(), i->sockfd, msg);
 // #else
-				m_connection.write(i->sockfd, type);
-				m_connection.write(i->sockfd, msg);
+				m_connection.write(i->sockfd, type, i->binaryFrames);
+				m_connection.write(i->sockfd, msg, i->binaryFrames);
 // #endif
 			} catch(const NetMauMau::Common::Exception::SocketException &) {
 				logError(NetMauMau::Common::Logger::time(TIMEFORMAT) << "Couldn't send \""
@@ -195,7 +195,7 @@ throw(NetMauMau::Common::Exception::SocketException) {
 // 			m_connection.signalMessage(m_connection.getData(), i->sockfd,
 // 									   NetMauMau::Common::Protocol::V15::STATS);
 // #else
-			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::STATS);
+			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::STATS, i->binaryFrames);
 // #endif
 		} catch(const NetMauMau::Common::Exception::SocketException &) {
 			logError(NetMauMau::Common::Logger::time(TIMEFORMAT) << "Could send stats to \""
@@ -222,15 +222,15 @@ throw(NetMauMau::Common::Exception::SocketException) {
 // 					m_connection.signalMessage(m_connection.getData(), i->sockfd, p->getName());
 // 					m_connection.signalMessage(m_connection.getData(), i->sockfd, cc);
 // #else
-					m_connection.write(i->sockfd, p->getName());
-					m_connection.write(i->sockfd, cc);
+					m_connection.write(i->sockfd, p->getName(), i->binaryFrames);
+					m_connection.write(i->sockfd, cc, i->binaryFrames);
 // #endif
 				} catch(const NetMauMau::Common::Exception::SocketException &) {
 					try {
 // #ifdef ENABLE_THREADS
 // 						m_connection.signalMessage(m_connection.getData(), i->sockfd, "0");
 // #else
-						m_connection.write(i->sockfd, "0");
+						m_connection.write(i->sockfd, "0", i->binaryFrames);
 // #endif
 					} catch(const NetMauMau::Common::Exception::SocketException &) {}
 				}
@@ -241,7 +241,7 @@ throw(NetMauMau::Common::Exception::SocketException) {
 // 		m_connection.signalMessage(m_connection.getData(), i->sockfd,
 // 								   NetMauMau::Common::Protocol::V15::ENDSTATS);
 // #else
-		m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::ENDSTATS);
+		m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::ENDSTATS, i->binaryFrames);
 // #endif
 	}
 
@@ -311,9 +311,9 @@ throw(NetMauMau::Common::Exception::SocketException) {
 // 			m_connection.signalMessage(m_connection.getData(), i->sockfd,
 // 									   playedCard->description());
 // #else
-			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::CARDREJECTED);
-			m_connection.write(i->sockfd, player->getName());
-			m_connection.write(i->sockfd, playedCard->description());
+			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::CARDREJECTED, i->binaryFrames);
+			m_connection.write(i->sockfd, player->getName(), i->binaryFrames);
+			m_connection.write(i->sockfd, playedCard->description(), i->binaryFrames);
 // #endif
 		}
 	}
@@ -341,8 +341,8 @@ throw(NetMauMau::Common::Exception::SocketException) {
 // 								   NetMauMau::Common::Protocol::V15::PLAYERPICKSCARD);
 // 		m_connection.signalMessage(m_connection.getData(), i->sockfd, player->getName());
 // #else
-		m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::PLAYERPICKSCARD);
-		m_connection.write(i->sockfd, player->getName());
+		m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::PLAYERPICKSCARD, i->binaryFrames);
+		m_connection.write(i->sockfd, player->getName(), i->binaryFrames);
 // #endif
 
 		if(card && i->name.compare(player->getName()) == 0) {
@@ -351,15 +351,15 @@ throw(NetMauMau::Common::Exception::SocketException) {
 // 									   NetMauMau::Common::Protocol::V15::CARDTAKEN);
 // 			m_connection.signalMessage(m_connection.getData(), i->sockfd, card->description());
 // #else
-			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::CARDTAKEN);
-			m_connection.write(i->sockfd, card->description());
+			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::CARDTAKEN, i->binaryFrames);
+			m_connection.write(i->sockfd, card->description(), i->binaryFrames);
 // #endif
 		} else {
 // #ifdef ENABLE_THREADS
 // 			m_connection.signalMessage(m_connection.getData(), i->sockfd,
 // 									   NetMauMau::Common::Protocol::V15::HIDDENCARDTAKEN);
 // #else
-			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::HIDDENCARDTAKEN);
+			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::HIDDENCARDTAKEN, i->binaryFrames);
 // #endif
 		}
 	}
@@ -423,8 +423,8 @@ throw(NetMauMau::Common::Exception::SocketException) {
 // 									   i->sockfd, NetMauMau::Common::Protocol::V15::NEXTPLAYER);
 // 			m_connection.signalMessage(m_connection.getData(), i->sockfd, player->getName());
 // #else
-			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::NEXTPLAYER);
-			m_connection.write(i->sockfd, player->getName());
+			m_connection.write(i->sockfd, NetMauMau::Common::Protocol::V15::NEXTPLAYER, i->binaryFrames);
+			m_connection.write(i->sockfd, player->getName(), i->binaryFrames);
 // #endif
 		}
 	}
@@ -37,7 +37,15 @@ const std::string ILLEGAL_CARD(NetMauMau::Common::getIllegalCard()->description(
 using namespace NetMauMau::Server;
 
 Player::Player(const std::string &name, int sockfd, Connection &con) : AbstractPlayer(name, 0L),
-	m_connection(con), m_sockfd(sockfd) {}
+	m_connection(con), m_sockfd(sockfd), m_clientVersion(0u), m_binary(false),
+	m_handIndexVersion(0ul), m_handBits(0u), m_handPos() {
+
+	// neither changes while the player is connected
+	const Connection::NAMESOCKFD &nfd(con.getPlayerInfo(name));
+
+	m_clientVersion = nfd.clientVersion;
+	m_binary = nfd.binaryFrames;
+}
 
 Player::~Player() {}
 
@@ -80,13 +88,13 @@ throw(NetMauMau::Common::Exception::SocketException) {
 	NetMauMau::Player::AbstractPlayer::receiveCardSet(cards);
 
 	try {
-		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::GETCARDS);
+		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::GETCARDS, m_binary);
 
 		for(CARDS::const_iterator i(cards.begin()); i != cards.end(); ++i) {
-			m_connection.write(m_sockfd, (*i)->description());
+			m_connection.write(m_sockfd, (*i)->description(), m_binary);
 		}
 
-		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::CARDSGOT);
+		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::CARDSGOT, m_binary);
 
 	} catch(const NetMauMau::Common::Exception::SocketException &e) {
 		throw Exception::ServerPlayerException(getName(), std::string(__FUNCTION__).append(": ").
@@ -94,24 +102,22 @@ throw(NetMauMau::Common::Exception::SocketException) {
 	}
 }
 
-void Player::shuffleCards() {}
-
 NetMauMau::Common::ICardPtr Player::requestCard(const NetMauMau::Common::ICardPtr &uncoveredCard,
 		const NetMauMau::Common::ICard::SUIT *s, std::size_t takeCount, bool) const {
 
 	try {
 
-		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::OPENCARD);
-		m_connection.write(m_sockfd, uncoveredCard->description());;
-		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::PLAYCARD);
+		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::OPENCARD, m_binary);
+		m_connection.write(m_sockfd, uncoveredCard->description(), m_binary);
+		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::PLAYCARD, m_binary);
 
 		const CARDS &posCards(getPossibleCards(uncoveredCard, s));
 
 		for(CARDS::const_iterator i(posCards.begin()); i != posCards.end(); ++i) {
-			m_connection.write(m_sockfd, (*i)->description());
+			m_connection.write(m_sockfd, (*i)->description(), m_binary);
 		}
 
-		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::PLAYCARDEND);
+		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::PLAYCARDEND, m_binary);
 
 		if(getClientVersion() >= 8) {
 
@@ -123,10 +129,10 @@ NetMauMau::Common::ICardPtr Player::requestCard(const NetMauMau::Common::ICardPt
 			std::snprintf(cc, 20, "%lu", (unsigned long)takeCount);
 #endif
 
-			m_connection.write(m_sockfd, cc);
+			m_connection.write(m_sockfd, cc, m_binary);
 		}
 
-		const std::string offeredCard = m_connection.read(m_sockfd);
+		const std::string offeredCard = m_connection.readReply(m_sockfd, m_binary);
 
 		if(offeredCard == NetMauMau::Common::Protocol::V15::SUSPEND) {
 			return NetMauMau::Common::ICardPtr();
@@ -145,19 +151,44 @@ NetMauMau::Common::ICardPtr Player::requestCard(const NetMauMau::Common::ICardPt
 
 NetMauMau::Common::ICardPtr Player::findCard(const std::string &offeredCard) const {
 
-	NetMauMau::Common::ICard::SUIT s = NetMauMau::Common::ICard::HEARTS;
-	NetMauMau::Common::ICard::RANK r = NetMauMau::Common::ICard::ACE;
+	std::size_t idx = NetMauMau::Common::parseCardIndex(offeredCard.data(), offeredCard.size());
+
+	if(idx == NetMauMau::Common::CARD_INDEX_ILLEGAL) {
+
+		NetMauMau::Common::ICard::SUIT s = NetMauMau::Common::ICard::HEARTS;
+		NetMauMau::Common::ICard::RANK r = NetMauMau::Common::ICard::ACE;
+
+		if(!(NetMauMau::Common::parseCardDesc(offeredCard, &s, &r) &&
+				(idx = NetMauMau::Common::getCardIndex(s, r)) !=
+				NetMauMau::Common::CARD_INDEX_ILLEGAL)) {
+			return NetMauMau::Common::ICardPtr();
+		}
+	}
+
+	if(m_handIndexVersion != getHandVersion()) updateHandIndex();
+
+	return (m_handBits & (1u << idx)) ? getPlayerCards()[m_handPos[idx]] :
+		   NetMauMau::Common::ICardPtr();
+}
+
+void Player::updateHandIndex() const {
+
+	const CARDS &pc(getPlayerCards());
+
+	m_handBits = 0u;
 
-	if(NetMauMau::Common::parseCardDesc(offeredCard, &s, &r)) {
+	for(CARDS::size_type i = 0u; i < pc.size(); ++i) {
 
-		const CARDS &pc(getPlayerCards());
+		const std::size_t idx = NetMauMau::Common::getCardIndex(pc[i]->getSuit(),
+								pc[i]->getRank());
 
-		for(CARDS::const_iterator i(pc.begin()); i != pc.end(); ++i) {
-			if((*i) == s && (*i) == r) return NetMauMau::Common::ICardPtr(*i);
+		if(idx != NetMauMau::Common::CARD_INDEX_ILLEGAL) {
+			m_handBits |= 1u << idx;
+			m_handPos[idx] = static_cast<unsigned char>(i);
 		}
 	}
 
-	return NetMauMau::Common::ICardPtr();
+	m_handIndexVersion = getHandVersion();
 }
 
 bool Player::cardAccepted(const NetMauMau::Common::ICard *playedCard)
@@ -167,8 +198,8 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 	try {
 
-		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::CARDACCEPTED);
-		m_connection.write(m_sockfd, playedCard->description());
+		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::CARDACCEPTED, m_binary);
+		m_connection.write(m_sockfd, playedCard->description(), m_binary);
 
 		return !getCardCount();
 
@@ -180,7 +211,7 @@ throw(NetMauMau::Common::Exception::SocketException) {
 
 void Player::talonShuffled() throw(NetMauMau::Common::Exception::SocketException) {
 	NetMauMau::Player::AbstractPlayer::talonShuffled();
-	m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::TALONSHUFFLED);
+	m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::TALONSHUFFLED, m_binary);
 }
 
 Player::IPlayer::REASON Player::getNoCardReason(const NetMauMau::Common::ICardPtr &uncoveredCard,
@@ -199,8 +230,8 @@ std::size_t Player::getCardCount() const throw(NetMauMau::Common::Exception::Soc
 	std::size_t cc = 0;
 
 	try {
-		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::CARDCOUNT);
-		cc = std::strtoul(m_connection.read(m_sockfd).c_str(), NULL, 10);
+		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::CARDCOUNT, m_binary);
+		cc = std::strtoul(m_connection.readReply(m_sockfd, m_binary).c_str(), NULL, 10);
 	} catch(const NetMauMau::Common::Exception::SocketException &e) {
 		throw Exception::ServerPlayerException(getName(),
 											   std::string("Error in getting card count: ").
@@ -215,8 +246,8 @@ NetMauMau::Common::ICard::SUIT Player::getJackChoice(const NetMauMau::Common::IC
 throw(NetMauMau::Common::Exception::SocketException) {
 
 	try {
-		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::JACKCHOICE);
-		return NetMauMau::Common::symbolToSuit(m_connection.read(m_sockfd));
+		m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::JACKCHOICE, m_binary);
+		return NetMauMau::Common::symbolToSuit(m_connection.readReply(m_sockfd, m_binary));
 	} catch(const NetMauMau::Common::Exception::SocketException &e) {
 		throw Exception::ServerPlayerException(getName(), std::string(__FUNCTION__).append(": ").
 											   append(e.what()));
@@ -228,8 +259,9 @@ bool Player::getAceRoundChoice() const throw(NetMauMau::Common::Exception::Socke
 	if(isAceRoundAllowed()) {
 
 		try {
-			m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::ACEROUND);
-			return m_connection.read(m_sockfd) == NetMauMau::Common::Protocol::V15::TRUE;
+			m_connection.write(m_sockfd, NetMauMau::Common::Protocol::V15::ACEROUND, m_binary);
+			return m_connection.readReply(m_sockfd, m_binary) ==
+				   NetMauMau::Common::Protocol::V15::TRUE;
 		} catch(const NetMauMau::Common::Exception::SocketException &e) {
 			throw Exception::ServerPlayerException(getName(), std::string(__FUNCTION__).
 												   append(": ").append(e.what()));
@@ -240,7 +272,7 @@ bool Player::getAceRoundChoice() const throw(NetMauMau::Common::Exception::Socke
 }
 
 uint32_t Player::getClientVersion() const {
-	return m_connection.getPlayerInfo(getName()).clientVersion;
+	return m_clientVersion;
 }
 
 // kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4; 
@@ -62,16 +62,21 @@ public:
 
 	virtual bool getAceRoundChoice() const throw(NetMauMau::Common::Exception::SocketException);
 
-protected:
-	virtual void shuffleCards() _CONST;
-
 private:
 	_NOUNUSED Common::ICardPtr findCard(const std::string &offeredCard) const;
+	void updateHandIndex() const;
 	uint32_t getClientVersion() const;
 
 private:
 	Connection &m_connection;
 	const int m_sockfd;
+	uint32_t m_clientVersion;
+	bool m_binary;
+
+	// position in the hand of each card by its card index, valid if its bit is set
+	mutable unsigned long m_handIndexVersion;
+	mutable uint32_t m_handBits;
+	mutable unsigned char m_handPos[32];
 };
 
 }
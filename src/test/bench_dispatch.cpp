@@ -0,0 +1,218 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Replays the messages of a game the way the client library dispatches them, once through the
+ * former map keyed by the protocol strings and once through the perfect hash over the protocol
+ * keywords.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <cstdlib>                      // for EXIT_SUCCESS, strtoul
+#include <ctime>
+#include <iomanip>                      // for operator<<, setprecision
+#include <iostream>                     // for basic_ostream, operator<<, etc
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "protocol.h"                   // for PLAYCARD, TURN, etc
+#include "protohash.h"                  // for messageId
+
+namespace {
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+// the messages the client of a player receives in a game against another player
+std::string makeGame() {
+
+	using namespace NetMauMau::Common::Protocol::V15;
+
+	static const std::string *const START[] = {
+		&PLAYERJOINED, &PLAYERJOINED, &MESSAGE, &GETCARDS, &INITIALCARD, &STATS, &OPENCARD
+	};
+
+	static const std::string *const TURNS[] = {
+		&TURN, &STATS, &NEXTPLAYER, &PLAYCARD, &CARDACCEPTED, &PLAYEDCARD, &CARDCOUNT, &STATS,
+		&OPENCARD, &TURN, &STATS, &NEXTPLAYER, &PLAYERPICKSCARD, &SUSPENDS, &TURN, &STATS,
+		&NEXTPLAYER, &PLAYCARD, &CARDREJECTED, &PLAYCARD, &CARDACCEPTED, &JACKCHOICE,
+		&PLAYEDCARD, &JACKSUIT, &OPENCARD, &TURN, &STATS, &NEXTPLAYER, &PLAYEDCARD,
+		&JACKMODEOFF, &OPENCARD, &ACEROUNDSTARTED, &ACEROUND, &ACEROUNDENDED, &DIRCHANGE,
+		&TALONSHUFFLED, &GETCARDS, &PLAYERPICKSCARDS
+	};
+
+	std::string s;
+
+	for(std::size_t i = 0u; i < sizeof(START) / sizeof(START[0]); ++i) {
+		s.append(*START[i]).append(1, 0);
+	}
+
+	s.append(SUSPEND).append(" ").append(ON).append(1, 0);
+
+	for(std::size_t t = 0u; t < 16u; ++t) {
+		for(std::size_t i = 0u; i < sizeof(TURNS) / sizeof(TURNS[0]); ++i) {
+			s.append(*TURNS[i]).append(1, 0);
+		}
+	}
+
+	s.append(PLAYERWINS).append(1, 0).append(PLAYERLOST).append(1, 0).append(BYE).append(1, 0);
+
+	return s;
+}
+
+struct ptrCmp {
+	inline bool operator()(const std::string *x, const std::string *y) const {
+		return *x < *y;
+	}
+};
+
+typedef std::map<const std::string *, int, ptrCmp> PROTOMAP;
+
+// what AbstractClientV05 registers
+const std::string *const HANDLED[] = {
+	&NetMauMau::Common::Protocol::V15::ACEROUND,
+	&NetMauMau::Common::Protocol::V15::ACEROUNDENDED,
+	&NetMauMau::Common::Protocol::V15::ACEROUNDSTARTED,
+	&NetMauMau::Common::Protocol::V15::BYE,
+	&NetMauMau::Common::Protocol::V15::CARDACCEPTED,
+	&NetMauMau::Common::Protocol::V15::CARDCOUNT,
+	&NetMauMau::Common::Protocol::V15::CARDREJECTED,
+	&NetMauMau::Common::Protocol::V15::DIRCHANGE,
+	&NetMauMau::Common::Protocol::V15::ERROR,
+	&NetMauMau::Common::Protocol::V15::GETCARDS,
+	&NetMauMau::Common::Protocol::V15::INITIALCARD,
+	&NetMauMau::Common::Protocol::V15::JACKCHOICE,
+	&NetMauMau::Common::Protocol::V15::JACKMODEOFF,
+	&NetMauMau::Common::Protocol::V15::JACKSUIT,
+	&NetMauMau::Common::Protocol::V15::MESSAGE,
+	&NetMauMau::Common::Protocol::V15::NEXTPLAYER,
+	&NetMauMau::Common::Protocol::V15::OPENCARD,
+	&NetMauMau::Common::Protocol::V15::PLAYCARD,
+	&NetMauMau::Common::Protocol::V15::PLAYEDCARD,
+	&NetMauMau::Common::Protocol::V15::PLAYERJOINED,
+	&NetMauMau::Common::Protocol::V15::PLAYERPICKSCARD,
+	&NetMauMau::Common::Protocol::V15::PLAYERPICKSCARDS,
+	&NetMauMau::Common::Protocol::V15::PLAYERREJECTED,
+	&NetMauMau::Common::Protocol::V15::STATS,
+	&NetMauMau::Common::Protocol::V15::SUSPENDS,
+	&NetMauMau::Common::Protocol::V15::TALONSHUFFLED,
+	&NetMauMau::Common::Protocol::V15::TURN
+};
+
+const std::size_t HANDLED_CNT = sizeof(HANDLED) / sizeof(HANDLED[0]);
+
+// the handler of every message, -1 if it isn't understood
+double replayMap(const std::string &game, unsigned long rounds, std::vector<int> &handlers) {
+
+	PROTOMAP map;
+
+	for(std::size_t i = 0u; i < HANDLED_CNT; ++i) map.insert(std::make_pair(HANDLED[i],
+				static_cast<int>(i)));
+
+	std::string msg;
+
+	const double start = now();
+
+	for(unsigned long r = 0ul; r < rounds; ++r) {
+
+		handlers.clear();
+
+		for(std::string::size_type p = 0u, e; (e = game.find('\0', p)) != std::string::npos;
+				p = e + 1u) {
+
+			msg.assign(game, p, e - p);
+
+			const PROTOMAP::const_iterator &f(map.find(&msg));
+
+			handlers.push_back(f != map.end() ? f->second : -1);
+		}
+	}
+
+	return now() - start;
+}
+
+double replayHash(const std::string &game, unsigned long rounds, std::vector<int> &handlers) {
+
+	int table[NetMauMau::Common::Protocol::ID_UNKNOWN + 1];
+
+	std::fill(table, table + NetMauMau::Common::Protocol::ID_UNKNOWN + 1, -1);
+
+	for(std::size_t i = 0u; i < HANDLED_CNT; ++i) {
+		table[NetMauMau::Common::Protocol::messageId(HANDLED[i]->data(),
+				HANDLED[i]->length())] = static_cast<int>(i);
+	}
+
+	const double start = now();
+
+	for(unsigned long r = 0ul; r < rounds; ++r) {
+
+		handlers.clear();
+
+		for(std::string::size_type p = 0u, e; (e = game.find('\0', p)) != std::string::npos;
+				p = e + 1u) {
+			handlers.push_back(table[NetMauMau::Common::Protocol::messageId(game.data() + p,
+								e - p)]);
+		}
+	}
+
+	return now() - start;
+}
+
+}
+
+int main(int argc, const char **argv) {
+
+	const unsigned long rounds = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 20000ul;
+
+	const std::string &game(makeGame());
+	std::vector<int> mHandlers, hHandlers;
+
+	const double mt = replayMap(game, rounds, mHandlers);
+	const double ht = replayHash(game, rounds, hHandlers);
+
+	const double msgs = static_cast<double>(hHandlers.size()) * static_cast<double>(rounds);
+	const bool ok = !hHandlers.empty() && mHandlers == hHandlers;
+
+	std::cout << hHandlers.size() << " messages per game, " << rounds << " games" << std::endl
+			  << std::fixed << std::setprecision(0)
+			  << "map:          " << (mt > 0.0 ? msgs / mt : 0.0) << " messages/sec" << std::endl
+			  << "perfect hash: " << (ht > 0.0 ? msgs / ht : 0.0) << " messages/sec" << std::endl;
+
+	if(!ok) std::cerr << "the dispatchers chose different handlers" << std::endl;
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
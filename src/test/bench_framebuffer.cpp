@@ -0,0 +1,192 @@
+/*
+ * Copyright 2014-2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Splits a stream of player list frames with megabyte sized pictures the way the client
+ * library receives them, once with the former deque based reader and once with FrameBuffer.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>                    // for find, min
+#include <cstdlib>                      // for EXIT_SUCCESS, strtoul
+#include <ctime>
+#include <deque>
+#include <iomanip>                      // for operator<<, setw
+#include <iostream>                     // for basic_ostream, operator<<, etc
+#include <string>
+#include <vector>
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "framebuffer.h"
+
+namespace {
+
+const std::size_t CHUNK = 1024u;
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+// player names and base64 pictures of the given size, all NUL terminated
+std::string makeStream(std::size_t picSize, std::size_t players) {
+
+	static const char B64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	std::string s;
+
+	for(std::size_t p = 0u; p < players; ++p) {
+
+		s.append("Player ").append(1, static_cast<char>('A' + p)).append(1, 0);
+
+		for(std::size_t i = 0u; i < picSize; ++i) s.append(1, B64[(i * 7u + p) & 63u]);
+
+		s.append(1, 0);
+	}
+
+	return s.append("PLAYERLISTEND").append(1, 0);
+}
+
+// what Client::Connection::operator>> did before
+class DequeReader {
+public:
+	DequeReader(const std::string &s) : m_src(s), m_pos(0u), m_buf() {}
+
+	bool next(std::string &msg) {
+
+		std::deque<char>::iterator f;
+
+		while(m_buf.empty() || (f = std::find(m_buf.begin(), m_buf.end(), '\0')) ==
+				m_buf.end()) {
+
+			if(m_pos == m_src.length()) return false;
+
+			const std::size_t l = std::min(CHUNK, m_src.length() - m_pos);
+
+			m_buf.insert(m_buf.end(), m_src.data() + m_pos, m_src.data() + m_pos + l);
+			m_pos += l;
+		}
+
+		std::string str;
+		str.insert(str.begin(), m_buf.begin(), f);
+		m_buf.erase(m_buf.begin(), f + 1);
+		str.swap(msg);
+
+		return true;
+	}
+
+private:
+	const std::string &m_src;
+	std::size_t m_pos;
+	std::deque<char> m_buf;
+};
+
+class FrameReader {
+public:
+	FrameReader(const std::string &s) : m_src(s), m_pos(0u), m_buf() {}
+
+	bool next(std::string &msg) {
+
+		const char *frame;
+		std::size_t len;
+
+		while(!m_buf.nextFrame(frame, len)) {
+
+			if(m_pos == m_src.length()) return false;
+
+			char *buf = m_buf.prepare(8192u);
+
+			// the socket won't return more than CHUNK bytes at once either
+			const std::size_t l = std::min(CHUNK, m_src.length() - m_pos);
+
+			m_src.copy(buf, l, m_pos);
+			m_buf.commit(l);
+			m_pos += l;
+		}
+
+		msg.assign(frame, len);
+
+		return true;
+	}
+
+private:
+	const std::string &m_src;
+	std::size_t m_pos;
+	NetMauMau::Common::FrameBuffer m_buf;
+};
+
+template<class Reader>
+double run(const std::string &stream, std::vector<std::string> &frames) {
+
+	Reader r(stream);
+	std::string msg;
+
+	frames.clear();
+
+	const double start = now();
+
+	while(r.next(msg)) frames.push_back(msg);
+
+	return now() - start;
+}
+
+}
+
+int main(int argc, const char **argv) {
+
+	const std::size_t maxKiB = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1024u;
+	bool ok = true;
+
+	std::cout << std::setw(12) << "picture" << std::setw(16) << "deque (MB/s)"
+			  << std::setw(20) << "FrameBuffer (MB/s)" << std::endl;
+
+	for(std::size_t kib = 64u; kib <= maxKiB; kib *= 2u) {
+
+		const std::string &stream(makeStream(kib * 1024u, 4u));
+		std::vector<std::string> dFrames, fFrames;
+
+		const double dt = run<DequeReader>(stream, dFrames);
+		const double ft = run<FrameReader>(stream, fFrames);
+
+		ok = ok && dFrames == fFrames && fFrames.size() == 9u;
+
+		const double mb = static_cast<double>(stream.length()) / 1048576.0;
+
+		std::cout << std::setw(8) << kib << " KiB" << std::fixed << std::setprecision(1)
+				  << std::setw(16) << (dt > 0.0 ? mb / dt : 0.0)
+				  << std::setw(20) << (ft > 0.0 ? mb / ft : 0.0) << std::endl;
+	}
+
+	if(!ok) std::cerr << "the readers split the stream differently" << std::endl;
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>                    // for find, random_shuffle, iter_swap
+#include <cstdlib>                      // for EXIT_SUCCESS, strtoul
+#include <ctime>
+#include <iomanip>                      // for operator<<, setw
+#include <iostream>                     // for basic_ostream, operator<<, etc
+#include <vector>
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "random_gen.h"
+#include "smartptr.h"
+
+namespace {
+
+struct Card {
+	explicit Card(unsigned int id) : m_id(id) {}
+	unsigned int m_id;
+};
+
+typedef NetMauMau::Common::SmartPtr<Card> CardPtr;
+typedef std::vector<CardPtr> CARDS;
+
+unsigned long rngCalls = 0ul;
+
+CARDS::difference_type countedRandom(CARDS::difference_type ubound) {
+	++rngCalls;
+	return NetMauMau::Common::genRandom<CARDS::difference_type>(ubound);
+}
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+// erase the played card and reshuffle the remaining hand
+void playShuffled(CARDS &hand, const Card *played) {
+
+	CARDS::iterator i(hand.begin());
+
+	while(i != hand.end() && static_cast<Card *>(*i) != played) ++i;
+
+	if(i != hand.end()) hand.erase(i);
+
+	if(!hand.empty()) std::random_shuffle(hand.begin(), hand.end(), countedRandom);
+}
+
+// swap-and-pop, the possible cards get shuffled at the next decision
+void playUnordered(CARDS &hand, const Card *played) {
+
+	CARDS::iterator i(hand.begin());
+
+	while(i != hand.end() && static_cast<Card *>(*i) != played) ++i;
+
+	if(i != hand.end()) {
+		std::iter_swap(i, hand.end() - 1);
+		hand.pop_back();
+	}
+}
+
+void decide(CARDS &possCards) {
+	std::random_shuffle(possCards.begin(), possCards.end(), countedRandom);
+}
+
+void run(const char *name, std::size_t size, unsigned long plays, bool unordered) {
+
+	std::vector<CardPtr> deck;
+	CARDS hand;
+
+	for(unsigned int c = 0u; c < 32u; ++c) deck.push_back(CardPtr(new Card(c)));
+
+	hand.assign(deck.begin(), deck.begin() + static_cast<CARDS::difference_type>(size));
+
+	unsigned long pick = 0ul;
+
+	rngCalls = 0ul;
+
+	const double start = now();
+
+	for(unsigned long n = 0ul; n < plays; ++n) {
+
+		// the played card is replaced by a card taken from the talon
+		const CardPtr played(hand[(pick = pick * 1103515245ul + 12345ul) % hand.size()]);
+
+		// the possible cards match the suit or rank of the played card in both cases
+		CARDS possCards;
+
+		for(CARDS::const_iterator i(hand.begin()); i != hand.end(); ++i) {
+			if(((*i)->m_id >> 3u) == (played->m_id >> 3u) ||
+					((*i)->m_id & 7u) == (played->m_id & 7u)) possCards.push_back(*i);
+		}
+
+		if(unordered) {
+			decide(possCards);
+			playUnordered(hand, played);
+		} else {
+			playShuffled(hand, played);
+		}
+
+		hand.push_back(deck[(played->m_id + size) % deck.size()]);
+	}
+
+	const double elapsed = now() - start;
+
+	std::cout << std::setw(12) << std::left << name << std::right << std::setw(6) << size
+			  << std::setw(12) << std::fixed << std::setprecision(1)
+			  << (elapsed > 0.0 ? 1e9 * elapsed / static_cast<double>(plays) : 0.0) << " ns/play"
+			  << std::setw(10) << std::setprecision(2)
+			  << static_cast<double>(rngCalls) / static_cast<double>(plays) << " rng/play"
+			  << std::endl;
+}
+
+}
+
+int main(int argc, const char **argv) {
+
+	const unsigned long plays = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000ul;
+	const std::size_t sizes[] = { 5u, 10u, 20u, 31u };
+
+	for(std::size_t i = 0u; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+		run("shuffled", sizes[i], plays, false);
+		run("unordered", sizes[i], plays, true);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
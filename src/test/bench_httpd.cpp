@@ -0,0 +1,316 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Load test of the web server: keeps several keep-alive connections busy requesting the given
+ * paths in turn for some seconds and reports the requests per second and the latencies.
+ *
+ * usage: bench-httpd HOST PORT [CONNECTIONS [SECONDS [PATH...]]]
+ *
+ * Without paths the status page and the default player picture get requested.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>                    // for sort
+#include <cerrno>                       // for errno, EINTR
+#include <cstdio>                       // for snprintf
+#include <cstdlib>                      // for EXIT_SUCCESS, strtoul
+#include <cstring>                      // for memset
+#include <iomanip>                      // for operator<<, setprecision
+#include <iostream>                     // for basic_ostream, operator<<, etc
+#include <string>
+#include <vector>
+
+#include <netdb.h>                      // for addrinfo, getaddrinfo
+#include <pthread.h>
+#include <strings.h>                    // for strncasecmp
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>                     // for close
+
+#include "linkercontrol.h"
+
+namespace {
+
+typedef std::vector<std::string> PATHS;
+typedef std::vector<unsigned long> LATENCIES;
+
+struct _worker {
+	const addrinfo *ai;
+	const char *host;
+	const PATHS *paths;
+	double until;
+	std::size_t first;
+	LATENCIES latencies;
+	unsigned long errors;
+	unsigned long reconnects;
+	unsigned long long bytes;
+};
+
+double now() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+}
+
+int connectTo(const addrinfo *ai) {
+
+	const int fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+
+	if(fd != -1 && connect(fd, ai->ai_addr, ai->ai_addrlen)) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+bool sendAll(int fd, const std::string &req) {
+
+	std::size_t sent = 0u;
+
+	while(sent < req.size()) {
+
+		const ssize_t n = send(fd, req.data() + sent, req.size() - sent, MSG_NOSIGNAL);
+
+		if(n < 0 && errno == EINTR) continue;
+
+		if(n <= 0) return false;
+
+		sent += static_cast<std::size_t>(n);
+	}
+
+	return true;
+}
+
+// reads one response, buf keeps what got received behind it
+bool readResponse(int fd, std::string &buf, int &status, bool &close, std::size_t &len) {
+
+	char chunk[16384];
+	std::string::size_type eoh;
+
+	while((eoh = buf.find("\r\n\r\n")) == std::string::npos) {
+
+		const ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+
+		if(n < 0 && errno == EINTR) continue;
+
+		if(n <= 0) return false;
+
+		buf.append(chunk, static_cast<std::size_t>(n));
+	}
+
+	if(buf.compare(0, 5, "HTTP/") || buf.find(' ') == std::string::npos) return false;
+
+	status = std::atoi(buf.c_str() + buf.find(' ') + 1);
+	close = false;
+	len = 0u;
+
+	for(std::string::size_type l = buf.find("\r\n") + 2u, e; l < eoh; l = e + 2u) {
+
+		e = buf.find("\r\n", l);
+
+		const std::string line(buf, l, e - l);
+
+		if(!strncasecmp(line.c_str(), "Content-Length:", 15)) {
+			len = std::strtoul(line.c_str() + 15, NULL, 10);
+		} else if(!strncasecmp(line.c_str(), "Connection:", 11) &&
+				  line.find("close") != std::string::npos) {
+			close = true;
+		}
+	}
+
+	const std::size_t total = eoh + 4u + len;
+
+	while(buf.size() < total) {
+
+		const ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+
+		if(n < 0 && errno == EINTR) continue;
+
+		if(n <= 0) return false;
+
+		buf.append(chunk, static_cast<std::size_t>(n));
+	}
+
+	buf.erase(0, total);
+
+	return true;
+}
+
+extern "C" void *work(void *arg) {
+
+	_worker &w(*static_cast<_worker *>(arg));
+
+	std::vector<std::string> requests;
+
+	for(PATHS::const_iterator i(w.paths->begin()); i != w.paths->end(); ++i) {
+		requests.push_back("GET " + *i + " HTTP/1.1\r\nHost: " + w.host +
+						   "\r\nAccept-Encoding: gzip\r\n\r\n");
+	}
+
+	std::string buf;
+	std::size_t next = w.first;
+	int fd = -1;
+
+	while(now() < w.until) {
+
+		if(fd == -1) {
+
+			if((fd = connectTo(w.ai)) == -1) {
+				++w.errors;
+				continue;
+			}
+
+			buf.clear();
+			++w.reconnects;
+		}
+
+		const std::string &req(requests[next++ % requests.size()]);
+		const double start = now();
+
+		int status = 0;
+		bool closed = false;
+		std::size_t len = 0u;
+
+		if(!(sendAll(fd, req) && readResponse(fd, buf, status, closed, len))) {
+			++w.errors;
+			close(fd);
+			fd = -1;
+			continue;
+		}
+
+		w.latencies.push_back(static_cast<unsigned long>((now() - start) * 1e6));
+		w.bytes += len;
+
+		if(status != 200 && status != 304) ++w.errors;
+
+		if(closed) {
+			close(fd);
+			fd = -1;
+		}
+	}
+
+	if(fd != -1) close(fd);
+
+	return 0L;
+}
+
+double percentile(const LATENCIES &l, double p) {
+	return l.empty() ? 0.0 : static_cast<double>(l[std::min(l.size() - 1u,
+			static_cast<std::size_t>(p * static_cast<double>(l.size())))]) / 1000.0;
+}
+
+}
+
+int main(int argc, const char **argv) {
+
+	if(argc < 3) {
+		std::cerr << "usage: " << argv[0] << " HOST PORT [CONNECTIONS [SECONDS [PATH...]]]"
+				  << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const unsigned long conns = argc > 3 ? std::max(1ul, std::strtoul(argv[3], NULL, 10)) : 32ul;
+	const unsigned long secs = argc > 4 ? std::max(1ul, std::strtoul(argv[4], NULL, 10)) : 10ul;
+
+	PATHS paths;
+
+	for(int i = 5; i < argc; ++i) paths.push_back(argv[i]);
+
+	if(paths.empty()) {
+		paths.push_back("/");
+		paths.push_back("/images/");
+	}
+
+	addrinfo hints, *ai = 0L;
+
+	std::memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	const int gai = getaddrinfo(argv[1], argv[2], &hints, &ai);
+
+	if(gai) {
+		std::cerr << argv[1] << ":" << argv[2] << ": " << gai_strerror(gai) << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<_worker> workers(conns);
+	std::vector<pthread_t> threads(conns);
+
+	const double start = now();
+
+	for(unsigned long i = 0ul; i < conns; ++i) {
+
+		_worker &w(workers[i]);
+
+		w.ai = ai;
+		w.host = argv[1];
+		w.paths = &paths;
+		w.until = start + static_cast<double>(secs);
+		w.first = i;
+		w.errors = w.reconnects = 0ul;
+		w.bytes = 0ull;
+
+		if(pthread_create(&threads[i], NULL, work, &w)) {
+			std::cerr << "cannot start connection " << i << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	LATENCIES all;
+	unsigned long errors = 0ul, reconnects = 0ul;
+	unsigned long long bytes = 0ull;
+
+	for(unsigned long i = 0ul; i < conns; ++i) {
+
+		pthread_join(threads[i], NULL);
+
+		all.insert(all.end(), workers[i].latencies.begin(), workers[i].latencies.end());
+		errors += workers[i].errors;
+		reconnects += workers[i].reconnects;
+		bytes += workers[i].bytes;
+	}
+
+	const double elapsed = now() - start;
+
+	freeaddrinfo(ai);
+	std::sort(all.begin(), all.end());
+
+	std::cout << conns << " connections, " << elapsed << " seconds, " << paths.size()
+			  << " paths" << std::endl
+			  << all.size() << " requests, " << errors << " errors, " << reconnects
+			  << " connects, " << bytes << " body bytes" << std::endl
+			  << std::fixed << std::setprecision(0)
+			  << (elapsed > 0.0 ? static_cast<double>(all.size()) / elapsed : 0.0)
+			  << " requests/sec" << std::endl << std::setprecision(2)
+			  << "latency ms: p50 " << percentile(all, 0.5) << ", p90 " << percentile(all, 0.9)
+			  << ", p99 " << percentile(all, 0.99) << ", p99.9 " << percentile(all, 0.999)
+			  << ", max " << (all.empty() ? 0.0 : static_cast<double>(all.back()) / 1000.0)
+			  << std::endl;
+
+	return (!all.empty() && !errors) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <cstdlib>                      // for EXIT_SUCCESS, strtoul
+#include <ctime>
+#include <iomanip>                      // for operator<<, setw
+#include <iostream>                     // for basic_ostream, operator<<, etc
+#include <vector>
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "intrusiveptr.h"
+#include "smartptr.h"
+
+namespace {
+
+const std::size_t POOL = 64u;
+
+class Plain {
+public:
+	Plain() : m_value(0u) {}
+	virtual ~Plain() {}
+
+	unsigned int m_value;
+};
+
+class PlainCounted : public NetMauMau::Common::RefCounted<> {
+public:
+	PlainCounted() : NetMauMau::Common::RefCounted<>(), m_value(0u) {}
+	virtual ~PlainCounted() {}
+
+	unsigned int m_value;
+};
+
+class AtomicCounted :
+	public NetMauMau::Common::RefCounted<NetMauMau::Common::AtomicRefCountPolicy> {
+public:
+	AtomicCounted() :
+		NetMauMau::Common::RefCounted<NetMauMau::Common::AtomicRefCountPolicy>(), m_value(0u) {}
+	virtual ~AtomicCounted() {}
+
+	unsigned int m_value;
+};
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+void report(const char *ptr, const char *op, unsigned long n, double elapsed) {
+	std::cout << std::setw(28) << std::left << ptr << std::setw(10) << op << std::right
+			  << std::setw(12) << std::fixed << std::setprecision(1)
+			  << (elapsed > 0.0 ? (static_cast<double>(n) / elapsed) / 1e6 : 0.0)
+			  << " Mops/s" << std::endl;
+}
+
+template<class Ptr, class T>
+unsigned long run(const char *name, unsigned long n) {
+
+	unsigned long sum = 0ul;
+	std::vector<Ptr> pool;
+
+	pool.reserve(POOL);
+
+	double start = now();
+
+	// taking ownership of a fresh object and releasing it again
+	for(unsigned long i = 0ul; i < n / POOL; ++i) {
+
+		for(std::size_t j = 0u; j < POOL; ++j) pool.push_back(Ptr(new T()));
+
+		sum += pool.back()->m_value;
+		pool.clear();
+	}
+
+	report(name, "own", n, now() - start);
+
+	for(std::size_t j = 0u; j < POOL; ++j) pool.push_back(Ptr(new T()));
+
+	start = now();
+
+	// copy construction and destruction of the copy
+	for(unsigned long i = 0ul; i < n; ++i) {
+		const Ptr p(pool[i % POOL]);
+		sum += p->m_value + (p.unique() ? 1u : 0u);
+	}
+
+	report(name, "copy", n, now() - start);
+
+	Ptr p(pool[0]);
+
+	start = now();
+
+	// assignment, releasing the previously held reference
+	for(unsigned long i = 0ul; i < n; ++i) {
+		p = pool[i % POOL];
+		sum += p->m_value;
+	}
+
+	report(name, "assign", n, now() - start);
+
+	return sum;
+}
+
+}
+
+int main(int argc, const char **argv) {
+
+	const unsigned long n = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 50000000ul;
+	unsigned long sum = 0ul;
+
+	sum += run<NetMauMau::Common::SmartPtr<Plain>, Plain>("SmartPtr", n);
+	sum += run<NetMauMau::Common::IntrusivePtr<PlainCounted>,
+		   PlainCounted>("IntrusivePtr (plain)", n);
+	sum += run<NetMauMau::Common::IntrusivePtr<AtomicCounted>,
+		   AtomicCounted>("IntrusivePtr (atomic)", n);
+
+	return sum == 0xFFFFFFFFul ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,261 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Sends the messages of a game once through the text protocol and once through the binary
+ * frames and compares the bytes on the wire and the CPU time spent on encoding and splitting
+ * them into messages again.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <cstdio>                       // for snprintf
+#include <cstdlib>                      // for EXIT_SUCCESS, strtoul
+#include <cstring>                      // for memcpy
+#include <ctime>
+#include <iomanip>                      // for operator<<, setprecision
+#include <iostream>                     // for basic_ostream, operator<<, etc
+#include <string>
+#include <vector>
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "framebuffer.h"                // for FrameBuffer
+#include "protocol.h"                   // for TURN, PLAYCARD, etc
+#include "wirecodec.h"                  // for WireCodec
+
+namespace {
+
+typedef std::vector<std::string> MESSAGES;
+
+const char *const PLAYERS[] = { "Gerhard", "Cathy", "Alex" };
+const std::size_t PLAYERCNT = sizeof(PLAYERS) / sizeof(PLAYERS[0]);
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+std::string number(std::size_t n) {
+
+	char buf[16];
+
+	return std::string(buf, static_cast<std::size_t>(std::snprintf(buf, sizeof(buf), "%lu",
+					   static_cast<unsigned long>(n))));
+}
+
+// the messages the client of a player receives in a game against two other players
+MESSAGES makeGame() {
+
+	using namespace NetMauMau::Common::Protocol::V15;
+
+	MESSAGES m;
+	unsigned int seed = 42u;
+
+	for(std::size_t p = 0u; p < PLAYERCNT; ++p) {
+		m.push_back(PLAYERJOINED);
+		m.push_back(PLAYERS[p]);
+	}
+
+	m.push_back(GETCARDS);
+
+	for(std::size_t c = 0u; c < 5u; ++c) {
+		m.push_back(NetMauMau::Common::getCardDesc((seed = seed * 1103515245u + 12345u) % 32u,
+					false));
+	}
+
+	m.push_back(CARDSGOT);
+	m.push_back(INITIALCARD);
+	m.push_back(NetMauMau::Common::getCardDesc(11u, false));
+
+	for(std::size_t t = 1u; t <= 30u; ++t) {
+
+		const std::string &uc(NetMauMau::Common::getCardDesc((seed = seed * 1103515245u +
+							  12345u) % 32u, false));
+
+		m.push_back(TURN);
+		m.push_back(number(t));
+		m.push_back(STATS);
+
+		for(std::size_t p = 0u; p < PLAYERCNT; ++p) {
+			m.push_back(PLAYERS[p]);
+			m.push_back(number(5u + (t + p) % 4u));
+		}
+
+		m.push_back(ENDSTATS);
+
+		for(std::size_t p = 0u; p < PLAYERCNT; ++p) {
+
+			m.push_back(NEXTPLAYER);
+			m.push_back(PLAYERS[p]);
+
+			if(!p) {
+
+				m.push_back(OPENCARD);
+				m.push_back(uc);
+				m.push_back(PLAYCARD);
+
+				for(std::size_t c = 0u; c < 2u + t % 3u; ++c) {
+					m.push_back(NetMauMau::Common::getCardDesc((seed = seed * 1103515245u +
+								12345u) % 32u, false));
+				}
+
+				m.push_back(PLAYCARDEND);
+				m.push_back(number(t % 5u ? 0u : 2u));
+				m.push_back(CARDACCEPTED);
+				m.push_back(uc);
+			}
+
+			if((t + p) % 3u) {
+				m.push_back(PLAYEDCARD);
+				m.push_back(PLAYERS[p]);
+				m.push_back(uc);
+			} else {
+				m.push_back(PLAYERPICKSCARD);
+				m.push_back(PLAYERS[p]);
+			}
+
+			m.push_back(CARDCOUNT);
+			m.push_back(PLAYERS[p]);
+			m.push_back(number(4u + (t + p) % 5u));
+		}
+
+		if(!(t % 7u)) {
+			m.push_back(MESSAGE);
+			m.push_back("Talon shuffled, the game goes on");
+			m.push_back(TALONSHUFFLED);
+		}
+	}
+
+	m.push_back(PLAYERWINS);
+	m.push_back(PLAYERS[1]);
+	m.push_back(number(1u));
+	m.push_back(PLAYERLOST);
+	m.push_back(PLAYERS[0]);
+	m.push_back(number(42u));
+	m.push_back(BYE);
+
+	return m;
+}
+
+// the text protocol terminates every message by NUL and splits at it
+double text(const MESSAGES &game, unsigned long rounds, std::size_t &bytes, MESSAGES &out) {
+
+	NetMauMau::Common::FrameBuffer buf;
+	std::string wire, msg;
+
+	const double start = now();
+
+	for(unsigned long r = 0ul; r < rounds; ++r) {
+
+		wire.clear();
+		out.clear();
+
+		for(MESSAGES::const_iterator i(game.begin()); i != game.end(); ++i) {
+			wire.append(*i).append(1, 0);
+		}
+
+		std::memcpy(buf.prepare(wire.length()), wire.data(), wire.length());
+		buf.commit(wire.length());
+
+		const char *frame;
+		std::size_t flen;
+
+		while(buf.nextFrame(frame, flen)) {
+			msg.assign(frame, flen);
+			out.push_back(msg);
+		}
+	}
+
+	bytes = wire.length();
+
+	return now() - start;
+}
+
+double binary(const MESSAGES &game, unsigned long rounds, std::size_t &bytes, MESSAGES &out) {
+
+	NetMauMau::Common::FrameBuffer buf;
+	std::string wire, msg;
+
+	const double start = now();
+
+	for(unsigned long r = 0ul; r < rounds; ++r) {
+
+		wire.clear();
+		out.clear();
+
+		for(MESSAGES::const_iterator i(game.begin()); i != game.end(); ++i) {
+			NetMauMau::Common::WireCodec::encode(wire, i->data(), i->length());
+		}
+
+		std::memcpy(buf.prepare(wire.length()), wire.data(), wire.length());
+		buf.commit(wire.length());
+
+		std::size_t n;
+
+		while(!buf.empty() && (n = NetMauMau::Common::WireCodec::decode(buf.front(), buf.size(),
+								   msg)) && n != NetMauMau::Common::WireCodec::MALFORMED) {
+			buf.consume(n);
+			out.push_back(msg);
+		}
+	}
+
+	bytes = wire.length();
+
+	return now() - start;
+}
+
+}
+
+int main(int argc, const char **argv) {
+
+	const unsigned long rounds = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 20000ul;
+
+	const MESSAGES &game(makeGame());
+	MESSAGES tOut, bOut;
+	std::size_t tBytes = 0u, bBytes = 0u;
+
+	const double tt = text(game, rounds, tBytes, tOut);
+	const double bt = binary(game, rounds, bBytes, bOut);
+
+	const bool ok = tOut == game && bOut == game;
+
+	std::cout << game.size() << " messages per game, " << rounds << " games" << std::endl
+			  << "text:   " << tBytes << " bytes/game, " << std::fixed << std::setprecision(2)
+			  << (rounds ? tt * 1e6 / static_cast<double>(rounds) : 0.0) << " us/game"
+			  << std::endl
+			  << "binary: " << bBytes << " bytes/game, "
+			  << (rounds ? bt * 1e6 / static_cast<double>(rounds) : 0.0) << " us/game"
+			  << std::endl;
+
+	if(!ok) std::cerr << "the messages didn't survive the round trip" << std::endl;
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
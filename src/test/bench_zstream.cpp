@@ -0,0 +1,190 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Compresses web server responses of several sizes once the way the web server used to, with a
+ * fresh deflate stream at the best level for every response, and once with the pooled streams
+ * and the level chosen by the size, and reports the responses per second of both.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>                    // for min, max
+#include <cstdio>                       // for snprintf
+#include <cstdlib>                      // for EXIT_SUCCESS, strtoul
+#include <ctime>
+#include <iomanip>                      // for operator<<, setprecision
+#include <iostream>                     // for basic_ostream, operator<<, etc
+#include <string>
+#include <vector>
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include <zlib.h>
+
+#include "zstreambuf.h"                 // for Zstreambuf
+
+namespace {
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+// a status page with the given number of rows in its tables
+std::string makePage(unsigned int rows) {
+
+	std::string page("<html><head><title>NetMauMau</title></head><body><table>");
+	char row[128];
+
+	for(unsigned int i = 0u; i < rows; ++i) {
+		page.append(row, static_cast<std::size_t>(std::snprintf(row, sizeof(row),
+					"<tr><td>Player %u</td><td align=\"right\">%u</td><td>%s</td></tr>\n", i,
+					(i * 7919u) % 1000u, (i & 1u) ? "waiting" : "running")));
+	}
+
+	return page.append("</table></body></html>");
+}
+
+// what every response cost before: stream set up and torn down, buffers allocated per chunk
+std::size_t fresh(const std::string &page) {
+
+	z_stream zs;
+
+	zs.zalloc = Z_NULL;
+	zs.zfree  = Z_NULL;
+	zs.opaque = Z_NULL;
+
+	if(deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+		return 0u;
+	}
+
+	const uLong bound = deflateBound(&zs, 32768u);
+	std::string out;
+
+	for(std::size_t pos = 0u; pos < page.size(); pos += 32768u) {
+
+		const std::size_t n = std::min<std::size_t>(32768u, page.size() - pos);
+		Bytef *buf = new Bytef[bound];
+
+		zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(page.data() + pos));
+		zs.avail_in = static_cast<uInt>(n);
+
+		do {
+			zs.next_out = buf;
+			zs.avail_out = static_cast<uInt>(bound);
+			deflate(&zs, pos + n < page.size() ? Z_NO_FLUSH : Z_FINISH);
+			out.append(reinterpret_cast<const char *>(buf), bound - zs.avail_out);
+		} while(zs.avail_out == 0);
+
+		delete [] buf;
+	}
+
+	deflateEnd(&zs);
+
+	return out.size();
+}
+
+bool inflatesTo(const std::string &z, const std::string &page) {
+
+	z_stream zs;
+
+	zs.zalloc = Z_NULL;
+	zs.zfree  = Z_NULL;
+	zs.opaque = Z_NULL;
+	zs.next_in = Z_NULL;
+	zs.avail_in = 0u;
+
+	if(inflateInit2(&zs, 31) != Z_OK) return false;
+
+	std::vector<Bytef> buf(page.size() + 1u);
+
+	zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(z.data()));
+	zs.avail_in = static_cast<uInt>(z.size());
+	zs.next_out = &buf[0];
+	zs.avail_out = static_cast<uInt>(buf.size());
+
+	const int err = inflate(&zs, Z_FINISH);
+	const std::size_t have = buf.size() - zs.avail_out;
+
+	inflateEnd(&zs);
+
+	return err == Z_STREAM_END && page.compare(0, std::string::npos,
+			reinterpret_cast<const char *>(&buf[0]), have) == 0;
+}
+
+}
+
+int main(int argc, const char **argv) {
+
+	const unsigned long rounds = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 2000ul;
+	const unsigned int ROWS[] = { 16u, 256u, 4096u };
+
+	bool ok = true;
+
+	std::cout << std::fixed << std::setprecision(0);
+
+	for(std::size_t r = 0u; r < sizeof(ROWS) / sizeof(ROWS[0]); ++r) {
+
+		const std::string &page(makePage(ROWS[r]));
+		const unsigned long n = std::max(1ul, rounds / (ROWS[r] / 16u));
+
+		std::size_t freshBytes = 0u;
+		double start = now();
+
+		for(unsigned long i = 0u; i < n; ++i) freshBytes = fresh(page);
+
+		const double ft = now() - start;
+
+		std::string z;
+		start = now();
+
+		for(unsigned long i = 0u; i < n; ++i) {
+			z.clear();
+			NetMauMau::Common::Zstreambuf::compress(z, page.data(), page.size());
+		}
+
+		const double pt = now() - start;
+
+		ok = ok && freshBytes && inflatesTo(z, page);
+
+		std::cout << page.size() << " bytes, level "
+				  << NetMauMau::Common::Zstreambuf::compressionLevel(page.size()) << std::endl
+				  << "  fresh:  " << freshBytes << " bytes, "
+				  << (ft > 0.0 ? static_cast<double>(n) / ft : 0.0) << " responses/sec" << std::endl
+				  << "  pooled: " << z.size() << " bytes, "
+				  << (pt > 0.0 ? static_cast<double>(n) / pt : 0.0) << " responses/sec" << std::endl;
+	}
+
+	if(!ok) std::cerr << "a response didn't survive the round trip" << std::endl;
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
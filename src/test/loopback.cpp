@@ -0,0 +1,84 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "loopback.h"
+
+#include <cerrno>                       // for errno, EINTR
+
+#include <netinet/in.h>                 // for sockaddr_in, htonl, INADDR_LOOPBACK
+#include <sys/socket.h>                 // for socket, bind, listen, getsockname
+#include <unistd.h>                     // for read, write, close
+
+int listenLoopback(uint16_t &port) {
+
+	const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+	sockaddr_in addr = sockaddr_in();
+	socklen_t alen = sizeof(addr);
+
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if(fd >= 0 && (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ||
+				   ::listen(fd, 4) ||
+				   ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &alen))) {
+		::close(fd);
+		return -1;
+	}
+
+	port = ntohs(addr.sin_port);
+
+	return fd;
+}
+
+bool writeAll(int fd, const char *buf, std::size_t len) {
+
+	while(len) {
+
+		const ssize_t w = ::write(fd, buf, len);
+
+		if(w < 0 && errno == EINTR) continue;
+
+		if(w <= 0) return false;
+
+		buf += w;
+		len -= static_cast<std::size_t>(w);
+	}
+
+	return true;
+}
+
+bool readSome(int fd, std::string &out) {
+
+	char buf[1024];
+	ssize_t r;
+
+	while((r = ::read(fd, buf, sizeof(buf))) < 0 && errno == EINTR);
+
+	if(r > 0) out.assign(buf, static_cast<std::size_t>(r));
+
+	return r > 0;
+}
+
+bool token(int fd) {
+	char c;
+	return ::read(fd, &c, 1) == 1;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
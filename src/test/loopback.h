@@ -0,0 +1,54 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_LOOPBACK_H
+#define NETMAUMAU_LOOPBACK_H
+
+#include <string>
+
+#include <stdint.h>                     // for uint16_t
+
+/**
+ * @brief Listens on a free port of the loopback interface
+ *
+ * @param[out] port the port listened on
+ * @return the listening socket or @c -1
+ */
+int listenLoopback(uint16_t &port);
+
+/**
+ * @brief Writes all of @c buf, retrying on interrupts
+ */
+bool writeAll(int fd, const char *buf, std::size_t len);
+
+/**
+ * @brief Reads whatever is available, but at least one byte
+ *
+ * @return @c false if the peer closed the connection or on errors
+ */
+bool readSome(int fd, std::string &out);
+
+/**
+ * @brief Waits for a single byte, used to let two processes take turns
+ */
+bool token(int fd);
+
+#endif /* NETMAUMAU_LOOPBACK_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
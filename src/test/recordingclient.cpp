@@ -0,0 +1,199 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "recordingclient.h"
+
+#include <sstream>                      // for ostringstream
+
+#include "cardtools.h"                  // for suitToSymbol
+
+namespace {
+
+std::string desc(const NetMauMau::Common::ICard *card) {
+	return card ? card->description() : std::string("-");
+}
+
+}
+
+RecordingClient::RecordingClient(uint16_t port) : AbstractClientV05("Alice", "127.0.0.1", port),
+	m_log() {}
+
+RecordingClient::~RecordingClient() {}
+
+const std::string &RecordingClient::getLog() const {
+	return m_log;
+}
+
+void RecordingClient::log(const std::string &s) const {
+	m_log.append(s).append(1, '\n');
+}
+
+NetMauMau::Common::ICard *RecordingClient::playCard(const CARDS &) const {
+	log("playCard");
+	return 0L;
+}
+
+NetMauMau::Common::ICard::SUIT RecordingClient::getJackSuitChoice() const {
+	log("getJackSuitChoice");
+	return NetMauMau::Common::ICard::HEARTS;
+}
+
+void RecordingClient::message(const std::string &msg) const {
+	log("message " + msg);
+}
+
+void RecordingClient::error(const std::string &msg) const {
+	log("error " + msg);
+}
+
+void RecordingClient::turn(std::size_t t) const {
+
+	std::ostringstream os;
+	os << "turn " << t;
+
+	log(os.str());
+}
+
+void RecordingClient::stats(const STATS &s) const {
+
+	std::ostringstream os;
+	os << "stats";
+
+	for(STATS::const_iterator i(s.begin()); i != s.end(); ++i) {
+		os << ' ' << i->playerName << '=' << i->cardCount;
+	}
+
+	log(os.str());
+}
+
+void RecordingClient::gameOver() const {
+	log("gameOver");
+}
+
+void RecordingClient::playerJoined(const std::string &player, const unsigned char *,
+								   std::size_t len) const {
+
+	std::ostringstream os;
+	os << "playerJoined " << player << ' ' << len;
+
+	log(os.str());
+}
+
+void RecordingClient::playerPictureReceived(const std::string &player, const unsigned char *,
+		std::size_t len) const throw() {
+
+	std::ostringstream os;
+	os << "playerPicture " << player << ' ' << len;
+
+	log(os.str());
+}
+
+void RecordingClient::playerRejected(const std::string &player) const {
+	log("playerRejected " + player);
+}
+
+void RecordingClient::playerSuspends(const std::string &player) const {
+	log("playerSuspends " + player);
+}
+
+void RecordingClient::playedCard(const std::string &player,
+								 const NetMauMau::Common::ICard *card) const {
+	log("playedCard " + player + ' ' + desc(card));
+}
+
+void RecordingClient::playerWins(const std::string &player, std::size_t t) const {
+
+	std::ostringstream os;
+	os << "playerWins " << player << ' ' << t;
+
+	log(os.str());
+}
+
+void RecordingClient::playerLost(const std::string &player, std::size_t t,
+								 std::size_t points) const {
+
+	std::ostringstream os;
+	os << "playerLost " << player << ' ' << t << ' ' << points;
+
+	log(os.str());
+}
+
+void RecordingClient::playerPicksCard(const std::string &player,
+									  const NetMauMau::Common::ICard *card) const {
+	log("playerPicksCard " + player + ' ' + desc(card));
+}
+
+void RecordingClient::playerPicksCard(const std::string &player, std::size_t count) const {
+
+	std::ostringstream os;
+	os << "playerPicksCards " << player << ' ' << count;
+
+	log(os.str());
+}
+
+void RecordingClient::nextPlayer(const std::string &player) const {
+	log("nextPlayer " + player);
+}
+
+void RecordingClient::enableSuspend(bool enable) const {
+	log(enable ? "enableSuspend on" : "enableSuspend off");
+}
+
+void RecordingClient::cardSet(const CARDS &cards) const {
+
+	std::string s("cardSet");
+
+	for(CARDS::const_iterator i(cards.begin()); i != cards.end(); ++i) {
+		s.append(1, ' ').append(desc(*i));
+	}
+
+	log(s);
+}
+
+void RecordingClient::initialCard(const NetMauMau::Common::ICard *card) const {
+	log("initialCard " + desc(card));
+}
+
+void RecordingClient::openCard(const NetMauMau::Common::ICard *card,
+							   const std::string &js) const {
+	log("openCard " + desc(card) + ' ' + js);
+}
+
+void RecordingClient::talonShuffled() const {
+	log("talonShuffled");
+}
+
+void RecordingClient::cardRejected(const std::string &player,
+								   const NetMauMau::Common::ICard *card) const {
+	log("cardRejected " + player + ' ' + desc(card));
+}
+
+void RecordingClient::cardAccepted(const NetMauMau::Common::ICard *card) const {
+	log("cardAccepted " + desc(card));
+}
+
+void RecordingClient::jackSuit(NetMauMau::Common::ICard::SUIT suit) const {
+	log("jackSuit " + NetMauMau::Common::suitToSymbol(suit, false));
+}
+
+void RecordingClient::unknownServerMessage(const std::string &msg) const {
+	log("unknownServerMessage " + msg);
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
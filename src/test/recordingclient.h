@@ -0,0 +1,83 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_RECORDINGCLIENT_H
+#define NETMAUMAU_RECORDINGCLIENT_H
+
+#include "abstractclient.h"             // for AbstractClientV05
+
+/**
+ * @brief A client connecting to a local server, which logs every callback as a line of text
+ */
+class RecordingClient : public NetMauMau::Client::AbstractClientV05 {
+	DISALLOW_COPY_AND_ASSIGN(RecordingClient)
+public:
+	explicit RecordingClient(uint16_t port);
+	virtual ~RecordingClient();
+
+	const std::string &getLog() const _CONST;
+
+protected:
+	virtual NetMauMau::Common::ICard *playCard(const CARDS &cards) const;
+	virtual NetMauMau::Common::ICard::SUIT getJackSuitChoice() const;
+
+	virtual void message(const std::string &msg) const;
+	virtual void error(const std::string &msg) const;
+	virtual void turn(std::size_t turn) const;
+	virtual void stats(const STATS &stats) const;
+	virtual void gameOver() const;
+
+	virtual void playerJoined(const std::string &player, const unsigned char *pngData,
+							  std::size_t pngDataLen) const;
+	virtual void playerRejected(const std::string &player) const;
+	virtual void playerSuspends(const std::string &player) const;
+	virtual void playedCard(const std::string &player, const NetMauMau::Common::ICard *card) const;
+	virtual void playerWins(const std::string &player, std::size_t turn) const;
+	virtual void playerLost(const std::string &player, std::size_t turn,
+							std::size_t points) const;
+	virtual void playerPicksCard(const std::string &player,
+								 const NetMauMau::Common::ICard *card) const;
+	virtual void playerPicksCard(const std::string &player, std::size_t count) const;
+	virtual void nextPlayer(const std::string &player) const;
+
+	virtual void enableSuspend(bool enable) const;
+	virtual void cardSet(const CARDS &cards) const;
+	virtual void initialCard(const NetMauMau::Common::ICard *card) const;
+	virtual void openCard(const NetMauMau::Common::ICard *card, const std::string &jackSuit) const;
+	virtual void talonShuffled() const;
+	virtual void cardRejected(const std::string &player,
+							  const NetMauMau::Common::ICard *card) const;
+	virtual void cardAccepted(const NetMauMau::Common::ICard *card) const;
+	virtual void jackSuit(NetMauMau::Common::ICard::SUIT suit) const;
+
+	virtual void playerPictureReceived(const std::string &player, const unsigned char *pngData,
+									   std::size_t len) const throw();
+
+	virtual void unknownServerMessage(const std::string &msg) const;
+
+private:
+	void log(const std::string &s) const;
+
+private:
+	mutable std::string m_log;
+};
+
+#endif /* NETMAUMAU_RECORDINGCLIENT_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_TEST_SIMPLERULESET_H
+#define NETMAUMAU_TEST_SIMPLERULESET_H
+
+#include "iruleset.h"                   // for IRuleSet
+
+namespace NetMauMau {
+
+namespace Test {
+
+// plain Mau-Mau: same suit or same rank, jacks on everything but jacks
+class SimpleRuleSet : public RuleSet::IRuleSet {
+	DISALLOW_COPY_AND_ASSIGN(SimpleRuleSet)
+public:
+	SimpleRuleSet() : IRuleSet() {}
+	virtual ~SimpleRuleSet() {}
+
+	virtual bool isNull() const throw() {
+		return false;
+	}
+
+	virtual void checkInitial(const NetMauMau::Player::IPlayer *,
+							  const NetMauMau::Common::ICardPtr &) {}
+
+	virtual bool checkCard(const NetMauMau::Player::IPlayer *,
+						   const NetMauMau::Common::ICardPtr &uc,
+						   const NetMauMau::Common::ICardPtr &pc, bool) {
+		return checkCard(uc, pc);
+	}
+
+	virtual bool checkCard(const NetMauMau::Common::ICardPtr &uc,
+						   const NetMauMau::Common::ICardPtr &pc) const {
+		return pc && (!uc || pc->getSuit() == uc->getSuit() || pc->getRank() == uc->getRank()
+					  || (pc->getRank() == NetMauMau::Common::ICard::JACK &&
+						  uc->getRank() != NetMauMau::Common::ICard::JACK));
+	}
+
+	virtual std::size_t lostPointFactor(const NetMauMau::Common::ICardPtr &) const {
+		return 1u;
+	}
+
+	virtual bool hasToSuspend() const {
+		return false;
+	}
+
+	virtual void hasSuspended() {}
+	virtual void hasTakenCards() {}
+
+	virtual std::size_t takeCardCount() const {
+		return 0u;
+	}
+
+	virtual std::size_t takeCards(const NetMauMau::Common::ICard *) const {
+		return 0u;
+	}
+
+	virtual std::size_t initialCardCount() const {
+		return 5u;
+	}
+
+	virtual bool takeAfterSevenIfNoMatch() const {
+		return false;
+	}
+
+	virtual bool takeIfLost() const {
+		return false;
+	}
+
+	virtual bool isAceRoundPossible() const {
+		return false;
+	}
+
+	virtual NetMauMau::Common::ICard::RANK getAceRoundRank() const {
+		return NetMauMau::Common::ICard::ACE;
+	}
+
+	virtual bool hasDirChange() const {
+		return false;
+	}
+
+	virtual void dirChanged() {}
+
+	virtual bool getDirChangeIsSuspend() const {
+		return false;
+	}
+
+	virtual void setDirChangeIsSuspend(bool) {}
+
+	virtual bool isAceRound() const {
+		return false;
+	}
+
+	virtual bool isJackMode() const {
+		return false;
+	}
+
+	virtual NetMauMau::Common::ICard::SUIT getJackSuit() const {
+		return NetMauMau::Common::ICard::SUIT_ILLEGAL;
+	}
+
+	virtual void setJackModeOff() {}
+
+	virtual std::size_t getMaxPlayers() const {
+		return 5u;
+	}
+
+	virtual void setCurPlayers(std::size_t) {}
+
+	virtual bool setState(std::size_t, bool, NetMauMau::Common::ICard::SUIT) {
+		return true;
+	}
+
+	virtual void reset() throw() {}
+};
+
+}
+
+}
+
+#endif /* NETMAUMAU_TEST_SIMPLERULESET_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
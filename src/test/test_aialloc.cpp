@@ -0,0 +1,170 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks that the decisions of an AI player don't touch the heap anymore once the scratch
+ * arena and the per player buffers have grown to their working size.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <cstdlib>                      // for malloc, free, EXIT_SUCCESS
+#include <iostream>                     // for operator<<, basic_ostream, etc
+#include <new>                          // for bad_alloc, nothrow_t
+
+#include "hardplayer.h"                 // for HardPlayer
+#include "simpleruleset.h"              // for SimpleRuleSet
+#include "stdcardfactory.h"             // for StdCardFactory
+
+namespace {
+
+bool countAllocs = false;
+unsigned long allocs = 0ul;
+
+void *countedAlloc(std::size_t n) throw() {
+
+	if(countAllocs) ++allocs;
+
+	return std::malloc(n ? n : 1u);
+}
+
+const NetMauMau::Common::ICard::SUIT SUITS[4] = {
+	NetMauMau::Common::ICard::DIAMONDS, NetMauMau::Common::ICard::HEARTS,
+	NetMauMau::Common::ICard::SPADES, NetMauMau::Common::ICard::CLUBS
+};
+
+const NetMauMau::Common::ICard::RANK RANKS[8] = {
+	NetMauMau::Common::ICard::SEVEN, NetMauMau::Common::ICard::EIGHT,
+	NetMauMau::Common::ICard::NINE, NetMauMau::Common::ICard::TEN,
+	NetMauMau::Common::ICard::JACK, NetMauMau::Common::ICard::QUEEN,
+	NetMauMau::Common::ICard::KING, NetMauMau::Common::ICard::ACE
+};
+
+unsigned long decide(const NetMauMau::Player::IPlayer &player,
+					 const NetMauMau::Player::IPlayer::CARDS &talon,
+					 const NetMauMau::Common::ICardPtr &jack, unsigned int rounds) {
+
+	unsigned long played = 0ul;
+
+	for(unsigned int r = 0u; r < rounds; ++r) {
+
+		for(NetMauMau::Player::IPlayer::CARDS::const_iterator i(talon.begin());
+				i != talon.end(); ++i) {
+
+			if(player.requestCard(*i, 0L, 0u)) ++played;
+
+			for(std::size_t s = 0u; s < 4u; ++s) {
+				if(player.requestCard(*i, &SUITS[s], 0u)) ++played;
+			}
+
+			if(player.getJackChoice(*i, jack) != NetMauMau::Common::ICard::SUIT_ILLEGAL) ++played;
+		}
+	}
+
+	return played;
+}
+
+}
+
+void *operator new(std::size_t n) throw(std::bad_alloc) {
+
+	void *p = countedAlloc(n);
+
+	if(!p) throw std::bad_alloc();
+
+	return p;
+}
+
+void *operator new[](std::size_t n) throw(std::bad_alloc) {
+
+	void *p = countedAlloc(n);
+
+	if(!p) throw std::bad_alloc();
+
+	return p;
+}
+
+void *operator new(std::size_t n, const std::nothrow_t &) throw() {
+	return countedAlloc(n);
+}
+
+void *operator new[](std::size_t n, const std::nothrow_t &) throw() {
+	return countedAlloc(n);
+}
+
+void operator delete(void *p) throw() {
+	std::free(p);
+}
+
+void operator delete[](void *p) throw() {
+	std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) throw() {
+	std::free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) throw() {
+	std::free(p);
+}
+
+int main(int, const char **) {
+
+	NetMauMau::Test::SimpleRuleSet ruleSet;
+	NetMauMau::Player::HardPlayer player("Cathy", 0L);
+	NetMauMau::Player::IPlayer::CARDS hand, talon;
+
+	for(std::size_t s = 0u; s < 4u; ++s) {
+		for(std::size_t r = 0u; r < 8u; ++r) {
+
+			const NetMauMau::Common::ICardPtr c(NetMauMau::StdCardFactory().create(SUITS[s],
+												RANKS[r]));
+
+			// every third card and all jacks but one go to the hand
+			if((((s * 8u + r) % 3u) == 0u || RANKS[r] == NetMauMau::Common::ICard::JACK) &&
+					SUITS[s] != NetMauMau::Common::ICard::HEARTS) {
+				hand.push_back(c);
+			} else {
+				talon.push_back(c);
+			}
+		}
+	}
+
+	const NetMauMau::Common::ICardPtr jack(NetMauMau::StdCardFactory().
+										   create(NetMauMau::Common::ICard::HEARTS,
+												  NetMauMau::Common::ICard::JACK));
+
+	player.setRuleSet(&ruleSet);
+	player.receiveCardSet(hand);
+
+	// grow the scratch arena and the buffers of the player to their working size
+	decide(player, talon, jack, 64u);
+
+	countAllocs = true;
+	const unsigned long played = decide(player, talon, jack, 16u);
+	countAllocs = false;
+
+	std::cout << played << " decisions, " << allocs << " heap allocations" << std::endl;
+
+	return (played && !allocs) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
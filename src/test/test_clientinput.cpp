@@ -0,0 +1,284 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Feeds a client driven by processInput() a game split at every byte boundary and checks that
+ * it fires exactly the same callbacks as if the game had arrived in one piece, once in the text
+ * protocol and once in binary frames. The client has to answer in the protocol of the game.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"                     // for PACKAGE_NAME, SERVER_VERSION_MAJOR, etc
+#endif
+
+#include <csignal>                      // for signal, SIGPIPE
+#include <cstdio>                       // for snprintf
+#include <cstdlib>                      // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>                     // for operator<<, basic_ostream, etc
+#include <sstream>                      // for ostringstream
+
+#include <netinet/in.h>                 // for IPPROTO_TCP
+#include <netinet/tcp.h>                // for TCP_NODELAY
+#include <poll.h>                       // for poll
+#include <sys/ioctl.h>                  // for ioctl, FIONREAD
+#include <sys/socket.h>                 // for accept, setsockopt
+#include <sys/wait.h>                   // for waitpid
+#include <unistd.h>                     // for fork, pipe, close
+
+#include "cardtools.h"                  // for getCardDesc, getCardIndex
+#include "protocol.h"                   // for MESSAGE, TURN, etc
+#include "wirecodec.h"                  // for WireCodec
+#include "loopback.h"                   // for listenLoopback, writeAll, etc
+#include "recordingclient.h"            // for RecordingClient
+
+namespace {
+
+unsigned int failures = 0u;
+
+void check(bool ok, const std::string &what) {
+
+	if(!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		++failures;
+	}
+}
+
+std::string card(NetMauMau::Common::ICard::SUIT suit, NetMauMau::Common::ICard::RANK rank) {
+	return NetMauMau::Common::getCardDesc(NetMauMau::Common::getCardIndex(suit, rank), false);
+}
+
+std::string frames(const char *const *msgs, std::size_t n) {
+
+	std::string s;
+
+	for(std::size_t i = 0u; i < n; ++i) s.append(msgs[i]).append(1, '\0');
+
+	return s;
+}
+
+std::string script() {
+
+	namespace P = NetMauMau::Common::Protocol::V15;
+
+	const std::string h7(card(NetMauMau::Common::ICard::HEARTS, NetMauMau::Common::ICard::SEVEN));
+	const std::string sa(card(NetMauMau::Common::ICard::SPADES, NetMauMau::Common::ICard::ACE));
+	const std::string cj(card(NetMauMau::Common::ICard::CLUBS, NetMauMau::Common::ICard::JACK));
+	const std::string hearts(NetMauMau::Common::suitToSymbol(NetMauMau::Common::ICard::HEARTS,
+							 false));
+
+	const char *const msgs[] = {
+		P::MESSAGE.c_str(), "Welcome",
+		P::PLAYERJOINED.c_str(), "Bob", "-",
+		P::GETCARDS.c_str(), h7.c_str(), sa.c_str(), P::CARDSGOT.c_str(), P::CARDCOUNT.c_str(),
+		P::INITIALCARD.c_str(), cj.c_str(),
+		P::OPENCARD.c_str(), cj.c_str(),
+		P::TURN.c_str(), "1",
+		P::STATS.c_str(), "Bob", "5", P::ENDSTATS.c_str(),
+		P::NEXTPLAYER.c_str(), "Bob",
+		P::PLAYEDCARD.c_str(), "Bob", h7.c_str(),
+		P::JACKSUIT.c_str(), hearts.c_str(),
+		P::PLAYERPICKSCARD.c_str(), "Bob", P::CARDTAKEN.c_str(), sa.c_str(),
+		P::TALONSHUFFLED.c_str(),
+		P::SUSPENDS.c_str(), "Bob",
+		P::PLAYERWINS.c_str(), "Bob"
+	};
+
+	return frames(msgs, sizeof(msgs) / sizeof(msgs[0]));
+}
+
+// the same messages as binary frames
+std::string binaryScript(const std::string &text) {
+
+	std::string s;
+
+	NetMauMau::Common::WireCodec::encode(s, text.data(), text.length() - 1u);
+
+	return s;
+}
+
+std::string expected() {
+
+	const std::string h7(card(NetMauMau::Common::ICard::HEARTS, NetMauMau::Common::ICard::SEVEN));
+	const std::string sa(card(NetMauMau::Common::ICard::SPADES, NetMauMau::Common::ICard::ACE));
+	const std::string cj(card(NetMauMau::Common::ICard::CLUBS, NetMauMau::Common::ICard::JACK));
+
+	return "message Welcome\n"
+		   "playerJoined Bob 0\n"
+		   "cardSet " + h7 + ' ' + sa + "\n"
+		   "initialCard " + cj + "\n"
+		   "turn 1\n"
+		   "stats Bob=5\n"
+		   "nextPlayer Bob\n"
+		   "playedCard Bob " + h7 + "\n"
+		   "jackSuit " + NetMauMau::Common::suitToSymbol(NetMauMau::Common::ICard::HEARTS,
+				   false) + "\n"
+		   "playerPicksCard Bob " + sa + "\n"
+		   "talonShuffled\n"
+		   "playerSuspends Bob\n"
+		   "playerWins Bob 1\n"
+		   "gameOver\n";
+}
+
+/*
+ * The server plays the handshake and sends the first part of the game, then waits for the
+ * client to process it before it sends the rest. At last it checks the client's answer to
+ * CARDCOUNT, a bare number in the text protocol and a number frame in the binary one.
+ */
+bool serve(int lfd, int toClient, int fromClient, const std::string &game, bool binary) {
+
+	std::signal(SIGPIPE, SIG_IGN);
+
+	char hello[64];
+	const int hlen = std::snprintf(hello, sizeof(hello), "%s %u.%u", PACKAGE_NAME,
+								   SERVER_VERSION_MAJOR, SERVER_VERSION_MINOR);
+
+	for(std::size_t split = 0u; split <= game.length(); ++split) {
+
+		const int fd = ::accept(lfd, 0L, 0L);
+
+		if(fd < 0) return false;
+
+		// don't let Nagle delay the rest of the game
+		const int one = 1;
+		::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+		std::string in;
+
+		const bool ok = writeAll(fd, hello, static_cast<std::size_t>(hlen)) &&
+						readSome(fd, in) && writeAll(fd, "NAME", 4u) && readSome(fd, in) &&
+						writeAll(fd, binary ? "OB" : "OK", 2u) &&
+						writeAll(fd, game.data(), split) && writeAll(toClient, "s", 1u) &&
+						token(fromClient) &&
+						writeAll(fd, game.data() + split, game.length() - split) &&
+						token(fromClient) && readSome(fd, in);
+
+		::close(fd);
+
+		if(!ok || in.compare(0u, binary ? 3u : 1u, binary ? "\x02\x80\x02" : "2")) return false;
+	}
+
+	return true;
+}
+
+// the data is written over loopback, but make sure it arrived before processing it
+void waitFor(int fd, std::size_t bytes) {
+
+	int avail = 0;
+
+	for(int i = 0; i < 100 && !ioctl(fd, FIONREAD, &avail) &&
+			static_cast<std::size_t>(avail) < bytes; ++i) {
+		pollfd pfd = { fd, POLLIN, 0 };
+		::poll(&pfd, 1, 10);
+	}
+}
+
+bool play(uint16_t port, std::size_t split, int fromServer, int toServer, std::string &log) {
+
+	RecordingClient client(port);
+
+	client.startPlay();
+
+	if(!token(fromServer)) return false;
+
+	waitFor(client.getSocketFD(), split);
+
+	bool playing = client.processInput();
+
+	if(!writeAll(toServer, "c", 1u)) return false;
+
+	for(int i = 0; playing && i < 1000; ++i) {
+		pollfd pfd = { client.getSocketFD(), POLLIN, 0 };
+		::poll(&pfd, 1, 10);
+		playing = client.processInput();
+	}
+
+	log = client.getLog();
+
+	return !playing && writeAll(toServer, "d", 1u);
+}
+
+}
+
+int main(int, const char **) {
+
+	const std::string game[2] = { script(), binaryScript(script()) };
+	const std::string exp(expected());
+
+	uint16_t port = 0u;
+	const int lfd = listenLoopback(port);
+
+	int toServer[2], toClient[2];
+
+	if(lfd < 0 || ::pipe(toServer) || ::pipe(toClient)) {
+		std::cerr << "Cannot set up a local server" << std::endl;
+		return 77;
+	}
+
+	const pid_t pid = ::fork();
+
+	if(pid < 0) return 77;
+
+	if(!pid) {
+		::close(toServer[1]);
+		::close(toClient[0]);
+		::_exit(serve(lfd, toClient[1], toServer[0], game[0], false) &&
+				serve(lfd, toClient[1], toServer[0], game[1], true) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	::close(lfd);
+	::close(toServer[0]);
+	::close(toClient[1]);
+
+	try {
+
+		for(std::size_t b = 0u; b < 2u; ++b) {
+
+			for(std::size_t split = 0u; split <= game[b].length(); ++split) {
+
+				std::string log;
+				std::ostringstream what;
+
+				what << (b ? "binary" : "text") << " game split after " << split << " of "
+					 << game[b].length() << " bytes";
+
+				if(!play(port, split, toClient[0], toServer[1], log)) {
+					check(false, what.str() + " ends");
+					break;
+				}
+
+				check(log == exp, what.str() + ":\n" + log);
+			}
+		}
+
+	} catch(const NetMauMau::Common::Exception::SocketException &e) {
+		check(false, e.what());
+	}
+
+	::close(toServer[1]);
+	::close(toClient[0]);
+
+	int status = EXIT_FAILURE;
+
+	check(::waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+		  WEXITSTATUS(status) == EXIT_SUCCESS, "server");
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,324 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks that the statically dispatched decision chains of the AI players choose the same cards
+ * as the virtually dispatched ones, and only ever one of the possible cards, for hands dealt by
+ * a locally seeded random number generator. Reports the decisions per second of both.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>                    // for find
+#include <cstdlib>                      // for srand, strtoul, EXIT_SUCCESS
+#include <ctime>
+#include <iomanip>                      // for operator<<, setprecision
+#include <iostream>                     // for operator<<, basic_ostream, etc
+#include <stdint.h>
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "hardplayer.h"                 // for HardPlayer
+#include "jackonlycondition.h"          // for JackOnlyCondition
+#include "powerjackcondition.h"         // for PowerJackCondition
+#include "simpleruleset.h"              // for SimpleRuleSet
+#include "stdcardfactory.h"             // for StdCardFactory
+
+namespace {
+
+#if defined(HAVE_GSL) || defined(HAVE_ARC4RANDOM_UNIFORM)
+// the generator of the AI can't be reseeded, a differing random choice gets another chance
+const unsigned int ATTEMPTS = 64u;
+#else
+const unsigned int ATTEMPTS = 1u;
+#endif
+
+const NetMauMau::Common::ICard::SUIT SUITS[4] = {
+	NetMauMau::Common::ICard::DIAMONDS, NetMauMau::Common::ICard::HEARTS,
+	NetMauMau::Common::ICard::SPADES, NetMauMau::Common::ICard::CLUBS
+};
+
+const NetMauMau::Common::ICard::RANK RANKS[8] = {
+	NetMauMau::Common::ICard::SEVEN, NetMauMau::Common::ICard::EIGHT,
+	NetMauMau::Common::ICard::NINE, NetMauMau::Common::ICard::TEN,
+	NetMauMau::Common::ICard::JACK, NetMauMau::Common::ICard::QUEEN,
+	NetMauMau::Common::ICard::KING, NetMauMau::Common::ICard::ACE
+};
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+// xorshift32, the deals don't depend on the generator of the library
+class Deal {
+	DISALLOW_COPY_AND_ASSIGN(Deal)
+public:
+	explicit Deal(uint32_t seed) : m_state(seed ? seed : 0x9E3779B9u) {}
+
+	inline uint32_t operator()(uint32_t ubound) {
+
+		m_state ^= m_state << 13u;
+		m_state ^= m_state >> 17u;
+		m_state ^= m_state << 5u;
+
+		return m_state % ubound;
+	}
+
+private:
+	uint32_t m_state;
+};
+
+// runs the chains the AI players use next to the same chains dispatched through the vtable
+class DispatchPlayer : public NetMauMau::Player::HardPlayer {
+	DISALLOW_COPY_AND_ASSIGN(DispatchPlayer)
+
+	typedef NetMauMau::AI::DecisionChain<NetMauMau::AI::JackOnlyCondition, false,
+			NetMauMau::AI::VirtualDispatch> VIRTUALCHAIN;
+	typedef NetMauMau::AI::DecisionChain<NetMauMau::AI::PowerJackCondition, true,
+			NetMauMau::AI::VirtualDispatch> VIRTUALJACKCHAIN;
+
+public:
+	explicit DispatchPlayer() : HardPlayer("Cathy", 0L), m_virtual(*this), m_jackVirtual(*this) {}
+
+	virtual ~DispatchPlayer() throw() {}
+
+	NetMauMau::Common::ICardPtr decide(const NetMauMau::Common::ICardPtr &uc,
+									   const NetMauMau::Common::ICard::SUIT *js,
+									   bool staticDispatch, unsigned int seed) const {
+
+		prepare(uc, NetMauMau::Common::ICardPtr(), seed);
+		m_jackSuit = const_cast<NetMauMau::Common::ICard::SUIT *>(js);
+
+		const CARDS &pc(getPossibleCards(uc, js));
+		const NetMauMau::Common::ICardPtr c(staticDispatch ? getDecisionChain()->getCard(pc) :
+											m_virtual.getCard(pc));
+
+		m_card = NetMauMau::Common::ICardPtr();
+
+		return c;
+	}
+
+	NetMauMau::Common::ICardPtr decideJack(const NetMauMau::Common::ICardPtr &uc,
+										   const NetMauMau::Common::ICardPtr &jack,
+										   bool staticDispatch, unsigned int seed) const {
+
+		prepare(uc, jack, seed);
+
+		const CARDS &pc(getPossibleCards(uc, 0L));
+		const NetMauMau::Common::ICardPtr c(staticDispatch ?
+											getJackDecisionChain()->getCard(pc, true) :
+											m_jackVirtual.getCard(pc, true));
+
+		m_card = m_playedCard = NetMauMau::Common::ICardPtr();
+
+		return c;
+	}
+
+	CARDS possibleCards(const NetMauMau::Common::ICardPtr &uc,
+						const NetMauMau::Common::ICard::SUIT *js) const {
+		return getPossibleCards(uc, js);
+	}
+
+	void deal(const NetMauMau::Player::IPlayer::CARDS &deck, Deal &rng,
+			  NetMauMau::Player::IPlayer::CARDS &talon, const NetMauMau::RuleSet::IRuleSet *rs) {
+
+		NetMauMau::Player::IPlayer::CARDS hand;
+
+		reset();
+		talon.clear();
+
+		for(NetMauMau::Player::IPlayer::CARDS::const_iterator i(deck.begin()); i != deck.end();
+				++i) {
+			(rng(3u) ? talon : hand).push_back(*i);
+		}
+
+		setRuleSet(rs);
+		receiveCardSet(hand);
+	}
+
+private:
+	// every decision starts from the same state, whatever the chain set before
+	void prepare(const NetMauMau::Common::ICardPtr &uc, const NetMauMau::Common::ICardPtr &jack,
+				 unsigned int seed) const {
+
+		DispatchPlayer *self = const_cast<DispatchPlayer *>(this);
+
+		self->setPowerSuit(NetMauMau::Common::ICard::SUIT_ILLEGAL);
+		self->setPowerPlay(false);
+		self->setTryAceRound(false);
+
+		m_card = m_playedCard = jack;
+		m_uncoveredCard = uc;
+		m_jackSuit = 0L;
+		m_scratchArena.reset();
+
+		std::srand(seed);
+	}
+
+private:
+	const VIRTUALCHAIN m_virtual;
+	const VIRTUALJACKCHAIN m_jackVirtual;
+};
+
+std::string describe(const NetMauMau::Common::ICardPtr &c) {
+	return c ? c->description() : "NO CARD";
+}
+
+// the static choice has to be the virtual one, or one the virtual chain can make by chance
+bool same(const DispatchPlayer &player, const NetMauMau::Common::ICardPtr &uc,
+		  const NetMauMau::Common::ICard::SUIT *js, const NetMauMau::Common::ICardPtr &jack,
+		  const NetMauMau::Common::ICardPtr &sc, unsigned int seed) {
+
+	for(unsigned int a = 0u; a < ATTEMPTS; ++a) {
+
+		const NetMauMau::Common::ICardPtr vc(jack ? player.decideJack(uc, jack, false, seed) :
+											 player.decide(uc, js, false, seed));
+
+		if(vc == sc) return true;
+
+		if(a + 1u == ATTEMPTS) {
+			std::cerr << (jack ? "jack on " : "on ") << describe(uc) << ": virtual "
+					  << describe(vc) << " != static " << describe(sc) << std::endl;
+		}
+	}
+
+	return false;
+}
+
+bool possible(const DispatchPlayer &player, const NetMauMau::Common::ICardPtr &uc,
+			  const NetMauMau::Common::ICard::SUIT *js, const NetMauMau::Common::ICardPtr &c) {
+
+	const NetMauMau::Player::IPlayer::CARDS pc(player.possibleCards(uc, js));
+
+	if(c && std::find(pc.begin(), pc.end(), c) == pc.end()) {
+		std::cerr << describe(c) << " on " << describe(uc) << " isn't a possible card" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+// compares every decision of a deal: on each talon card, on each wished suit and on a jack
+void compare(const DispatchPlayer &player, const NetMauMau::Player::IPlayer::CARDS &talon,
+			 const NetMauMau::Common::ICardPtr &jack, unsigned int seed,
+			 unsigned long &checked, unsigned int &mismatches, unsigned int &illegal) {
+
+	for(NetMauMau::Player::IPlayer::CARDS::const_iterator i(talon.begin()); i != talon.end();
+			++i, checked += 2ul) {
+
+		const NetMauMau::Common::ICardPtr sc(player.decide(*i, 0L, true, seed));
+
+		if(!possible(player, *i, 0L, sc)) ++illegal;
+
+		if(!same(player, *i, 0L, NetMauMau::Common::ICardPtr(), sc, seed)) ++mismatches;
+
+		if(!same(player, *i, 0L, jack, player.decideJack(*i, jack, true, seed), seed)) {
+			++mismatches;
+		}
+	}
+
+	for(std::size_t s = 0u; s < 4u; ++s, ++checked) {
+
+		// a jack on the jack gets dropped by the player, so only the dispatch is checked here
+		if(!same(player, jack, &SUITS[s], NetMauMau::Common::ICardPtr(),
+				 player.decide(jack, &SUITS[s], true, seed), seed)) {
+			++mismatches;
+		}
+	}
+}
+
+unsigned long bench(const DispatchPlayer &player, const NetMauMau::Player::IPlayer::CARDS &talon,
+					const NetMauMau::Common::ICardPtr &jack, bool staticDispatch) {
+
+	unsigned long n = 0ul;
+
+	for(NetMauMau::Player::IPlayer::CARDS::const_iterator i(talon.begin()); i != talon.end();
+			++i, n += 2ul) {
+		player.decide(*i, 0L, staticDispatch, 0u);
+		player.decideJack(*i, jack, staticDispatch, 0u);
+	}
+
+	return n;
+}
+
+}
+
+int main(int argc, const char **argv) {
+
+	const unsigned long rounds = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 200ul;
+
+	NetMauMau::Test::SimpleRuleSet ruleSet;
+	DispatchPlayer player;
+	NetMauMau::Player::IPlayer::CARDS deck, talon;
+
+	for(std::size_t s = 0u; s < 4u; ++s) {
+		for(std::size_t r = 0u; r < 8u; ++r) {
+			deck.push_back(NetMauMau::Common::ICardPtr(NetMauMau::StdCardFactory().create(SUITS[s],
+						   RANKS[r])));
+		}
+	}
+
+	const NetMauMau::Common::ICardPtr jack(NetMauMau::StdCardFactory().
+										   create(NetMauMau::Common::ICard::HEARTS,
+												  NetMauMau::Common::ICard::JACK));
+
+	unsigned long checked = 0ul, decisions[2] = { 0ul, 0ul };
+	unsigned int mismatches = 0u, illegal = 0u;
+	double elapsed[2] = { 0.0, 0.0 };
+
+	for(unsigned long r = 0ul; r < rounds; ++r) {
+
+		Deal rng(static_cast<uint32_t>(r + 1u));
+
+		player.deal(deck, rng, talon, &ruleSet);
+
+		compare(player, talon, jack, static_cast<unsigned int>(r), checked, mismatches, illegal);
+
+		for(std::size_t d = 0u; d < 2u; ++d) {
+
+			const double start = now();
+
+			decisions[d] += bench(player, talon, jack, d != 0u);
+			elapsed[d] += now() - start;
+		}
+	}
+
+	std::cout << checked << " decisions compared, " << mismatches << " mismatches, " << illegal
+			  << " illegal" << std::endl << std::fixed << std::setprecision(0);
+
+	for(std::size_t d = 0u; d < 2u; ++d) {
+		std::cout << (d ? "static dispatch:  " : "virtual dispatch: ")
+				  << (elapsed[d] > 0.0 ? static_cast<double>(decisions[d]) / elapsed[d] : 0.0)
+				  << " decisions/sec" << std::endl;
+	}
+
+	return (checked && !mismatches && !illegal) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
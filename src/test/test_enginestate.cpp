@@ -0,0 +1,127 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks that a snapshot of a running game survives an export/import round trip and that
+ * rejected snapshots leave the game unchanged.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <algorithm>                    // for max
+#include <cstdlib>                      // for EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>                      // for memcmp
+#include <iostream>                     // for operator<<, basic_ostream, etc
+
+#include "logger.h"
+#include "engine.h"                     // for Engine
+#include "hardplayer.h"                 // for HardPlayer
+#include "enginestate.h"                // for EngineState
+#include "testeventhandler.h"           // for TestEventHandler
+
+namespace {
+
+unsigned int failures = 0u;
+
+void check(bool ok, const char *what) {
+
+	if(!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		++failures;
+	}
+}
+
+bool sameState(const NetMauMau::EngineState &a, const NetMauMau::EngineState &b) {
+	return !std::memcmp(&a, &b, sizeof(NetMauMau::EngineState));
+}
+
+}
+
+int main(int, const char **) {
+
+	try {
+
+		TestEventHandler evHdlr;
+		NetMauMau::EngineContext ctx(evHdlr, true, 0L, false, 'A',
+									 NetMauMau::Common::getCardConfig(4));
+		NetMauMau::Engine engine(ctx);
+
+		NetMauMau::Common::SmartPtr<NetMauMau::Player::IPlayer>
+		p1(new NetMauMau::Player::HardPlayer("Cathy", engine.getPlayedOutCards()));
+		NetMauMau::Common::SmartPtr<NetMauMau::Player::IPlayer>
+		p2(new NetMauMau::Player::HardPlayer("Heiko", engine.getPlayedOutCards()));
+		NetMauMau::Common::SmartPtr<NetMauMau::Player::IPlayer>
+		p3(new NetMauMau::Player::HardPlayer("Sabrina", engine.getPlayedOutCards()));
+
+		engine.addPlayer(p1);
+		engine.addPlayer(p2);
+		engine.addPlayer(p3);
+
+		engine.distributeCards();
+		engine.initialTurn();
+
+		for(unsigned int i = 0u; i < 3u && engine.hasPlayers(); ++i) engine.nextTurn();
+
+		NetMauMau::EngineState snapshot, state;
+
+		snapshot.clear();
+		state.clear();
+
+		check(engine.exportState(snapshot), "export of a running game");
+		check(snapshot.players == 3u && snapshot.uncoveredSize, "exported players and cards");
+
+		// diverge from the snapshot and return to it
+		for(unsigned int i = 0u; i < 2u && engine.hasPlayers(); ++i) engine.nextTurn();
+
+		check(engine.importState(snapshot), "import of the snapshot");
+		check(engine.exportState(state) && sameState(snapshot, state), "round trip");
+
+		NetMauMau::EngineState bad(snapshot);
+
+		bad.takeCount = static_cast<unsigned char>(snapshot.takeCount + 2u);
+		bad.talon[0] = NetMauMau::EngineState::NOCARD;
+		bad.talonSize = static_cast<unsigned char>(std::max<unsigned char>(1u,
+						snapshot.talonSize));
+
+		check(!engine.importState(bad), "snapshot with an invalid card is rejected");
+		check(engine.exportState(state) && sameState(snapshot, state),
+			  "rejected snapshot leaves the game unchanged");
+
+		bad = snapshot;
+		bad.decks = static_cast<unsigned char>(snapshot.decks + 1u);
+
+		check(!engine.importState(bad), "snapshot of another deck count is rejected");
+
+		bool ok = true;
+
+		while(ok && engine.hasPlayers()) ok = engine.nextTurn();
+
+		check(ok, "game continues after the import");
+
+	} catch(const NetMauMau::Common::Exception::SocketException &e) {
+		logError(e);
+		check(false, "game with snapshots");
+	}
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
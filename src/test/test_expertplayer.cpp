@@ -0,0 +1,253 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks the rules of the compact game model of the expert AI, that its search finds a legal,
+ * and if there is one, winning move, that the endgame solver doesn't take a position as exact
+ * once the played out cards can get reshuffled and that it plays a game against the hard AI to
+ * the end.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <cstdlib>                      // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>                     // for operator<<, basic_ostream, etc
+
+#include "logger.h"
+#include "ismcts.h"                     // for ISMCTS
+#include "endgamesolver.h"              // for EndgameSolver
+#include "hardplayer.h"                 // for HardPlayer
+#include "expertplayer.h"               // for ExpertPlayer
+#include "testeventhandler.h"           // for TestEventHandler
+
+namespace {
+
+typedef NetMauMau::Player::CompactState CS;
+
+unsigned int failures = 0u;
+
+void check(bool ok, const char *what) {
+
+	if(!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		++failures;
+	}
+}
+
+CS::CARD card(NetMauMau::Common::ICard::SUIT s, NetMauMau::Common::ICard::RANK r) {
+	return CS::getCard(s, r);
+}
+
+// a two player game with the diamond ten uncovered
+CS::OBSERVATION observation(CS::HAND hand, unsigned char oppCount, unsigned char takeCount) {
+
+	CS::OBSERVATION obs;
+
+	obs.hand = hand;
+	obs.uncovered = card(NetMauMau::Common::ICard::DIAMONDS, NetMauMau::Common::ICard::TEN);
+	obs.takeCount = takeCount;
+	obs.players = 2u;
+	obs.count[0] = static_cast<unsigned char>(__builtin_popcount(hand));
+	obs.count[1] = oppCount;
+
+	return obs;
+}
+
+bool hasMove(const CS &state, CS::MOVE m) {
+
+	CS::MOVE moves[CS::MAXMOVES];
+	const unsigned int n = state.getMoves(moves);
+
+	for(unsigned int i = 0u; i < n; ++i) if(moves[i] == m) return true;
+
+	return false;
+}
+
+void checkMoves() {
+
+	CS::RNG rng(1u);
+
+	const CS::CARD jack = card(NetMauMau::Common::ICard::CLUBS, NetMauMau::Common::ICard::JACK);
+	const CS::CARD suit = card(NetMauMau::Common::ICard::DIAMONDS, NetMauMau::Common::ICard::ACE);
+	const CS::CARD rank = card(NetMauMau::Common::ICard::SPADES, NetMauMau::Common::ICard::TEN);
+	const CS::CARD none = card(NetMauMau::Common::ICard::HEARTS, NetMauMau::Common::ICard::KING);
+
+	const CS state(observation(CS::bit(jack) | CS::bit(suit) | CS::bit(rank) | CS::bit(none),
+							   5u, 0u), rng);
+
+	CS::MOVE moves[CS::MAXMOVES];
+
+	check(state.getMoves(moves) == 7u, "a jack for every suit, two cards and to pass");
+	check(hasMove(state, suit) && hasMove(state, rank), "cards of same suit or rank");
+	check(!hasMove(state, none), "card of other suit and rank");
+	check(hasMove(state, CS::makeMove(jack, 2u)), "jack wishing spades");
+	check(hasMove(state, CS::PASS), "pass");
+}
+
+void checkPass() {
+
+	const CS::CARD seven = card(NetMauMau::Common::ICard::HEARTS, NetMauMau::Common::ICard::SEVEN);
+	const CS::CARD queen = card(NetMauMau::Common::ICard::CLUBS, NetMauMau::Common::ICard::QUEEN);
+
+	for(uint32_t seed = 1u; seed <= 64u; ++seed) {
+
+		CS::RNG rng(seed);
+		CS state(observation(CS::bit(seven) | CS::bit(queen), 5u, 2u), rng);
+
+		state.apply(CS::PASS, rng);
+
+		// the pending sevens get taken instead of a card picked
+		check(state.getCardCount(0u) == 4u, "taking two cards for a seven replaces the pick");
+		check(state.getPlayerToMove() == 1u, "turn ends after taking");
+
+		CS fresh(observation(CS::bit(seven) | CS::bit(queen), 5u, 0u), rng);
+		const CS::KEY before = fresh.getKey();
+
+		fresh.apply(CS::PASS, rng);
+
+		// the picked card is either kept or played at once
+		check(fresh.getCardCount(0u) == 3u || (fresh.getCardCount(0u) == 2u &&
+				(fresh.getKey().misc & 31u) != (before.misc & 31u)), "picking a card");
+	}
+}
+
+void checkPlayout() {
+
+	for(uint32_t seed = 1u; seed <= 256u; ++seed) {
+
+		CS::RNG rng(seed);
+		CS::OBSERVATION obs(observation(CS::bit(card(NetMauMau::Common::ICard::HEARTS,
+										NetMauMau::Common::ICard::SEVEN)) |
+										CS::bit(card(NetMauMau::Common::ICard::SPADES,
+												NetMauMau::Common::ICard::NINE)), 5u, 0u));
+
+		obs.players = 3u;
+		obs.count[2] = 4u;
+
+		CS state(obs, rng);
+
+		check(state.playout(rng) < 3u, "playout yields a player");
+	}
+}
+
+void checkSearch() {
+
+	const CS::CARD win = card(NetMauMau::Common::ICard::DIAMONDS, NetMauMau::Common::ICard::KING);
+	const CS::CARD other = card(NetMauMau::Common::ICard::SPADES, NetMauMau::Common::ICard::SEVEN);
+
+	NetMauMau::Player::ISMCTS search(1u);
+
+	// the last card wins at once
+	check(search.search(observation(CS::bit(win), 5u, 0u), 20L, 42u) == win, "winning move");
+	check(search.getPlayouts() > 0ul, "playouts counted");
+
+	search.reset();
+
+	const CS::OBSERVATION obs(observation(CS::bit(win) | CS::bit(other), 3u, 0u));
+	const CS::MOVE m = search.search(obs, 20L, 4711u);
+
+	check(m == win || m == CS::PASS, "legal move");
+	check(search.advance(0u, m), "tree follows the chosen move");
+}
+
+// all cards but the opponent's one are played out, thus a single determinization is exact
+CS::OBSERVATION knownPosition(CS::HAND hand, CS::CARD opp) {
+
+	CS::OBSERVATION obs(observation(hand, 1u, 0u));
+
+	obs.playedOut = ~(hand | CS::bit(obs.uncovered) | CS::bit(opp));
+
+	return obs;
+}
+
+void checkSolver() {
+
+	const CS::CARD d8 = card(NetMauMau::Common::ICard::DIAMONDS, NetMauMau::Common::ICard::EIGHT);
+	const CS::CARD c8 = card(NetMauMau::Common::ICard::CLUBS, NetMauMau::Common::ICard::EIGHT);
+	const CS::CARD dA = card(NetMauMau::Common::ICard::DIAMONDS, NetMauMau::Common::ICard::ACE);
+	const CS::CARD s7 = card(NetMauMau::Common::ICard::SPADES, NetMauMau::Common::ICard::SEVEN);
+	const CS::CARD hJ = card(NetMauMau::Common::ICard::HEARTS, NetMauMau::Common::ICard::JACK);
+	const CS::CARD dQ = card(NetMauMau::Common::ICard::DIAMONDS, NetMauMau::Common::ICard::QUEEN);
+
+	NetMauMau::Player::EndgameSolver solver;
+	CS::MOVE m = CS::PASS;
+	const long budget = 100L;
+
+	// the eight suspends the opponent, then the other eight wins
+	check(solver.solve(knownPosition(CS::bit(d8) | CS::bit(c8), hJ), budget, 42u, m) &&
+		  m == d8, "solver finds the winning move");
+	check(solver.getDeterminizations() == 1ul, "known position is solved once");
+	// counted rather than timed, a loaded machine mustn't fail the test
+	check(solver.getNodes() && solver.getNodes() <= 16ul, "known position takes a few nodes");
+
+	// the ace loses to the queen, picking a card reshuffles the played out cards and is
+	// undecided rather than a pick of nothing
+	check(solver.solve(knownPosition(CS::bit(dA) | CS::bit(s7), dQ), budget, 4711u, m) &&
+		  m == CS::PASS, "picking from the reshuffled talon");
+}
+
+void checkGame() {
+
+	try {
+
+		TestEventHandler evHdlr;
+		NetMauMau::EngineContext ctx(evHdlr, true, 0L, false, 'A',
+									 NetMauMau::Common::getCardConfig(4));
+		NetMauMau::Engine engine(ctx);
+
+		NetMauMau::Common::SmartPtr<NetMauMau::Player::IPlayer>
+		p1(new NetMauMau::Player::HardPlayer("Cathy", engine.getPlayedOutCards()));
+		NetMauMau::Common::SmartPtr<NetMauMau::Player::IPlayer>
+		p2(new NetMauMau::Player::ExpertPlayer("Heiko", engine.getPlayedOutCards(), 20L));
+
+		engine.addPlayer(p1);
+		engine.addPlayer(p2);
+
+		engine.distributeCards();
+		engine.initialTurn();
+
+		bool ok = true;
+
+		while(ok && engine.hasPlayers()) ok = engine.nextTurn();
+
+		check(ok, "game against the hard AI");
+
+	} catch(const NetMauMau::Common::Exception::SocketException &e) {
+		logError(e);
+		check(false, "game against the hard AI");
+	}
+}
+
+}
+
+int main(int, const char **) {
+
+	checkMoves();
+	checkPass();
+	checkPlayout();
+	checkSearch();
+	checkSolver();
+	checkGame();
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks the SHA-1 used to address player pictures against the standard test vectors and
+ * that the picture cache only ever stores and returns pictures matching their hash.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"                     // for PACKAGE
+#endif
+
+#include <cstdio>                       // for fopen, fputs, remove
+#include <cstdlib>                      // for EXIT_SUCCESS, EXIT_FAILURE, setenv
+#include <iostream>                     // for operator<<, basic_ostream, etc
+
+#if !defined(_WIN32) && (defined(HAVE_SYS_STAT_H) && defined(HAVE_SYS_TYPES_H))
+#include <unistd.h>                     // for rmdir
+#define NMM_PICTURE_DISK_CACHE 1
+#endif
+
+#include "sha1.h"                       // for sha1_hex
+#include "picturecache.h"               // for PictureCache
+
+namespace {
+
+unsigned int failures = 0u;
+
+void check(bool ok, const char *what) {
+
+	if(!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		++failures;
+	}
+}
+
+std::string sha1(const std::string &s) {
+	return NetMauMau::Common::sha1_hex(reinterpret_cast<const unsigned char *>(s.data()),
+									   s.length());
+}
+
+void checkSHA1() {
+
+	check(sha1("") == "da39a3ee5e6b4b0d3255bfef95601890afd80709", "SHA-1 of \"\"");
+	check(sha1("abc") == "a9993e364706816aba3e25717850c26c9cd0d89d", "SHA-1 of \"abc\"");
+	check(sha1("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+		  "84983e441c3bd26ebaae4aa1f95129e5e54670f1", "SHA-1 of two blocks");
+	check(sha1(std::string(1000000u, 'a')) == "34aa973cd4c4daa4f61eeb2bdbad27316534016f",
+		  "SHA-1 of a million 'a'");
+}
+
+void checkHashRef() {
+
+	const std::string h(sha1("abc"));
+
+	check(NetMauMau::Client::PictureCache::isHashRef("#" + h), "hash reference");
+	check(!NetMauMau::Client::PictureCache::isHashRef(h), "hash without '#'");
+	check(!NetMauMau::Client::PictureCache::isHashRef("#" + h.substr(1)), "short hash");
+	check(!NetMauMau::Client::PictureCache::isHashRef("#../../../../../../../etc/passwd.xxxxxxxx"),
+		  "path as hash");
+	check(!NetMauMau::Client::PictureCache::isHashRef("#A9993E364706816ABA3E25717850C26C9CD0D89D"),
+		  "upper case hash");
+}
+
+void checkCache() {
+
+	const char png[] = "\x89PNG\r\n\x1a\n not really a picture";
+	const NetMauMau::Client::PictureCache::PNGDATA data(png, png + sizeof(png) - 1u);
+	const std::string hash(NetMauMau::Common::sha1_hex(&data.front(), data.size()));
+	const std::string other(sha1("abc"));
+
+	const NetMauMau::Client::PictureCache cache;
+	NetMauMau::Client::PictureCache::PNGDATA out;
+
+	check(!cache.put(hash, NetMauMau::Client::PictureCache::PNGDATA()), "empty picture rejected");
+	check(!cache.put(other, data), "picture not matching its hash rejected");
+	check(!cache.get(other, out) && out.empty(), "rejected picture isn't cached");
+	check(cache.put(hash, data), "picture stored");
+
+#ifdef NMM_PICTURE_DISK_CACHE
+
+	check(cache.get(hash, out) && out == data, "stored picture returned");
+
+	// a picture modified on disk doesn't match its hash any more
+	const std::string file(std::string(std::getenv("XDG_CACHE_HOME")).
+						   append("/" PACKAGE "/pictures/").append(hash).append(".png"));
+
+	FILE *f = std::fopen(file.c_str(), "ab");
+
+	if(f) {
+		std::fputs("garbage", f);
+		std::fclose(f);
+	}
+
+	NetMauMau::Client::PictureCache::PNGDATA().swap(out);
+
+	check(f && !cache.get(hash, out) && out.empty(), "modified picture rejected");
+	check(!std::remove(file.c_str()), "cached picture file");
+#endif
+}
+
+}
+
+int main(int, const char **) {
+
+	checkSHA1();
+	checkHashRef();
+
+#ifdef NMM_PICTURE_DISK_CACHE
+
+	char dir[] = "/tmp/nmm-picturecache-XXXXXX";
+
+	if(!mkdtemp(dir)) {
+		std::cerr << "Cannot create a cache directory" << std::endl;
+		return 77;
+	}
+
+	setenv("XDG_CACHE_HOME", dir, 1);
+#endif
+
+	checkCache();
+
+#ifdef NMM_PICTURE_DISK_CACHE
+	rmdir((std::string(dir).append("/" PACKAGE "/pictures")).c_str());
+	rmdir((std::string(dir).append("/" PACKAGE)).c_str());
+	rmdir(dir);
+#endif
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks that a client driven by processInput() lets players join before their pictures have
+ * arrived, and that it fetches all of them over one query session without blocking the game.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"                     // for PACKAGE, PACKAGE_NAME, SERVER_VERSION_MAJOR, etc
+#endif
+
+#include <algorithm>                    // for count
+#include <csignal>                      // for signal, SIGPIPE
+#include <cstdio>                       // for snprintf, remove
+#include <cstdlib>                      // for EXIT_SUCCESS, EXIT_FAILURE, setenv
+#include <cstring>                      // for strlen
+#include <iostream>                     // for operator<<, basic_ostream, etc
+
+#include <poll.h>                       // for poll
+#include <sys/socket.h>                 // for accept
+#include <sys/wait.h>                   // for waitpid
+#include <unistd.h>                     // for fork, pipe, close, rmdir
+
+#include "base64.h"                     // for base64_encode
+#include "sha1.h"                       // for sha1_hex
+#include "protocol.h"                   // for PLAYERJOINED, PLAYERWINS, etc
+#include "loopback.h"                   // for listenLoopback, writeAll, etc
+#include "recordingclient.h"            // for RecordingClient
+
+namespace {
+
+unsigned int failures = 0u;
+
+void check(bool ok, const std::string &what) {
+
+	if(!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		++failures;
+	}
+}
+
+const char *const PICTURES[2] = { "Bob's picture", "Alice's somewhat larger picture" };
+
+std::string hash(std::size_t i) {
+	return NetMauMau::Common::sha1_hex(reinterpret_cast<const unsigned char *>(PICTURES[i]),
+									   std::strlen(PICTURES[i]));
+}
+
+std::string base64(std::size_t i) {
+	return NetMauMau::Common::base64_encode(reinterpret_cast<const unsigned char *>(PICTURES[i]),
+											static_cast<unsigned int>(std::strlen(PICTURES[i])));
+}
+
+bool accepted(int lfd, int &fd) {
+
+	pollfd pfd = { lfd, POLLIN, 0 };
+
+	return ::poll(&pfd, 1, 5000) == 1 && (fd = ::accept(lfd, 0L, 0L)) >= 0;
+}
+
+// reads until the peer has sent @c n NUL terminated strings
+bool readQueries(int fd, std::size_t n, std::string &in) {
+
+	std::string s;
+
+	while(static_cast<std::size_t>(std::count(in.begin(), in.end(), '\0')) < n) {
+
+		if(!readSome(fd, s)) return false;
+
+		in.append(s);
+	}
+
+	return true;
+}
+
+/*
+ * Two players join, the client has to ask for both pictures on a single session. The answers
+ * are held back until the client has reported both players, and the game only ends after the
+ * client got the pictures.
+ */
+bool serve(int lfd, int toClient, int fromClient) {
+
+	namespace P = NetMauMau::Common::Protocol::V15;
+
+	std::signal(SIGPIPE, SIG_IGN);
+
+	char hello[64];
+	const int hlen = std::snprintf(hello, sizeof(hello), "%s %u.%u", PACKAGE_NAME,
+								   SERVER_VERSION_MAJOR, SERVER_VERSION_MINOR);
+
+	const std::string joins(P::PLAYERJOINED + '\0' + "Bob" + '\0' + '#' + hash(0) + '\0' +
+							P::PLAYERJOINED + '\0' + "Alice" + '\0' + '#' + hash(1) + '\0');
+	const std::string wins(P::PLAYERWINS + '\0' + "Bob" + '\0');
+	const std::string answers(base64(0) + '\0' + base64(1) + '\0');
+	const std::string queries(P::PICTURE + ' ' + hash(0) + '\0' +
+							  P::PICTURE + ' ' + hash(1) + '\0');
+
+	int fd = -1, pfd = -1;
+	std::string in, q;
+
+	bool ok = accepted(lfd, fd) && writeAll(fd, hello, static_cast<std::size_t>(hlen)) &&
+			  readSome(fd, in) && writeAll(fd, "NAME", 4u) && readSome(fd, in) &&
+			  writeAll(fd, "OK", 2u) && writeAll(fd, joins.data(), joins.length()) &&
+			  accepted(lfd, pfd) && writeAll(pfd, hello, static_cast<std::size_t>(hlen)) &&
+			  readSome(pfd, in) && in.compare(0u, P::QUERY.length(), P::QUERY) == 0 &&
+			  writeAll(pfd, P::QUERY.data(), P::QUERY.length()) && readQueries(pfd, 2u, q) &&
+			  q == queries && writeAll(toClient, "q", 1u) && token(fromClient) &&
+			  writeAll(pfd, answers.data(), answers.length()) && token(fromClient) &&
+			  writeAll(fd, wins.data(), wins.length());
+
+	// the client must not have tried another connection for the pictures
+	pollfd lpfd = { lfd, POLLIN, 0 };
+	ok = ok && !::poll(&lpfd, 1, 0);
+
+	if(pfd >= 0) ::close(pfd);
+
+	if(fd >= 0) ::close(fd);
+
+	return ok;
+}
+
+bool waitForLog(RecordingClient &client, const std::string &line, bool pictures) {
+
+	for(int i = 0; i < 500 && client.getLog().find(line) == std::string::npos; ++i) {
+
+		pollfd pfd = { pictures ? client.getPictureSocketFD() : client.getSocketFD(), POLLIN, 0 };
+
+		::poll(&pfd, 1, 10);
+
+		if(pictures) {
+			client.processPictures();
+		} else if(!client.processInput()) {
+			break;
+		}
+	}
+
+	return client.getLog().find(line) != std::string::npos;
+}
+
+void play(uint16_t port, int fromServer, int toServer) {
+
+	RecordingClient client(port);
+
+	client.startPlay();
+
+	check(waitForLog(client, "playerJoined Alice 0\n", false), "players joined");
+	check(client.getLog() == "playerJoined Bob 0\nplayerJoined Alice 0\n",
+		  "players join without pictures:\n" + client.getLog());
+	check(client.getPictureSocketFD() != INVALID_SOCKET, "pictures pending");
+
+	if(!token(fromServer) || !writeAll(toServer, "a", 1u)) {
+		check(false, "server");
+		return;
+	}
+
+	check(waitForLog(client, "playerPicture Alice", true), "pictures received");
+	check(client.getPictureSocketFD() == INVALID_SOCKET, "no picture pending");
+
+	if(!writeAll(toServer, "e", 1u)) {
+		check(false, "server");
+		return;
+	}
+
+	check(waitForLog(client, "gameOver\n", false), "game over");
+
+	char exp[256];
+	std::snprintf(exp, sizeof(exp), "playerJoined Bob 0\nplayerJoined Alice 0\n"
+				  "playerPicture Bob %lu\nplayerPicture Alice %lu\nplayerWins Bob 0\ngameOver\n",
+				  static_cast<unsigned long>(std::strlen(PICTURES[0])),
+				  static_cast<unsigned long>(std::strlen(PICTURES[1])));
+
+	check(client.getLog() == exp, "callbacks:\n" + client.getLog());
+}
+
+}
+
+int main(int, const char **) {
+
+	// a picture cache of its own, the pictures must not be known before
+	char dir[] = "/tmp/nmm-picturefetch-XXXXXX";
+
+	if(!mkdtemp(dir)) {
+		std::cerr << "Cannot create a cache directory" << std::endl;
+		return 77;
+	}
+
+	setenv("XDG_CACHE_HOME", dir, 1);
+
+	uint16_t port = 0u;
+	const int lfd = listenLoopback(port);
+
+	int toServer[2], toClient[2];
+
+	if(lfd < 0 || ::pipe(toServer) || ::pipe(toClient)) {
+		std::cerr << "Cannot set up a local server" << std::endl;
+		return 77;
+	}
+
+	const pid_t pid = ::fork();
+
+	if(pid < 0) return 77;
+
+	if(!pid) {
+		::close(toServer[1]);
+		::close(toClient[0]);
+		::_exit(serve(lfd, toClient[1], toServer[0]) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	::close(lfd);
+	::close(toServer[0]);
+	::close(toClient[1]);
+
+	try {
+		play(port, toClient[0], toServer[1]);
+	} catch(const NetMauMau::Common::Exception::SocketException &e) {
+		check(false, e.what());
+	}
+
+	::close(toServer[1]);
+	::close(toClient[0]);
+
+	int status = EXIT_FAILURE;
+
+	check(::waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+		  WEXITSTATUS(status) == EXIT_SUCCESS, "server");
+
+	const std::string pics(std::string(dir).append("/" PACKAGE "/pictures/"));
+
+	for(std::size_t i = 0u; i < 2u; ++i) std::remove((pics + hash(i) + ".png").c_str());
+
+	rmdir(pics.c_str());
+	rmdir((std::string(dir).append("/" PACKAGE)).c_str());
+	rmdir(dir);
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,309 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Checks that a lobby query session answers queries arriving in pieces or several at once,
+ * that a client uses sessions with the server and that it falls back to separate connections
+ * with a server which doesn't know query sessions.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"                     // for PACKAGE_NAME
+#endif
+
+#include <csignal>                      // for signal, kill, SIGPIPE, SIGKILL
+#include <cstdlib>                      // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>                     // for operator<<, basic_ostream, etc
+
+#include <poll.h>                       // for poll
+#include <sys/socket.h>                 // for socket, connect, accept
+#include <sys/wait.h>                   // for waitpid
+#include <netinet/in.h>                 // for sockaddr_in, htonl, INADDR_LOOPBACK
+#include <unistd.h>                     // for fork, close
+
+#include "protocol.h"                   // for QUERY, CAP, CAPEND
+#include "loopback.h"                   // for listenLoopback, writeAll, etc
+#include "recordingclient.h"            // for RecordingClient
+#include "serverconnection.h"           // for Connection
+
+namespace {
+
+unsigned int failures = 0u;
+
+void check(bool ok, const char *what) {
+
+	if(!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		++failures;
+	}
+}
+
+int connectLoopback(uint16_t port) {
+
+	const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+	sockaddr_in addr = sockaddr_in();
+
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = htons(port);
+
+	if(fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr))) {
+		::close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+bool readable(int fd) {
+	pollfd pfd = { fd, POLLIN, 0 };
+	return ::poll(&pfd, 1, 200) > 0;
+}
+
+// reads until the response contains the end marker @c n times
+bool response(int fd, const std::string &end, unsigned int n, std::string &resp) {
+
+	const std::string marker(std::string(end).append(1, '\0'));
+	std::string::size_type p = 0;
+
+	resp.clear();
+
+	while(n) {
+
+		std::string in;
+
+		if(!readable(fd) || !readSome(fd, in)) return false;
+
+		resp.append(in);
+
+		std::string::size_type f;
+
+		while(n && (f = resp.find(marker, p)) != std::string::npos) {
+			p = f + marker.length();
+			--n;
+		}
+	}
+
+	return p == resp.length();
+}
+
+// a client talking the raw protocol to the server, the exit code is the failed step
+int rawClient(uint16_t port) {
+
+	const std::string &CAPEND(NetMauMau::Common::Protocol::V15::CAPEND);
+
+	const int fd = connectLoopback(port);
+
+	std::string in;
+
+	if(fd < 0 || !readSome(fd, in) || in.compare(0, sizeof(PACKAGE_NAME) - 1u, PACKAGE_NAME)) {
+		return 1;
+	}
+
+	if(!writeAll(fd, NetMauMau::Common::Protocol::V15::QUERY.c_str(),
+				 NetMauMau::Common::Protocol::V15::QUERY.length()) || !readSome(fd, in) ||
+			in != NetMauMau::Common::Protocol::V15::QUERY) return 2;
+
+	// the first half of a query must not be answered yet
+	if(!writeAll(fd, "CA", 2u) || readable(fd)) return 3;
+
+	// the string literals include the terminating NUL of the last query
+	if(!writeAll(fd, "P", 2u) || !response(fd, CAPEND, 1u, in)) return 4;
+
+	const std::string expected(in);
+
+	// two queries in one piece get two answers
+	if(!writeAll(fd, "CAP\0CAP", 8u) || !response(fd, CAPEND, 2u, in) ||
+			in != expected + expected) return 5;
+
+	// an overlong query closes the session
+	const std::string garbage(2048u, 'x');
+
+	if(!writeAll(fd, garbage.data(), garbage.length()) || (readable(fd) && readSome(fd, in))) {
+		return 6;
+	}
+
+	::close(fd);
+
+	return EXIT_SUCCESS;
+}
+
+// a client using a session, the exit code is the failed step
+int sessionClient(uint16_t port) {
+
+	RecordingClient client(port);
+
+	if(!client.openQuerySession()) return 1;
+
+	try {
+
+		for(int i = 0; i < 3; ++i) {
+
+			const RecordingClient::CAPABILITIES &caps(client.capabilities());
+
+			if(caps.find("TEST") == caps.end()) return 2;
+		}
+
+		if(!client.playerList().empty()) return 3;
+
+	} catch(const NetMauMau::Common::Exception::SocketException &e) {
+		std::cerr << e.what() << std::endl;
+		return 4;
+	}
+
+	client.closeQuerySession();
+
+	return EXIT_SUCCESS;
+}
+
+void checkServer(int (*cl)(uint16_t), const char *what) {
+
+	uint16_t port = 0u;
+	const int lfd = listenLoopback(port);
+
+	::close(lfd);
+
+	if(lfd < 0) {
+		check(false, "free port for the server");
+		return;
+	}
+
+	NetMauMau::Server::Connection con(MAKE_VERSION(MIN_MAJOR, MIN_MINOR), false, port,
+									  "127.0.0.1");
+
+	NetMauMau::Server::Connection::CAPABILITIES caps;
+	caps.insert(std::make_pair("TEST", "1"));
+
+	con.setCapabilities(caps);
+	con.connect(false);
+
+	const pid_t pid = ::fork();
+
+	if(!pid) ::_exit(cl(port));
+
+	int status = EXIT_FAILURE;
+	pid_t w = 0;
+
+	for(int i = 0; pid > 0 && !(w = ::waitpid(pid, &status, WNOHANG)) && i < 500; ++i) {
+
+		timeval tv = { 0, 10000 };
+
+		if(con.wait(&tv) > 0) {
+
+			NetMauMau::Server::Connection::INFO info;
+
+			try {
+				con.accept(info, false);
+			} catch(const NetMauMau::Common::Exception::SocketException &) {}
+		}
+	}
+
+	if(pid > 0 && !w) {
+		::kill(pid, SIGKILL);
+		::waitpid(pid, &status, 0);
+	}
+
+	if(pid > 0 && WIFEXITED(status) && WEXITSTATUS(status) != EXIT_SUCCESS) {
+		std::cerr << what << ": step " << WEXITSTATUS(status) << std::endl;
+	}
+
+	check(pid > 0 && w == pid && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS, what);
+}
+
+// a server of 0.24 takes a query session request for a malformed player hello
+int oldServer(int lfd) {
+
+	const std::string CAPS(std::string("TEST=1").append(1, '\0').
+						   append(NetMauMau::Common::Protocol::V15::CAPEND).append(1, '\0'));
+
+	std::string in;
+
+	int fd = ::accept(lfd, 0L, 0L);
+
+	if(fd < 0 || !writeAll(fd, PACKAGE_NAME " 0.2", sizeof(PACKAGE_NAME) + 3u) ||
+			!readSome(fd, in) || in.compare(0, NetMauMau::Common::Protocol::V15::QUERY.length(),
+											NetMauMau::Common::Protocol::V15::QUERY) ||
+			!writeAll(fd, "NO", 2u)) return 1;
+
+	::close(fd);
+
+	// without a session the query comes as before, without a terminating NUL
+	fd = ::accept(lfd, 0L, 0L);
+
+	if(fd < 0 || !writeAll(fd, PACKAGE_NAME " 0.2", sizeof(PACKAGE_NAME) + 3u) ||
+			!readSome(fd, in) || in != NetMauMau::Common::Protocol::V15::CAP ||
+			!writeAll(fd, CAPS.data(), CAPS.length())) return 2;
+
+	::close(fd);
+
+	return EXIT_SUCCESS;
+}
+
+void checkOldServer() {
+
+	uint16_t port = 0u;
+	const int lfd = listenLoopback(port);
+
+	if(lfd < 0) {
+		check(false, "free port for the old server");
+		return;
+	}
+
+	const pid_t pid = ::fork();
+
+	if(!pid) ::_exit(oldServer(lfd));
+
+	::close(lfd);
+
+	try {
+
+		RecordingClient client(port);
+
+		check(pid > 0 && !client.openQuerySession(), "no query session with an old server");
+
+		const RecordingClient::CAPABILITIES &caps(client.capabilities());
+
+		check(caps.find("TEST") != caps.end(), "separate query with an old server");
+
+	} catch(const NetMauMau::Common::Exception::SocketException &e) {
+		std::cerr << e.what() << std::endl;
+		check(false, "queries with an old server");
+	}
+
+	int status = EXIT_FAILURE;
+
+	check(pid > 0 && ::waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+		  WEXITSTATUS(status) == EXIT_SUCCESS, "old server");
+}
+
+}
+
+int main(int, const char **) {
+
+	std::signal(SIGPIPE, SIG_IGN);
+
+	checkServer(rawClient, "query session with queries in pieces");
+	checkServer(sessionClient, "query session of a client");
+	checkOldServer();
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
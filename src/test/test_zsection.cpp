@@ -0,0 +1,236 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Sends responses through the sections of a compressing query session and checks that they
+ * come out the same, also if the sections arrive split at any byte, and that corrupted sections
+ * are refused.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"                     // for ENABLE_THREADS
+#endif
+
+#include <cstdlib>                      // for EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>                      // for memcpy
+#include <iostream>                     // for operator<<, basic_ostream, etc
+#include <sstream>                      // for ostringstream
+#include <vector>
+
+#ifdef ENABLE_THREADS
+#include <pthread.h>
+#endif
+
+#include "protocol.h"                   // for PLAYERLIST, PLAYERLISTEND
+#include "zsection.h"                   // for ZSectionDeflater, ZSectionInflater
+
+namespace {
+
+typedef std::vector<std::string> RESPONSES;
+
+const std::size_t THRESHOLD = 64u;
+
+unsigned int failures = 0u;
+
+void check(bool ok, const std::string &what) {
+
+	if(!ok) {
+		std::cerr << "FAILED: " << what << std::endl;
+		++failures;
+	}
+}
+
+// short ones are sent as they are, the player lists get compressed against each other
+RESPONSES responses() {
+
+	RESPONSES r;
+
+	r.push_back("OK");
+	r.push_back(std::string(THRESHOLD - 1u, 'x'));
+	r.push_back(std::string(THRESHOLD, 'x'));
+
+	for(int n = 0; n < 3; ++n) {
+
+		std::ostringstream os;
+
+		os << NetMauMau::Common::Protocol::V15::PLAYERLIST << '\0';
+
+		for(int p = 0; p <= n; ++p) {
+			os << "Player " << p << '\0' << "iVBORw0KGgoAAAANSUhEUgAA" << '\0';
+		}
+
+		os << NetMauMau::Common::Protocol::V15::PLAYERLISTEND << '\0';
+
+		r.push_back(os.str());
+	}
+
+	std::string noise;
+	unsigned int seed = 42u;
+
+	for(std::size_t i = 0u; i < 4096u; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		noise.append(1, static_cast<char>(seed >> 24u));
+	}
+
+	r.push_back(noise);
+
+	return r;
+}
+
+std::string deflate(const RESPONSES &r) {
+
+	NetMauMau::Common::ZSectionDeflater zd(THRESHOLD);
+	std::string out;
+
+	for(RESPONSES::const_iterator i(r.begin()); i != r.end(); ++i) {
+		zd.append(out, i->data(), i->length());
+	}
+
+	return out;
+}
+
+std::string expected(const RESPONSES &r) {
+
+	std::string s;
+
+	for(RESPONSES::const_iterator i(r.begin()); i != r.end(); ++i) s.append(*i);
+
+	return s;
+}
+
+void feed(NetMauMau::Common::FrameBuffer &in, const char *data, std::size_t len) {
+	std::memcpy(in.prepare(len), data, len);
+	in.commit(len);
+}
+
+// the sections are received in two reads, split after the first split bytes
+bool inflate(const std::string &sections, std::size_t split, std::string &out) {
+
+	NetMauMau::Common::ZSectionInflater zi;
+	NetMauMau::Common::FrameBuffer in, res;
+
+	feed(in, sections.data(), split);
+
+	if(!zi.inflate(in, res)) return false;
+
+	feed(in, sections.data() + split, sections.length() - split);
+
+	if(!zi.inflate(in, res) || !in.empty()) return false;
+
+	out.assign(res.front(), res.size());
+
+	return true;
+}
+
+void checkSections(const RESPONSES &r, const std::string &sections) {
+
+	// the lowest bit of the first varint tells if a section is deflated
+	check(!(sections[0] & 1), "short response sent as it is");
+	check(sections.length() < expected(r).length(), "sections are compressed");
+
+	NetMauMau::Common::FrameBuffer in, res;
+	NetMauMau::Common::ZSectionInflater zi;
+
+	feed(in, sections.data(), 1u + r[0].length());
+	check(zi.inflate(in, res) && in.empty() && std::string(res.front(), res.size()) == r[0],
+		  "first section alone");
+}
+
+void checkSplits(const RESPONSES &r, const std::string &sections) {
+
+	const std::string exp(expected(r));
+
+	for(std::size_t split = 0u; split <= sections.length(); ++split) {
+
+		std::string out;
+		std::ostringstream what;
+
+		what << "sections split after " << split << " of " << sections.length() << " bytes";
+
+		check(inflate(sections, split, out) && out == exp, what.str());
+	}
+}
+
+void checkCorrupted(const std::string &sections) {
+
+	std::string bad(sections), out;
+
+	// the first deflated section is the one of THRESHOLD bytes behind the two raw ones
+	const std::size_t z = 1u + 2u + 1u + (THRESHOLD - 1u);
+
+	check(sections[z] & 1, "first deflated section found");
+
+	bad[z + 2u] = static_cast<char>(bad[z + 2u] ^ 0x55);
+	check(!inflate(bad, bad.length(), out) || out != expected(responses()),
+		  "corrupted section not taken for the original");
+
+	check(!inflate(std::string(5u, '\xff'), 5u, out), "overlong varint refused");
+}
+
+#ifdef ENABLE_THREADS
+void *roundTrip(void *arg) {
+
+	const RESPONSES &r(responses());
+	std::string out;
+
+	*static_cast<bool *>(arg) = inflate(deflate(r), 0u, out) && out == expected(r);
+
+	return 0L;
+}
+
+// the first sessions of several threads build the shared dictionary at the same time
+void checkThreads() {
+
+	pthread_t t[8];
+	bool ok[8] = { false };
+
+	for(std::size_t i = 0u; i < 8u; ++i) pthread_create(&t[i], 0L, roundTrip, &ok[i]);
+
+	for(std::size_t i = 0u; i < 8u; ++i) {
+		pthread_join(t[i], 0L);
+		check(ok[i], "round trip in a thread");
+	}
+}
+#endif
+
+}
+
+int main(int, const char **) {
+
+	try {
+
+#ifdef ENABLE_THREADS
+		checkThreads();
+#endif
+
+		const RESPONSES &r(responses());
+		const std::string &sections(deflate(r));
+
+		checkSections(r, sections);
+		checkSplits(r, sections);
+		checkCorrupted(sections);
+
+	} catch(const NetMauMau::Common::Exception::ZLibException &e) {
+		check(false, e.what());
+	}
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
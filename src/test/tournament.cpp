@@ -0,0 +1,537 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <ctime>
+#include <cstdio>
+#include <cerrno>
+#include <cstdlib>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+
+#ifdef HAVE_SYS_TIME_H
+#include <sys/time.h>
+#endif
+
+#include "tournament.h"
+
+#include "logger.h"
+#include "easyplayer.h"
+#include "hardplayer.h"
+#include "expertplayer.h"
+#include "enginecontext.h"
+#include "defaulteventhandler.h"
+
+#if defined(HAVE_UNISTD_H) && defined(HAVE_SYS_WAIT_H)
+#define FORK_WORKERS 1
+#endif
+
+typedef enum { GAME, ABORTED, STATS } RECORDKIND;
+
+struct Tournament::_record {
+	unsigned int kind;
+	unsigned int winner;
+	unsigned int loser;
+	unsigned int turns;
+	unsigned long decisions;
+	double cpuTime;
+};
+
+namespace {
+
+const std::size_t MAXTURNS = 10000u;
+
+const double ELO_BASE = 1500.0;
+const double GLICKO_RD = 350.0;
+const double Q = std::log(10.0) / 400.0;
+const double Z95 = 1.96;
+
+class ResultEventHandler : public NetMauMau::Event::DefaultEventHandler {
+	DISALLOW_COPY_AND_ASSIGN(ResultEventHandler)
+public:
+	explicit ResultEventHandler() : DefaultEventHandler(), m_winner(0L), m_turn(0u) {}
+	virtual ~ResultEventHandler() {}
+
+	virtual void playerWins(const NetMauMau::Player::IPlayer *player, std::size_t turn,
+							bool) const throw(NetMauMau::Common::Exception::SocketException) {
+		if(!m_winner) {
+			m_winner = player;
+			m_turn = turn;
+		}
+	}
+
+	virtual void setJackModeOff() const throw(NetMauMau::Common::Exception::SocketException) {}
+
+	virtual void reset() throw() {
+		m_winner = 0L;
+		m_turn = 0u;
+	}
+
+	inline const NetMauMau::Player::IPlayer *getWinner() const {
+		return m_winner;
+	}
+
+	inline std::size_t getTurn() const {
+		return m_turn;
+	}
+
+private:
+	mutable const NetMauMau::Player::IPlayer *m_winner;
+	mutable std::size_t m_turn;
+};
+
+class DecisionTimer {
+	DISALLOW_COPY_AND_ASSIGN(DecisionTimer)
+public:
+	virtual ~DecisionTimer() {}
+
+	inline unsigned long getDecisions() const {
+		return m_decisions;
+	}
+
+	inline double getCPUTime() const {
+		return static_cast<double>(m_cpuTime) / CLOCKS_PER_SEC;
+	}
+
+protected:
+	explicit DecisionTimer() : m_decisions(0ul), m_cpuTime(0) {}
+
+	inline void account(std::clock_t start) const {
+		m_cpuTime += std::clock() - start;
+		++m_decisions;
+	}
+
+private:
+	mutable unsigned long m_decisions;
+	mutable std::clock_t m_cpuTime;
+};
+
+template<class P>
+class TimedPlayer : public P, public DecisionTimer {
+	DISALLOW_COPY_AND_ASSIGN(TimedPlayer)
+public:
+	explicit TimedPlayer(const std::string &name, const NetMauMau::IPlayedOutCards *poc)
+		: P(name, poc), DecisionTimer() {}
+
+	explicit TimedPlayer(const std::string &name, const NetMauMau::IPlayedOutCards *poc,
+						 long thinkTime, unsigned int threads) : P(name, poc, thinkTime, threads),
+		DecisionTimer() {}
+
+	virtual ~TimedPlayer() throw() {}
+
+	virtual NetMauMau::Common::ICardPtr requestCard(const NetMauMau::Common::ICardPtr &uc,
+			const NetMauMau::Common::ICard::SUIT *js, std::size_t takeCount,
+			bool noSuspend) const {
+
+		const std::clock_t start = std::clock();
+		const NetMauMau::Common::ICardPtr c(P::requestCard(uc, js, takeCount, noSuspend));
+
+		account(start);
+
+		return c;
+	}
+
+	virtual NetMauMau::Common::ICard::SUIT getJackChoice(const NetMauMau::Common::ICardPtr &uc,
+			const NetMauMau::Common::ICardPtr &pc) const {
+
+		const std::clock_t start = std::clock();
+		const NetMauMau::Common::ICard::SUIT s = P::getJackChoice(uc, pc);
+
+		account(start);
+
+		return s;
+	}
+};
+
+NetMauMau::Player::IPlayer *createPlayer(const Tournament::AICONFIG &cfg,
+		const NetMauMau::IPlayedOutCards *poc, unsigned int threads,
+		const DecisionTimer **timer) {
+
+	if(cfg.type == NetMauMau::Player::IPlayer::EXPERT) {
+		TimedPlayer<NetMauMau::Player::ExpertPlayer> *p =
+			new TimedPlayer<NetMauMau::Player::ExpertPlayer>(cfg.name, poc, cfg.thinkTime, threads);
+		*timer = p;
+		return p;
+	}
+
+	if(cfg.type == NetMauMau::Player::IPlayer::EASY) {
+		TimedPlayer<NetMauMau::Player::EasyPlayer> *p =
+			new TimedPlayer<NetMauMau::Player::EasyPlayer>(cfg.name, poc);
+		*timer = p;
+		return p;
+	}
+
+	TimedPlayer<NetMauMau::Player::HardPlayer> *p =
+		new TimedPlayer<NetMauMau::Player::HardPlayer>(cfg.name, poc);
+	*timer = p;
+	return p;
+}
+
+double now() {
+#ifdef HAVE_SYS_TIME_H
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+#else
+	return static_cast<double>(std::time(0L));
+#endif
+}
+
+void seedWorker(unsigned long seed) {
+
+	char gslSeed[32];
+
+	std::snprintf(gslSeed, sizeof(gslSeed), "%lu", seed);
+	setenv("GSL_RNG_SEED", gslSeed, 1);
+	std::srand(static_cast<unsigned int>(seed));
+}
+
+inline double glickoG(double rd) {
+	return 1.0 / std::sqrt(1.0 + 3.0 * Q * Q * rd * rd / (M_PI * M_PI));
+}
+
+}
+
+Tournament::Tournament(const AICONFIGS &configs, std::size_t gamesPerPairing,
+					   const NetMauMau::Common::CARDCONFIG &cc, char aceRound, bool dirChange,
+					   unsigned long seed) : m_configs(configs), m_gamesPerPairing(gamesPerPairing),
+	m_cardConfig(cc), m_aceRound(aceRound), m_dirChange(dirChange),
+	m_seed(seed ? seed : static_cast<unsigned long>(std::time(0L))), m_jobs(1u),
+	m_standings(configs.size()), m_winMatrix(configs.size(),
+			std::vector<std::size_t>(configs.size(), 0u)), m_playedGames(0u),
+	m_abortedGames(0u), m_wallTime(0.0) {}
+
+Tournament::~Tournament() {}
+
+unsigned int Tournament::getCores() {
+#if defined(HAVE_UNISTD_H) && defined(_SC_NPROCESSORS_ONLN)
+	const long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n > 0 ? static_cast<unsigned int>(n) : 1u;
+#else
+	return 1u;
+#endif
+}
+
+std::size_t Tournament::getScheduledGames() const {
+	return ((m_configs.size() * (m_configs.size() - 1u)) / 2u) * m_gamesPerPairing;
+}
+
+bool Tournament::run(unsigned int jobs) {
+
+	if(m_configs.size() < 2u || !m_gamesPerPairing) return false;
+
+	m_standings.assign(m_configs.size(), STANDING());
+	m_winMatrix.assign(m_configs.size(), std::vector<std::size_t>(m_configs.size(), 0u));
+	m_playedGames = m_abortedGames = 0u;
+
+	m_jobs = std::max(1u, static_cast<unsigned int>(std::min<std::size_t>(jobs ? jobs :
+					  getCores(), getScheduledGames())));
+
+	const double start = now();
+	bool ok = true;
+
+#ifdef FORK_WORKERS
+
+	if(m_jobs > 1u) {
+
+		int fds[2];
+
+		if(pipe(fds)) {
+			logError("Cannot create pipe: " << std::strerror(errno));
+			return false;
+		}
+
+		std::vector<pid_t> workers;
+
+		for(unsigned int w = 0u; w < m_jobs; ++w) {
+
+			const pid_t pid = fork();
+
+			if(!pid) {
+				close(fds[0]);
+				seedWorker(m_seed + w);
+				play(w, fds[1]);
+				close(fds[1]);
+				_exit(EXIT_SUCCESS);
+			} else if(pid > 0) {
+				workers.push_back(pid);
+			} else {
+				logError("Cannot fork worker #" << w << ": " << std::strerror(errno));
+				ok = false;
+				break;
+			}
+		}
+
+		close(fds[1]);
+
+		RECORD rec;
+		std::size_t got = 0u;
+		ssize_t r;
+
+		while((r = read(fds[0], reinterpret_cast<char *>(&rec) + got, sizeof(RECORD) - got)) != 0) {
+
+			if(r < 0) {
+
+				if(errno == EINTR) continue;
+
+				break;
+			}
+
+			if((got += static_cast<std::size_t>(r)) == sizeof(RECORD)) {
+				collect(rec);
+				got = 0u;
+			}
+		}
+
+		close(fds[0]);
+
+		for(std::vector<pid_t>::const_iterator i(workers.begin()); i != workers.end(); ++i) {
+
+			int status = 0;
+
+			if(waitpid(*i, &status, 0) != *i || !WIFEXITED(status) ||
+					WEXITSTATUS(status) != EXIT_SUCCESS) ok = false;
+		}
+
+		ok = ok && !workers.empty();
+
+	} else
+#endif
+	{
+		m_jobs = 1u;
+		seedWorker(m_seed);
+		play(0u, -1);
+	}
+
+	m_wallTime = now() - start;
+
+	rate();
+
+	return ok && m_playedGames;
+}
+
+void Tournament::play(unsigned int worker, int fd) {
+
+	std::vector<std::pair<std::size_t, std::size_t> > pairings;
+
+	for(std::size_t i = 0u; i < m_configs.size(); ++i) {
+		for(std::size_t j = i + 1u; j < m_configs.size(); ++j) {
+			pairings.push_back(std::make_pair(i, j));
+		}
+	}
+
+	ResultEventHandler evHdlr;
+	NetMauMau::EngineContext ctx(evHdlr, m_dirChange, 0L, false, m_aceRound, m_cardConfig);
+
+	std::vector<NetMauMau::Player::IPlayer *> players(m_configs.size(), 0L);
+	std::vector<const DecisionTimer *> timers(m_configs.size(), 0L);
+
+	try {
+
+		NetMauMau::Engine engine(ctx);
+
+		for(std::size_t i = 0u; i < m_configs.size(); ++i) {
+			// don't let parallel workers compete for the cores with the search threads
+			players[i] = createPlayer(m_configs[i], engine.getPlayedOutCards(),
+									  m_jobs > 1u ? 1u : 0u, &timers[i]);
+		}
+
+		for(std::size_t g = worker; g < getScheduledGames(); g += m_jobs) {
+
+			const std::pair<std::size_t, std::size_t> &p(pairings[g / m_gamesPerPairing]);
+			const bool swapSeats = g % 2u;
+
+			NetMauMau::Player::IPlayer *const first  = players[swapSeats ? p.second : p.first];
+			NetMauMau::Player::IPlayer *const second = players[swapSeats ? p.first : p.second];
+
+			RECORD rec = { ABORTED, 0u, 0u, 0u, 0ul, 0.0 };
+
+			try {
+
+				engine.addPlayer(first);
+				engine.addPlayer(second);
+
+				if(engine.distributeCards()) {
+
+					engine.initialTurn();
+
+					for(std::size_t t = 0u; engine.hasPlayers() && t < MAXTURNS; ++t) {
+						if(!engine.nextTurn()) break;
+					}
+				}
+
+				if(evHdlr.getWinner() && !engine.hasPlayers()) {
+
+					const bool firstWins = evHdlr.getWinner() == first;
+
+					rec.kind   = GAME;
+					rec.winner = static_cast<unsigned int>(firstWins == swapSeats ? p.second :
+								 p.first);
+					rec.loser  = static_cast<unsigned int>(firstWins == swapSeats ? p.first :
+								 p.second);
+					rec.turns  = static_cast<unsigned int>(evHdlr.getTurn());
+				}
+
+			} catch(const NetMauMau::Common::Exception::SocketException &e) {
+				logDebug("Game #" << g << " aborted: " << e.what());
+			}
+
+			if(fd >= 0) {
+				if(write(fd, &rec, sizeof(RECORD)) != static_cast<ssize_t>(sizeof(RECORD))) break;
+			} else {
+				collect(rec);
+			}
+
+			engine.reset();
+			first->reset();
+			second->reset();
+		}
+
+	} catch(const NetMauMau::Common::Exception::SocketException &e) {
+		logError("Worker #" << worker << ": " << e.what());
+	}
+
+	for(std::size_t i = 0u; i < m_configs.size(); ++i) {
+
+		if(timers[i]) {
+
+			const RECORD rec = { STATS, static_cast<unsigned int>(i), 0u, 0u,
+								 timers[i]->getDecisions(), timers[i]->getCPUTime()
+							   };
+
+			if(fd >= 0) {
+				if(write(fd, &rec, sizeof(RECORD)) != static_cast<ssize_t>(sizeof(RECORD))) break;
+			} else {
+				collect(rec);
+			}
+		}
+
+		delete players[i];
+	}
+}
+
+void Tournament::collect(const RECORD &rec) {
+
+	switch(rec.kind) {
+	case GAME:
+		++m_playedGames;
+		++m_standings[rec.winner].wins;
+		++m_standings[rec.winner].games;
+		++m_standings[rec.loser].games;
+		m_standings[rec.winner].turns += rec.turns;
+		m_standings[rec.loser].turns += rec.turns;
+		++m_winMatrix[rec.winner][rec.loser];
+		break;
+
+	case STATS:
+		m_standings[rec.winner].decisions += rec.decisions;
+		m_standings[rec.winner].cpuTime += rec.cpuTime;
+		break;
+
+	default:
+		++m_abortedGames;
+		break;
+	}
+}
+
+void Tournament::rate() {
+
+	const std::size_t n = m_configs.size();
+
+	// Elo as maximum likelihood estimate of the Bradley-Terry model, with a virtual draw
+	// against each opponent to keep perfect scores finite (Hunter's MM algorithm)
+	std::vector<double> gamma(n, 1.0), next(n);
+
+	for(unsigned int iter = 0u; iter < 10000u; ++iter) {
+
+		double delta = 0.0, logSum = 0.0;
+
+		for(std::size_t i = 0u; i < n; ++i) {
+
+			double w = 0.0, d = 0.0;
+
+			for(std::size_t j = 0u; j < n; ++j) {
+
+				if(i == j) continue;
+
+				w += static_cast<double>(m_winMatrix[i][j]) + 0.5;
+				d += static_cast<double>(m_winMatrix[i][j] + m_winMatrix[j][i] + 1u) /
+					 (gamma[i] + gamma[j]);
+			}
+
+			logSum += std::log(next[i] = w / d);
+		}
+
+		const double norm = std::exp(logSum / static_cast<double>(n));
+
+		for(std::size_t i = 0u; i < n; ++i) {
+			next[i] /= norm;
+			delta = std::max(delta, std::fabs(next[i] - gamma[i]) / gamma[i]);
+		}
+
+		gamma.swap(next);
+
+		if(delta < 1e-10) break;
+	}
+
+	for(std::size_t i = 0u; i < n; ++i) {
+
+		double info = 0.0, dSum = 0.0, gSum = 0.0;
+
+		for(std::size_t j = 0u; j < n; ++j) {
+
+			if(i == j) continue;
+
+			const double games = static_cast<double>(m_winMatrix[i][j] + m_winMatrix[j][i]);
+			const double p = gamma[i] / (gamma[i] + gamma[j]);
+
+			info += (games + 1.0) * p * (1.0 - p);
+
+			// Glicko: a single rating period, everybody starting unrated
+			const double g = glickoG(GLICKO_RD);
+
+			dSum += games * g * g * 0.25;
+			gSum += g * (static_cast<double>(m_winMatrix[i][j]) - 0.5 * games);
+		}
+
+		STANDING &s(m_standings[i]);
+
+		s.elo   = ELO_BASE + 400.0 * std::log10(gamma[i]);
+		s.eloCI = Z95 * (400.0 / std::log(10.0)) / std::sqrt(info);
+
+		const double invVar = 1.0 / (GLICKO_RD * GLICKO_RD) + Q * Q * dSum;
+
+		s.glicko   = ELO_BASE + (Q / invVar) * gSum;
+		s.glickoRD = std::sqrt(1.0 / invVar);
+	}
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
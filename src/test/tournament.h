@@ -0,0 +1,129 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NETMAUMAU_TEST_TOURNAMENT_H
+#define NETMAUMAU_TEST_TOURNAMENT_H
+
+#include <string>
+#include <vector>
+
+#include "iplayer.h"
+#include "cardtools.h"
+
+class Tournament {
+	DISALLOW_COPY_AND_ASSIGN(Tournament)
+public:
+	typedef struct _aiConfig {
+
+		inline _aiConfig(const std::string &n, NetMauMau::Player::IPlayer::TYPE t,
+						 long tt = 500L) : name(n), type(t), thinkTime(tt) {}
+
+		std::string name;
+		NetMauMau::Player::IPlayer::TYPE type;
+		long thinkTime; ///< think time of expert players in milliseconds
+
+	} AICONFIG;
+
+	typedef std::vector<AICONFIG> AICONFIGS;
+
+	typedef struct _standing {
+
+		inline _standing() : games(0u), wins(0u), turns(0u), decisions(0u), cpuTime(0.0),
+			elo(0.0), eloCI(0.0), glicko(0.0), glickoRD(0.0) {}
+
+		std::size_t games;
+		std::size_t wins;
+		std::size_t turns;
+		unsigned long decisions;
+		double cpuTime;
+		double elo;
+		double eloCI;
+		double glicko;
+		double glickoRD;
+
+	} STANDING;
+
+	typedef std::vector<STANDING> STANDINGS;
+	typedef std::vector<std::vector<std::size_t> > WINMATRIX;
+
+	explicit Tournament(const AICONFIGS &configs, std::size_t gamesPerPairing,
+						const NetMauMau::Common::CARDCONFIG &cc, char aceRound = 0,
+						bool dirChange = false, unsigned long seed = 0ul);
+	~Tournament();
+
+	bool run(unsigned int jobs = 0u);
+
+	inline const AICONFIGS &getConfigs() const {
+		return m_configs;
+	}
+
+	inline const STANDINGS &getStandings() const {
+		return m_standings;
+	}
+
+	inline const WINMATRIX &getWinMatrix() const {
+		return m_winMatrix;
+	}
+
+	inline std::size_t getPlayedGames() const {
+		return m_playedGames;
+	}
+
+	inline std::size_t getAbortedGames() const {
+		return m_abortedGames;
+	}
+
+	inline double getWallTime() const {
+		return m_wallTime;
+	}
+
+	inline unsigned int getJobs() const {
+		return m_jobs;
+	}
+
+	static unsigned int getCores();
+
+private:
+	struct _record;
+	typedef _record RECORD;
+
+	std::size_t getScheduledGames() const _PURE;
+
+	void play(unsigned int worker, int fd);
+	void collect(const RECORD &rec);
+	void rate();
+
+private:
+	const AICONFIGS m_configs;
+	const std::size_t m_gamesPerPairing;
+	const NetMauMau::Common::CARDCONFIG m_cardConfig;
+	const char m_aceRound;
+	const bool m_dirChange;
+	const unsigned long m_seed;
+	unsigned int m_jobs;
+	STANDINGS m_standings;
+	WINMATRIX m_winMatrix;
+	std::size_t m_playedGames;
+	std::size_t m_abortedGames;
+	double m_wallTime;
+};
+
+#endif /* NETMAUMAU_TEST_TOURNAMENT_H */
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2015 by Heiko Schäfer <heiko@rangun.de>
+ *
+ * This file is part of NetMauMau.
+ *
+ * NetMauMau is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * NetMauMau is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with NetMauMau.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(HAVE_CONFIG_H) || defined(IN_IDE_PARSER)
+#include "config.h"
+#endif
+
+#include <popt.h>                       // for POPT_ARG_VAL, poptBadOption, etc
+#include <cstdlib>                      // for NULL, EXIT_FAILURE, etc
+#include <iomanip>                      // for operator<<, setw
+#include <iostream>                     // for basic_ostream, operator<<, etc
+#include <cctype>
+
+#include <algorithm>
+
+#include "tournament.h"
+#include "ci_string.h"
+
+namespace {
+
+int games = 100;
+int jobs = 0;
+int decks = 1;
+int initialCards = 5;
+int dirChange = 0;
+long seed = 0L;
+long thinkTime = 500L;
+
+char *arRank = NULL;
+
+poptOption poptOptions[] = {
+	{
+		"games", 'g', POPT_ARG_INT | POPT_ARGFLAG_SHOW_DEFAULT, &games,
+		0, "Play NUMBER games per pairing", "NUMBER"
+	},
+	{
+		"jobs", 'j', POPT_ARG_INT, &jobs, 0,
+		"Play in NUMBER parallel processes (default: number of online cores)", "NUMBER"
+	},
+	{
+		"decks", 0, POPT_ARG_INT | POPT_ARGFLAG_SHOW_DEFAULT, &decks,
+		0, "Set the amount of card decks to use", "NUMBER"
+	},
+	{
+		"initial-card-count", 'c', POPT_ARG_INT | POPT_ARGFLAG_SHOW_DEFAULT, &initialCards,
+		0, "Set the amount of initial cards", "NUMBER"
+	},
+	{
+		"ace-round", 'a', POPT_ARG_STRING | POPT_ARGFLAG_OPTIONAL, &arRank, 'a',
+		"Enable ace rounds", "ACE|QUEEN|KING"
+	},
+	{
+		"direction-change", 'd', POPT_ARG_NONE, &dirChange, 0,
+		"Enable direction change", NULL
+	},
+	{
+		"think-time", 't', POPT_ARG_LONG | POPT_ARGFLAG_SHOW_DEFAULT, &thinkTime, 0,
+		"Time expert players may think about a move", "MILLISECONDS"
+	},
+	{
+		"seed", 's', POPT_ARG_LONG, &seed, 0,
+		"Seed the random generators of the workers (default: current time)", "SEED"
+	},
+	POPT_AUTOHELP
+	POPT_TABLEEND
+};
+
+Tournament::AICONFIG parseAI(const std::string &arg) {
+
+	const std::string::size_type p = arg.rfind(':');
+
+	if(p != std::string::npos && p + 2u == arg.length()) {
+		switch(::toupper(arg[p + 1u])) {
+		case 'E':
+			return Tournament::AICONFIG(arg.substr(0, p), NetMauMau::Player::IPlayer::EASY);
+
+		case 'H':
+			return Tournament::AICONFIG(arg.substr(0, p), NetMauMau::Player::IPlayer::HARD);
+
+		case 'X':
+			return Tournament::AICONFIG(arg.substr(0, p), NetMauMau::Player::IPlayer::EXPERT,
+										thinkTime);
+		}
+	}
+
+	return Tournament::AICONFIG(arg, NetMauMau::Player::IPlayer::HARD);
+}
+
+const char *typeName(NetMauMau::Player::IPlayer::TYPE t) {
+	return t == NetMauMau::Player::IPlayer::EASY ? "E" :
+		   (t == NetMauMau::Player::IPlayer::EXPERT ? "X" : "H");
+}
+
+}
+
+int main(int argc, const char **argv) {
+
+	poptContext pctx = poptGetContext(NULL, argc, argv, poptOptions, 0);
+	char aceRound = 0;
+	int c;
+
+	poptSetOtherOptionHelp(pctx, "[OPTIONS]* [NAME[:E|H|X]]*");
+
+	while((c = poptGetNextOpt(pctx)) >= 0) {
+
+		switch(c) {
+		case 'a':
+			aceRound = static_cast<char>(::toupper(arRank ? arRank[0] : 'A'));
+
+			if(!(aceRound == 'A' || aceRound == 'Q' || aceRound == 'K')) {
+				std::cerr << "\'" << arRank << "\' is not a valid ace round rank. "
+						  << "Valid ranks are ACE, KING, or QUEEN." << std::endl;
+				poptFreeContext(pctx);
+				return EXIT_FAILURE;
+			}
+
+			break;
+		}
+	}
+
+	if(c < -1) {
+		std::cerr << poptBadOption(pctx, POPT_BADOPTION_NOALIAS) << ": " << poptStrerror(c)
+				  << std::endl;
+		poptFreeContext(pctx);
+		return EXIT_FAILURE;
+	}
+
+	Tournament::AICONFIGS configs;
+	const char *arg;
+
+	while((arg = poptGetArg(pctx))) {
+
+		const Tournament::AICONFIG cfg(parseAI(arg));
+
+		for(Tournament::AICONFIGS::const_iterator i(configs.begin()); i != configs.end(); ++i) {
+			if(NetMauMau::Common::ci_string(i->name.c_str()) ==
+					NetMauMau::Common::ci_string(cfg.name.c_str())) {
+				std::cerr << "Duplicate player name: " << cfg.name << std::endl;
+				poptFreeContext(pctx);
+				return EXIT_FAILURE;
+			}
+		}
+
+		configs.push_back(cfg);
+	}
+
+	poptFreeContext(pctx);
+
+	if(configs.empty()) {
+		configs.push_back(Tournament::AICONFIG("Easy", NetMauMau::Player::IPlayer::EASY));
+		configs.push_back(Tournament::AICONFIG("Hard", NetMauMau::Player::IPlayer::HARD));
+	} else if(configs.size() < 2u) {
+		std::cerr << "At least two players are required" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if(games < 1 || jobs < 0 || decks < 1 || initialCards < 1) {
+		std::cerr << "Invalid arguments" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	setenv("NMM_NO_SQLITE", "1", 0);
+	setenv("NMM_NO_TRACE", "1", 0);
+
+	Tournament tournament(configs, static_cast<std::size_t>(games),
+						  NetMauMau::Common::getCardConfig(2u,
+								  static_cast<std::size_t>(initialCards),
+								  static_cast<std::size_t>(decks)), aceRound, dirChange,
+						  static_cast<unsigned long>(seed));
+
+	const bool ok = tournament.run(static_cast<unsigned int>(jobs));
+
+	const Tournament::STANDINGS &st(tournament.getStandings());
+	std::vector<std::size_t> rank(st.size());
+
+	for(std::size_t i = 0u; i < rank.size(); ++i) rank[i] = i;
+
+	for(std::size_t i = 1u; i < rank.size(); ++i) {
+		for(std::size_t j = i; j > 0u && st[rank[j - 1u]].elo < st[rank[j]].elo; --j) {
+			std::swap(rank[j - 1u], rank[j]);
+		}
+	}
+
+	std::cout << std::fixed << std::endl << " #  " << std::left << std::setw(20)
+			  << "Name" << std::right << " T  Games   Wins   Win%      Elo (95%)    Glicko   (RD)"
+			  << "   us/dec" << std::endl;
+
+	for(std::size_t r = 0u; r < rank.size(); ++r) {
+
+		const Tournament::STANDING &s(st[rank[r]]);
+		const Tournament::AICONFIG &cfg(tournament.getConfigs()[rank[r]]);
+
+		std::cout << std::setw(2) << (r + 1u) << "  " << std::left << std::setw(20)
+				  << cfg.name.substr(0, 20) << std::right << ' ' << typeName(cfg.type)
+				  << std::setw(7) << s.games << std::setw(7) << s.wins << std::setprecision(1)
+				  << std::setw(7) << (s.games ? 100.0 * s.wins / s.games : 0.0)
+				  << std::setprecision(0) << std::setw(9) << s.elo << " +/-" << std::setw(5)
+				  << s.eloCI << std::setw(10) << s.glicko << " (" << std::setw(4) << s.glickoRD
+				  << ')' << std::setprecision(2) << std::setw(9)
+				  << (s.decisions ? s.cpuTime * 1e06 / s.decisions : 0.0) << std::endl;
+	}
+
+	std::cout << std::endl << "Wins (row) against (column):"
+			  << std::endl << std::setw(4) << ' ';
+
+	for(std::size_t j = 0u; j < rank.size(); ++j) std::cout << std::setw(7) << (j + 1u);
+
+	std::cout << std::endl;
+
+	for(std::size_t i = 0u; i < rank.size(); ++i) {
+
+		std::cout << std::setw(2) << (i + 1u) << "  ";
+
+		for(std::size_t j = 0u; j < rank.size(); ++j) {
+			if(i == j) {
+				std::cout << std::setw(7) << '-';
+			} else {
+				std::cout << std::setw(7) << tournament.getWinMatrix()[rank[i]][rank[j]];
+			}
+		}
+
+		std::cout << std::endl;
+	}
+
+	const double wt = tournament.getWallTime();
+
+	std::cout << std::endl << "Games played: " << tournament.getPlayedGames()
+			  << " (aborted: " << tournament.getAbortedGames() << ") in " << std::setprecision(3)
+			  << wt << "s on " << tournament.getJobs() << " worker(s), " << std::setprecision(1)
+			  << (wt > 0.0 ? tournament.getPlayedGames() / wt : 0.0) << " games/s" << std::endl;
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// kate: indent-mode cstyle; indent-width 4; replace-tabs off; tab-width 4;